@@ -1,7 +1,9 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "esp_err.h"
+#include "kc_touch_input.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -64,9 +66,68 @@ esp_err_t kc_touch_display_set_cancel_cb(kc_touch_display_cancel_cb_t cb, void *
  */
 void kc_touch_display_reset_ui_state(void);
 
+/** Flush and frame timing counters since the last reset. */
+typedef struct {
+    bool async;                /**< Flush completion is signalled by the panel transfer-done interrupt. */
+    uint32_t frames;           /**< LVGL refresh cycles that flushed at least one area. */
+    uint32_t flushes;          /**< Buffers handed to the panel. */
+    uint32_t frame_us_avg;     /**< Refresh start to refresh end, render and flush included. */
+    uint32_t frame_us_max;
+    uint32_t transfer_us_avg;  /**< Buffer handed to the panel until the transfer completed. */
+    uint32_t transfer_us_max;
+    uint64_t wait_us_total;    /**< Time LVGL spent blocked waiting for a buffer to come back. */
+    uint64_t window_us;        /**< Wall time covered by these counters. */
+} kc_touch_display_flush_stats_t;
+
+/**
+ * @brief Snapshot the flush/frame counters. FPS is frames * 1e6 / window_us.
+ */
+esp_err_t kc_touch_display_get_flush_stats(kc_touch_display_flush_stats_t *out_stats);
+void kc_touch_display_reset_flush_stats(void);
+
+/**
+ * @brief Redraw the active screen continuously for @p duration_ms and report the counters.
+ *
+ * Blocks the caller (never call it from the GUI task). Build with each render mode and run it
+ * on the same screen to compare PARTIAL, DIRECT and FULL.
+ */
+esp_err_t kc_touch_display_run_benchmark(uint32_t duration_ms, kc_touch_display_flush_stats_t *out_stats);
+
 bool kc_touch_display_is_ready(void);
 bool kc_touch_touch_is_ready(void);
 
+/** Runs on the GUI task with the LVGL lock held. */
+typedef void (*kc_touch_gesture_cb_t)(const kc_touch_gesture_t *gesture, void *ctx);
+
+/**
+ * @brief Receive long-press, pinch and two-finger swipe gestures from the touch task.
+ *
+ * Pinch updates are coalesced, so a busy GUI task sees the newest scale only. Returns
+ * ESP_ERR_NOT_SUPPORTED when gesture recognition is compiled out.
+ */
+esp_err_t kc_touch_display_set_gesture_cb(kc_touch_gesture_cb_t cb, void *ctx);
+
+/** Touch task counters since boot. */
+typedef struct {
+    bool irq;             /**< Reads are triggered by the controller interrupt rather than polling */
+    uint32_t reads;       /**< Controller reads over I2C */
+    uint32_t frames;      /**< Reports handed to LVGL through the frame ring */
+    uint32_t dropped;     /**< Reports skipped because the ring was full (moves only, never edges) */
+    uint32_t gestures;
+    uint32_t read_us_avg; /**< I2C read time, all of it spent in the touch task */
+    uint32_t read_us_max;
+} kc_touch_touch_stats_t;
+
+esp_err_t kc_touch_touch_get_stats(kc_touch_touch_stats_t *out_stats);
+
+/**
+ * @brief Touch-to-photon latency since the last reset: controller scan to LVGL read, to the
+ * first input event, and to the end of the flush of the first frame rendered after the read.
+ * Touch-to-photon is also recorded as the `touch` profiler metric.
+ */
+esp_err_t kc_touch_touch_get_latency(kc_touch_latency_stats_t *out_stats);
+void kc_touch_touch_reset_latency(void);
+
 #ifdef __cplusplus
 }
 #endif
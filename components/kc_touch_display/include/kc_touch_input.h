@@ -0,0 +1,176 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CONFIG_KC_TOUCH_TOUCH_MAX_POINTS
+#define KC_TOUCH_MAX_POINTS CONFIG_KC_TOUCH_TOUCH_MAX_POINTS
+#else
+#define KC_TOUCH_MAX_POINTS 5
+#endif
+
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+} kc_touch_point_t;
+
+/** Every point the controller reported in one scan; count == 0 means released. */
+typedef struct {
+    int64_t timestamp_us; /**< esp_timer time the scan was read */
+    uint8_t count;
+    kc_touch_point_t points[KC_TOUCH_MAX_POINTS];
+} kc_touch_frame_t;
+
+typedef enum {
+    KC_TOUCH_GESTURE_LONG_PRESS = 0, /**< One finger held still for long_press_ms */
+    KC_TOUCH_GESTURE_PINCH_BEGIN,    /**< Two fingers started moving apart or together */
+    KC_TOUCH_GESTURE_PINCH_UPDATE,
+    KC_TOUCH_GESTURE_PINCH_END,
+    KC_TOUCH_GESTURE_SWIPE,          /**< Two fingers moved together in one direction */
+} kc_touch_gesture_type_t;
+
+typedef enum {
+    KC_TOUCH_GESTURE_DIR_NONE = 0,
+    KC_TOUCH_GESTURE_DIR_LEFT,
+    KC_TOUCH_GESTURE_DIR_RIGHT,
+    KC_TOUCH_GESTURE_DIR_UP,
+    KC_TOUCH_GESTURE_DIR_DOWN,
+} kc_touch_gesture_dir_t;
+
+typedef struct {
+    kc_touch_gesture_type_t type;
+    kc_touch_gesture_dir_t direction; /**< SWIPE only */
+    int32_t x;                        /**< Touch point, or the two-finger centroid */
+    int32_t y;
+    int32_t dx;                       /**< Centroid movement since the gesture started */
+    int32_t dy;
+    float scale;                      /**< Finger distance relative to the start (pinch) */
+    uint32_t duration_ms;             /**< Since the first finger went down */
+    int64_t timestamp_us;             /**< Timestamp of the frame that produced the event */
+} kc_touch_gesture_t;
+
+typedef struct {
+    uint32_t long_press_ms;  /**< Hold time before LONG_PRESS */
+    uint16_t slop_px;        /**< Movement still counted as holding still */
+    uint16_t swipe_min_px;   /**< Centroid travel that makes two fingers a SWIPE */
+    uint16_t pinch_min_pct;  /**< Distance change (percent) that makes two fingers a PINCH */
+} kc_touch_gesture_config_t;
+
+typedef enum {
+    KC_TOUCH_GESTURE_STATE_IDLE = 0,
+    KC_TOUCH_GESTURE_STATE_SINGLE,   /**< One finger down, long press still possible */
+    KC_TOUCH_GESTURE_STATE_MOVED,    /**< One finger that moved past the slop (LVGL's drag) */
+    KC_TOUCH_GESTURE_STATE_TWO,      /**< Two fingers, not classified yet */
+    KC_TOUCH_GESTURE_STATE_PINCH,
+    KC_TOUCH_GESTURE_STATE_DONE,     /**< Gesture reported; ignore input until all fingers lift */
+} kc_touch_gesture_state_t;
+
+/**
+ * Frame-driven recognizer for long press, pinch and two-finger swipe. Pure logic with no
+ * RTOS or LVGL dependency, so it runs in the touch task and in host tests alike.
+ */
+typedef struct {
+    kc_touch_gesture_config_t cfg;
+    kc_touch_gesture_state_t state;
+    int64_t down_us;
+    kc_touch_point_t start;   /**< First finger, or the two-finger centroid */
+    float start_distance;
+    float last_scale;
+    kc_touch_gesture_t last;  /**< Last pinch event, reused for PINCH_END */
+} kc_touch_gesture_recognizer_t;
+
+kc_touch_gesture_config_t kc_touch_gesture_default_config(void);
+void kc_touch_gesture_init(kc_touch_gesture_recognizer_t *rec, const kc_touch_gesture_config_t *cfg);
+
+/**
+ * Feed one frame; writes up to @p max_events recognized gestures to @p out_events and returns
+ * how many. Frames must arrive in timestamp order and keep coming while fingers are down.
+ */
+size_t kc_touch_gesture_feed(kc_touch_gesture_recognizer_t *rec, const kc_touch_frame_t *frame,
+                             kc_touch_gesture_t *out_events, size_t max_events);
+
+/** Dominant axis of a movement, for re-deriving the direction after a rotation. */
+kc_touch_gesture_dir_t kc_touch_gesture_direction(int32_t dx, int32_t dy);
+
+const char *kc_touch_gesture_type_name(kc_touch_gesture_type_t type);
+const char *kc_touch_gesture_dir_name(kc_touch_gesture_dir_t dir);
+
+/**
+ * Short-horizon motion predictor for drags. It fits a line through the last few positions of
+ * a single contact and moves the reported point ahead by horizon_ms, which hides part of the
+ * touch-to-photon delay while scrolling. Taps and resting fingers are left untouched.
+ */
+typedef struct {
+    uint32_t horizon_ms;   /**< How far ahead to extrapolate */
+    uint16_t max_px;       /**< Upper bound on the correction */
+    uint16_t max_x;        /**< Predicted points are clamped to [0, max_x] x [0, max_y] */
+    uint16_t max_y;
+} kc_touch_predictor_config_t;
+
+#define KC_TOUCH_PREDICTOR_WINDOW 4
+
+typedef struct {
+    kc_touch_predictor_config_t cfg;
+    int64_t t_us[KC_TOUCH_PREDICTOR_WINDOW];
+    float x[KC_TOUCH_PREDICTOR_WINDOW];
+    float y[KC_TOUCH_PREDICTOR_WINDOW];
+    uint8_t count;
+    uint8_t next;
+} kc_touch_predictor_t;
+
+void kc_touch_predictor_init(kc_touch_predictor_t *pred, const kc_touch_predictor_config_t *cfg);
+
+/** Records the frame's first point and, for a single moving contact, replaces it with the prediction. */
+void kc_touch_predictor_apply(kc_touch_predictor_t *pred, kc_touch_frame_t *frame);
+
+/** Touch-to-photon counters for one pipeline stage, in microseconds. */
+typedef struct {
+    uint32_t count;
+    uint32_t avg_us;
+    uint32_t max_us;
+} kc_touch_latency_stage_t;
+
+typedef struct {
+    kc_touch_latency_stage_t to_read;   /**< Controller scan until LVGL read the frame */
+    kc_touch_latency_stage_t to_event;  /**< ... until LVGL sent the first input event for it */
+    kc_touch_latency_stage_t to_photon; /**< ... until a frame rendered after the read finished flushing */
+} kc_touch_latency_stats_t;
+
+/**
+ * Latency tracker. Each stage follows the oldest touch sample not yet on screen, so a
+ * sample that waits for a busy frame is charged the full wait. Not thread safe: feed it from
+ * the GUI task only.
+ */
+typedef struct {
+    int64_t pending_touch_us; /**< 0 = nothing pending */
+    int64_t pending_read_us;
+    bool event_seen;
+    struct {
+        uint32_t count;
+        uint32_t max_us;
+        uint64_t total_us;
+    } stages[3];
+} kc_touch_latency_t;
+
+void kc_touch_latency_reset(kc_touch_latency_t *lat);
+void kc_touch_latency_on_read(kc_touch_latency_t *lat, int64_t touch_us, int64_t now_us);
+void kc_touch_latency_on_event(kc_touch_latency_t *lat, int64_t now_us);
+
+/**
+ * A frame whose rendering started at @p render_start_us finished flushing at @p shown_us.
+ * Returns true and the touch-to-photon time when it completed a pending sample.
+ */
+bool kc_touch_latency_on_frame_shown(kc_touch_latency_t *lat, int64_t render_start_us, int64_t shown_us,
+                                     uint32_t *out_photon_us);
+void kc_touch_latency_get(const kc_touch_latency_t *lat, kc_touch_latency_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,15 +1,26 @@
 #include "kc_touch_display.h"
 
+#include <inttypes.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
+#include "esp_attr.h"
 #include "esp_check.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "kc_touch_display_backend.h"
 #include "kc_touch_gui.h"
+#include "kc_touch_input_priv.h"
 #include "lvgl.h"
 #include "sdkconfig.h"
+#include "yamui_profiler.h"
+
+#include "esp_heap_caps.h"
+#if CONFIG_KC_TOUCH_DISPLAY_RGB565_PPA
+#include "driver/ppa.h"
+#endif
 
 #if CONFIG_KC_TOUCH_DISPLAY_BACKEND_WAVESHARE_P4 && __has_include("bsp/display.h")
 #include "bsp/display.h"
@@ -33,13 +44,54 @@
 _Static_assert(BUFFER_LINES <= DISPLAY_HEIGHT, "LVGL buffer must not exceed panel height");
 #endif
 
+#ifndef CONFIG_KC_TOUCH_DISPLAY_FLUSH_STATS_INTERVAL_MS
+#define CONFIG_KC_TOUCH_DISPLAY_FLUSH_STATS_INTERVAL_MS 0
+#endif
+
+/* Upper bound for one buffer transfer; a lost interrupt must not stall the GUI task forever. */
+#define FLUSH_WAIT_TIMEOUT_MS 200
+
+#if CONFIG_KC_TOUCH_DISPLAY_RENDER_DIRECT
+#define KC_TOUCH_DISPLAY_RENDER_MODE        LV_DISPLAY_RENDER_MODE_DIRECT
+#define KC_TOUCH_DISPLAY_PANEL_FRAMEBUFFERS 1
+#elif CONFIG_KC_TOUCH_DISPLAY_RENDER_FULL
+#define KC_TOUCH_DISPLAY_RENDER_MODE        LV_DISPLAY_RENDER_MODE_FULL
+#define KC_TOUCH_DISPLAY_PANEL_FRAMEBUFFERS 1
+#else
+#define KC_TOUCH_DISPLAY_RENDER_MODE        LV_DISPLAY_RENDER_MODE_PARTIAL
+#define KC_TOUCH_DISPLAY_PANEL_FRAMEBUFFERS 0
+#endif
+
+/* Byte order selection; LV_COLOR_FORMAT_RGB565_SWAPPED rendering landed in LVGL 9.3.
+ * The DPI framebuffers used by DIRECT/FULL hold RGB565 in CPU byte order. */
+#if KC_TOUCH_DISPLAY_PANEL_FRAMEBUFFERS
+#define KC_TOUCH_DISPLAY_COLOR_FORMAT LV_COLOR_FORMAT_RGB565
+#define KC_TOUCH_DISPLAY_CPU_SWAP     0
+#define KC_TOUCH_DISPLAY_PPA_SWAP     0
+#elif CONFIG_KC_TOUCH_DISPLAY_RGB565_NATIVE && (LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 3))
+#define KC_TOUCH_DISPLAY_COLOR_FORMAT LV_COLOR_FORMAT_RGB565_SWAPPED
+#define KC_TOUCH_DISPLAY_CPU_SWAP     0
+#define KC_TOUCH_DISPLAY_PPA_SWAP     0
+#else
+#define KC_TOUCH_DISPLAY_COLOR_FORMAT LV_COLOR_FORMAT_RGB565
+#define KC_TOUCH_DISPLAY_CPU_SWAP     (CONFIG_LV_COLOR_DEPTH == 16 && !CONFIG_KC_TOUCH_DISPLAY_RGB565_PPA)
+#define KC_TOUCH_DISPLAY_PPA_SWAP     CONFIG_KC_TOUCH_DISPLAY_RGB565_PPA
+#endif
+
+#if KC_TOUCH_DISPLAY_PPA_SWAP
+/* PPA reads the LVGL buffers by DMA, so keep them on cache-line boundaries. */
+#define KC_TOUCH_DISPLAY_BUF_ATTR __attribute__((aligned(64)))
+#else
+#define KC_TOUCH_DISPLAY_BUF_ATTR
+#endif
+
 static const char *TAG = "kc_touch_display";
 
 static lv_display_t *s_lv_display;
 static bool s_display_ready;
-#if !KC_TOUCH_HAS_WAVESHARE_BSP_DISPLAY
-static lv_color_t s_lv_buf_a[BUFFER_PIXELS];
-static lv_color_t s_lv_buf_b[BUFFER_PIXELS];
+#if !KC_TOUCH_HAS_WAVESHARE_BSP_DISPLAY && !KC_TOUCH_DISPLAY_PANEL_FRAMEBUFFERS
+static lv_color_t s_lv_buf_a[BUFFER_PIXELS] KC_TOUCH_DISPLAY_BUF_ATTR;
+static lv_color_t s_lv_buf_b[BUFFER_PIXELS] KC_TOUCH_DISPLAY_BUF_ATTR;
 #endif
 static kc_touch_display_prov_cb_t s_prov_cb;
 static void *s_prov_ctx;
@@ -48,9 +100,33 @@ static void *s_cancel_ctx = NULL;
 static lv_obj_t *s_status_label;
 static lv_obj_t *s_prov_back_btn = NULL;
 
-#if CONFIG_KC_TOUCH_TOUCH_ENABLE && !KC_TOUCH_HAS_WAVESHARE_BSP_DISPLAY
-static lv_indev_t *s_touch_indev;
-#endif
+/* Timing counters: the GUI task owns most fields, the transfer-done ISR adds transfer times. */
+typedef struct {
+    uint32_t frames;
+    uint32_t flushes;
+    uint32_t transfers;
+    uint64_t frame_us_total;
+    uint32_t frame_us_max;
+    uint64_t transfer_us_total;
+    uint32_t transfer_us_max;
+    uint64_t wait_us_total;
+    int64_t window_start_us;
+} kc_touch_display_flush_counters_t;
+
+static portMUX_TYPE s_flush_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static kc_touch_display_flush_counters_t s_flush_stats;
+static bool s_flush_async;
+/* DIRECT/FULL: LVGL renders into the DPI panel's own framebuffers. */
+static bool s_render_into_framebuffers;
+
+static const char *kc_touch_display_render_mode_name(void)
+{
+    if (!s_render_into_framebuffers) {
+        return "partial";
+    }
+    return KC_TOUCH_DISPLAY_RENDER_MODE == LV_DISPLAY_RENDER_MODE_DIRECT ? "direct" : "full";
+}
+
 #if CONFIG_KC_TOUCH_TOUCH_ENABLE
 static bool s_touch_ready;
 #endif
@@ -71,6 +147,131 @@ static lv_display_rotation_t kc_touch_display_rotation(void)
 #endif
 }
 
+#if KC_TOUCH_DISPLAY_PPA_SWAP
+static ppa_client_handle_t s_ppa_srm;
+static void *s_ppa_out;
+static size_t s_ppa_out_bytes;
+
+/* LVGL waits for the previous flush before issuing the next one, so a single staging buffer suffices. */
+static void kc_touch_display_ppa_init(void)
+{
+    ppa_client_config_t client_cfg = {
+        .oper_type = PPA_OPERATION_SRM,
+        .max_pending_trans_num = 1,
+    };
+    esp_err_t err = ppa_register_client(&client_cfg, &s_ppa_srm);
+    if (err == ESP_OK) {
+        s_ppa_out_bytes = (BUFFER_PIXELS * sizeof(uint16_t) + 63U) & ~(size_t)63U;
+        s_ppa_out = heap_caps_aligned_calloc(64, 1, s_ppa_out_bytes, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+        if (!s_ppa_out) {
+            err = ESP_ERR_NO_MEM;
+            (void)ppa_unregister_client(s_ppa_srm);
+            s_ppa_srm = NULL;
+        }
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "PPA byte swap unavailable (%s); swapping on the CPU", esp_err_to_name(err));
+    }
+}
+
+static lv_color_t *kc_touch_display_ppa_swap(const lv_area_t *area, lv_color_t *color_p)
+{
+    uint32_t w = (uint32_t)lv_area_get_width(area);
+    uint32_t h = (uint32_t)lv_area_get_height(area);
+    if (s_ppa_srm) {
+        ppa_srm_oper_config_t oper = {
+            .in = {
+                .buffer = color_p,
+                .pic_w = w,
+                .pic_h = h,
+                .block_w = w,
+                .block_h = h,
+                .srm_cm = PPA_SRM_COLOR_MODE_RGB565,
+            },
+            .out = {
+                .buffer = s_ppa_out,
+                .buffer_size = s_ppa_out_bytes,
+                .pic_w = w,
+                .pic_h = h,
+                .srm_cm = PPA_SRM_COLOR_MODE_RGB565,
+            },
+            .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
+            .scale_x = 1.0f,
+            .scale_y = 1.0f,
+            .byte_swap = true,
+            .mode = PPA_TRANS_MODE_BLOCKING,
+        };
+        if (ppa_do_scale_rotate_mirror(s_ppa_srm, &oper) == ESP_OK) {
+            return (lv_color_t *)s_ppa_out;
+        }
+    }
+    lv_draw_sw_rgb565_swap(color_p, lv_area_get_size(area));
+    return color_p;
+}
+#endif
+
+static SemaphoreHandle_t s_flush_done_sem;
+static volatile int64_t s_flush_started_us;
+static volatile uint32_t s_last_transfer_us;
+static bool s_frame_flushed;
+static int64_t s_frame_started_us;
+/* Completion of a frame's last buffer, for touch-to-photon latency. */
+static volatile int64_t s_last_transfer_done_us;
+static bool s_last_area_pending;
+static int64_t s_last_area_frame_us;
+
+static IRAM_ATTR void kc_touch_display_record_transfer(int64_t done_us)
+{
+    uint32_t elapsed = (uint32_t)(done_us - s_flush_started_us);
+    s_last_transfer_us = elapsed;
+    s_last_transfer_done_us = done_us;
+    s_flush_stats.transfers++;
+    s_flush_stats.transfer_us_total += elapsed;
+    if (elapsed > s_flush_stats.transfer_us_max) {
+        s_flush_stats.transfer_us_max = elapsed;
+    }
+}
+
+static IRAM_ATTR bool kc_touch_display_flush_done_isr(void *ctx)
+{
+    (void)ctx;
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL_ISR(&s_flush_stats_lock);
+    kc_touch_display_record_transfer(now);
+    portEXIT_CRITICAL_ISR(&s_flush_stats_lock);
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(s_flush_done_sem, &woken);
+    return woken == pdTRUE;
+}
+
+/* Runs once the last buffer of a frame is out; with async flushes that may be a frame later,
+ * but the completion time is the one the ISR stamped. */
+static void kc_touch_display_note_frame_shown(int64_t shown_us)
+{
+    if (!s_last_area_pending) {
+        return;
+    }
+    s_last_area_pending = false;
+    kc_touch_input_note_frame_shown(s_last_area_frame_us, shown_us);
+}
+
+/* LVGL only calls this while a flush is outstanding, i.e. right before it reuses a buffer. */
+static void kc_touch_display_flush_wait_cb(lv_display_t *disp)
+{
+    (void)disp;
+    int64_t start = esp_timer_get_time();
+    if (xSemaphoreTake(s_flush_done_sem, pdMS_TO_TICKS(FLUSH_WAIT_TIMEOUT_MS)) != pdTRUE) {
+        ESP_LOGW(TAG, "Panel transfer did not complete within %d ms", FLUSH_WAIT_TIMEOUT_MS);
+    }
+    int64_t waited = esp_timer_get_time() - start;
+    /* The ISR only stashes the transfer time; the profiler lives in flash. */
+    yamui_prof_record(YAMUI_PROF_FLUSH, s_last_transfer_us);
+    portENTER_CRITICAL(&s_flush_stats_lock);
+    s_flush_stats.wait_us_total += (uint64_t)waited;
+    portEXIT_CRITICAL(&s_flush_stats_lock);
+    kc_touch_display_note_frame_shown(s_last_transfer_done_us);
+}
+
 static void kc_touch_display_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
 {
     if (!area || !px_map) {
@@ -82,15 +283,163 @@ static void kc_touch_display_flush_cb(lv_display_t *disp, const lv_area_t *area,
         return;
     }
     lv_color_t *color_p = (lv_color_t *)px_map;
-#if CONFIG_LV_COLOR_DEPTH == 16
+    lv_area_t screen_area;
+    if (s_render_into_framebuffers) {
+        /* LVGL drew straight into a panel framebuffer; hand it to the panel once per frame,
+         * the backend releases it on the next vsync. */
+        if (!lv_display_flush_is_last(disp)) {
+            lv_display_flush_ready(disp);
+            return;
+        }
+        lv_area_set(&screen_area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                    lv_display_get_vertical_resolution(disp) - 1);
+        area = &screen_area;
+    }
+#if KC_TOUCH_DISPLAY_CPU_SWAP
     // Swap RGB565 byte order before panel flush.
     lv_draw_sw_rgb565_swap(color_p, lv_area_get_size(area));
+#elif KC_TOUCH_DISPLAY_PPA_SWAP
+    color_p = kc_touch_display_ppa_swap(area, color_p);
 #endif
+    s_frame_flushed = true;
+    if (lv_display_flush_is_last(disp)) {
+        s_last_area_pending = true;
+        s_last_area_frame_us = s_frame_started_us;
+    }
+    s_flush_started_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_flush_stats_lock);
+    s_flush_stats.flushes++;
+    portEXIT_CRITICAL(&s_flush_stats_lock);
     esp_err_t err = kc_touch_display_backend_flush(area->x1, area->y1, area->x2, area->y2, color_p);
     if (err != ESP_OK) {
         ESP_LOGW(TAG, "Panel flush failed (%s)", esp_err_to_name(err));
+        if (s_flush_async) {
+            /* No transfer was queued, so no completion will arrive. */
+            (void)xSemaphoreGive(s_flush_done_sem);
+        }
+    }
+    if (!s_flush_async) {
+        int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL(&s_flush_stats_lock);
+        kc_touch_display_record_transfer(now);
+        portEXIT_CRITICAL(&s_flush_stats_lock);
+        yamui_prof_record(YAMUI_PROF_FLUSH, s_last_transfer_us);
+        kc_touch_display_note_frame_shown(now);
+        lv_display_flush_ready(disp);
+    }
+}
+
+static void kc_touch_display_log_flush_stats(void)
+{
+    kc_touch_display_flush_stats_t stats;
+    (void)kc_touch_display_get_flush_stats(&stats);
+    if (stats.window_us == 0U) {
+        return;
+    }
+    uint32_t fps_x10 = (uint32_t)(((uint64_t)stats.frames * 10000000ULL) / stats.window_us);
+    ESP_LOGI(TAG,
+             "%s %s flush: %" PRIu32 ".%" PRIu32 " fps, frame avg %" PRIu32 " us max %" PRIu32 " us, "
+             "transfer avg %" PRIu32 " us max %" PRIu32 " us, %" PRIu32 " flushes, blocked %" PRIu32 " ms",
+             kc_touch_display_render_mode_name(),
+             stats.async ? "async" : "sync",
+             fps_x10 / 10U,
+             fps_x10 % 10U,
+             stats.frame_us_avg,
+             stats.frame_us_max,
+             stats.transfer_us_avg,
+             stats.transfer_us_max,
+             stats.flushes,
+             (uint32_t)(stats.wait_us_total / 1000U));
+    kc_touch_display_reset_flush_stats();
+}
+
+static void kc_touch_display_refr_event_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    int64_t now = esp_timer_get_time();
+    if (code == LV_EVENT_REFR_START) {
+        s_frame_started_us = now;
+        s_frame_flushed = false;
+        return;
+    }
+    if (code != LV_EVENT_REFR_READY || !s_frame_flushed) {
+        return;
+    }
+    uint32_t elapsed = (uint32_t)(now - s_frame_started_us);
+    yamui_prof_record(YAMUI_PROF_FRAME, elapsed);
+    portENTER_CRITICAL(&s_flush_stats_lock);
+    s_flush_stats.frames++;
+    s_flush_stats.frame_us_total += elapsed;
+    if (elapsed > s_flush_stats.frame_us_max) {
+        s_flush_stats.frame_us_max = elapsed;
+    }
+    int64_t window_start = s_flush_stats.window_start_us;
+    portEXIT_CRITICAL(&s_flush_stats_lock);
+    if (CONFIG_KC_TOUCH_DISPLAY_FLUSH_STATS_INTERVAL_MS > 0
+        && now - window_start >= (int64_t)CONFIG_KC_TOUCH_DISPLAY_FLUSH_STATS_INTERVAL_MS * 1000) {
+        kc_touch_display_log_flush_stats();
+    }
+}
+
+static void kc_touch_display_enable_async_flush(void)
+{
+    /* Framebuffer modes always wait for the vsync release, whatever ASYNC_FLUSH says. */
+#if CONFIG_KC_TOUCH_DISPLAY_ASYNC_FLUSH || KC_TOUCH_DISPLAY_PANEL_FRAMEBUFFERS
+    s_flush_done_sem = xSemaphoreCreateBinary();
+    if (!s_flush_done_sem) {
+        ESP_LOGW(TAG, "No memory for the flush semaphore; flushing synchronously");
+        return;
+    }
+    if (kc_touch_display_backend_set_flush_done_cb(kc_touch_display_flush_done_isr, NULL) != ESP_OK) {
+        ESP_LOGI(TAG, "Backend flushes synchronously");
+        vSemaphoreDelete(s_flush_done_sem);
+        s_flush_done_sem = NULL;
+        return;
     }
-    lv_display_flush_ready(disp);
+    lv_display_set_flush_wait_cb(s_lv_display, kc_touch_display_flush_wait_cb);
+    s_flush_async = true;
+    ESP_LOGI(TAG, "Asynchronous flush enabled: rendering overlaps panel transfers");
+#endif
+}
+#endif
+
+#if !KC_TOUCH_HAS_WAVESHARE_BSP_DISPLAY
+static bool kc_touch_display_attach_buffers(lv_display_t *disp)
+{
+#if KC_TOUCH_DISPLAY_PANEL_FRAMEBUFFERS
+    void *fb0 = NULL;
+    void *fb1 = NULL;
+    size_t fb_bytes = 0;
+    /* Without the vsync release, flush_ready would hand LVGL the buffer still being scanned
+     * out and it would tear; render into line buffers instead. */
+    if (!s_flush_async) {
+        ESP_LOGW(TAG, "No vsync callback for %s rendering", kc_touch_display_render_mode_name());
+    } else if (kc_touch_display_backend_get_framebuffers(&fb0, &fb1, &fb_bytes) == ESP_OK) {
+        lv_display_set_buffers(disp, fb0, fb1, (uint32_t)fb_bytes, KC_TOUCH_DISPLAY_RENDER_MODE);
+        s_render_into_framebuffers = true;
+        ESP_LOGI(TAG, "Rendering %s into panel framebuffers (%u bytes each)", kc_touch_display_render_mode_name(),
+                 (unsigned)fb_bytes);
+        return true;
+    }
+    /* Same line buffers PARTIAL would use, just from the heap so framebuffer builds don't carry them. */
+    size_t buffer_bytes = BUFFER_PIXELS * sizeof(lv_color_t);
+    void *buf_a = heap_caps_malloc(buffer_bytes, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    void *buf_b = heap_caps_malloc(buffer_bytes, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    if (!buf_a) {
+        heap_caps_free(buf_b);
+        ESP_LOGE(TAG, "Panel framebuffers unavailable and no memory for a %u byte line buffer",
+                 (unsigned)buffer_bytes);
+        return false;
+    }
+    if (!buf_b) {
+        ESP_LOGW(TAG, "Single line buffer only; rendering waits for every transfer");
+    }
+    ESP_LOGW(TAG, "Panel framebuffers unavailable; falling back to partial rendering");
+    lv_display_set_buffers(disp, buf_a, buf_b, (uint32_t)buffer_bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
+#else
+    lv_display_set_buffers(disp, s_lv_buf_a, s_lv_buf_b, sizeof(s_lv_buf_a), LV_DISPLAY_RENDER_MODE_PARTIAL);
+#endif
+    return true;
 }
 #endif
 
@@ -116,16 +465,26 @@ static void kc_touch_display_register_lvgl(void *ctx)
         return;
     }
 
-    lv_display_set_color_format(s_lv_display, LV_COLOR_FORMAT_RGB565);
-    lv_display_set_render_mode(s_lv_display, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_color_format(s_lv_display, KC_TOUCH_DISPLAY_COLOR_FORMAT);
+#if KC_TOUCH_DISPLAY_PPA_SWAP
+    kc_touch_display_ppa_init();
+#endif
     lv_display_set_flush_cb(s_lv_display, kc_touch_display_flush_cb);
-
-    size_t buffer_bytes = sizeof(s_lv_buf_a);
-    lv_display_set_buffers(s_lv_display, s_lv_buf_a, s_lv_buf_b, buffer_bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    /* Decides whether DIRECT/FULL can be honoured, so it runs before the buffers are chosen. */
+    kc_touch_display_enable_async_flush();
+    if (!kc_touch_display_attach_buffers(s_lv_display)) {
+        lv_display_delete(s_lv_display);
+        s_lv_display = NULL;
+        return;
+    }
 
     // Force 0-degree rotation because hardware rotation is handled externally
     lv_display_set_rotation(s_lv_display, LV_DISPLAY_ROTATION_0);
 
+    kc_touch_display_reset_flush_stats();
+    lv_display_add_event_cb(s_lv_display, kc_touch_display_refr_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(s_lv_display, kc_touch_display_refr_event_cb, LV_EVENT_REFR_READY, NULL);
+
     // We do NOT build the default scene here anymore because kc_touch_gui
     // loads the YamUI bundle as the main application UI.
     // kc_touch_display_build_scene(NULL);
@@ -133,48 +492,9 @@ static void kc_touch_display_register_lvgl(void *ctx)
 }
 
 #if CONFIG_KC_TOUCH_TOUCH_ENABLE && !KC_TOUCH_HAS_WAVESHARE_BSP_DISPLAY
-static bool kc_touch_touch_sample(uint16_t *x, uint16_t *y)
-{
-    if (!x || !y) {
-        return false;
-    }
-    return kc_touch_display_backend_touch_sample(x, y);
-}
-
-static void kc_touch_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
-{
-    (void)indev;
-    uint16_t x = 0;
-    uint16_t y = 0;
-    if (kc_touch_touch_sample(&x, &y)) {
-        // ESP_LOGI(TAG, "Touch: x=%d, y=%d", x, y);
-        data->point.x = x;
-        data->point.y = y;
-        data->state = LV_INDEV_STATE_PRESSED;
-    } else {
-        data->state = LV_INDEV_STATE_RELEASED;
-    }
-}
-
-static void kc_touch_touch_register_lvgl(void *ctx)
-{
-    (void)ctx;
-    if (!s_lv_display) {
-        return;
-    }
-    s_touch_indev = lv_indev_create();
-    if (!s_touch_indev) {
-        ESP_LOGE(TAG, "Failed to create touch input device");
-        return;
-    }
-    lv_indev_set_type(s_touch_indev, LV_INDEV_TYPE_POINTER);
-    lv_indev_set_read_cb(s_touch_indev, kc_touch_touch_read_cb);
-    lv_indev_set_display(s_touch_indev, s_lv_display);
-}
-
 static esp_err_t kc_touch_touch_init(void)
 {
-    esp_err_t err = kc_touch_gui_dispatch(kc_touch_touch_register_lvgl, NULL, pdMS_TO_TICKS(100));
+    esp_err_t err = kc_touch_input_start(s_lv_display);
     if (err != ESP_OK) {
         return err;
     }
@@ -369,6 +689,96 @@ void kc_touch_display_reset_ui_state(void)
     s_prov_back_btn = NULL;
 }
 
+esp_err_t kc_touch_display_get_flush_stats(kc_touch_display_flush_stats_t *out_stats)
+{
+    if (!out_stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    kc_touch_display_flush_counters_t counters;
+    portENTER_CRITICAL(&s_flush_stats_lock);
+    counters = s_flush_stats;
+    portEXIT_CRITICAL(&s_flush_stats_lock);
+    memset(out_stats, 0, sizeof(*out_stats));
+    out_stats->async = s_flush_async;
+    out_stats->frames = counters.frames;
+    out_stats->flushes = counters.flushes;
+    out_stats->frame_us_avg = counters.frames ? (uint32_t)(counters.frame_us_total / counters.frames) : 0U;
+    out_stats->frame_us_max = counters.frame_us_max;
+    out_stats->transfer_us_avg = counters.transfers ? (uint32_t)(counters.transfer_us_total / counters.transfers) : 0U;
+    out_stats->transfer_us_max = counters.transfer_us_max;
+    out_stats->wait_us_total = counters.wait_us_total;
+    out_stats->window_us = counters.window_start_us ? (uint64_t)(esp_timer_get_time() - counters.window_start_us) : 0U;
+    return ESP_OK;
+}
+
+void kc_touch_display_reset_flush_stats(void)
+{
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_flush_stats_lock);
+    memset(&s_flush_stats, 0, sizeof(s_flush_stats));
+    s_flush_stats.window_start_us = now;
+    portEXIT_CRITICAL(&s_flush_stats_lock);
+}
+
+typedef struct {
+    SemaphoreHandle_t done;
+    kc_touch_display_flush_stats_t *out_stats;
+} kc_touch_display_benchmark_t;
+
+static lv_timer_t *s_benchmark_timer;
+
+static void kc_touch_display_benchmark_tick(lv_timer_t *timer)
+{
+    (void)timer;
+    lv_obj_invalidate(lv_screen_active());
+}
+
+static void kc_touch_display_benchmark_start_task(void *ctx)
+{
+    (void)ctx;
+    kc_touch_display_reset_flush_stats();
+    /* Period 0: invalidate on every timer pass so LVGL renders back to back. */
+    s_benchmark_timer = lv_timer_create(kc_touch_display_benchmark_tick, 0, NULL);
+}
+
+static void kc_touch_display_benchmark_stop_task(void *ctx)
+{
+    kc_touch_display_benchmark_t *bench = (kc_touch_display_benchmark_t *)ctx;
+    if (s_benchmark_timer) {
+        lv_timer_delete(s_benchmark_timer);
+        s_benchmark_timer = NULL;
+    }
+    (void)kc_touch_display_get_flush_stats(bench->out_stats);
+    xSemaphoreGive(bench->done);
+}
+
+esp_err_t kc_touch_display_run_benchmark(uint32_t duration_ms, kc_touch_display_flush_stats_t *out_stats)
+{
+    ESP_RETURN_ON_FALSE(out_stats && duration_ms > 0U, ESP_ERR_INVALID_ARG, TAG, "invalid args");
+    ESP_RETURN_ON_FALSE(s_display_ready, ESP_ERR_INVALID_STATE, TAG, "display not ready");
+    ESP_RETURN_ON_FALSE(!s_benchmark_timer, ESP_ERR_INVALID_STATE, TAG, "benchmark running");
+
+    kc_touch_display_benchmark_t bench = {
+        .done = xSemaphoreCreateBinary(),
+        .out_stats = out_stats,
+    };
+    ESP_RETURN_ON_FALSE(bench.done, ESP_ERR_NO_MEM, TAG, "benchmark sem");
+    esp_err_t err = kc_touch_gui_dispatch(kc_touch_display_benchmark_start_task, NULL, pdMS_TO_TICKS(200));
+    if (err == ESP_OK) {
+        vTaskDelay(pdMS_TO_TICKS(duration_ms));
+        err = kc_touch_gui_dispatch(kc_touch_display_benchmark_stop_task, &bench, portMAX_DELAY);
+    }
+    if (err == ESP_OK && xSemaphoreTake(bench.done, portMAX_DELAY) != pdTRUE) {
+        err = ESP_ERR_TIMEOUT;
+    }
+    vSemaphoreDelete(bench.done);
+    ESP_RETURN_ON_ERROR(err, TAG, "benchmark dispatch");
+    ESP_LOGI(TAG, "Benchmark (%s): %" PRIu32 " frames in %" PRIu32 " ms, frame avg %" PRIu32 " us, transfer avg %" PRIu32 " us",
+             kc_touch_display_render_mode_name(), out_stats->frames, (uint32_t)(out_stats->window_us / 1000U),
+             out_stats->frame_us_avg, out_stats->transfer_us_avg);
+    return ESP_OK;
+}
+
 bool kc_touch_display_is_ready(void)
 {
     return s_display_ready;
@@ -432,6 +842,23 @@ void kc_touch_display_reset_ui_state(void)
 {
 }
 
+esp_err_t kc_touch_display_get_flush_stats(kc_touch_display_flush_stats_t *out_stats)
+{
+    (void)out_stats;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void kc_touch_display_reset_flush_stats(void)
+{
+}
+
+esp_err_t kc_touch_display_run_benchmark(uint32_t duration_ms, kc_touch_display_flush_stats_t *out_stats)
+{
+    (void)duration_ms;
+    (void)out_stats;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
 bool kc_touch_display_is_ready(void)
 {
     return false;
@@ -4,6 +4,7 @@
 #include <stdint.h>
 
 #include "esp_err.h"
+#include "kc_touch_input.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -11,7 +12,35 @@ extern "C" {
 
 esp_err_t kc_touch_display_backend_init_hw(void);
 esp_err_t kc_touch_display_backend_flush(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const void *color_data);
-bool kc_touch_display_backend_touch_sample(uint16_t *x, uint16_t *y);
+
+/* Called from the transfer-done ISR; returns true when a higher priority task was woken. */
+typedef bool (*kc_touch_display_backend_flush_done_cb_t)(void *ctx);
+
+/**
+ * Switches the backend to asynchronous flushes: kc_touch_display_backend_flush() returns once the
+ * transfer is queued and @p cb fires when the buffer may be reused. Returns ESP_ERR_NOT_SUPPORTED
+ * when the backend can only flush synchronously.
+ */
+esp_err_t kc_touch_display_backend_set_flush_done_cb(kc_touch_display_backend_flush_done_cb_t cb, void *ctx);
+
+/**
+ * Returns the panel's two framebuffers for DIRECT/FULL rendering. Flushing one of them swaps it
+ * to the front at the next vsync; the flush-done callback fires once the old one is released.
+ */
+esp_err_t kc_touch_display_backend_get_framebuffers(void **out_fb0, void **out_fb1, size_t *out_bytes);
+/* Called from the touch controller's interrupt; returns true when a higher priority task was woken. */
+typedef bool (*kc_touch_display_backend_touch_irq_cb_t)(void *ctx);
+
+/**
+ * Brings up the touch controller. When it has an interrupt line, @p cb fires for every new
+ * report and *out_has_irq is set; otherwise the caller has to poll.
+ */
+esp_err_t kc_touch_display_backend_touch_init(kc_touch_display_backend_touch_irq_cb_t cb, void *ctx, bool *out_has_irq);
+/** Undoes kc_touch_display_backend_touch_init(); the interrupt callback is detached first. */
+void kc_touch_display_backend_touch_deinit(void);
+
+/** Reads one report over I2C (blocking) and returns how many points are down. */
+uint8_t kc_touch_display_backend_touch_read(kc_touch_point_t *points, uint8_t max_points);
 esp_err_t kc_touch_display_backend_backlight_set(bool enable);
 esp_err_t kc_touch_display_backend_brightness_set(int percent);
 
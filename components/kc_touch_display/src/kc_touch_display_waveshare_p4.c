@@ -4,6 +4,7 @@
 
 #include "kc_touch_display_backend.h"
 
+#include "esp_attr.h"
 #include "esp_check.h"
 #include "esp_err.h"
 #include "esp_log.h"
@@ -16,6 +17,14 @@
 #define KC_TOUCH_ESP_LCD_TOUCH_AVAILABLE 0
 #endif
 
+#if KC_TOUCH_ESP_LCD_TOUCH_AVAILABLE && __has_include("esp_lcd_touch_gt911.h") && __has_include("driver/i2c_master.h")
+#include "driver/i2c_master.h"
+#include "esp_lcd_touch_gt911.h"
+#define KC_TOUCH_WAVESHARE_GT911_AVAILABLE 1
+#else
+#define KC_TOUCH_WAVESHARE_GT911_AVAILABLE 0
+#endif
+
 #if __has_include("bsp/esp32_p4_platform.h")
 #include "bsp/esp32_p4_platform.h"
 #define KC_TOUCH_WAVESHARE_BSP_AVAILABLE 1
@@ -53,13 +62,33 @@ static bool s_bsp_lvgl_active;
 #if KC_TOUCH_ESP_LCD_TOUCH_AVAILABLE
 static esp_lcd_touch_handle_t s_touch;
 #endif
+#if KC_TOUCH_WAVESHARE_GT911_AVAILABLE
+static i2c_master_bus_handle_t s_touch_i2c;
+static esp_lcd_panel_io_handle_t s_touch_io;
+static kc_touch_display_backend_touch_irq_cb_t s_touch_irq_cb;
+static void *s_touch_irq_ctx;
+#endif
 #if KC_TOUCH_WAVESHARE_JD9365_COMPONENT_AVAILABLE
 static esp_lcd_dsi_bus_handle_t s_mipi_dsi_bus;
 static esp_lcd_panel_io_handle_t s_mipi_dbi_io;
 static esp_ldo_channel_handle_t s_mipi_ldo_chan;
+static bool s_async_flush_ready;
+static kc_touch_display_backend_flush_done_cb_t s_flush_done_cb;
+static void *s_flush_done_ctx;
 #endif
 static bool s_backlight_ready;
 
+/* DIRECT/FULL rendering draws into the DPI framebuffers, which are kept in RGB565 to halve PSRAM traffic. */
+#if CONFIG_KC_TOUCH_DISPLAY_RENDER_DIRECT || CONFIG_KC_TOUCH_DISPLAY_RENDER_FULL
+#define KC_WS_P4_PANEL_FRAMEBUFFERS 2
+#define KC_WS_P4_PIXEL_FORMAT       LCD_COLOR_PIXEL_FORMAT_RGB565
+#define KC_WS_P4_BITS_PER_PIXEL     16
+#else
+#define KC_WS_P4_PANEL_FRAMEBUFFERS 0
+#define KC_WS_P4_PIXEL_FORMAT       LCD_COLOR_PIXEL_FORMAT_RGB888
+#define KC_WS_P4_BITS_PER_PIXEL     24
+#endif
+
 #ifndef CONFIG_KC_TOUCH_DISPLAY_WIDTH
 #define CONFIG_KC_TOUCH_DISPLAY_WIDTH 1280
 #endif
@@ -68,6 +97,35 @@ static bool s_backlight_ready;
 #define CONFIG_KC_TOUCH_DISPLAY_HEIGHT 800
 #endif
 
+#if KC_TOUCH_WAVESHARE_JD9365_COMPONENT_AVAILABLE
+#if KC_WS_P4_PANEL_FRAMEBUFFERS
+static volatile bool s_fb_swap_pending;
+
+/* The first refresh that ends after a swap was the last scan-out of the previous framebuffer. */
+static IRAM_ATTR bool kc_ws_p4_refresh_done(esp_lcd_panel_handle_t panel, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx)
+{
+    (void)panel;
+    (void)edata;
+    (void)user_ctx;
+    if (!s_fb_swap_pending) {
+        return false;
+    }
+    s_fb_swap_pending = false;
+    kc_touch_display_backend_flush_done_cb_t cb = s_flush_done_cb;
+    return cb ? cb(s_flush_done_ctx) : false;
+}
+#elif CONFIG_KC_TOUCH_DISPLAY_ASYNC_FLUSH
+static IRAM_ATTR bool kc_ws_p4_color_trans_done(esp_lcd_panel_handle_t panel, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx)
+{
+    (void)panel;
+    (void)edata;
+    (void)user_ctx;
+    kc_touch_display_backend_flush_done_cb_t cb = s_flush_done_cb;
+    return cb ? cb(s_flush_done_ctx) : false;
+}
+#endif
+#endif
+
 esp_err_t kc_touch_display_backend_init_hw(void)
 {
     if (s_ready) {
@@ -139,7 +197,13 @@ esp_err_t kc_touch_display_backend_init_hw(void)
         return err;
     }
 
-    esp_lcd_dpi_panel_config_t dpi_config = JD9365_800_1280_PANEL_60HZ_DPI_CONFIG(LCD_COLOR_PIXEL_FORMAT_RGB888);
+    esp_lcd_dpi_panel_config_t dpi_config = JD9365_800_1280_PANEL_60HZ_DPI_CONFIG(KC_WS_P4_PIXEL_FORMAT);
+#if KC_WS_P4_PANEL_FRAMEBUFFERS
+    dpi_config.num_fbs = KC_WS_P4_PANEL_FRAMEBUFFERS;
+#elif CONFIG_KC_TOUCH_DISPLAY_ASYNC_FLUSH
+    /* Let draw_bitmap return as soon as the DMA2D copy into the framebuffer is queued. */
+    dpi_config.flags.use_dma2d = true;
+#endif
     jd9365_vendor_config_t vendor_config = {
         .flags = {
             .use_mipi_interface = 1,
@@ -153,7 +217,7 @@ esp_err_t kc_touch_display_backend_init_hw(void)
     const esp_lcd_panel_dev_config_t panel_config = {
         .reset_gpio_num = CONFIG_KC_TOUCH_WAVESHARE_LCD_RST_GPIO,
         .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
-        .bits_per_pixel = 24,
+        .bits_per_pixel = KC_WS_P4_BITS_PER_PIXEL,
         .vendor_config = &vendor_config,
     };
     err = esp_lcd_new_panel_jd9365(s_mipi_dbi_io, &panel_config, &s_panel);
@@ -164,7 +228,24 @@ esp_err_t kc_touch_display_backend_init_hw(void)
     ESP_RETURN_ON_ERROR(esp_lcd_panel_reset(s_panel), TAG, "panel reset failed");
     ESP_RETURN_ON_ERROR(esp_lcd_panel_init(s_panel), TAG, "panel init failed");
     ESP_RETURN_ON_ERROR(esp_lcd_panel_disp_on_off(s_panel, true), TAG, "panel on failed");
-    ESP_LOGI(TAG, "Waveshare P4 panel initialized via jd9365 component (touch TBD)");
+#if KC_WS_P4_PANEL_FRAMEBUFFERS
+    const esp_lcd_dpi_panel_event_callbacks_t dpi_cbs = {
+        .on_refresh_done = kc_ws_p4_refresh_done,
+    };
+#elif CONFIG_KC_TOUCH_DISPLAY_ASYNC_FLUSH
+    const esp_lcd_dpi_panel_event_callbacks_t dpi_cbs = {
+        .on_color_trans_done = kc_ws_p4_color_trans_done,
+    };
+#endif
+#if KC_WS_P4_PANEL_FRAMEBUFFERS || CONFIG_KC_TOUCH_DISPLAY_ASYNC_FLUSH
+    err = esp_lcd_dpi_panel_register_event_callbacks(s_panel, &dpi_cbs, NULL);
+    if (err == ESP_OK) {
+        s_async_flush_ready = true;
+    } else {
+        ESP_LOGW(TAG, "DPI transfer-done callback unavailable (%s); flushing synchronously", esp_err_to_name(err));
+    }
+#endif
+    ESP_LOGI(TAG, "Waveshare P4 panel initialized via jd9365 component");
     ESP_LOGI(TAG, "Configured LVGL resolution: %dx%d", CONFIG_KC_TOUCH_DISPLAY_WIDTH, CONFIG_KC_TOUCH_DISPLAY_HEIGHT);
 #else
     ESP_LOGE(TAG, "No Waveshare display backend available. Add waveshare/esp32_p4_platform or waveshare/esp_lcd_jd9365.");
@@ -192,47 +273,185 @@ esp_err_t kc_touch_display_backend_flush(int32_t x1, int32_t y1, int32_t x2, int
         return ESP_ERR_INVALID_ARG;
     }
 
+    /* Passing one of the panel's own framebuffers only re-points scan-out; no pixels are copied. */
     esp_err_t err = esp_lcd_panel_draw_bitmap(s_panel, x1, y1, x2 + 1, y2 + 1, color_data);
     if (err != ESP_OK) {
         ESP_LOGW(TAG, "panel draw failed: %s", esp_err_to_name(err));
+        return err;
+    }
+#if KC_TOUCH_WAVESHARE_JD9365_COMPONENT_AVAILABLE && KC_WS_P4_PANEL_FRAMEBUFFERS
+    /* Armed only once the swap is queued: a vsync before this point still scanned out the
+     * old front buffer, which LVGL must not get back yet. A vsync that races this store
+     * merely releases the buffer one frame late. */
+    s_fb_swap_pending = true;
+#endif
+    return ESP_OK;
+}
+
+esp_err_t kc_touch_display_backend_set_flush_done_cb(kc_touch_display_backend_flush_done_cb_t cb, void *ctx)
+{
+#if KC_TOUCH_WAVESHARE_JD9365_COMPONENT_AVAILABLE
+    if (!s_ready || s_bsp_lvgl_active || !s_async_flush_ready) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    s_flush_done_ctx = ctx;
+    s_flush_done_cb = cb;
+    return ESP_OK;
+#else
+    (void)cb;
+    (void)ctx;
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t kc_touch_display_backend_get_framebuffers(void **out_fb0, void **out_fb1, size_t *out_bytes)
+{
+    if (!out_fb0 || !out_fb1 || !out_bytes) {
+        return ESP_ERR_INVALID_ARG;
+    }
+#if KC_TOUCH_WAVESHARE_JD9365_COMPONENT_AVAILABLE && KC_WS_P4_PANEL_FRAMEBUFFERS
+    if (!s_ready || s_bsp_lvgl_active || !s_panel) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    ESP_RETURN_ON_ERROR(esp_lcd_dpi_panel_get_frame_buffer(s_panel, 2, out_fb0, out_fb1), TAG, "get frame buffers");
+    *out_bytes = (size_t)CONFIG_KC_TOUCH_DISPLAY_WIDTH * CONFIG_KC_TOUCH_DISPLAY_HEIGHT * (KC_WS_P4_BITS_PER_PIXEL / 8);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+#if KC_TOUCH_WAVESHARE_GT911_AVAILABLE
+/* esp_lcd_touch runs this from the INT pin's GPIO ISR. */
+static IRAM_ATTR void kc_ws_p4_touch_isr(esp_lcd_touch_handle_t tp)
+{
+    (void)tp;
+    kc_touch_display_backend_touch_irq_cb_t cb = s_touch_irq_cb;
+    if (cb && cb(s_touch_irq_ctx)) {
+        portYIELD_FROM_ISR();
     }
-    return err;
 }
+#endif
 
-bool kc_touch_display_backend_touch_sample(uint16_t *x, uint16_t *y)
+esp_err_t kc_touch_display_backend_touch_init(kc_touch_display_backend_touch_irq_cb_t cb, void *ctx, bool *out_has_irq)
+{
+    if (out_has_irq) {
+        *out_has_irq = false;
+    }
+#if KC_TOUCH_WAVESHARE_GT911_AVAILABLE
+    if (!s_ready || s_bsp_lvgl_active) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (s_touch) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    const bool has_irq = CONFIG_KC_TOUCH_WAVESHARE_TOUCH_INT_GPIO >= 0;
+    s_touch_irq_cb = cb;
+    s_touch_irq_ctx = ctx;
+
+    i2c_master_bus_config_t bus_config = {
+        .i2c_port = CONFIG_KC_TOUCH_WAVESHARE_TOUCH_I2C_PORT,
+        .sda_io_num = CONFIG_KC_TOUCH_WAVESHARE_TOUCH_SDA_GPIO,
+        .scl_io_num = CONFIG_KC_TOUCH_WAVESHARE_TOUCH_SCL_GPIO,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .glitch_ignore_cnt = 7,
+        .flags.enable_internal_pullup = true,
+    };
+    esp_err_t err = i2c_new_master_bus(&bus_config, &s_touch_i2c);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "touch i2c bus failed: %s", esp_err_to_name(err));
+        kc_touch_display_backend_touch_deinit();
+        return err;
+    }
+
+    esp_lcd_panel_io_i2c_config_t tp_io_config = ESP_LCD_TOUCH_IO_I2C_GT911_CONFIG();
+    tp_io_config.scl_speed_hz = 400000;
+    err = esp_lcd_new_panel_io_i2c(s_touch_i2c, &tp_io_config, &s_touch_io);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "touch panel io failed: %s", esp_err_to_name(err));
+        kc_touch_display_backend_touch_deinit();
+        return err;
+    }
+    esp_lcd_touch_config_t tp_config = {
+        .x_max = CONFIG_KC_TOUCH_DISPLAY_WIDTH,
+        .y_max = CONFIG_KC_TOUCH_DISPLAY_HEIGHT,
+        .rst_gpio_num = CONFIG_KC_TOUCH_WAVESHARE_TOUCH_RST_GPIO,
+        .int_gpio_num = CONFIG_KC_TOUCH_WAVESHARE_TOUCH_INT_GPIO,
+        .levels = {
+            .reset = 0,
+            .interrupt = 0,
+        },
+        .interrupt_callback = has_irq ? kc_ws_p4_touch_isr : NULL,
+    };
+    err = esp_lcd_touch_new_i2c_gt911(s_touch_io, &tp_config, &s_touch);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "GT911 init failed: %s", esp_err_to_name(err));
+        s_touch = NULL;
+        kc_touch_display_backend_touch_deinit();
+        return err;
+    }
+    if (out_has_irq) {
+        *out_has_irq = has_irq;
+    }
+    ESP_LOGI(TAG, "GT911 touch ready (%s)", has_irq ? "interrupt" : "polled");
+    return ESP_OK;
+#else
+    (void)cb;
+    (void)ctx;
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+void kc_touch_display_backend_touch_deinit(void)
+{
+#if KC_TOUCH_WAVESHARE_GT911_AVAILABLE
+    /* Detach the callback first so a late interrupt has nowhere to go. */
+    s_touch_irq_cb = NULL;
+    s_touch_irq_ctx = NULL;
+    if (s_touch) {
+        (void)esp_lcd_touch_del(s_touch);
+        s_touch = NULL;
+    }
+    if (s_touch_io) {
+        (void)esp_lcd_panel_io_del(s_touch_io);
+        s_touch_io = NULL;
+    }
+    if (s_touch_i2c) {
+        (void)i2c_del_master_bus(s_touch_i2c);
+        s_touch_i2c = NULL;
+    }
+#endif
+}
+
+uint8_t kc_touch_display_backend_touch_read(kc_touch_point_t *points, uint8_t max_points)
 {
 #if KC_TOUCH_ESP_LCD_TOUCH_AVAILABLE
-    if (s_bsp_lvgl_active) {
-        (void)x;
-        (void)y;
-        return false;
+    if (!s_ready || s_bsp_lvgl_active || !s_touch || !points || max_points == 0U) {
+        return 0;
     }
-    if (!s_ready || !s_touch || !x || !y) {
-        return false;
+    if (esp_lcd_touch_read_data(s_touch) != ESP_OK) {
+        return 0;
     }
-    esp_lcd_touch_read_data(s_touch);
-    uint16_t x_pos[1] = {0};
-    uint16_t y_pos[1] = {0};
-    uint16_t strength[1] = {0};
+    uint16_t x_pos[KC_TOUCH_MAX_POINTS];
+    uint16_t y_pos[KC_TOUCH_MAX_POINTS];
+    uint16_t strength[KC_TOUCH_MAX_POINTS];
     uint8_t point_count = 0;
-    bool pressed = esp_lcd_touch_get_coordinates(
-        s_touch,
-        x_pos,
-        y_pos,
-        strength,
-        &point_count,
-        1
-    );
-    if (!pressed || point_count == 0) {
-        return false;
+    if (max_points > KC_TOUCH_MAX_POINTS) {
+        max_points = KC_TOUCH_MAX_POINTS;
+    }
+    bool pressed = esp_lcd_touch_get_coordinates(s_touch, x_pos, y_pos, strength, &point_count, max_points);
+    if (!pressed) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < point_count; ++i) {
+        points[i].x = x_pos[i];
+        points[i].y = y_pos[i];
     }
-    *x = x_pos[0];
-    *y = y_pos[0];
-    return true;
+    return point_count;
 #else
-    (void)x;
-    (void)y;
-    return false;
+    (void)points;
+    (void)max_points;
+    return 0;
 #endif
 }
 
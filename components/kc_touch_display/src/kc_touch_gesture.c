@@ -0,0 +1,231 @@
+#include "kc_touch_input.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef CONFIG_KC_TOUCH_GESTURE_LONG_PRESS_MS
+#define CONFIG_KC_TOUCH_GESTURE_LONG_PRESS_MS 600
+#endif
+
+#ifndef CONFIG_KC_TOUCH_GESTURE_SLOP_PX
+#define CONFIG_KC_TOUCH_GESTURE_SLOP_PX 12
+#endif
+
+#ifndef CONFIG_KC_TOUCH_GESTURE_SWIPE_MIN_PX
+#define CONFIG_KC_TOUCH_GESTURE_SWIPE_MIN_PX 80
+#endif
+
+#ifndef CONFIG_KC_TOUCH_GESTURE_PINCH_MIN_PCT
+#define CONFIG_KC_TOUCH_GESTURE_PINCH_MIN_PCT 10
+#endif
+
+/* Pinch updates smaller than this are controller noise. */
+#define KC_TOUCH_GESTURE_PINCH_STEP 0.005f
+
+kc_touch_gesture_config_t kc_touch_gesture_default_config(void)
+{
+    kc_touch_gesture_config_t cfg = {
+        .long_press_ms = CONFIG_KC_TOUCH_GESTURE_LONG_PRESS_MS,
+        .slop_px = CONFIG_KC_TOUCH_GESTURE_SLOP_PX,
+        .swipe_min_px = CONFIG_KC_TOUCH_GESTURE_SWIPE_MIN_PX,
+        .pinch_min_pct = CONFIG_KC_TOUCH_GESTURE_PINCH_MIN_PCT,
+    };
+    return cfg;
+}
+
+void kc_touch_gesture_init(kc_touch_gesture_recognizer_t *rec, const kc_touch_gesture_config_t *cfg)
+{
+    if (!rec) {
+        return;
+    }
+    memset(rec, 0, sizeof(*rec));
+    rec->cfg = cfg ? *cfg : kc_touch_gesture_default_config();
+}
+
+kc_touch_gesture_dir_t kc_touch_gesture_direction(int32_t dx, int32_t dy)
+{
+    if (dx == 0 && dy == 0) {
+        return KC_TOUCH_GESTURE_DIR_NONE;
+    }
+    if (abs(dx) >= abs(dy)) {
+        return dx < 0 ? KC_TOUCH_GESTURE_DIR_LEFT : KC_TOUCH_GESTURE_DIR_RIGHT;
+    }
+    return dy < 0 ? KC_TOUCH_GESTURE_DIR_UP : KC_TOUCH_GESTURE_DIR_DOWN;
+}
+
+const char *kc_touch_gesture_type_name(kc_touch_gesture_type_t type)
+{
+    switch (type) {
+    case KC_TOUCH_GESTURE_LONG_PRESS:
+        return "long_press";
+    case KC_TOUCH_GESTURE_PINCH_BEGIN:
+        return "pinch_begin";
+    case KC_TOUCH_GESTURE_PINCH_UPDATE:
+        return "pinch";
+    case KC_TOUCH_GESTURE_PINCH_END:
+        return "pinch_end";
+    case KC_TOUCH_GESTURE_SWIPE:
+        return "swipe";
+    default:
+        return "unknown";
+    }
+}
+
+const char *kc_touch_gesture_dir_name(kc_touch_gesture_dir_t dir)
+{
+    switch (dir) {
+    case KC_TOUCH_GESTURE_DIR_LEFT:
+        return "left";
+    case KC_TOUCH_GESTURE_DIR_RIGHT:
+        return "right";
+    case KC_TOUCH_GESTURE_DIR_UP:
+        return "up";
+    case KC_TOUCH_GESTURE_DIR_DOWN:
+        return "down";
+    default:
+        return "none";
+    }
+}
+
+static float kc_touch_gesture_distance(const kc_touch_point_t *a, const kc_touch_point_t *b)
+{
+    float dx = (float)a->x - (float)b->x;
+    float dy = (float)a->y - (float)b->y;
+    return sqrtf(dx * dx + dy * dy);
+}
+
+static kc_touch_point_t kc_touch_gesture_centroid(const kc_touch_frame_t *frame)
+{
+    kc_touch_point_t c = {
+        .x = (uint16_t)(((uint32_t)frame->points[0].x + frame->points[1].x) / 2U),
+        .y = (uint16_t)(((uint32_t)frame->points[0].y + frame->points[1].y) / 2U),
+    };
+    return c;
+}
+
+static void kc_touch_gesture_fill(const kc_touch_gesture_recognizer_t *rec, const kc_touch_frame_t *frame,
+                                  kc_touch_gesture_type_t type, kc_touch_point_t at, kc_touch_gesture_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->type = type;
+    out->x = at.x;
+    out->y = at.y;
+    out->dx = (int32_t)at.x - rec->start.x;
+    out->dy = (int32_t)at.y - rec->start.y;
+    out->scale = 1.0f;
+    out->duration_ms = (uint32_t)((frame->timestamp_us - rec->down_us) / 1000);
+    out->timestamp_us = frame->timestamp_us;
+}
+
+/* Starts tracking two fingers from the current frame; earlier one-finger movement is ignored. */
+static void kc_touch_gesture_begin_two(kc_touch_gesture_recognizer_t *rec, const kc_touch_frame_t *frame)
+{
+    rec->state = KC_TOUCH_GESTURE_STATE_TWO;
+    rec->start = kc_touch_gesture_centroid(frame);
+    rec->start_distance = kc_touch_gesture_distance(&frame->points[0], &frame->points[1]);
+    rec->last_scale = 1.0f;
+}
+
+size_t kc_touch_gesture_feed(kc_touch_gesture_recognizer_t *rec, const kc_touch_frame_t *frame,
+                             kc_touch_gesture_t *out_events, size_t max_events)
+{
+    if (!rec || !frame || !out_events || max_events == 0U) {
+        return 0U;
+    }
+    size_t emitted = 0;
+    const uint32_t slop_sq = (uint32_t)rec->cfg.slop_px * rec->cfg.slop_px;
+
+    if (frame->count == 0U) {
+        if (rec->state == KC_TOUCH_GESTURE_STATE_PINCH) {
+            out_events[emitted] = rec->last;
+            out_events[emitted].type = KC_TOUCH_GESTURE_PINCH_END;
+            out_events[emitted].timestamp_us = frame->timestamp_us;
+            emitted++;
+        }
+        rec->state = KC_TOUCH_GESTURE_STATE_IDLE;
+        return emitted;
+    }
+
+    if (rec->state == KC_TOUCH_GESTURE_STATE_IDLE) {
+        rec->down_us = frame->timestamp_us;
+    }
+
+    if (frame->count == 1U) {
+        const kc_touch_point_t *p = &frame->points[0];
+        switch (rec->state) {
+        case KC_TOUCH_GESTURE_STATE_IDLE:
+            rec->state = KC_TOUCH_GESTURE_STATE_SINGLE;
+            rec->start = *p;
+            break;
+        case KC_TOUCH_GESTURE_STATE_SINGLE: {
+            int32_t dx = (int32_t)p->x - rec->start.x;
+            int32_t dy = (int32_t)p->y - rec->start.y;
+            if ((uint32_t)(dx * dx + dy * dy) > slop_sq) {
+                rec->state = KC_TOUCH_GESTURE_STATE_MOVED;
+            } else if (frame->timestamp_us - rec->down_us >= (int64_t)rec->cfg.long_press_ms * 1000) {
+                kc_touch_gesture_fill(rec, frame, KC_TOUCH_GESTURE_LONG_PRESS, *p, &out_events[emitted++]);
+                rec->state = KC_TOUCH_GESTURE_STATE_DONE;
+            }
+            break;
+        }
+        case KC_TOUCH_GESTURE_STATE_PINCH:
+            /* Lifting one finger ends the pinch; the other one must lift before anything new. */
+            out_events[emitted] = rec->last;
+            out_events[emitted].type = KC_TOUCH_GESTURE_PINCH_END;
+            out_events[emitted].timestamp_us = frame->timestamp_us;
+            emitted++;
+            rec->state = KC_TOUCH_GESTURE_STATE_DONE;
+            break;
+        case KC_TOUCH_GESTURE_STATE_TWO:
+            rec->state = KC_TOUCH_GESTURE_STATE_DONE;
+            break;
+        default:
+            break;
+        }
+        return emitted;
+    }
+
+    /* Two or more fingers: only the first two reported points take part. */
+    switch (rec->state) {
+    case KC_TOUCH_GESTURE_STATE_IDLE:
+    case KC_TOUCH_GESTURE_STATE_SINGLE:
+    case KC_TOUCH_GESTURE_STATE_MOVED:
+        kc_touch_gesture_begin_two(rec, frame);
+        break;
+    case KC_TOUCH_GESTURE_STATE_TWO:
+    case KC_TOUCH_GESTURE_STATE_PINCH: {
+        if (rec->start_distance < 1.0f) {
+            kc_touch_gesture_begin_two(rec, frame);
+            break;
+        }
+        kc_touch_point_t c = kc_touch_gesture_centroid(frame);
+        float scale = kc_touch_gesture_distance(&frame->points[0], &frame->points[1]) / rec->start_distance;
+        if (rec->state == KC_TOUCH_GESTURE_STATE_TWO) {
+            int32_t dx = (int32_t)c.x - rec->start.x;
+            int32_t dy = (int32_t)c.y - rec->start.y;
+            if (fabsf(scale - 1.0f) * 100.0f >= (float)rec->cfg.pinch_min_pct) {
+                rec->state = KC_TOUCH_GESTURE_STATE_PINCH;
+                kc_touch_gesture_fill(rec, frame, KC_TOUCH_GESTURE_PINCH_BEGIN, c, &rec->last);
+                rec->last.scale = scale;
+                rec->last_scale = scale;
+                out_events[emitted++] = rec->last;
+            } else if ((uint32_t)(dx * dx + dy * dy) >= (uint32_t)rec->cfg.swipe_min_px * rec->cfg.swipe_min_px) {
+                kc_touch_gesture_fill(rec, frame, KC_TOUCH_GESTURE_SWIPE, c, &out_events[emitted]);
+                out_events[emitted].direction = kc_touch_gesture_direction(dx, dy);
+                emitted++;
+                rec->state = KC_TOUCH_GESTURE_STATE_DONE;
+            }
+        } else if (fabsf(scale - rec->last_scale) >= KC_TOUCH_GESTURE_PINCH_STEP) {
+            kc_touch_gesture_fill(rec, frame, KC_TOUCH_GESTURE_PINCH_UPDATE, c, &rec->last);
+            rec->last.scale = scale;
+            rec->last_scale = scale;
+            out_events[emitted++] = rec->last;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return emitted;
+}
@@ -0,0 +1,446 @@
+#include "sdkconfig.h"
+
+#if CONFIG_KC_TOUCH_DISPLAY_ENABLE && CONFIG_KC_TOUCH_TOUCH_ENABLE
+
+#include "kc_touch_input_priv.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "kc_touch_display.h"
+#include "kc_touch_display_backend.h"
+#include "kc_touch_gui.h"
+#include "yamui_profiler.h"
+
+#ifndef CONFIG_KC_TOUCH_TOUCH_POLL_MS
+#define CONFIG_KC_TOUCH_TOUCH_POLL_MS 10
+#endif
+
+#ifndef CONFIG_KC_TOUCH_TOUCH_RING_LENGTH
+#define CONFIG_KC_TOUCH_TOUCH_RING_LENGTH 16
+#endif
+
+#ifndef CONFIG_KC_TOUCH_TOUCH_TASK_PRIORITY
+#define CONFIG_KC_TOUCH_TOUCH_TASK_PRIORITY 6
+#endif
+
+#ifndef CONFIG_KC_TOUCH_GESTURES
+#define CONFIG_KC_TOUCH_GESTURES 0
+#endif
+
+#ifndef CONFIG_KC_TOUCH_PREDICTION
+#define CONFIG_KC_TOUCH_PREDICTION 0
+#endif
+
+#ifndef CONFIG_KC_TOUCH_PREDICT_HORIZON_MS
+#define CONFIG_KC_TOUCH_PREDICT_HORIZON_MS 16
+#endif
+
+#ifndef CONFIG_KC_TOUCH_PREDICT_MAX_PX
+#define CONFIG_KC_TOUCH_PREDICT_MAX_PX 48
+#endif
+
+#define KC_TOUCH_INPUT_TASK_STACK 4096
+/* Pinch updates share one dispatch mailbox so a stalled GUI task only sees the newest scale. */
+#define KC_TOUCH_INPUT_PINCH_KEY  0x6B740001U
+
+_Static_assert(sizeof(kc_touch_gesture_t) <= KC_TOUCH_GUI_PAYLOAD_MAX, "gesture must fit a GUI post payload");
+
+static const char *TAG = "kc_touch_input";
+
+/* Single producer (touch task) / single consumer (LVGL read callback) frame ring. */
+static kc_touch_frame_t *s_frames;
+static uint32_t s_mask;
+static _Atomic uint32_t s_head;
+static _Atomic uint32_t s_tail;
+
+static TaskHandle_t s_task;
+static bool s_has_irq;
+static lv_indev_t *s_indev;
+static kc_touch_frame_t s_current; /* GUI task only: the frame LVGL is currently seeing */
+static bool s_multi_reset;
+
+static kc_touch_gesture_cb_t s_gesture_cb;
+static void *s_gesture_ctx;
+
+/* Fed from the GUI task; the lock only guards snapshots taken from other tasks. */
+static kc_touch_latency_t s_latency;
+static portMUX_TYPE s_latency_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static struct {
+    _Atomic uint32_t reads;
+    _Atomic uint32_t frames;
+    _Atomic uint32_t dropped;
+    _Atomic uint32_t gestures;
+    _Atomic uint32_t read_us_max;
+    _Atomic uint64_t read_us_total;
+} s_stats;
+
+static uint32_t kc_touch_input_round_pow2(uint32_t value)
+{
+    uint32_t pow2 = 2U;
+    while (pow2 < value) {
+        pow2 <<= 1;
+    }
+    return pow2;
+}
+
+static bool kc_touch_input_push(const kc_touch_frame_t *frame)
+{
+    uint32_t head = atomic_load_explicit(&s_head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&s_tail, memory_order_acquire);
+    if (head - tail > s_mask) {
+        return false;
+    }
+    s_frames[head & s_mask] = *frame;
+    atomic_store_explicit(&s_head, head + 1U, memory_order_release);
+    return true;
+}
+
+static const kc_touch_frame_t *kc_touch_input_peek(void)
+{
+    uint32_t tail = atomic_load_explicit(&s_tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&s_head, memory_order_acquire)) {
+        return NULL;
+    }
+    return &s_frames[tail & s_mask];
+}
+
+static void kc_touch_input_consume(void)
+{
+    atomic_fetch_add_explicit(&s_tail, 1U, memory_order_release);
+}
+
+static IRAM_ATTR bool kc_touch_input_irq(void *ctx)
+{
+    (void)ctx;
+    BaseType_t woken = pdFALSE;
+    if (s_task) {
+        vTaskNotifyGiveFromISR(s_task, &woken);
+    }
+    return woken == pdTRUE;
+}
+
+static void kc_touch_input_gesture_post_cb(const void *payload, size_t len)
+{
+    kc_touch_gesture_cb_t cb = s_gesture_cb;
+    if (cb && len == sizeof(kc_touch_gesture_t)) {
+        kc_touch_gesture_t gesture;
+        memcpy(&gesture, payload, sizeof(gesture));
+        cb(&gesture, s_gesture_ctx);
+    }
+}
+
+static void kc_touch_input_publish_gestures(kc_touch_gesture_recognizer_t *rec, const kc_touch_frame_t *frame)
+{
+    kc_touch_gesture_t events[2];
+    size_t count = kc_touch_gesture_feed(rec, frame, events, sizeof(events) / sizeof(events[0]));
+    for (size_t i = 0; i < count; ++i) {
+        atomic_fetch_add_explicit(&s_stats.gestures, 1U, memory_order_relaxed);
+        if (!s_gesture_cb) {
+            continue;
+        }
+        uint32_t key = events[i].type == KC_TOUCH_GESTURE_PINCH_UPDATE ? KC_TOUCH_INPUT_PINCH_KEY : 0U;
+        if (kc_touch_gui_post(kc_touch_input_gesture_post_cb, &events[i], sizeof(events[i]), key) != ESP_OK) {
+            ESP_LOGW(TAG, "Dropped %s gesture", kc_touch_gesture_type_name(events[i].type));
+        }
+    }
+}
+
+/* All I2C traffic happens here; the GUI task only copies frames out of the ring. */
+static void kc_touch_input_task(void *arg)
+{
+    (void)arg;
+    TickType_t poll = pdMS_TO_TICKS(CONFIG_KC_TOUCH_TOUCH_POLL_MS);
+    if (poll == 0) {
+        poll = 1;
+    }
+#if CONFIG_KC_TOUCH_GESTURES
+    kc_touch_gesture_recognizer_t recognizer;
+    kc_touch_gesture_init(&recognizer, NULL);
+#endif
+#if CONFIG_KC_TOUCH_PREDICTION
+    kc_touch_predictor_t predictor;
+    const kc_touch_predictor_config_t predictor_cfg = {
+        .horizon_ms = CONFIG_KC_TOUCH_PREDICT_HORIZON_MS,
+        .max_px = CONFIG_KC_TOUCH_PREDICT_MAX_PX,
+        .max_x = CONFIG_KC_TOUCH_DISPLAY_WIDTH - 1,
+        .max_y = CONFIG_KC_TOUCH_DISPLAY_HEIGHT - 1,
+    };
+    kc_touch_predictor_init(&predictor, &predictor_cfg);
+#endif
+    kc_touch_frame_t frame = {0};
+    bool down = false;
+    bool pushed_down = false;
+    bool pending = false;
+
+    while (true) {
+        /* The controller keeps reporting while touched, but poll anyway so a lost edge cannot
+         * leave LVGL pressed. */
+        TickType_t wait = (s_has_irq && !down && !pending) ? portMAX_DELAY : poll;
+        (void)ulTaskNotifyTake(pdTRUE, wait);
+
+        if (!pending) {
+            int64_t start = esp_timer_get_time();
+            frame.count = kc_touch_display_backend_touch_read(frame.points, KC_TOUCH_MAX_POINTS);
+            uint32_t read_us = (uint32_t)(esp_timer_get_time() - start);
+            frame.timestamp_us = start;
+            atomic_fetch_add_explicit(&s_stats.reads, 1U, memory_order_relaxed);
+            atomic_fetch_add_explicit(&s_stats.read_us_total, read_us, memory_order_relaxed);
+            uint32_t seen = atomic_load_explicit(&s_stats.read_us_max, memory_order_relaxed);
+            if (read_us > seen) {
+                atomic_store_explicit(&s_stats.read_us_max, read_us, memory_order_relaxed);
+            }
+            bool was_down = down;
+            down = frame.count > 0U;
+            if (!down && !was_down) {
+                continue;
+            }
+#if CONFIG_KC_TOUCH_GESTURES
+            kc_touch_input_publish_gestures(&recognizer, &frame);
+#endif
+#if CONFIG_KC_TOUCH_PREDICTION
+            /* Gestures see raw points; only what LVGL drags with is extrapolated. */
+            kc_touch_predictor_apply(&predictor, &frame);
+#endif
+        }
+
+        if (kc_touch_input_push(&frame)) {
+            pending = false;
+            pushed_down = frame.count > 0U;
+            atomic_fetch_add_explicit(&s_stats.frames, 1U, memory_order_relaxed);
+            kc_touch_gui_wake();
+        } else if ((frame.count > 0U) == pushed_down) {
+            /* A newer position of the same contact; LVGL only needs the latest one. */
+            pending = false;
+            atomic_fetch_add_explicit(&s_stats.dropped, 1U, memory_order_relaxed);
+        } else {
+            /* Press/release edges must reach LVGL; retry once the ring drains. */
+            pending = true;
+        }
+    }
+}
+
+static void kc_touch_input_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    const kc_touch_frame_t *next = kc_touch_input_peek();
+    if (next) {
+        portENTER_CRITICAL(&s_latency_lock);
+        kc_touch_latency_on_read(&s_latency, next->timestamp_us, esp_timer_get_time());
+        portEXIT_CRITICAL(&s_latency_lock);
+        /* Collapse runs of frames with the same contact state to the newest one, but deliver
+         * every press/release edge so taps are never lost. */
+        bool pressed = next->count > 0U;
+        do {
+            s_current = *next;
+            kc_touch_input_consume();
+            next = kc_touch_input_peek();
+        } while (next && (next->count > 0U) == pressed);
+        data->continue_reading = next != NULL;
+    }
+
+    if (s_current.count == 0U) {
+        data->state = LV_INDEV_STATE_RELEASED;
+        s_multi_reset = false;
+        return;
+    }
+    data->point.x = s_current.points[0].x;
+    data->point.y = s_current.points[0].y;
+    data->state = LV_INDEV_STATE_PRESSED;
+    if (s_current.count >= 2U && !s_multi_reset) {
+        /* A second finger turns the touch into a gesture: stop the scroll/press LVGL started
+         * on the first finger and swallow the click on release. */
+        s_multi_reset = true;
+        lv_indev_reset(indev, NULL);
+        lv_indev_wait_release(indev);
+    }
+}
+
+static void kc_touch_input_indev_event_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code != LV_EVENT_PRESSED && code != LV_EVENT_PRESSING && code != LV_EVENT_RELEASED) {
+        return;
+    }
+    portENTER_CRITICAL(&s_latency_lock);
+    kc_touch_latency_on_event(&s_latency, esp_timer_get_time());
+    portEXIT_CRITICAL(&s_latency_lock);
+}
+
+void kc_touch_input_note_frame_shown(int64_t render_start_us, int64_t shown_us)
+{
+    uint32_t photon_us = 0;
+    portENTER_CRITICAL(&s_latency_lock);
+    bool counted = kc_touch_latency_on_frame_shown(&s_latency, render_start_us, shown_us, &photon_us);
+    portEXIT_CRITICAL(&s_latency_lock);
+    if (counted) {
+        yamui_prof_record(YAMUI_PROF_TOUCH_LATENCY, photon_us);
+    }
+}
+
+static void kc_touch_input_register_lvgl(void *ctx)
+{
+    lv_display_t *disp = (lv_display_t *)ctx;
+    s_indev = lv_indev_create();
+    if (!s_indev) {
+        ESP_LOGE(TAG, "Failed to create touch input device");
+        return;
+    }
+    lv_indev_set_type(s_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(s_indev, kc_touch_input_read_cb);
+    lv_indev_add_event_cb(s_indev, kc_touch_input_indev_event_cb, LV_EVENT_ALL, NULL);
+    if (disp) {
+        lv_indev_set_display(s_indev, disp);
+    }
+}
+
+/* Runs on the GUI task after the register call it undoes, so the read callback is gone before
+ * the ring is freed. */
+static void kc_touch_input_unregister_lvgl(void *ctx)
+{
+    (void)ctx;
+    if (s_indev) {
+        lv_indev_delete(s_indev);
+        s_indev = NULL;
+    }
+    heap_caps_free(s_frames);
+    s_frames = NULL;
+    atomic_store_explicit(&s_head, 0U, memory_order_relaxed);
+    atomic_store_explicit(&s_tail, 0U, memory_order_relaxed);
+}
+
+esp_err_t kc_touch_input_start(lv_display_t *disp)
+{
+    if (s_task) {
+        return ESP_OK;
+    }
+    if (s_frames) {
+        /* A failed start is still being undone on the GUI task. */
+        return ESP_ERR_INVALID_STATE;
+    }
+    uint32_t capacity = kc_touch_input_round_pow2(CONFIG_KC_TOUCH_TOUCH_RING_LENGTH);
+    s_frames = heap_caps_calloc(capacity, sizeof(kc_touch_frame_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!s_frames) {
+        return ESP_ERR_NO_MEM;
+    }
+    s_mask = capacity - 1U;
+
+    esp_err_t err = kc_touch_display_backend_touch_init(kc_touch_input_irq, NULL, &s_has_irq);
+    if (err != ESP_OK) {
+        heap_caps_free(s_frames);
+        s_frames = NULL;
+        return err;
+    }
+    err = kc_touch_gui_dispatch(kc_touch_input_register_lvgl, disp, pdMS_TO_TICKS(100));
+    if (err != ESP_OK) {
+        kc_touch_display_backend_touch_deinit();
+        heap_caps_free(s_frames);
+        s_frames = NULL;
+        return err;
+    }
+    BaseType_t created = xTaskCreatePinnedToCore(kc_touch_input_task,
+                                                 "kc_touch",
+                                                 KC_TOUCH_INPUT_TASK_STACK,
+                                                 NULL,
+                                                 CONFIG_KC_TOUCH_TOUCH_TASK_PRIORITY,
+                                                 &s_task,
+                                                 tskNO_AFFINITY);
+    if (created != pdPASS) {
+        s_task = NULL;
+        kc_touch_display_backend_touch_deinit();
+        if (kc_touch_gui_dispatch(kc_touch_input_unregister_lvgl, NULL, pdMS_TO_TICKS(100)) != ESP_OK) {
+            /* The registered indev still reads the ring; keep it rather than free it under LVGL. */
+            ESP_LOGW(TAG, "Touch input device left registered after a failed start");
+        }
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGI(TAG, "Touch task started (%s, %u frame ring, prediction %s)", s_has_irq ? "interrupt" : "polled",
+             (unsigned)capacity, CONFIG_KC_TOUCH_PREDICTION ? "on" : "off");
+    return ESP_OK;
+}
+
+esp_err_t kc_touch_display_set_gesture_cb(kc_touch_gesture_cb_t cb, void *ctx)
+{
+    s_gesture_cb = NULL;
+    s_gesture_ctx = ctx;
+    s_gesture_cb = cb;
+    return CONFIG_KC_TOUCH_GESTURES ? ESP_OK : ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t kc_touch_touch_get_stats(kc_touch_touch_stats_t *out_stats)
+{
+    if (!out_stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(out_stats, 0, sizeof(*out_stats));
+    out_stats->irq = s_has_irq;
+    out_stats->reads = atomic_load_explicit(&s_stats.reads, memory_order_relaxed);
+    out_stats->frames = atomic_load_explicit(&s_stats.frames, memory_order_relaxed);
+    out_stats->dropped = atomic_load_explicit(&s_stats.dropped, memory_order_relaxed);
+    out_stats->gestures = atomic_load_explicit(&s_stats.gestures, memory_order_relaxed);
+    out_stats->read_us_max = atomic_load_explicit(&s_stats.read_us_max, memory_order_relaxed);
+    uint64_t total = atomic_load_explicit(&s_stats.read_us_total, memory_order_relaxed);
+    out_stats->read_us_avg = out_stats->reads ? (uint32_t)(total / out_stats->reads) : 0U;
+    return ESP_OK;
+}
+
+esp_err_t kc_touch_touch_get_latency(kc_touch_latency_stats_t *out_stats)
+{
+    if (!out_stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_latency_lock);
+    kc_touch_latency_get(&s_latency, out_stats);
+    portEXIT_CRITICAL(&s_latency_lock);
+    return ESP_OK;
+}
+
+void kc_touch_touch_reset_latency(void)
+{
+    portENTER_CRITICAL(&s_latency_lock);
+    kc_touch_latency_reset(&s_latency);
+    portEXIT_CRITICAL(&s_latency_lock);
+}
+
+#else
+
+#include "kc_touch_display.h"
+#include "kc_touch_input_priv.h"
+
+void kc_touch_input_note_frame_shown(int64_t render_start_us, int64_t shown_us)
+{
+    (void)render_start_us;
+    (void)shown_us;
+}
+
+esp_err_t kc_touch_touch_get_latency(kc_touch_latency_stats_t *out_stats)
+{
+    (void)out_stats;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void kc_touch_touch_reset_latency(void)
+{
+}
+
+esp_err_t kc_touch_display_set_gesture_cb(kc_touch_gesture_cb_t cb, void *ctx)
+{
+    (void)cb;
+    (void)ctx;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t kc_touch_touch_get_stats(kc_touch_touch_stats_t *out_stats)
+{
+    (void)out_stats;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // CONFIG_KC_TOUCH_DISPLAY_ENABLE && CONFIG_KC_TOUCH_TOUCH_ENABLE
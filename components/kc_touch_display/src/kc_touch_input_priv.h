@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Brings up the touch controller, registers the LVGL pointer device on @p disp and starts the
+ * touch task that reads every report into the frame ring. Call from outside the GUI task.
+ */
+esp_err_t kc_touch_input_start(lv_display_t *disp);
+
+/** GUI task: a frame LVGL started rendering at @p render_start_us finished flushing at @p shown_us. */
+void kc_touch_input_note_frame_shown(int64_t render_start_us, int64_t shown_us);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,86 @@
+#include "kc_touch_input.h"
+
+#include <string.h>
+
+enum {
+    KC_TOUCH_LATENCY_READ = 0,
+    KC_TOUCH_LATENCY_EVENT,
+    KC_TOUCH_LATENCY_PHOTON,
+};
+
+static void kc_touch_latency_add(kc_touch_latency_t *lat, int stage, int64_t elapsed_us)
+{
+    uint32_t us = elapsed_us < 0 ? 0U : (uint32_t)elapsed_us;
+    lat->stages[stage].count++;
+    lat->stages[stage].total_us += us;
+    if (us > lat->stages[stage].max_us) {
+        lat->stages[stage].max_us = us;
+    }
+}
+
+void kc_touch_latency_reset(kc_touch_latency_t *lat)
+{
+    if (lat) {
+        memset(lat, 0, sizeof(*lat));
+    }
+}
+
+void kc_touch_latency_on_read(kc_touch_latency_t *lat, int64_t touch_us, int64_t now_us)
+{
+    if (!lat || touch_us <= 0) {
+        return;
+    }
+    kc_touch_latency_add(lat, KC_TOUCH_LATENCY_READ, now_us - touch_us);
+    if (lat->pending_touch_us == 0) {
+        lat->pending_touch_us = touch_us;
+        lat->pending_read_us = now_us;
+        lat->event_seen = false;
+    }
+}
+
+void kc_touch_latency_on_event(kc_touch_latency_t *lat, int64_t now_us)
+{
+    if (!lat || lat->pending_touch_us == 0 || lat->event_seen) {
+        return;
+    }
+    lat->event_seen = true;
+    kc_touch_latency_add(lat, KC_TOUCH_LATENCY_EVENT, now_us - lat->pending_touch_us);
+}
+
+bool kc_touch_latency_on_frame_shown(kc_touch_latency_t *lat, int64_t render_start_us, int64_t shown_us,
+                                     uint32_t *out_photon_us)
+{
+    /* Frames that started rendering before the read cannot show it. */
+    if (!lat || lat->pending_touch_us == 0 || render_start_us < lat->pending_read_us) {
+        return false;
+    }
+    int64_t photon = shown_us - lat->pending_touch_us;
+    bool counted = lat->event_seen;
+    if (counted) {
+        kc_touch_latency_add(lat, KC_TOUCH_LATENCY_PHOTON, photon);
+        if (out_photon_us) {
+            *out_photon_us = photon < 0 ? 0U : (uint32_t)photon;
+        }
+    }
+    /* Input that changed nothing on screen is dropped with the frame that ignored it. */
+    lat->pending_touch_us = 0;
+    lat->event_seen = false;
+    return counted;
+}
+
+void kc_touch_latency_get(const kc_touch_latency_t *lat, kc_touch_latency_stats_t *out_stats)
+{
+    if (!out_stats) {
+        return;
+    }
+    memset(out_stats, 0, sizeof(*out_stats));
+    if (!lat) {
+        return;
+    }
+    kc_touch_latency_stage_t *stages[3] = {&out_stats->to_read, &out_stats->to_event, &out_stats->to_photon};
+    for (int i = 0; i < 3; ++i) {
+        stages[i]->count = lat->stages[i].count;
+        stages[i]->max_us = lat->stages[i].max_us;
+        stages[i]->avg_us = lat->stages[i].count ? (uint32_t)(lat->stages[i].total_us / lat->stages[i].count) : 0U;
+    }
+}
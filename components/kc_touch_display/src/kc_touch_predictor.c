@@ -0,0 +1,111 @@
+#include "kc_touch_input.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Corrections below this are noise from a resting finger: +-1 px jitter over three samples
+ * extrapolates to about 2.3 px at a 16 ms horizon. */
+#define KC_TOUCH_PREDICTOR_DEADBAND_PX 3.0f
+/* Samples further apart than this belong to a different movement. */
+#define KC_TOUCH_PREDICTOR_MAX_GAP_US 100000
+
+void kc_touch_predictor_init(kc_touch_predictor_t *pred, const kc_touch_predictor_config_t *cfg)
+{
+    if (!pred) {
+        return;
+    }
+    memset(pred, 0, sizeof(*pred));
+    if (cfg) {
+        pred->cfg = *cfg;
+    }
+}
+
+static float kc_touch_predictor_clampf(float value, float max)
+{
+    if (value < 0.0f) {
+        return 0.0f;
+    }
+    return value > max ? max : value;
+}
+
+void kc_touch_predictor_apply(kc_touch_predictor_t *pred, kc_touch_frame_t *frame)
+{
+    if (!pred || !frame) {
+        return;
+    }
+    if (frame->count != 1U) {
+        pred->count = 0;
+        pred->next = 0;
+        return;
+    }
+    if (pred->count) {
+        uint8_t newest = (uint8_t)((pred->next + KC_TOUCH_PREDICTOR_WINDOW - 1U) % KC_TOUCH_PREDICTOR_WINDOW);
+        int64_t gap = frame->timestamp_us - pred->t_us[newest];
+        if (gap <= 0) {
+            return;
+        }
+        if (gap > KC_TOUCH_PREDICTOR_MAX_GAP_US) {
+            pred->count = 0;
+        }
+    }
+    pred->t_us[pred->next] = frame->timestamp_us;
+    pred->x[pred->next] = (float)frame->points[0].x;
+    pred->y[pred->next] = (float)frame->points[0].y;
+    pred->next = (uint8_t)((pred->next + 1U) % KC_TOUCH_PREDICTOR_WINDOW);
+    if (pred->count < KC_TOUCH_PREDICTOR_WINDOW) {
+        pred->count++;
+    }
+    if (pred->count < 3U || pred->cfg.horizon_ms == 0U) {
+        return;
+    }
+
+    /* Least-squares velocity over the window, in px per ms. */
+    float tm = 0.0f;
+    float xm = 0.0f;
+    float ym = 0.0f;
+    float t[KC_TOUCH_PREDICTOR_WINDOW];
+    for (uint8_t i = 0; i < pred->count; ++i) {
+        uint8_t idx = (uint8_t)((pred->next + KC_TOUCH_PREDICTOR_WINDOW - 1U - i) % KC_TOUCH_PREDICTOR_WINDOW);
+        t[i] = (float)(pred->t_us[idx] - frame->timestamp_us) / 1000.0f;
+        tm += t[i];
+        xm += pred->x[idx];
+        ym += pred->y[idx];
+    }
+    tm /= pred->count;
+    xm /= pred->count;
+    ym /= pred->count;
+    float stt = 0.0f;
+    float stx = 0.0f;
+    float sty = 0.0f;
+    for (uint8_t i = 0; i < pred->count; ++i) {
+        uint8_t idx = (uint8_t)((pred->next + KC_TOUCH_PREDICTOR_WINDOW - 1U - i) % KC_TOUCH_PREDICTOR_WINDOW);
+        float dt = t[i] - tm;
+        stt += dt * dt;
+        stx += dt * (pred->x[idx] - xm);
+        sty += dt * (pred->y[idx] - ym);
+    }
+    if (stt <= 0.0f) {
+        return;
+    }
+    float dx = stx / stt * (float)pred->cfg.horizon_ms;
+    float dy = sty / stt * (float)pred->cfg.horizon_ms;
+    float dist = sqrtf(dx * dx + dy * dy);
+    if (dist < KC_TOUCH_PREDICTOR_DEADBAND_PX) {
+        return;
+    }
+    if (pred->cfg.max_px && dist > (float)pred->cfg.max_px) {
+        float k = (float)pred->cfg.max_px / dist;
+        dx *= k;
+        dy *= k;
+    }
+    float px = (float)frame->points[0].x + dx;
+    float py = (float)frame->points[0].y + dy;
+    if (pred->cfg.max_x) {
+        px = kc_touch_predictor_clampf(px, (float)pred->cfg.max_x);
+    }
+    if (pred->cfg.max_y) {
+        py = kc_touch_predictor_clampf(py, (float)pred->cfg.max_y);
+    }
+    frame->points[0].x = (uint16_t)lroundf(px < 0.0f ? 0.0f : px);
+    frame->points[0].y = (uint16_t)lroundf(py < 0.0f ? 0.0f : py);
+}
@@ -1,23 +1,33 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
 #include "lvgl.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifdef CONFIG_KC_TOUCH_GUI_PAYLOAD_SIZE
+#define KC_TOUCH_GUI_PAYLOAD_MAX CONFIG_KC_TOUCH_GUI_PAYLOAD_SIZE
+#else
+#define KC_TOUCH_GUI_PAYLOAD_MAX 112
+#endif
+
 /** GUI task configuration */
 typedef struct {
     uint32_t task_stack_size;   /**< GUI FreeRTOS task stack size in bytes */
     UBaseType_t task_priority;  /**< GUI FreeRTOS task priority */
-    uint32_t task_period_ms;    /**< Period in milliseconds for lv_timer_handler */
-    uint32_t tick_period_ms;    /**< Period in milliseconds for lv_tick_inc */
-    uint32_t work_queue_length; /**< Pending work items that fit in the GUI queue */
+    uint32_t max_sleep_ms;      /**< Longest sleep when LVGL has no timer pending */
+    uint32_t deep_idle_ms;      /**< Inactivity before input polling slows down, 0 = never */
+    uint32_t deep_idle_poll_ms; /**< Input read period while in deep idle */
+    uint32_t work_queue_length; /**< Dispatch ring slots (rounded up to a power of two) */
+    uint32_t coalesce_slots;    /**< Distinct coalescing keys kc_touch_gui_post() can track */
 } kc_touch_gui_config_t;
 
 typedef void (*kc_touch_gui_work_cb_t)(void *ctx);
@@ -28,10 +38,46 @@ esp_err_t kc_touch_gui_init(const kc_touch_gui_config_t *config);
 
 esp_err_t kc_touch_gui_dispatch(kc_touch_gui_work_cb_t cb, void *ctx, TickType_t ticks_to_wait);
 
+/** Receives the GUI task's private copy of a posted payload; valid only during the call. */
+typedef void (*kc_touch_gui_post_cb_t)(const void *payload, size_t len);
+
+/**
+ * @brief Copy up to KC_TOUCH_GUI_PAYLOAD_MAX bytes into the dispatch ring and run @p cb with
+ * them on the GUI task. Never blocks or allocates; safe from any task.
+ *
+ * A non-zero @p coalesce_key replaces the payload of a still-pending post with the same key,
+ * so bursts of updates to one value are delivered once with the newest payload. Once all
+ * coalescing slots are claimed, new keys are posted without coalescing.
+ *
+ * @return ESP_ERR_TIMEOUT when the ring is full (counted in `dropped`).
+ */
+esp_err_t kc_touch_gui_post(kc_touch_gui_post_cb_t cb, const void *payload, size_t len, uint32_t coalesce_key);
+
+typedef struct {
+    uint32_t posted;     /**< Items accepted into the ring */
+    uint32_t coalesced;  /**< Posts that replaced a pending payload instead of taking a slot */
+    uint32_t dropped;    /**< Posts and dispatches rejected because the ring stayed full */
+    uint32_t high_water; /**< Deepest ring occupancy since the last reset */
+    uint32_t depth;      /**< Current ring occupancy */
+    uint32_t capacity;   /**< Ring slots */
+} kc_touch_gui_dispatch_stats_t;
+
+esp_err_t kc_touch_gui_get_dispatch_stats(kc_touch_gui_dispatch_stats_t *out_stats);
+void kc_touch_gui_reset_dispatch_stats(void);
+
 void kc_touch_gui_show_root(void);
 
 bool kc_touch_gui_is_ready(void);
 
+/**
+ * Wake the GUI task and read input devices right away, leaving deep idle.
+ * The ISR variant is meant for touch controller interrupts; it returns true when a
+ * higher-priority task was woken.
+ */
+void kc_touch_gui_wake(void);
+bool kc_touch_gui_wake_from_isr(void);
+bool kc_touch_gui_in_deep_idle(void);
+
 /** 
  * Set/Get global scanning state.
  * When scanning is active, the app should avoid auto-connecting to Wi-Fi.
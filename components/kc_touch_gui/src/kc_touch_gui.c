@@ -3,12 +3,14 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include "esp_attr.h"
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_timer.h"
-#include "freertos/queue.h"
 #include "freertos/task.h"
+#include "kc_touch_gui_ring.h"
 #include "sdkconfig.h"
+#include "yamui_profiler.h"
 
 #if CONFIG_KC_TOUCH_DISPLAY_BACKEND_WAVESHARE_P4 && __has_include("bsp/display.h")
 #include "bsp/display.h"
@@ -26,16 +28,24 @@
 #define CONFIG_KC_TOUCH_GUI_TASK_PRIORITY 5
 #endif
 
-#ifndef CONFIG_KC_TOUCH_GUI_TASK_PERIOD_MS
-#define CONFIG_KC_TOUCH_GUI_TASK_PERIOD_MS 10
+#ifndef CONFIG_KC_TOUCH_GUI_MAX_SLEEP_MS
+#define CONFIG_KC_TOUCH_GUI_MAX_SLEEP_MS 1000
 #endif
 
-#ifndef CONFIG_KC_TOUCH_GUI_TICK_PERIOD_MS
-#define CONFIG_KC_TOUCH_GUI_TICK_PERIOD_MS 5
+#ifndef CONFIG_KC_TOUCH_GUI_DEEP_IDLE_MS
+#define CONFIG_KC_TOUCH_GUI_DEEP_IDLE_MS 30000
+#endif
+
+#ifndef CONFIG_KC_TOUCH_GUI_DEEP_IDLE_POLL_MS
+#define CONFIG_KC_TOUCH_GUI_DEEP_IDLE_POLL_MS 100
 #endif
 
 #ifndef CONFIG_KC_TOUCH_GUI_WORK_QUEUE_LENGTH
-#define CONFIG_KC_TOUCH_GUI_WORK_QUEUE_LENGTH 8
+#define CONFIG_KC_TOUCH_GUI_WORK_QUEUE_LENGTH 64
+#endif
+
+#ifndef CONFIG_KC_TOUCH_GUI_COALESCE_SLOTS
+#define CONFIG_KC_TOUCH_GUI_COALESCE_SLOTS 16
 #endif
 
 #ifndef CONFIG_KC_TOUCH_GUI_EMBEDDED_SCHEMA_NAME
@@ -49,26 +59,24 @@ kc_touch_gui_config_t kc_touch_gui_default_config(void)
     kc_touch_gui_config_t cfg = {
         .task_stack_size = CONFIG_KC_TOUCH_GUI_TASK_STACK_SIZE,
         .task_priority = CONFIG_KC_TOUCH_GUI_TASK_PRIORITY,
-        .task_period_ms = CONFIG_KC_TOUCH_GUI_TASK_PERIOD_MS,
-        .tick_period_ms = CONFIG_KC_TOUCH_GUI_TICK_PERIOD_MS,
+        .max_sleep_ms = CONFIG_KC_TOUCH_GUI_MAX_SLEEP_MS,
+        .deep_idle_ms = CONFIG_KC_TOUCH_GUI_DEEP_IDLE_MS,
+        .deep_idle_poll_ms = CONFIG_KC_TOUCH_GUI_DEEP_IDLE_POLL_MS,
         .work_queue_length = CONFIG_KC_TOUCH_GUI_WORK_QUEUE_LENGTH,
+        .coalesce_slots = CONFIG_KC_TOUCH_GUI_COALESCE_SLOTS,
     };
     return cfg;
 }
 
 #if CONFIG_KC_TOUCH_GUI_ENABLE
 
-typedef struct {
-    kc_touch_gui_work_cb_t cb;
-    void *ctx;
-} kc_touch_gui_work_item_t;
-
 typedef struct {
     kc_touch_gui_config_t cfg;
-    QueueHandle_t queue;
+    kc_touch_gui_ring_t ring;
     TaskHandle_t task;
-    esp_timer_handle_t tick_timer;
     bool ready;
+    volatile bool input_wake;
+    volatile bool deep_idle;
     volatile bool scanning;
     bool camera_ready;
     kc_touch_gui_prov_cb_t prov_cb;
@@ -142,57 +150,121 @@ bool kc_touch_gui_camera_ready(void)
 static bool kc_touch_gui_validate_config(const kc_touch_gui_config_t *cfg)
 {
     return cfg && cfg->task_stack_size >= 4096U &&
-           cfg->task_period_ms >= 1U &&
-           cfg->tick_period_ms >= 1U &&
-           cfg->work_queue_length >= 2U;
+           cfg->max_sleep_ms >= 1U &&
+           (cfg->deep_idle_ms == 0U || cfg->deep_idle_poll_ms >= 1U) &&
+           cfg->work_queue_length >= 2U &&
+           cfg->coalesce_slots <= UINT16_MAX;
 }
 
-static void kc_touch_gui_tick_cb(void *arg)
+/* LVGL reads the clock on demand, so no periodic tick interrupt wakes the CPU. */
+static uint32_t kc_touch_gui_tick_get_cb(void)
 {
-    (void)arg;
-    lv_tick_inc(s_gui.cfg.tick_period_ms);
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+/* Deep idle only slows the input read timers; LVGL already pauses the refresh and
+ * animation timers while nothing is invalidated or animating. */
+static void kc_touch_gui_set_deep_idle(bool idle)
+{
+    if (idle == s_gui.deep_idle) {
+        return;
+    }
+    s_gui.deep_idle = idle;
+    uint32_t period = idle ? s_gui.cfg.deep_idle_poll_ms : LV_DEF_REFR_PERIOD;
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        lv_timer_t *timer = lv_indev_get_read_timer(indev);
+        if (timer) {
+            lv_timer_set_period(timer, period);
+        }
+    }
+    ESP_LOGD(TAG, "%s deep idle", idle ? "Entering" : "Leaving");
+}
+
+static void kc_touch_gui_read_input_now(void)
+{
+    kc_touch_gui_set_deep_idle(false);
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        lv_timer_t *timer = lv_indev_get_read_timer(indev);
+        if (timer) {
+            lv_timer_ready(timer);
+        }
+    }
+}
+
+static TickType_t kc_touch_gui_next_wait(uint32_t next_ms)
+{
+    if (next_ms == LV_NO_TIMER_READY || next_ms > s_gui.cfg.max_sleep_ms) {
+        next_ms = s_gui.cfg.max_sleep_ms;
+    }
+    /* Round up so the handler never runs before its deadline, and always yield a tick. */
+    TickType_t ticks = (TickType_t)((next_ms + portTICK_PERIOD_MS - 1U) / portTICK_PERIOD_MS);
+    return ticks ? ticks : 1;
+}
+
+static void kc_touch_gui_run_item(const kc_touch_gui_ring_item_t *item)
+{
+    if (yamui_prof_enabled()) {
+        yamui_prof_record(YAMUI_PROF_DISPATCH_LATENCY, (uint32_t)esp_timer_get_time() - item->posted_us);
+    }
+    if (item->kind == KC_TOUCH_GUI_RING_POST) {
+        if (item->cb.post) {
+            item->cb.post(item->payload.bytes, item->len);
+        }
+    } else if (item->cb.work) {
+        item->cb.work(item->ctx);
+    }
+}
+
+/* Runs at most one ring's worth of items so a producer burst cannot starve rendering. */
+static bool kc_touch_gui_drain_work(void)
+{
+    if (kc_touch_gui_ring_depth(&s_gui.ring) == 0U) {
+        return false;
+    }
+    if (!kc_touch_gui_lvgl_lock(pdMS_TO_TICKS(1000))) {
+        ESP_LOGW(TAG, "Failed to acquire BSP LVGL lock for queued UI work");
+        return true;
+    }
+    kc_touch_gui_ring_item_t item;
+    uint32_t budget = s_gui.ring.mask + 1U;
+    while (budget-- > 0U && kc_touch_gui_ring_pop(&s_gui.ring, &item)) {
+        kc_touch_gui_run_item(&item);
+    }
+    kc_touch_gui_lvgl_unlock();
+    return kc_touch_gui_ring_depth(&s_gui.ring) != 0U;
 }
 
 static void kc_touch_gui_task(void *arg)
 {
     (void)arg;
-    const TickType_t wait = pdMS_TO_TICKS(s_gui.cfg.task_period_ms);
-    kc_touch_gui_work_item_t item;
     const bool bsp_lvgl = kc_touch_gui_uses_bsp_lvgl_adapter();
+    /* The BSP adapter runs lv_timer_handler itself; this task only drains work there. */
+    TickType_t wait = bsp_lvgl ? portMAX_DELAY : 0;
 
     while (true) {
-        if (xQueueReceive(s_gui.queue, &item, wait) == pdTRUE) {
-            if (kc_touch_gui_lvgl_lock(pdMS_TO_TICKS(1000))) {
-                if (item.cb) {
-                    item.cb(item.ctx);
-                }
-                while (xQueueReceive(s_gui.queue, &item, 0) == pdTRUE) {
-                    if (item.cb) {
-                        item.cb(item.ctx);
-                    }
-                }
-                kc_touch_gui_lvgl_unlock();
-            } else {
-                ESP_LOGW(TAG, "Failed to acquire BSP LVGL lock for queued UI work");
-            }
+        (void)ulTaskNotifyTake(pdTRUE, wait);
+        bool backlog = kc_touch_gui_drain_work();
+        if (bsp_lvgl) {
+            wait = backlog ? 0 : portMAX_DELAY;
+            continue;
+        }
+        if (s_gui.input_wake) {
+            s_gui.input_wake = false;
+            kc_touch_gui_read_input_now();
         }
-        if (!bsp_lvgl) {
-            lv_timer_handler();
+        int64_t handler_start = esp_timer_get_time();
+        uint32_t next_ms = lv_timer_handler();
+        yamui_prof_record(YAMUI_PROF_TIMER_HANDLER, (uint32_t)(esp_timer_get_time() - handler_start));
+        if (s_gui.cfg.deep_idle_ms) {
+            kc_touch_gui_set_deep_idle(lv_display_get_inactive_time(NULL) >= s_gui.cfg.deep_idle_ms);
         }
+        wait = backlog ? 0 : kc_touch_gui_next_wait(next_ms);
     }
 }
 
 static void kc_touch_gui_cleanup_partial(void)
 {
-    if (s_gui.tick_timer) {
-        esp_timer_stop(s_gui.tick_timer);
-        esp_timer_delete(s_gui.tick_timer);
-        s_gui.tick_timer = NULL;
-    }
-    if (s_gui.queue) {
-        vQueueDelete(s_gui.queue);
-        s_gui.queue = NULL;
-    }
+    kc_touch_gui_ring_deinit(&s_gui.ring);
     s_gui.task = NULL;
     s_gui.ready = false;
 }
@@ -212,27 +284,10 @@ esp_err_t kc_touch_gui_init(const kc_touch_gui_config_t *config)
     s_gui.cfg = cfg;
 
     lv_init();
+    lv_tick_set_cb(kc_touch_gui_tick_get_cb);
 
-    s_gui.queue = xQueueCreate((UBaseType_t)s_gui.cfg.work_queue_length, sizeof(kc_touch_gui_work_item_t));
-    if (s_gui.queue == NULL) {
-        return ESP_ERR_NO_MEM;
-    }
-
-    esp_timer_create_args_t timer_args = {
-        .callback = kc_touch_gui_tick_cb,
-        .dispatch_method = ESP_TIMER_TASK,
-        .name = "kc_gui_tick",
-    };
-
-    esp_err_t err = esp_timer_create(&timer_args, &s_gui.tick_timer);
+    esp_err_t err = kc_touch_gui_ring_init(&s_gui.ring, s_gui.cfg.work_queue_length, (uint16_t)s_gui.cfg.coalesce_slots);
     if (err != ESP_OK) {
-        kc_touch_gui_cleanup_partial();
-        return err;
-    }
-
-    err = esp_timer_start_periodic(s_gui.tick_timer, s_gui.cfg.tick_period_ms * 1000ULL);
-    if (err != ESP_OK) {
-        kc_touch_gui_cleanup_partial();
         return err;
     }
 
@@ -249,12 +304,19 @@ esp_err_t kc_touch_gui_init(const kc_touch_gui_config_t *config)
     }
 
     s_gui.ready = true;
-    ESP_LOGI(TAG, "LVGL core initialized (stack=%" PRIu32 ", period=%" PRIu32 " ms)",
-             s_gui.cfg.task_stack_size, s_gui.cfg.task_period_ms);
+    ESP_LOGI(TAG, "LVGL core initialized (stack=%" PRIu32 ", max sleep=%" PRIu32 " ms, deep idle=%" PRIu32 " ms)",
+             s_gui.cfg.task_stack_size, s_gui.cfg.max_sleep_ms, s_gui.cfg.deep_idle_ms);
 
     return ESP_OK;
 }
 
+static void kc_touch_gui_notify(void)
+{
+    if (s_gui.task) {
+        xTaskNotifyGive(s_gui.task);
+    }
+}
+
 esp_err_t kc_touch_gui_dispatch(kc_touch_gui_work_cb_t cb, void *ctx, TickType_t ticks_to_wait)
 {
     if (!s_gui.ready) {
@@ -264,18 +326,105 @@ esp_err_t kc_touch_gui_dispatch(kc_touch_gui_work_cb_t cb, void *ctx, TickType_t
         return ESP_ERR_INVALID_ARG;
     }
 
-    kc_touch_gui_work_item_t item = {
-        .cb = cb,
+    kc_touch_gui_ring_item_t item = {
+        .kind = KC_TOUCH_GUI_RING_WORK,
+        .posted_us = (uint32_t)esp_timer_get_time(),
+        .cb.work = cb,
         .ctx = ctx,
     };
 
-    BaseType_t queued = xQueueSend(s_gui.queue, &item, ticks_to_wait);
-    if (queued != pdPASS) {
-        return ESP_ERR_TIMEOUT;
+    /* The ring has no blocking push; poll once per tick while the caller is willing to wait. */
+    TickType_t start = xTaskGetTickCount();
+    while (!kc_touch_gui_ring_push(&s_gui.ring, &item)) {
+        if (xTaskGetTickCount() - start >= ticks_to_wait) {
+            kc_touch_gui_ring_note_drop(&s_gui.ring);
+            return ESP_ERR_TIMEOUT;
+        }
+        kc_touch_gui_notify();
+        vTaskDelay(1);
     }
+    kc_touch_gui_notify();
     return ESP_OK;
 }
 
+esp_err_t kc_touch_gui_post(kc_touch_gui_post_cb_t cb, const void *payload, size_t len, uint32_t coalesce_key)
+{
+    if (!s_gui.ready) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (cb == NULL || len > KC_TOUCH_GUI_PAYLOAD_MAX || (len && !payload)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t now_us = (uint32_t)esp_timer_get_time();
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    if (coalesce_key) {
+        err = kc_touch_gui_ring_post_coalesced(&s_gui.ring, coalesce_key, cb, payload, len, now_us);
+    }
+    if (err == ESP_ERR_NOT_FOUND) {
+        kc_touch_gui_ring_item_t item = {
+            .kind = KC_TOUCH_GUI_RING_POST,
+            .len = (uint16_t)len,
+            .posted_us = now_us,
+            .cb.post = cb,
+        };
+        if (len) {
+            memcpy(item.payload.bytes, payload, len);
+        }
+        err = kc_touch_gui_ring_push(&s_gui.ring, &item) ? ESP_OK : ESP_ERR_TIMEOUT;
+    }
+    if (err == ESP_ERR_TIMEOUT) {
+        kc_touch_gui_ring_note_drop(&s_gui.ring);
+    }
+    kc_touch_gui_notify();
+    return err;
+}
+
+esp_err_t kc_touch_gui_get_dispatch_stats(kc_touch_gui_dispatch_stats_t *out_stats)
+{
+    if (!out_stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_gui.ready) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    kc_touch_gui_ring_get_stats(&s_gui.ring, out_stats);
+    return ESP_OK;
+}
+
+void kc_touch_gui_reset_dispatch_stats(void)
+{
+    if (s_gui.ready) {
+        kc_touch_gui_ring_reset_stats(&s_gui.ring);
+    }
+}
+
+/* input_wake is a flag, so wakes never compete with work for ring slots. */
+void kc_touch_gui_wake(void)
+{
+    if (!s_gui.ready) {
+        return;
+    }
+    s_gui.input_wake = true;
+    kc_touch_gui_notify();
+}
+
+IRAM_ATTR bool kc_touch_gui_wake_from_isr(void)
+{
+    if (!s_gui.ready) {
+        return false;
+    }
+    s_gui.input_wake = true;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_gui.task, &woken);
+    return woken == pdTRUE;
+}
+
+bool kc_touch_gui_in_deep_idle(void)
+{
+    return s_gui.deep_idle;
+}
+
 static void kc_touch_gui_build_ui(void *ctx)
 {
     (void)ctx;
@@ -320,11 +469,44 @@ esp_err_t kc_touch_gui_dispatch(kc_touch_gui_work_cb_t cb, void *ctx, TickType_t
     return ESP_ERR_NOT_SUPPORTED;
 }
 
+esp_err_t kc_touch_gui_post(kc_touch_gui_post_cb_t cb, const void *payload, size_t len, uint32_t coalesce_key)
+{
+    (void)cb;
+    (void)payload;
+    (void)len;
+    (void)coalesce_key;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t kc_touch_gui_get_dispatch_stats(kc_touch_gui_dispatch_stats_t *out_stats)
+{
+    (void)out_stats;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void kc_touch_gui_reset_dispatch_stats(void)
+{
+}
+
 bool kc_touch_gui_is_ready(void)
 {
     return false;
 }
 
+void kc_touch_gui_wake(void)
+{
+}
+
+bool kc_touch_gui_wake_from_isr(void)
+{
+    return false;
+}
+
+bool kc_touch_gui_in_deep_idle(void)
+{
+    return false;
+}
+
 void kc_touch_gui_set_camera_ready(bool ready)
 {
     (void)ready;
@@ -0,0 +1,207 @@
+#include "kc_touch_gui_ring.h"
+
+#include <string.h>
+
+#include "esp_heap_caps.h"
+
+static uint32_t kc_touch_gui_ring_round_pow2(uint32_t value)
+{
+    uint32_t pow2 = 2U;
+    while (pow2 < value && pow2 < 0x80000000U) {
+        pow2 <<= 1;
+    }
+    return pow2;
+}
+
+esp_err_t kc_touch_gui_ring_init(kc_touch_gui_ring_t *ring, uint32_t capacity, uint16_t mailbox_count)
+{
+    if (!ring || capacity < 2U) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(ring, 0, sizeof(*ring));
+    capacity = kc_touch_gui_ring_round_pow2(capacity);
+    /* Producers spin on the slot sequence numbers, keep them in internal RAM. */
+    ring->slots = heap_caps_calloc(capacity, sizeof(kc_touch_gui_ring_slot_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!ring->slots) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (mailbox_count) {
+        ring->mailboxes = heap_caps_calloc(mailbox_count, sizeof(kc_touch_gui_ring_mailbox_t),
+                                           MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!ring->mailboxes) {
+            heap_caps_free(ring->slots);
+            ring->slots = NULL;
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    ring->mask = capacity - 1U;
+    ring->mailbox_count = mailbox_count;
+    portMUX_INITIALIZE(&ring->mailbox_lock);
+    for (uint32_t i = 0; i < capacity; ++i) {
+        atomic_init(&ring->slots[i].seq, i);
+    }
+    return ESP_OK;
+}
+
+void kc_touch_gui_ring_deinit(kc_touch_gui_ring_t *ring)
+{
+    if (!ring) {
+        return;
+    }
+    heap_caps_free(ring->slots);
+    heap_caps_free(ring->mailboxes);
+    memset(ring, 0, sizeof(*ring));
+}
+
+static void kc_touch_gui_ring_note_depth(kc_touch_gui_ring_t *ring, uint32_t depth)
+{
+    uint32_t seen = atomic_load_explicit(&ring->high_water, memory_order_relaxed);
+    while (depth > seen &&
+           !atomic_compare_exchange_weak_explicit(&ring->high_water, &seen, depth, memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+bool kc_touch_gui_ring_push(kc_touch_gui_ring_t *ring, const kc_touch_gui_ring_item_t *item)
+{
+    uint32_t pos = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+    kc_touch_gui_ring_slot_t *slot;
+    while (true) {
+        slot = &ring->slots[pos & ring->mask];
+        uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->enqueue_pos, &pos, pos + 1U, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+        }
+    }
+    /* Copy only the used part of the payload; the consumer never reads past len. */
+    size_t copy = offsetof(kc_touch_gui_ring_item_t, payload) + (item->kind == KC_TOUCH_GUI_RING_POST ? item->len : 0U);
+    memcpy(&slot->item, item, copy);
+    atomic_store_explicit(&slot->seq, pos + 1U, memory_order_release);
+    atomic_fetch_add_explicit(&ring->posted, 1U, memory_order_relaxed);
+    /* The consumer may already have drained this item and later ones from other producers. */
+    int32_t depth = (int32_t)(pos + 1U - atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed));
+    if (depth > 0) {
+        kc_touch_gui_ring_note_depth(ring, (uint32_t)depth);
+    }
+    return true;
+}
+
+static kc_touch_gui_ring_mailbox_t *kc_touch_gui_ring_claim_mailbox(kc_touch_gui_ring_t *ring, uint32_t key,
+                                                                    uint16_t *out_index)
+{
+    uint32_t start = (key * 2654435761U) % ring->mailbox_count;
+    for (uint16_t probe = 0; probe < ring->mailbox_count; ++probe) {
+        uint16_t index = (uint16_t)((start + probe) % ring->mailbox_count);
+        kc_touch_gui_ring_mailbox_t *mailbox = &ring->mailboxes[index];
+        uint32_t owner = atomic_load_explicit(&mailbox->key, memory_order_acquire);
+        if (owner == 0U) {
+            if (atomic_compare_exchange_strong_explicit(&mailbox->key, &owner, key, memory_order_acq_rel,
+                                                        memory_order_acquire)) {
+                owner = key;
+            }
+        }
+        if (owner == key) {
+            *out_index = index;
+            return mailbox;
+        }
+    }
+    return NULL;
+}
+
+esp_err_t kc_touch_gui_ring_post_coalesced(kc_touch_gui_ring_t *ring, uint32_t key, kc_touch_gui_post_cb_t cb,
+                                           const void *payload, size_t len, uint32_t posted_us)
+{
+    uint16_t index = 0;
+    kc_touch_gui_ring_mailbox_t *mailbox = ring->mailbox_count ? kc_touch_gui_ring_claim_mailbox(ring, key, &index) : NULL;
+    if (!mailbox) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    portENTER_CRITICAL_SAFE(&ring->mailbox_lock);
+    mailbox->cb = cb;
+    mailbox->len = (uint16_t)len;
+    if (len) {
+        memcpy(mailbox->payload.bytes, payload, len);
+    }
+    portEXIT_CRITICAL_SAFE(&ring->mailbox_lock);
+
+    /* The consumer clears `queued` before it copies the mailbox, so a write that lands after
+     * the copy always queues a fresh slot. */
+    if (atomic_exchange(&mailbox->queued, true)) {
+        atomic_fetch_add_explicit(&ring->coalesced, 1U, memory_order_relaxed);
+        return ESP_OK;
+    }
+    kc_touch_gui_ring_item_t item = {
+        .kind = KC_TOUCH_GUI_RING_COALESCED,
+        .mailbox = index,
+        .posted_us = posted_us,
+    };
+    if (!kc_touch_gui_ring_push(ring, &item)) {
+        atomic_store(&mailbox->queued, false);
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+bool kc_touch_gui_ring_pop(kc_touch_gui_ring_t *ring, kc_touch_gui_ring_item_t *out)
+{
+    uint32_t pos = atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+    kc_touch_gui_ring_slot_t *slot = &ring->slots[pos & ring->mask];
+    uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if (seq != pos + 1U) {
+        return false;
+    }
+    const kc_touch_gui_ring_item_t *item = &slot->item;
+    size_t copy = offsetof(kc_touch_gui_ring_item_t, payload) + (item->kind == KC_TOUCH_GUI_RING_POST ? item->len : 0U);
+    memcpy(out, item, copy);
+    atomic_store_explicit(&slot->seq, pos + ring->mask + 1U, memory_order_release);
+    atomic_store_explicit(&ring->dequeue_pos, pos + 1U, memory_order_relaxed);
+
+    if (out->kind == KC_TOUCH_GUI_RING_COALESCED) {
+        kc_touch_gui_ring_mailbox_t *mailbox = &ring->mailboxes[out->mailbox];
+        atomic_store(&mailbox->queued, false);
+        portENTER_CRITICAL_SAFE(&ring->mailbox_lock);
+        out->cb.post = mailbox->cb;
+        out->len = mailbox->len;
+        memcpy(out->payload.bytes, mailbox->payload.bytes, mailbox->len);
+        portEXIT_CRITICAL_SAFE(&ring->mailbox_lock);
+        out->kind = KC_TOUCH_GUI_RING_POST;
+    }
+    return true;
+}
+
+uint32_t kc_touch_gui_ring_depth(const kc_touch_gui_ring_t *ring)
+{
+    return atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed) -
+           atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+}
+
+void kc_touch_gui_ring_note_drop(kc_touch_gui_ring_t *ring)
+{
+    atomic_fetch_add_explicit(&ring->dropped, 1U, memory_order_relaxed);
+}
+
+void kc_touch_gui_ring_get_stats(kc_touch_gui_ring_t *ring, kc_touch_gui_dispatch_stats_t *out_stats)
+{
+    out_stats->posted = atomic_load_explicit(&ring->posted, memory_order_relaxed);
+    out_stats->coalesced = atomic_load_explicit(&ring->coalesced, memory_order_relaxed);
+    out_stats->dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    out_stats->high_water = atomic_load_explicit(&ring->high_water, memory_order_relaxed);
+    out_stats->depth = kc_touch_gui_ring_depth(ring);
+    out_stats->capacity = ring->mask + 1U;
+}
+
+void kc_touch_gui_ring_reset_stats(kc_touch_gui_ring_t *ring)
+{
+    atomic_store_explicit(&ring->posted, 0U, memory_order_relaxed);
+    atomic_store_explicit(&ring->coalesced, 0U, memory_order_relaxed);
+    atomic_store_explicit(&ring->dropped, 0U, memory_order_relaxed);
+    atomic_store_explicit(&ring->high_water, kc_touch_gui_ring_depth(ring), memory_order_relaxed);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "kc_touch_gui.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Bounded multi-producer / single-consumer ring for GUI work (per-slot sequence numbers,
+ * no locks on push or pop). Producers copy small payloads into the slot; the GUI task pops
+ * a private copy and runs the callback on it. Coalesced posts keep their newest payload in
+ * a keyed mailbox and occupy at most one ring slot while pending; only the mailbox copy is
+ * done under a short critical section.
+ */
+
+typedef enum {
+    KC_TOUCH_GUI_RING_WORK = 0,  /**< Legacy kc_touch_gui_dispatch() callback + context pointer */
+    KC_TOUCH_GUI_RING_POST,      /**< kc_touch_gui_post() callback + inline payload */
+    KC_TOUCH_GUI_RING_COALESCED, /**< Payload lives in the mailbox named by `mailbox` */
+} kc_touch_gui_ring_kind_t;
+
+typedef struct {
+    uint8_t kind;
+    uint8_t reserved;
+    uint16_t len;
+    uint16_t mailbox;
+    uint32_t posted_us; /**< Producer timestamp (esp_timer, truncated) for latency profiling */
+    union {
+        kc_touch_gui_work_cb_t work;
+        kc_touch_gui_post_cb_t post;
+    } cb;
+    void *ctx;
+    union {
+        uint8_t bytes[KC_TOUCH_GUI_PAYLOAD_MAX];
+        max_align_t align;
+    } payload;
+} kc_touch_gui_ring_item_t;
+
+typedef struct {
+    _Atomic uint32_t seq;
+    kc_touch_gui_ring_item_t item;
+} kc_touch_gui_ring_slot_t;
+
+typedef struct {
+    _Atomic uint32_t key; /**< 0 = free; keys are never released once claimed */
+    _Atomic bool queued;
+    kc_touch_gui_post_cb_t cb;
+    uint16_t len;
+    union {
+        uint8_t bytes[KC_TOUCH_GUI_PAYLOAD_MAX];
+        max_align_t align;
+    } payload;
+} kc_touch_gui_ring_mailbox_t;
+
+typedef struct {
+    kc_touch_gui_ring_slot_t *slots;
+    uint32_t mask;
+    _Atomic uint32_t enqueue_pos;
+    _Atomic uint32_t dequeue_pos;
+    kc_touch_gui_ring_mailbox_t *mailboxes;
+    uint16_t mailbox_count;
+    portMUX_TYPE mailbox_lock; /**< Guards mailbox payload copies (a few dozen bytes) */
+    _Atomic uint32_t posted;
+    _Atomic uint32_t coalesced;
+    _Atomic uint32_t dropped;
+    _Atomic uint32_t high_water;
+} kc_touch_gui_ring_t;
+
+/** @p capacity is rounded up to a power of two. */
+esp_err_t kc_touch_gui_ring_init(kc_touch_gui_ring_t *ring, uint32_t capacity, uint16_t mailbox_count);
+void kc_touch_gui_ring_deinit(kc_touch_gui_ring_t *ring);
+
+/** Returns false when the ring is full; the caller decides whether that counts as a drop. */
+bool kc_touch_gui_ring_push(kc_touch_gui_ring_t *ring, const kc_touch_gui_ring_item_t *item);
+
+/**
+ * Store @p payload as the newest value for @p key. ESP_OK when it was queued or replaced a
+ * pending value, ESP_ERR_NOT_FOUND when every mailbox holds another key, ESP_ERR_TIMEOUT when
+ * the ring is full.
+ */
+esp_err_t kc_touch_gui_ring_post_coalesced(kc_touch_gui_ring_t *ring, uint32_t key, kc_touch_gui_post_cb_t cb,
+                                           const void *payload, size_t len, uint32_t posted_us);
+
+/** Consumer only. Copies the oldest item (resolving mailboxes) into @p out. */
+bool kc_touch_gui_ring_pop(kc_touch_gui_ring_t *ring, kc_touch_gui_ring_item_t *out);
+
+uint32_t kc_touch_gui_ring_depth(const kc_touch_gui_ring_t *ring);
+void kc_touch_gui_ring_note_drop(kc_touch_gui_ring_t *ring);
+void kc_touch_gui_ring_get_stats(kc_touch_gui_ring_t *ring, kc_touch_gui_dispatch_stats_t *out_stats);
+void kc_touch_gui_ring_reset_stats(kc_touch_gui_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Enables the hot-path profiler per Kconfig, registers the `perf_report` and `perf_overlay`
+ * native functions and shows the overlay when CONFIG_YAMUI_PROFILER_OVERLAY is set.
+ * Only the first call does anything, so later calls keep the enabled state set at runtime.
+ * Must run on the LVGL task.
+ */
+void yui_perf_init(void);
+
+/** Show or hide the live profiler summary on LVGL's top layer (LVGL task only). */
+void yui_perf_overlay_show(bool show);
+bool yui_perf_overlay_visible(void);
+
+#ifdef __cplusplus
+}
+#endif
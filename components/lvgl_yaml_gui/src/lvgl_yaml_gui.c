@@ -14,19 +14,56 @@
 #include "yamui_events.h"
 #include "yamui_expr.h"
 #include "yamui_async.h"
+#include "yamui_collection.h"
 #include "yamui_logging.h"
+#include "yamui_profiler.h"
 #include "yamui_runtime.h"
 #include "yamui_state.h"
 #include "yui_camera.h"
 #include "yui_navigation_queue.h"
+#include "yui_perf_overlay.h"
+#include "sdkconfig.h"
 
 #include <ctype.h>
+#include <inttypes.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
 
 #define YUI_TEXT_BUFFER_MAX 256
+#define YUI_VLIST_DEFAULT_ROW_HEIGHT 40
+#define YUI_VLIST_DEFAULT_OVERSCAN 2
+#define YUI_VLIST_POOL_MAX 64U
+
+#ifndef CONFIG_YAMUI_SCREEN_CACHE_BUDGET_KB
+#define CONFIG_YAMUI_SCREEN_CACHE_BUDGET_KB 0
+#endif
+
+#ifndef CONFIG_YAMUI_SCREEN_CACHE_MAX_SCREENS
+#define CONFIG_YAMUI_SCREEN_CACHE_MAX_SCREENS 1
+#endif
+
+#ifndef CONFIG_YAMUI_RENDER_WIDGETS_PER_STEP
+#define CONFIG_YAMUI_RENDER_WIDGETS_PER_STEP 0
+#endif
+
+#ifndef CONFIG_YAMUI_SCREEN_PREFETCH
+#define CONFIG_YAMUI_SCREEN_PREFETCH 0
+#endif
+
+#ifndef CONFIG_YAMUI_SCREEN_PREFETCH_DELAY_MS
+#define CONFIG_YAMUI_SCREEN_PREFETCH_DELAY_MS 500
+#endif
+
+#ifndef CONFIG_YAMUI_SCREEN_PREFETCH_SLICE_MS
+#define CONFIG_YAMUI_SCREEN_PREFETCH_SLICE_MS 4
+#endif
+
+#ifndef CONFIG_YAMUI_SCREEN_PREFETCH_TARGETS
+#define CONFIG_YAMUI_SCREEN_PREFETCH_TARGETS 2
+#endif
 
 #ifndef LV_FLEX_ALIGN_STRETCH
 #define LV_FLEX_ALIGN_STRETCH LV_FLEX_ALIGN_START
@@ -48,12 +85,44 @@ typedef enum {
     YUI_VALUE_BIND_LED,
 } yui_value_bind_kind_t;
 
+/* Resolution of one `type:` scalar: a schema component, a custom factory, or a built-in handler. */
+typedef struct {
+    const char *type; /* scalar pointer from the schema tree */
+    const yui_component_def_t *component;
+    yamui_widget_factory_t factory;
+    void *factory_ctx;
+    int16_t builtin; /* index into s_widget_handlers, -1 if none */
+} yui_widget_type_slot_t;
+
+typedef struct {
+    yui_widget_type_slot_t *slots;
+    size_t capacity; /* power of two */
+    size_t count;
+    uint32_t generation;
+} yui_widget_type_cache_t;
+
 typedef struct {
     char *name;
     yml_node_t *root;
+    void *blob_storage; /* private copy backing a binary schema tree, if any */
     yui_schema_t schema;
+    yui_widget_type_cache_t types;
 } yui_schema_runtime_t;
 
+/* Shared LVGL style for one logical schema style name; "card" covers "card", "dark.card" and
+ * "light.card". Allocated individually so the lv_style_t never moves. */
+typedef struct {
+    char *name;
+    lv_style_t style;
+} yui_style_slot_t;
+
+typedef esp_err_t (*yui_widget_render_fn_t)(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope);
+
+typedef struct {
+    const char *name;
+    yui_widget_render_fn_t render;
+} yui_widget_handler_t;
+
 typedef struct {
     yui_schema_runtime_t *schema;
     char *screen_name;
@@ -64,6 +133,18 @@ typedef struct {
     lv_obj_t *obj;
 } yui_widget_ref_t;
 
+typedef struct {
+    yui_schema_runtime_t *schema;
+    char *screen_name;
+    lv_obj_t *screen;
+    yui_widget_ref_t *refs; /* widget ids of the screen while it is detached */
+    size_t ref_count;
+    size_t ref_capacity;
+    size_t bytes;
+    uint32_t last_used;
+    bool stale; /* tree was cleaned behind our back; never re-attach */
+} yui_screen_cache_entry_t;
+
 typedef struct {
     lv_obj_t *container;
     lv_obj_t *image;
@@ -100,41 +181,65 @@ struct yui_component_scope {
     size_t ref_count;
 };
 
+typedef struct {
+    char *literal;
+    yui_expr_program_t *program;
+} yui_template_segment_t;
+
+typedef struct {
+    yui_template_segment_t *segments;
+    size_t segment_count;
+} yui_compiled_template_t;
+
+typedef void (*yui_text_setter_t)(lv_obj_t *target, uint32_t index, const char *text);
+
+/* Secondary text owned by a widget (titles, placeholders) that is looked up by translation key. */
+typedef struct {
+    lv_obj_t *target;
+    uint32_t index;
+    yui_text_setter_t set;
+    yui_compiled_template_t *key_template;
+    yui_translation_handle_t handle;
+} yui_localized_text_t;
+
 struct yui_widget_runtime {
     lv_obj_t *event_target;
     lv_obj_t *text_target;
-    char *text_template;
+    yui_compiled_template_t *text_template;
     bool text_template_is_translation_key;
+    yui_translation_handle_t text_handle;
+    yui_localized_text_t *localized;
+    size_t localized_count;
     lv_obj_t *value_target;
-    char *value_template;
+    yui_compiled_template_t *value_template;
     lv_obj_t *condition_target;
-    char *visible_expr;
-    char *enabled_expr;
+    yui_expr_program_t *visible_program;
+    yui_expr_program_t *enabled_program;
     yui_value_bind_kind_t value_kind;
-    char **bindings;
-    size_t binding_count;
     yui_state_watch_handle_t *watch_handles;
+    yui_state_key_t *watch_keys;
     size_t watch_count;
     yui_component_scope_t *scope;
     yui_widget_events_t events;
     bool disposed;
     bool binding_refresh_pending;
+    bool binding_stale;
     bool condition_refresh_pending;
     bool condition_refreshing;
     bool has_visible_state;
     bool last_visible;
     bool has_enabled_state;
     bool last_enabled;
-    bool watch_all_state;
 };
 
 static void yui_widget_refresh_text(yui_widget_runtime_t *runtime);
+static void yui_widget_refresh_localized(yui_widget_runtime_t *runtime);
 static void yui_widget_refresh_value(yui_widget_runtime_t *runtime);
 static void yui_widget_refresh_conditions(yui_widget_runtime_t *runtime);
 static void yui_widget_schedule_condition_refresh(yui_widget_runtime_t *runtime);
-static esp_err_t yui_widget_watch_all_state(yui_widget_runtime_t *runtime);
 static bool yui_expr_value_is_truthy(const yui_expr_value_t *value);
 static void yui_format_text(const char *tmpl, yui_component_scope_t *scope, char *out, size_t out_len);
+static void yui_template_free(yui_compiled_template_t *tmpl);
 static bool yui_format_node_text(const yml_node_t *node, yui_component_scope_t *scope, char *out, size_t out_len);
 static lv_chart_type_t yui_chart_type_from_string(const char *value);
 static lv_chart_update_mode_t yui_chart_update_mode_from_string(const char *value);
@@ -144,20 +249,26 @@ static lv_menu_mode_header_t yui_menu_header_mode_from_string(const char *value)
 static lv_menu_mode_root_back_button_t yui_menu_root_back_button_mode_from_string(const char *value);
 static char *yui_strdup_local(const char *value);
 static esp_err_t yui_collect_bindings_from_text(const char *text, char ***out_tokens, size_t *out_count);
-static esp_err_t yui_collect_bindings_from_expr(const char *expr, char ***out_tokens, size_t *out_count);
 static void yui_apply_layout(lv_obj_t *obj, const yml_node_t *layout_node, const char *default_type);
 static lv_flex_align_t yui_flex_align_from_string(const char *value, lv_flex_align_t def);
 static esp_err_t yui_render_widget_list(const yml_node_t *widgets_node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope);
+static esp_err_t yui_build_push_frame(const yml_node_t *widgets_node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope);
+static void yui_build_abort(void);
+static void yui_build_invalidate(lv_obj_t *screen);
 static bool yui_dropdown_select_value(lv_obj_t *dropdown, const char *value);
 static bool yui_roller_select_value(lv_obj_t *roller, const char *value);
 static esp_err_t yui_widget_bind_conditions(yui_widget_runtime_t *runtime, const yml_node_t *node, lv_obj_t *target);
 static bool yui_theme_is_dark(void);
+static void yui_styles_rebuild(const yui_schema_runtime_t *schema);
 static lv_color_t yui_theme_screen_bg_color(void);
 static lv_color_t yui_theme_modal_overlay_color(void);
 static lv_color_t yui_theme_modal_panel_color(void);
 static const yui_style_t *yui_resolve_style(const yui_schema_t *schema, const char *style_name);
+static bool yui_attach_style(lv_obj_t *obj, const char *style_name);
+static void yui_theme_styles_compile(void);
 static const yml_node_t *yui_find_event_node(const yml_node_t *node, const char *yaml_key, const char *companion_key);
 static const char *yui_translate_key(const char *key);
+static const char *yui_translate_handle(yui_translation_handle_t handle);
 static const char *yui_canonicalize_state_key(const char *key);
 static esp_err_t yui_camera_preview_start(lv_obj_t *container, lv_obj_t *image, lv_obj_t *placeholder);
 static void yui_camera_preview_stop(void);
@@ -180,6 +291,7 @@ typedef struct {
 typedef struct {
     const lv_event_t *lv_event;
     yui_component_scope_t *scope;
+    const kc_touch_gesture_t *gesture;
 } yui_event_resolver_ctx_t;
 
 static const yui_widget_event_field_t s_widget_events[] = {
@@ -189,6 +301,10 @@ static const yui_widget_event_field_t s_widget_events[] = {
     {"on_change", "onChange", YUI_WIDGET_EVENT_CHANGE, LV_EVENT_VALUE_CHANGED},
     {"on_focus", "onFocus", YUI_WIDGET_EVENT_FOCUS, LV_EVENT_FOCUSED},
     {"on_blur", "onBlur", YUI_WIDGET_EVENT_BLUR, LV_EVENT_DEFOCUSED},
+    /* Gestures come from the touch recognizer, not from LVGL (LV_EVENT_ALL is never sent). */
+    {"on_long_press", "onLongPress", YUI_WIDGET_EVENT_LONG_PRESS, LV_EVENT_ALL},
+    {"on_pinch", "onPinch", YUI_WIDGET_EVENT_PINCH, LV_EVENT_ALL},
+    {"on_swipe", "onSwipe", YUI_WIDGET_EVENT_SWIPE, LV_EVENT_ALL},
 };
 static const size_t s_widget_event_count = sizeof(s_widget_events) / sizeof(s_widget_events[0]);
 
@@ -380,12 +496,31 @@ static void yui_scope_delete_cb(lv_event_t *event)
 }
 
 static yui_schema_runtime_t *s_loaded_schema;
+static yui_style_slot_t **s_style_slots;
+static size_t s_style_slot_count;
+static size_t s_style_slot_capacity;
+static lv_style_t s_theme_screen_style;
+static lv_style_t s_theme_overlay_style;
+static lv_style_t s_theme_panel_style;
+static bool s_theme_styles_ready;
 static yui_screen_frame_t *s_nav_stack;
 static size_t s_nav_count;
 static size_t s_nav_capacity;
+static yui_screen_cache_entry_t *s_screen_cache;
+static size_t s_screen_cache_count;
+static size_t s_screen_cache_capacity;
+static size_t s_screen_cache_bytes;
+static uint32_t s_screen_cache_clock;
+static yui_widget_runtime_t **s_stale_runtimes;
+static size_t s_stale_runtime_count;
+static size_t s_stale_runtime_capacity;
+/* Widget that took PINCH_BEGIN; updates and the end stay with it wherever the fingers drift. */
+static yui_widget_runtime_t *s_pinch_target;
+static bool s_build_deferring;
 static yui_state_watch_handle_t s_display_brightness_watch;
 static yui_state_watch_handle_t s_theme_watch;
-static yui_state_watch_handle_t s_locale_watch;
+static yui_state_key_t s_dark_mode_key;
+static yui_state_key_t s_locale_key;
 typedef struct {
     lv_obj_t *overlay;
 } yui_modal_frame_t;
@@ -854,6 +989,16 @@ static void yui_modal_close_all(void)
     }
 }
 
+/* Keeps open modals above widgets a screen build appends after they were shown. */
+static void yui_modal_raise_all(void)
+{
+    for (size_t i = 0; i < s_modal_count; ++i) {
+        if (s_modal_stack[i].overlay) {
+            lv_obj_move_foreground(s_modal_stack[i].overlay);
+        }
+    }
+}
+
 static esp_err_t yui_modal_close_top(void)
 {
     if (s_modal_count == 0U) {
@@ -891,16 +1036,17 @@ static esp_err_t yui_modal_show_component(const char *component_name)
     lv_obj_t *overlay = lv_obj_create(root);
     lv_obj_remove_style_all(overlay);
     lv_obj_set_size(overlay, LV_PCT(100), LV_PCT(100));
-    lv_obj_set_style_bg_color(overlay, yui_theme_modal_overlay_color(), 0);
-    lv_obj_set_style_bg_opa(overlay, LV_OPA_60, 0);
+    if (!s_theme_styles_ready) {
+        yui_theme_styles_compile();
+    }
+    lv_obj_add_style(overlay, &s_theme_overlay_style, 0);
     lv_obj_add_flag(overlay, LV_OBJ_FLAG_CLICKABLE);
     lv_obj_add_flag(overlay, LV_OBJ_FLAG_FLOATING);
     lv_obj_add_flag(overlay, LV_OBJ_FLAG_IGNORE_LAYOUT);
     lv_obj_clear_flag(overlay, LV_OBJ_FLAG_SCROLLABLE);
 
     lv_obj_t *panel = lv_obj_create(overlay);
-    lv_obj_set_style_bg_color(panel, yui_theme_modal_panel_color(), 0);
-    lv_obj_set_style_bg_opa(panel, LV_OPA_COVER, 0);
+    lv_obj_add_style(panel, &s_theme_panel_style, 0);
     lv_obj_set_style_pad_all(panel, 18, 0);
     lv_obj_set_style_radius(panel, 16, 0);
     
@@ -941,15 +1087,54 @@ static esp_err_t yui_runtime_emit_event(const char *event, const char **args, si
 
 static bool yui_theme_is_dark(void)
 {
-    return yui_state_get_bool("ui.dark_mode", false);
+    if (s_dark_mode_key == YUI_STATE_KEY_INVALID && yui_state_key_resolve("ui.dark_mode", &s_dark_mode_key) != ESP_OK) {
+        return yui_state_get_bool("ui.dark_mode", false);
+    }
+    const char *value = yui_state_get_by_key(s_dark_mode_key, NULL);
+    if (!value) {
+        return false;
+    }
+    return strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0;
 }
 
 static const char *yui_current_locale(void)
+{
+    const char *fallback = s_loaded_schema ? yui_schema_locale(&s_loaded_schema->schema) : "";
+    if (s_locale_key == YUI_STATE_KEY_INVALID && yui_state_key_resolve("ui.locale", &s_locale_key) != ESP_OK) {
+        return yui_state_get("ui.locale", fallback);
+    }
+    return yui_state_get_by_key(s_locale_key, fallback);
+}
+
+/* Cached bundle of the loaded schema; points into its translation tables, so it is dropped
+ * whenever a schema is attached or destroyed. */
+static bool s_bundle_valid;
+static const yui_translation_locale_t *s_bundle;
+static char s_bundle_locale[16];
+
+static void yui_translations_invalidate(void)
+{
+    s_bundle_valid = false;
+    s_bundle = NULL;
+    s_bundle_locale[0] = '\0';
+}
+
+/* The active bundle is re-resolved only when the schema or the locale name changes. */
+static const yui_translation_locale_t *yui_current_translations(void)
 {
     if (!s_loaded_schema) {
-        return yui_state_get("ui.locale", "");
+        return NULL;
     }
-    return yui_state_get("ui.locale", yui_schema_locale(&s_loaded_schema->schema));
+    const char *locale = yui_current_locale();
+    if (!locale) {
+        locale = "";
+    }
+    if (!s_bundle_valid || strncmp(s_bundle_locale, locale, sizeof(s_bundle_locale)) != 0) {
+        s_bundle_valid = true;
+        s_bundle = yui_schema_find_locale(&s_loaded_schema->schema, locale);
+        snprintf(s_bundle_locale, sizeof(s_bundle_locale), "%s", locale);
+    }
+    return s_bundle;
 }
 
 static const char *yui_translate_key(const char *key)
@@ -957,10 +1142,21 @@ static const char *yui_translate_key(const char *key)
     if (!key || key[0] == '\0' || !s_loaded_schema) {
         return key;
     }
-    const char *translated = yui_schema_translate(&s_loaded_schema->schema, yui_current_locale(), key);
+    yui_translation_handle_t handle = yui_schema_translation_handle(&s_loaded_schema->schema, key);
+    const char *translated = yui_translation_lookup(yui_current_translations(), handle);
     return translated ? translated : key;
 }
 
+/* Handles come from the loaded schema; widgets built from an older schema never outlive it. */
+static const char *yui_translate_handle(yui_translation_handle_t handle)
+{
+    if (!s_loaded_schema || handle >= s_loaded_schema->schema.translation_index.key_count) {
+        return NULL;
+    }
+    const char *translated = yui_translation_lookup(yui_current_translations(), handle);
+    return translated ? translated : s_loaded_schema->schema.translation_index.keys[handle];
+}
+
 static lv_color_t yui_theme_screen_bg_color(void)
 {
     return yui_theme_is_dark() ? lv_color_hex(0x0F1117) : lv_color_hex(0xF5F7FB);
@@ -1011,20 +1207,21 @@ static void yui_display_brightness_watch_cb(const char *key, const char *value,
     yui_apply_display_brightness_value(value);
 }
 
-static void yui_theme_watch_cb(const char *key, const char *value, void *user_ctx)
+static void yui_theme_apply_cb(void *ctx)
 {
-    (void)key;
-    (void)value;
-    (void)user_ctx;
-    (void)yui_nav_queue_submit(YUI_NAV_REQUEST_REFRESH, NULL);
+    (void)ctx;
+    yui_styles_rebuild(s_loaded_schema);
 }
 
-static void yui_locale_watch_cb(const char *key, const char *value, void *user_ctx)
+/* Widgets reference shared styles, so a theme switch only recompiles them; nothing is rebuilt. */
+static void yui_theme_watch_cb(const char *key, const char *value, void *user_ctx)
 {
     (void)key;
     (void)value;
     (void)user_ctx;
-    (void)yui_nav_queue_submit(YUI_NAV_REQUEST_REFRESH, NULL);
+    if (kc_touch_gui_dispatch(yui_theme_apply_cb, NULL, 0) != ESP_OK) {
+        (void)yui_nav_queue_submit(YUI_NAV_REQUEST_REFRESH, NULL);
+    }
 }
 
 static esp_err_t yui_register_display_watchers(void)
@@ -1043,14 +1240,6 @@ static esp_err_t yui_register_theme_watchers(void)
     return yui_state_watch("ui.dark_mode", yui_theme_watch_cb, NULL, &s_theme_watch);
 }
 
-static esp_err_t yui_register_locale_watchers(void)
-{
-    if (s_locale_watch != 0U) {
-        return ESP_OK;
-    }
-    return yui_state_watch("ui.locale", yui_locale_watch_cb, NULL, &s_locale_watch);
-}
-
 static void yui_sync_display_brightness_from_state(void)
 {
     yui_apply_display_brightness_value(yui_state_get("display.brightness", "100"));
@@ -1081,7 +1270,22 @@ static bool yui_expression_symbol_resolver(const char *identifier, void *ctx, yu
         value = yui_scope_resolve_prop(expr_ctx->scope, identifier);
     }
     if (!value) {
-        value = yui_state_get(identifier, "");
+        /* Typed state feeds numbers and booleans straight through; only text state is coerced. */
+        yui_state_value_t state_value;
+        if (!yui_state_get_value(identifier, &state_value)) {
+            value = "";
+        } else if (state_value.type == YUI_STATE_VALUE_INT) {
+            yui_expr_value_set_number(out, (double)state_value.int_value);
+            return true;
+        } else if (state_value.type == YUI_STATE_VALUE_FLOAT) {
+            yui_expr_value_set_number(out, state_value.float_value);
+            return true;
+        } else if (state_value.type == YUI_STATE_VALUE_BOOL) {
+            yui_expr_value_set_bool(out, state_value.bool_value);
+            return true;
+        } else {
+            value = state_value.string;
+        }
     }
     if (!value) {
         value = "";
@@ -1198,6 +1402,41 @@ static const char *yui_event_resolve_checked(const yui_event_resolver_ctx_t *ctx
     return buffer;
 }
 
+/* Gesture handlers see gesture, phase, scale, direction, x, y, dx, dy; `value` is the pinch
+ * scale or the swipe direction. Returns NULL for anything else. */
+static const char *yui_event_resolve_gesture(const kc_touch_gesture_t *gesture, const char *symbol, char *buffer,
+                                             size_t buffer_len)
+{
+    if (!buffer || buffer_len == 0U) {
+        return NULL;
+    }
+    bool pinch = gesture->type == KC_TOUCH_GESTURE_PINCH_BEGIN || gesture->type == KC_TOUCH_GESTURE_PINCH_UPDATE ||
+                 gesture->type == KC_TOUCH_GESTURE_PINCH_END;
+    if (strcmp(symbol, "gesture") == 0) {
+        snprintf(buffer, buffer_len, "%s", pinch ? "pinch" : kc_touch_gesture_type_name(gesture->type));
+    } else if (strcmp(symbol, "phase") == 0) {
+        const char *phase = gesture->type == KC_TOUCH_GESTURE_PINCH_BEGIN ? "begin"
+                            : gesture->type == KC_TOUCH_GESTURE_PINCH_END ? "end"
+                                                                          : "update";
+        snprintf(buffer, buffer_len, "%s", phase);
+    } else if (strcmp(symbol, "scale") == 0 || (pinch && strcmp(symbol, "value") == 0)) {
+        snprintf(buffer, buffer_len, "%.3f", (double)gesture->scale);
+    } else if (strcmp(symbol, "direction") == 0 || strcmp(symbol, "value") == 0) {
+        snprintf(buffer, buffer_len, "%s", kc_touch_gesture_dir_name(gesture->direction));
+    } else if (strcmp(symbol, "x") == 0) {
+        snprintf(buffer, buffer_len, "%" PRId32, gesture->x);
+    } else if (strcmp(symbol, "y") == 0) {
+        snprintf(buffer, buffer_len, "%" PRId32, gesture->y);
+    } else if (strcmp(symbol, "dx") == 0) {
+        snprintf(buffer, buffer_len, "%" PRId32, gesture->dx);
+    } else if (strcmp(symbol, "dy") == 0) {
+        snprintf(buffer, buffer_len, "%" PRId32, gesture->dy);
+    } else {
+        return NULL;
+    }
+    return buffer;
+}
+
 const char *yui_event_symbol_resolver(const char *symbol, void *ctx, char *buffer, size_t buffer_len)
 {
     if (!symbol) {
@@ -1207,6 +1446,12 @@ const char *yui_event_symbol_resolver(const char *symbol, void *ctx, char *buffe
         return buffer;
     }
     yui_event_resolver_ctx_t *resolver_ctx = (yui_event_resolver_ctx_t *)ctx;
+    if (resolver_ctx && resolver_ctx->gesture) {
+        const char *gesture_value = yui_event_resolve_gesture(resolver_ctx->gesture, symbol, buffer, buffer_len);
+        if (gesture_value) {
+            return gesture_value;
+        }
+    }
     if (strcmp(symbol, "value") == 0) {
         return yui_event_resolve_value(resolver_ctx, buffer, buffer_len);
     }
@@ -1378,6 +1623,9 @@ static void yui_widget_runtime_dispose(yui_widget_runtime_t *runtime)
         return;
     }
     runtime->disposed = true;
+    if (s_pinch_target == runtime) {
+        s_pinch_target = NULL;
+    }
     runtime->event_target = NULL;
     runtime->text_target = NULL;
     runtime->value_target = NULL;
@@ -1392,14 +1640,8 @@ static void yui_widget_runtime_dispose(yui_widget_runtime_t *runtime)
         runtime->watch_handles = NULL;
         runtime->watch_count = 0U;
     }
-    if (runtime->bindings) {
-        for (size_t i = 0; i < runtime->binding_count; ++i) {
-            free(runtime->bindings[i]);
-        }
-        free(runtime->bindings);
-        runtime->bindings = NULL;
-        runtime->binding_count = 0U;
-    }
+    free(runtime->watch_keys);
+    runtime->watch_keys = NULL;
     for (size_t i = 0; i < YUI_WIDGET_EVENT_COUNT; ++i) {
         yui_action_list_free(&runtime->events.lists[i]);
     }
@@ -1407,14 +1649,20 @@ static void yui_widget_runtime_dispose(yui_widget_runtime_t *runtime)
         yui_scope_release(runtime->scope);
         runtime->scope = NULL;
     }
-    free(runtime->text_template);
+    yui_template_free(runtime->text_template);
     runtime->text_template = NULL;
-    free(runtime->value_template);
+    for (size_t i = 0; i < runtime->localized_count; ++i) {
+        yui_template_free(runtime->localized[i].key_template);
+    }
+    free(runtime->localized);
+    runtime->localized = NULL;
+    runtime->localized_count = 0U;
+    yui_template_free(runtime->value_template);
     runtime->value_template = NULL;
-    free(runtime->visible_expr);
-    runtime->visible_expr = NULL;
-    free(runtime->enabled_expr);
-    runtime->enabled_expr = NULL;
+    yui_expr_program_free(runtime->visible_program);
+    runtime->visible_program = NULL;
+    yui_expr_program_free(runtime->enabled_program);
+    runtime->enabled_program = NULL;
 }
 
 static void yui_widget_event_cb(lv_event_t *event)
@@ -1470,6 +1718,7 @@ static yui_widget_runtime_t *yui_widget_runtime_create(lv_obj_t *event_target, y
     }
     runtime->event_target = event_target;
     runtime->text_target = event_target;
+    runtime->text_handle = YUI_TRANSLATION_HANDLE_INVALID;
     runtime->scope = scope;
     if (scope) {
         yui_scope_acquire(scope);
@@ -1478,6 +1727,86 @@ static yui_widget_runtime_t *yui_widget_runtime_create(lv_obj_t *event_target, y
     return runtime;
 }
 
+static yui_widget_runtime_t *yui_widget_runtime_of(lv_obj_t *obj)
+{
+    uint32_t count = lv_obj_get_event_count(obj);
+    for (uint32_t i = 0; i < count; ++i) {
+        lv_event_dsc_t *dsc = lv_obj_get_event_dsc(obj, i);
+        if (dsc && lv_event_dsc_get_cb(dsc) == yui_widget_event_cb) {
+            return (yui_widget_runtime_t *)lv_event_dsc_get_user_data(dsc);
+        }
+    }
+    return NULL;
+}
+
+static void yui_gesture_execute(yui_widget_runtime_t *runtime, yui_widget_event_type_t type,
+                                const kc_touch_gesture_t *gesture)
+{
+    yui_event_resolver_ctx_t resolver_ctx = {
+        .scope = runtime->scope,
+        .gesture = gesture,
+    };
+    yui_action_eval_ctx_t eval_ctx = {
+        .resolver = yui_event_symbol_resolver,
+        .resolver_ctx = &resolver_ctx,
+    };
+    esp_err_t err = yui_action_list_execute(&runtime->events.lists[type], &eval_ctx);
+    if (err != ESP_OK) {
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_ACTION, "Gesture action failed (%s)", esp_err_to_name(err));
+    }
+}
+
+/* Delivers a recognized gesture to the innermost widget under it that handles that gesture.
+ * A pinch is hit-tested once, at PINCH_BEGIN. */
+static void yui_gesture_cb(const kc_touch_gesture_t *gesture, void *ctx)
+{
+    (void)ctx;
+    yui_widget_event_type_t type;
+    switch (gesture->type) {
+    case KC_TOUCH_GESTURE_LONG_PRESS:
+        type = YUI_WIDGET_EVENT_LONG_PRESS;
+        break;
+    case KC_TOUCH_GESTURE_SWIPE:
+        type = YUI_WIDGET_EVENT_SWIPE;
+        break;
+    default:
+        type = YUI_WIDGET_EVENT_PINCH;
+        break;
+    }
+    if (gesture->type == KC_TOUCH_GESTURE_PINCH_UPDATE || gesture->type == KC_TOUCH_GESTURE_PINCH_END) {
+        yui_widget_runtime_t *target = s_pinch_target;
+        if (gesture->type == KC_TOUCH_GESTURE_PINCH_END) {
+            s_pinch_target = NULL;
+        }
+        if (target && !target->disposed) {
+            yui_gesture_execute(target, type, gesture);
+        }
+        return;
+    }
+    if (gesture->type == KC_TOUCH_GESTURE_PINCH_BEGIN) {
+        s_pinch_target = NULL;
+    }
+    lv_point_t point = {
+        .x = gesture->x,
+        .y = gesture->y,
+    };
+    lv_obj_t *hit = lv_indev_search_obj(lv_layer_top(), &point);
+    if (!hit) {
+        hit = lv_indev_search_obj(lv_screen_active(), &point);
+    }
+    for (lv_obj_t *obj = hit; obj; obj = lv_obj_get_parent(obj)) {
+        yui_widget_runtime_t *runtime = yui_widget_runtime_of(obj);
+        if (!runtime || runtime->disposed || runtime->events.lists[type].count == 0U) {
+            continue;
+        }
+        if (gesture->type == KC_TOUCH_GESTURE_PINCH_BEGIN) {
+            s_pinch_target = runtime;
+        }
+        yui_gesture_execute(runtime, type, gesture);
+        return;
+    }
+}
+
 static void yui_format_text(const char *tmpl, yui_component_scope_t *scope, char *out, size_t out_len)
 {
     if (!tmpl || !out || out_len == 0U) {
@@ -1515,6 +1844,140 @@ static void yui_format_text(const char *tmpl, yui_component_scope_t *scope, char
     out[pos] = '\0';
 }
 
+static void yui_template_free(yui_compiled_template_t *tmpl)
+{
+    if (!tmpl) {
+        return;
+    }
+    for (size_t i = 0; i < tmpl->segment_count; ++i) {
+        free(tmpl->segments[i].literal);
+        yui_expr_program_free(tmpl->segments[i].program);
+    }
+    free(tmpl->segments);
+    free(tmpl);
+}
+
+static esp_err_t yui_template_append_segment(yui_compiled_template_t *tmpl, const char *literal, size_t literal_len, yui_expr_program_t *program)
+{
+    yui_template_segment_t *next = (yui_template_segment_t *)realloc(tmpl->segments, (tmpl->segment_count + 1U) * sizeof(yui_template_segment_t));
+    if (!next) {
+        return ESP_ERR_NO_MEM;
+    }
+    tmpl->segments = next;
+    char *copy = (char *)malloc(literal_len + 1U);
+    if (!copy) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(copy, literal, literal_len);
+    copy[literal_len] = '\0';
+    tmpl->segments[tmpl->segment_count].literal = copy;
+    tmpl->segments[tmpl->segment_count].program = program;
+    tmpl->segment_count++;
+    return ESP_OK;
+}
+
+/* Splits a "{{expr}}" template into literal runs and compiled expressions so
+ * binding refreshes never re-tokenize. Mirrors yui_format_text: an unterminated
+ * "{{" ends the template and an expression that fails to compile renders empty. */
+static esp_err_t yui_template_compile(const char *text, yui_compiled_template_t **out_tmpl)
+{
+    if (!text || !out_tmpl) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_tmpl = NULL;
+    yui_compiled_template_t *tmpl = (yui_compiled_template_t *)calloc(1, sizeof(yui_compiled_template_t));
+    if (!tmpl) {
+        return ESP_ERR_NO_MEM;
+    }
+    const char *cursor = text;
+    esp_err_t err = ESP_OK;
+    while (err == ESP_OK) {
+        const char *open = strstr(cursor, "{{");
+        const char *close = open ? strstr(open + 2, "}}") : NULL;
+        if (!open || !close) {
+            size_t literal_len = open ? (size_t)(open - cursor) : strlen(cursor);
+            if (literal_len > 0U) {
+                err = yui_template_append_segment(tmpl, cursor, literal_len, NULL);
+            }
+            break;
+        }
+        size_t expr_len = (size_t)(close - (open + 2));
+        char *expr = (char *)malloc(expr_len + 1U);
+        if (!expr) {
+            err = ESP_ERR_NO_MEM;
+            break;
+        }
+        memcpy(expr, open + 2, expr_len);
+        expr[expr_len] = '\0';
+        yui_expr_program_t *program = NULL;
+        esp_err_t compile_err = yui_expr_compile(expr, &program);
+        free(expr);
+        if (compile_err == ESP_ERR_NO_MEM) {
+            err = compile_err;
+            break;
+        }
+        err = yui_template_append_segment(tmpl, cursor, (size_t)(open - cursor), program);
+        if (err != ESP_OK) {
+            yui_expr_program_free(program);
+            break;
+        }
+        cursor = close + 2;
+    }
+    if (err != ESP_OK) {
+        yui_template_free(tmpl);
+        return err;
+    }
+    *out_tmpl = tmpl;
+    return ESP_OK;
+}
+
+static void yui_template_render(const yui_compiled_template_t *tmpl, yui_component_scope_t *scope, char *out, size_t out_len)
+{
+    if (!tmpl || !out || out_len == 0U) {
+        return;
+    }
+    yui_expression_ctx_t ctx = {
+        .scope = scope,
+    };
+    size_t pos = 0;
+    out[0] = '\0';
+    for (size_t i = 0; i < tmpl->segment_count && pos + 1U < out_len; ++i) {
+        const yui_template_segment_t *segment = &tmpl->segments[i];
+        for (const char *lit = segment->literal; *lit && pos + 1U < out_len; ++lit) {
+            out[pos++] = *lit;
+        }
+        if (!segment->program || pos + 1U >= out_len) {
+            continue;
+        }
+        if (yui_expr_run_to_string(segment->program, yui_expression_symbol_resolver, &ctx, out + pos, out_len - pos) == ESP_OK) {
+            pos += strlen(out + pos);
+        }
+    }
+    out[pos] = '\0';
+}
+
+/* A template that is a single numeric expression ("{{ sensor.level }}") is evaluated
+ * straight to an integer for slider/bar/arc bindings, skipping the text round-trip.
+ * The result matches rendering (3 decimals) followed by atoi(). */
+static bool yui_template_eval_int(const yui_compiled_template_t *tmpl, yui_component_scope_t *scope, int32_t *out)
+{
+    if (!tmpl || !out || tmpl->segment_count != 1U || !tmpl->segments[0].program || tmpl->segments[0].literal[0] != '\0') {
+        return false;
+    }
+    yui_expression_ctx_t ctx = {
+        .scope = scope,
+    };
+    yui_expr_value_t value = {0};
+    bool ok = false;
+    if (yui_expr_run(tmpl->segments[0].program, yui_expression_symbol_resolver, &ctx, &value) == ESP_OK &&
+        value.type == YUI_EXPR_VALUE_NUMBER && fabs(value.number) < 2147483647.0) {
+        *out = (int32_t)(round(value.number * 1000.0) / 1000.0);
+        ok = true;
+    }
+    yui_expr_value_reset(&value);
+    return ok;
+}
+
 static bool yui_format_node_text(const yml_node_t *node, yui_component_scope_t *scope, char *out, size_t out_len)
 {
     if (!out || out_len == 0U) {
@@ -1758,11 +2221,14 @@ static void yui_widget_refresh_text(yui_widget_runtime_t *runtime)
         return;
     }
     char buffer[YUI_TEXT_BUFFER_MAX];
-    yui_format_text(runtime->text_template, runtime->scope, buffer, sizeof(buffer));
-    const char *final_text = buffer;
-    if (runtime->text_template_is_translation_key) {
-        const char *translated = yui_translate_key(buffer);
-        final_text = translated ? translated : "";
+    const char *final_text = runtime->text_template_is_translation_key ? yui_translate_handle(runtime->text_handle) : NULL;
+    if (!final_text) {
+        yui_template_render(runtime->text_template, runtime->scope, buffer, sizeof(buffer));
+        final_text = buffer;
+        if (runtime->text_template_is_translation_key) {
+            const char *translated = yui_translate_key(buffer);
+            final_text = translated ? translated : "";
+        }
     }
     lv_label_set_text(runtime->text_target, final_text);
     lv_obj_mark_layout_as_dirty(runtime->text_target);
@@ -1774,6 +2240,23 @@ static void yui_widget_refresh_text(yui_widget_runtime_t *runtime)
     }
 }
 
+static void yui_widget_refresh_localized(yui_widget_runtime_t *runtime)
+{
+    if (!runtime || runtime->disposed) {
+        return;
+    }
+    for (size_t i = 0; i < runtime->localized_count; ++i) {
+        yui_localized_text_t *entry = &runtime->localized[i];
+        const char *translated = yui_translate_handle(entry->handle);
+        if (!translated) {
+            char key[YUI_TEXT_BUFFER_MAX];
+            yui_template_render(entry->key_template, runtime->scope, key, sizeof(key));
+            translated = yui_translate_key(key);
+        }
+        entry->set(entry->target, entry->index, translated ? translated : "");
+    }
+}
+
 static bool yui_dropdown_select_value(lv_obj_t *dropdown, const char *value)
 {
 #if LV_USE_DROPDOWN
@@ -1825,8 +2308,15 @@ static void yui_widget_refresh_value(yui_widget_runtime_t *runtime)
     if (!runtime || runtime->disposed || !runtime->value_target || !runtime->value_template || runtime->value_kind == YUI_VALUE_BIND_NONE) {
         return;
     }
+    bool numeric_kind = runtime->value_kind == YUI_VALUE_BIND_SLIDER || runtime->value_kind == YUI_VALUE_BIND_BAR ||
+                        runtime->value_kind == YUI_VALUE_BIND_ARC;
     char buffer[YUI_TEXT_BUFFER_MAX];
-    yui_format_text(runtime->value_template, runtime->scope, buffer, sizeof(buffer));
+    buffer[0] = '\0';
+    int32_t number = 0;
+    if (!numeric_kind || !yui_template_eval_int(runtime->value_template, runtime->scope, &number)) {
+        yui_template_render(runtime->value_template, runtime->scope, buffer, sizeof(buffer));
+        number = atoi(buffer);
+    }
 
     switch (runtime->value_kind) {
         case YUI_VALUE_BIND_TEXTAREA:
@@ -1846,17 +2336,17 @@ static void yui_widget_refresh_value(yui_widget_runtime_t *runtime)
         }
         case YUI_VALUE_BIND_SLIDER:
 #if LV_USE_SLIDER
-            lv_slider_set_value(runtime->value_target, atoi(buffer), LV_ANIM_OFF);
+            lv_slider_set_value(runtime->value_target, number, LV_ANIM_OFF);
 #endif
             break;
         case YUI_VALUE_BIND_BAR:
 #if LV_USE_BAR
-            lv_bar_set_value(runtime->value_target, atoi(buffer), LV_ANIM_OFF);
+            lv_bar_set_value(runtime->value_target, number, LV_ANIM_OFF);
 #endif
             break;
         case YUI_VALUE_BIND_ARC:
 #if LV_USE_ARC
-            lv_arc_set_value(runtime->value_target, atoi(buffer));
+            lv_arc_set_value(runtime->value_target, number);
 #endif
             break;
         case YUI_VALUE_BIND_DROPDOWN:
@@ -1957,9 +2447,9 @@ static void yui_widget_refresh_conditions(yui_widget_runtime_t *runtime)
     yui_expression_ctx_t ctx = {
         .scope = runtime->scope,
     };
-    if (runtime->visible_expr) {
+    if (runtime->visible_program) {
         yui_expr_value_t value = {0};
-        if (yui_expr_eval(runtime->visible_expr, yui_expression_symbol_resolver, &ctx, &value) == ESP_OK) {
+        if (yui_expr_run(runtime->visible_program, yui_expression_symbol_resolver, &ctx, &value) == ESP_OK) {
             bool visible = yui_expr_value_is_truthy(&value);
             if (!runtime->has_visible_state || runtime->last_visible != visible) {
                 runtime->last_visible = visible;
@@ -1973,9 +2463,9 @@ static void yui_widget_refresh_conditions(yui_widget_runtime_t *runtime)
         }
         yui_expr_value_reset(&value);
     }
-    if (runtime->enabled_expr) {
+    if (runtime->enabled_program) {
         yui_expr_value_t value = {0};
-        if (yui_expr_eval(runtime->enabled_expr, yui_expression_symbol_resolver, &ctx, &value) == ESP_OK) {
+        if (yui_expr_run(runtime->enabled_program, yui_expression_symbol_resolver, &ctx, &value) == ESP_OK) {
             bool enabled = yui_expr_value_is_truthy(&value);
             if (!runtime->has_enabled_state || runtime->last_enabled != enabled) {
                 runtime->last_enabled = enabled;
@@ -1999,9 +2489,61 @@ static void yui_widget_refresh_binding_async_cb(void *user_data)
         return;
     }
     runtime->binding_refresh_pending = false;
+    int64_t start = yamui_prof_enabled() ? esp_timer_get_time() : 0;
     yui_widget_refresh_text(runtime);
+    yui_widget_refresh_localized(runtime);
     yui_widget_refresh_value(runtime);
     yui_widget_schedule_condition_refresh(runtime);
+    if (start) {
+        yamui_prof_record(YAMUI_PROF_BINDING_REFRESH, (uint32_t)(esp_timer_get_time() - start));
+    }
+}
+
+/* Widgets on a cached, off-screen tree skip refreshes until the screen is shown again. */
+static bool yui_widget_defer_refresh(yui_widget_runtime_t *runtime)
+{
+    if (runtime->binding_stale) {
+        return true;
+    }
+    if (!runtime->event_target || lv_obj_get_screen(runtime->event_target) == lv_scr_act()) {
+        return false;
+    }
+    if (s_stale_runtime_count == s_stale_runtime_capacity) {
+        size_t new_capacity = s_stale_runtime_capacity == 0U ? 16U : s_stale_runtime_capacity * 2U;
+        yui_widget_runtime_t **next = (yui_widget_runtime_t **)realloc(s_stale_runtimes, new_capacity * sizeof(yui_widget_runtime_t *));
+        if (!next) {
+            return false;
+        }
+        s_stale_runtimes = next;
+        s_stale_runtime_capacity = new_capacity;
+    }
+    runtime->binding_stale = true;
+    s_stale_runtimes[s_stale_runtime_count++] = runtime;
+    yui_build_invalidate(lv_obj_get_screen(runtime->event_target));
+    return true;
+}
+
+/* Brings every deferred widget on @p screen up to date; runtimes are never freed, only disposed. */
+static void yui_screen_resume_bindings(lv_obj_t *screen)
+{
+    size_t kept = 0U;
+    for (size_t i = 0; i < s_stale_runtime_count; ++i) {
+        yui_widget_runtime_t *runtime = s_stale_runtimes[i];
+        if (runtime->disposed) {
+            runtime->binding_stale = false;
+            continue;
+        }
+        if (lv_obj_get_screen(runtime->event_target) != screen) {
+            s_stale_runtimes[kept++] = runtime;
+            continue;
+        }
+        runtime->binding_stale = false;
+        yui_widget_refresh_text(runtime);
+        yui_widget_refresh_localized(runtime);
+        yui_widget_refresh_value(runtime);
+        yui_widget_refresh_conditions(runtime);
+    }
+    s_stale_runtime_count = kept;
 }
 
 static void yui_widget_state_cb(const char *key, const char *value, void *user_ctx)
@@ -2012,86 +2554,95 @@ static void yui_widget_state_cb(const char *key, const char *value, void *user_c
     if (!runtime || runtime->disposed) {
         return;
     }
-    if (runtime->binding_refresh_pending) {
+    if (runtime->binding_refresh_pending || yui_widget_defer_refresh(runtime)) {
         return;
     }
     runtime->binding_refresh_pending = true;
     if (lv_async_call(yui_widget_refresh_binding_async_cb, runtime) != LV_RESULT_OK) {
         runtime->binding_refresh_pending = false;
         yui_widget_refresh_text(runtime);
+        yui_widget_refresh_localized(runtime);
         yui_widget_refresh_value(runtime);
         yui_widget_schedule_condition_refresh(runtime);
     }
 }
 
-static bool yui_is_valid_token(const char *token)
+typedef struct {
+    char ***out_tokens;
+    size_t *out_count;
+} yui_expr_binding_ctx_t;
+
+static void yui_collect_expr_identifier_cb(const char *identifier, void *ctx)
 {
-    if (!token || token[0] == '\0') {
-        return false;
+    if (!identifier || !ctx) {
+        return;
     }
-    for (const char *cursor = token; *cursor; ++cursor) {
-        char ch = *cursor;
-        if (!(isalnum((unsigned char)ch) || ch == '_' || ch == '-' || ch == '.')) {
-            return false;
+    yui_expr_binding_ctx_t *binding_ctx = (yui_expr_binding_ctx_t *)ctx;
+    for (size_t i = 0; i < *binding_ctx->out_count; ++i) {
+        if (strcmp((*binding_ctx->out_tokens)[i], identifier) == 0) {
+            return;
         }
     }
-    return true;
-}
-
-static esp_err_t yui_collect_bindings_from_text(const char *text, char ***out_tokens, size_t *out_count)
-{
-    if (!out_tokens || !out_count) {
-        return ESP_ERR_INVALID_ARG;
+    char *copy = yui_strdup_local(identifier);
+    if (!copy) {
+        return;
     }
-    *out_tokens = NULL;
+    char **next = (char **)realloc(*binding_ctx->out_tokens, (*binding_ctx->out_count + 1U) * sizeof(char *));
+    if (!next) {
+        free(copy);
+        return;
+    }
+    *binding_ctx->out_tokens = next;
+    (*binding_ctx->out_tokens)[(*binding_ctx->out_count)++] = copy;
+}
+
+static void yui_free_tokens(char **tokens, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        free(tokens[i]);
+    }
+    free(tokens);
+}
+
+static void yui_template_collect_identifiers(const yui_compiled_template_t *tmpl, yui_expr_binding_ctx_t *ctx)
+{
+    if (!tmpl) {
+        return;
+    }
+    for (size_t i = 0; i < tmpl->segment_count; ++i) {
+        if (tmpl->segments[i].program) {
+            (void)yui_expr_program_collect_identifiers(tmpl->segments[i].program, yui_collect_expr_identifier_cb, ctx);
+        }
+    }
+}
+
+/* Returns every identifier referenced by the template's expressions, not just bare
+ * "{{key}}" tokens, so dependencies of computed bindings are tracked as well. */
+static esp_err_t yui_collect_bindings_from_text(const char *text, char ***out_tokens, size_t *out_count)
+{
+    if (!out_tokens || !out_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_tokens = NULL;
     *out_count = 0;
-    if (!text) {
+    if (!text || !strstr(text, "{{")) {
         return ESP_OK;
     }
-    const char *cursor = text;
-    while (true) {
-        const char *open = strstr(cursor, "{{");
-        if (!open) {
-            break;
-        }
-        const char *close = strstr(open + 2, "}}");
-        if (!close) {
-            break;
-        }
-        const char *token_start = open + 2;
-        size_t len = (size_t)(close - token_start);
-        while (len > 0U && isspace((unsigned char)*token_start)) {
-            ++token_start;
-            --len;
-        }
-        while (len > 0U && isspace((unsigned char)token_start[len - 1U])) {
-            --len;
-        }
-        if (len > 0U) {
-            char *token = (char *)malloc(len + 1U);
-            if (!token) {
-                return ESP_ERR_NO_MEM;
-            }
-            memcpy(token, token_start, len);
-            token[len] = '\0';
-            if (yui_is_valid_token(token)) {
-                char **next = (char **)realloc(*out_tokens, (*out_count + 1U) * sizeof(char *));
-                if (!next) {
-                    free(token);
-                    return ESP_ERR_NO_MEM;
-                }
-                *out_tokens = next;
-                (*out_tokens)[(*out_count)++] = token;
-            } else {
-                free(token);
-            }
-        }
-        cursor = close + 2;
+    yui_compiled_template_t *tmpl = NULL;
+    esp_err_t err = yui_template_compile(text, &tmpl);
+    if (err != ESP_OK) {
+        return err;
     }
+    yui_expr_binding_ctx_t ctx = {
+        .out_tokens = out_tokens,
+        .out_count = out_count,
+    };
+    yui_template_collect_identifiers(tmpl, &ctx);
+    yui_template_free(tmpl);
     return ESP_OK;
 }
 
-static esp_err_t yui_widget_append_watch(yui_widget_runtime_t *runtime, yui_state_watch_handle_t handle)
+static esp_err_t yui_widget_append_watch(yui_widget_runtime_t *runtime, yui_state_watch_handle_t handle, yui_state_key_t key)
 {
     if (!runtime || handle == 0U) {
         return ESP_OK;
@@ -2101,7 +2652,14 @@ static esp_err_t yui_widget_append_watch(yui_widget_runtime_t *runtime, yui_stat
         return ESP_ERR_NO_MEM;
     }
     runtime->watch_handles = next;
-    runtime->watch_handles[runtime->watch_count++] = handle;
+    yui_state_key_t *next_keys = (yui_state_key_t *)realloc(runtime->watch_keys, (runtime->watch_count + 1U) * sizeof(yui_state_key_t));
+    if (!next_keys) {
+        return ESP_ERR_NO_MEM;
+    }
+    runtime->watch_keys = next_keys;
+    runtime->watch_handles[runtime->watch_count] = handle;
+    runtime->watch_keys[runtime->watch_count] = key;
+    runtime->watch_count++;
     return ESP_OK;
 }
 
@@ -2114,12 +2672,22 @@ static esp_err_t yui_widget_watch_state(yui_widget_runtime_t *runtime, const cha
     if (!watch_key || watch_key[0] == '\0') {
         return ESP_OK;
     }
+    yui_state_key_t state_key = YUI_STATE_KEY_INVALID;
+    esp_err_t err = yui_state_key_resolve(watch_key, &state_key);
+    if (err != ESP_OK) {
+        return err;
+    }
+    for (size_t i = 0; i < runtime->watch_count; ++i) {
+        if (runtime->watch_keys[i] == state_key) {
+            return ESP_OK;
+        }
+    }
     yui_state_watch_handle_t handle = 0;
-    esp_err_t err = yui_state_watch(watch_key, yui_widget_state_cb, runtime, &handle);
+    err = yui_state_watch_key(state_key, yui_widget_state_cb, runtime, &handle);
     if (err != ESP_OK || handle == 0U) {
         return err;
     }
-    esp_err_t append_err = yui_widget_append_watch(runtime, handle);
+    esp_err_t append_err = yui_widget_append_watch(runtime, handle, state_key);
     if (append_err != ESP_OK) {
         yui_state_unwatch(handle);
         return append_err;
@@ -2127,100 +2695,114 @@ static esp_err_t yui_widget_watch_state(yui_widget_runtime_t *runtime, const cha
     return ESP_OK;
 }
 
-static esp_err_t yui_widget_bind_text(yui_widget_runtime_t *runtime, const char *text, lv_obj_t *target, bool is_translation_key)
+/* Subscribes the widget to exactly the state keys its expressions read. Component
+ * props are expanded to the state keys their own templates depend on. */
+static esp_err_t yui_widget_watch_identifiers(yui_widget_runtime_t *runtime, char **tokens, size_t token_count)
 {
-    if (!runtime || !text || !target) {
-        return ESP_OK;
-    }
-    runtime->text_target = target;
-    runtime->text_template_is_translation_key = is_translation_key;
-    runtime->text_template = yui_strdup_local(text);
-    if (!runtime->text_template) {
-        return ESP_ERR_NO_MEM;
-    }
-    esp_err_t err = yui_collect_bindings_from_text(text, &runtime->bindings, &runtime->binding_count);
-    if (err != ESP_OK) {
-        return err;
-    }
-    for (size_t i = 0; i < runtime->binding_count; ++i) {
-        const char *token = runtime->bindings[i];
+    for (size_t i = 0; i < token_count; ++i) {
+        const char *token = tokens[i];
         if (!token) {
             continue;
         }
-        bool handled = false;
-        if (runtime->scope) {
-            yui_component_prop_t *prop = yui_scope_find_prop(runtime->scope, token);
-            if (prop) {
-                handled = true;
-                for (size_t dep = 0; dep < prop->dependency_count; ++dep) {
-                    err = yui_widget_watch_state(runtime, prop->dependencies[dep]);
-                    if (err != ESP_OK) {
-                        return err;
-                    }
-                }
+        esp_err_t err = ESP_OK;
+        yui_component_prop_t *prop = runtime->scope ? yui_scope_find_prop(runtime->scope, token) : NULL;
+        if (prop) {
+            for (size_t dep = 0; dep < prop->dependency_count && err == ESP_OK; ++dep) {
+                err = yui_widget_watch_state(runtime, prop->dependencies[dep]);
             }
-        }
-        if (!handled) {
+        } else {
             err = yui_widget_watch_state(runtime, token);
-            if (err != ESP_OK) {
-                return err;
-            }
         }
-    }
-    if (runtime->binding_count == 0U) {
-        err = yui_widget_watch_all_state(runtime);
         if (err != ESP_OK) {
             return err;
         }
     }
-    yui_widget_refresh_text(runtime);
     return ESP_OK;
 }
 
-typedef struct {
-    char ***out_tokens;
-    size_t *out_count;
-} yui_expr_binding_ctx_t;
+static esp_err_t yui_widget_watch_template(yui_widget_runtime_t *runtime, const yui_compiled_template_t *tmpl)
+{
+    char **tokens = NULL;
+    size_t token_count = 0U;
+    yui_expr_binding_ctx_t ctx = {
+        .out_tokens = &tokens,
+        .out_count = &token_count,
+    };
+    yui_template_collect_identifiers(tmpl, &ctx);
+    esp_err_t err = yui_widget_watch_identifiers(runtime, tokens, token_count);
+    yui_free_tokens(tokens, token_count);
+    return err;
+}
 
-static void yui_collect_expr_identifier_cb(const char *identifier, void *ctx)
+/* Keys without expressions are resolved to a handle once; templated keys are looked up per refresh. */
+static yui_translation_handle_t yui_template_translation_handle(const yui_compiled_template_t *tmpl)
 {
-    if (!identifier || !ctx) {
-        return;
+    if (!s_loaded_schema || !tmpl || tmpl->segment_count != 1U || tmpl->segments[0].program) {
+        return YUI_TRANSLATION_HANDLE_INVALID;
     }
-    yui_expr_binding_ctx_t *binding_ctx = (yui_expr_binding_ctx_t *)ctx;
-    for (size_t i = 0; i < *binding_ctx->out_count; ++i) {
-        if (strcmp((*binding_ctx->out_tokens)[i], identifier) == 0) {
-            return;
-        }
+    return yui_schema_translation_handle(&s_loaded_schema->schema, tmpl->segments[0].literal);
+}
+
+static esp_err_t yui_widget_bind_text(yui_widget_runtime_t *runtime, const char *text, lv_obj_t *target, bool is_translation_key)
+{
+    if (!runtime || !text || !target) {
+        return ESP_OK;
     }
-    char *copy = yui_strdup_local(identifier);
-    if (!copy) {
-        return;
+    runtime->text_target = target;
+    runtime->text_template_is_translation_key = is_translation_key;
+    esp_err_t err = yui_template_compile(text, &runtime->text_template);
+    if (err != ESP_OK) {
+        return err;
     }
-    char **next = (char **)realloc(*binding_ctx->out_tokens, (*binding_ctx->out_count + 1U) * sizeof(char *));
-    if (!next) {
-        free(copy);
-        return;
+    runtime->text_handle = is_translation_key ? yui_template_translation_handle(runtime->text_template) : YUI_TRANSLATION_HANDLE_INVALID;
+    err = yui_widget_watch_template(runtime, runtime->text_template);
+    if (err == ESP_OK && is_translation_key) {
+        err = yui_widget_watch_state(runtime, "ui.locale");
     }
-    *binding_ctx->out_tokens = next;
-    (*binding_ctx->out_tokens)[(*binding_ctx->out_count)++] = copy;
+    if (err != ESP_OK) {
+        return err;
+    }
+    yui_widget_refresh_text(runtime);
+    return ESP_OK;
 }
 
-static esp_err_t yui_collect_bindings_from_expr(const char *expr, char ***out_tokens, size_t *out_count)
+/* Binds @p target to the translation key in @p node's @p key_field so locale switches
+ * re-translate it in place. Returns false when the node has no such key. */
+static bool yui_widget_bind_localized(yui_widget_runtime_t *runtime,
+                                      const yml_node_t *node,
+                                      const char *key_field,
+                                      lv_obj_t *target,
+                                      uint32_t index,
+                                      yui_text_setter_t set)
 {
-    if (!out_tokens || !out_count) {
-        return ESP_ERR_INVALID_ARG;
+    const char *raw_key = yui_node_scalar(node, key_field);
+    if (!runtime || runtime->disposed || !target || !set || !raw_key || raw_key[0] == '\0') {
+        return false;
     }
-    *out_tokens = NULL;
-    *out_count = 0U;
-    if (!expr || expr[0] == '\0') {
-        return ESP_OK;
+    yui_localized_text_t *next = (yui_localized_text_t *)realloc(runtime->localized, (runtime->localized_count + 1U) * sizeof(yui_localized_text_t));
+    if (!next) {
+        return false;
     }
-    yui_expr_binding_ctx_t ctx = {
-        .out_tokens = out_tokens,
-        .out_count = out_count,
-    };
-    return yui_expr_collect_identifiers(expr, yui_collect_expr_identifier_cb, &ctx);
+    runtime->localized = next;
+    yui_localized_text_t *entry = &runtime->localized[runtime->localized_count];
+    memset(entry, 0, sizeof(*entry));
+    if (yui_template_compile(raw_key, &entry->key_template) != ESP_OK) {
+        return false;
+    }
+    entry->target = target;
+    entry->index = index;
+    entry->set = set;
+    entry->handle = yui_template_translation_handle(entry->key_template);
+    runtime->localized_count++;
+    (void)yui_widget_watch_template(runtime, entry->key_template);
+    (void)yui_widget_watch_state(runtime, "ui.locale");
+    return true;
+}
+
+static void yui_set_label_text(lv_obj_t *target, uint32_t index, const char *text)
+{
+    (void)index;
+    lv_label_set_text(target, text);
 }
 
 static esp_err_t yui_widget_bind_value(yui_widget_runtime_t *runtime, const char *value_tmpl, lv_obj_t *target, yui_value_bind_kind_t kind)
@@ -2230,44 +2812,13 @@ static esp_err_t yui_widget_bind_value(yui_widget_runtime_t *runtime, const char
     }
     runtime->value_target = target;
     runtime->value_kind = kind;
-    runtime->value_template = yui_strdup_local(value_tmpl);
-    if (!runtime->value_template) {
-        return ESP_ERR_NO_MEM;
-    }
-    esp_err_t err = yui_collect_bindings_from_text(value_tmpl, &runtime->bindings, &runtime->binding_count);
+    esp_err_t err = yui_template_compile(value_tmpl, &runtime->value_template);
     if (err != ESP_OK) {
         return err;
     }
-    for (size_t i = 0; i < runtime->binding_count; ++i) {
-        const char *token = runtime->bindings[i];
-        if (!token) {
-            continue;
-        }
-        bool handled = false;
-        if (runtime->scope) {
-            yui_component_prop_t *prop = yui_scope_find_prop(runtime->scope, token);
-            if (prop) {
-                handled = true;
-                for (size_t dep = 0; dep < prop->dependency_count; ++dep) {
-                    err = yui_widget_watch_state(runtime, prop->dependencies[dep]);
-                    if (err != ESP_OK) {
-                        return err;
-                    }
-                }
-            }
-        }
-        if (!handled) {
-            err = yui_widget_watch_state(runtime, token);
-            if (err != ESP_OK) {
-                return err;
-            }
-        }
-    }
-    if (runtime->binding_count == 0U) {
-        err = yui_widget_watch_all_state(runtime);
-        if (err != ESP_OK) {
-            return err;
-        }
+    err = yui_widget_watch_template(runtime, runtime->value_template);
+    if (err != ESP_OK) {
+        return err;
     }
     yui_widget_refresh_value(runtime);
     return ESP_OK;
@@ -2284,81 +2835,38 @@ static esp_err_t yui_widget_bind_conditions(yui_widget_runtime_t *runtime, const
         return ESP_OK;
     }
     runtime->condition_target = target;
+    esp_err_t err = ESP_OK;
     if (visible_expr && visible_expr[0] != '\0') {
-        runtime->visible_expr = yui_strdup_local(visible_expr);
-        if (!runtime->visible_expr) {
-            return ESP_ERR_NO_MEM;
+        err = yui_expr_compile(visible_expr, &runtime->visible_program);
+        if (err == ESP_ERR_NO_MEM) {
+            return err;
         }
     }
     if (enabled_expr && enabled_expr[0] != '\0') {
-        runtime->enabled_expr = yui_strdup_local(enabled_expr);
-        if (!runtime->enabled_expr) {
-            return ESP_ERR_NO_MEM;
+        err = yui_expr_compile(enabled_expr, &runtime->enabled_program);
+        if (err == ESP_ERR_NO_MEM) {
+            return err;
         }
     }
+    if (!runtime->visible_program && !runtime->enabled_program) {
+        return err;
+    }
     char **tokens = NULL;
     size_t token_count = 0U;
-    esp_err_t err = ESP_OK;
-    if (runtime->visible_expr) {
-        err = yui_collect_bindings_from_expr(runtime->visible_expr, &tokens, &token_count);
-        if (err != ESP_OK) {
-            return err;
-        }
-    }
-    if (runtime->enabled_expr) {
-        char **enabled_tokens = NULL;
-        size_t enabled_count = 0U;
-        err = yui_collect_bindings_from_expr(runtime->enabled_expr, &enabled_tokens, &enabled_count);
-        if (err != ESP_OK) {
-            if (tokens) {
-                for (size_t i = 0; i < token_count; ++i) free(tokens[i]);
-                free(tokens);
-            }
-            return err;
-        }
-        for (size_t i = 0; i < enabled_count; ++i) {
-            bool exists = false;
-            for (size_t j = 0; j < token_count; ++j) {
-                if (strcmp(tokens[j], enabled_tokens[i]) == 0) {
-                    exists = true;
-                    break;
-                }
-            }
-            if (!exists) {
-                char **next = (char **)realloc(tokens, (token_count + 1U) * sizeof(char *));
-                if (!next) {
-                    err = ESP_ERR_NO_MEM;
-                    break;
-                }
-                tokens = next;
-                tokens[token_count++] = enabled_tokens[i];
-                enabled_tokens[i] = NULL;
-            }
-        }
-        for (size_t i = 0; i < enabled_count; ++i) {
-            free(enabled_tokens[i]);
-        }
-        free(enabled_tokens);
-        if (err != ESP_OK) {
-            for (size_t i = 0; i < token_count; ++i) free(tokens[i]);
-            free(tokens);
-            return err;
-        }
+    yui_expr_binding_ctx_t ctx = {
+        .out_tokens = &tokens,
+        .out_count = &token_count,
+    };
+    if (runtime->visible_program) {
+        (void)yui_expr_program_collect_identifiers(runtime->visible_program, yui_collect_expr_identifier_cb, &ctx);
     }
-    for (size_t i = 0; i < token_count; ++i) {
-        err = yui_widget_watch_state(runtime, tokens[i]);
-        free(tokens[i]);
-        if (err != ESP_OK) {
-            free(tokens);
-            return err;
-        }
+    if (runtime->enabled_program) {
+        (void)yui_expr_program_collect_identifiers(runtime->enabled_program, yui_collect_expr_identifier_cb, &ctx);
     }
-    free(tokens);
-    if (token_count == 0U) {
-        err = yui_widget_watch_all_state(runtime);
-        if (err != ESP_OK) {
-            return err;
-        }
+    err = yui_widget_watch_identifiers(runtime, tokens, token_count);
+    yui_free_tokens(tokens, token_count);
+    if (err != ESP_OK) {
+        return err;
     }
     yui_widget_schedule_condition_refresh(runtime);
     return ESP_OK;
@@ -2382,25 +2890,6 @@ static esp_err_t yui_widget_parse_events(const yml_node_t *node, yui_widget_runt
     return ESP_OK;
 }
 
-static esp_err_t yui_widget_watch_all_state(yui_widget_runtime_t *runtime)
-{
-    if (!runtime || runtime->watch_all_state) {
-        return ESP_OK;
-    }
-    yui_state_watch_handle_t handle = 0U;
-    esp_err_t err = yui_state_watch(NULL, yui_widget_state_cb, runtime, &handle);
-    if (err != ESP_OK || handle == 0U) {
-        return err;
-    }
-    esp_err_t append_err = yui_widget_append_watch(runtime, handle);
-    if (append_err != ESP_OK) {
-        yui_state_unwatch(handle);
-        return append_err;
-    }
-    runtime->watch_all_state = true;
-    return ESP_OK;
-}
-
 static const yml_node_t *yui_find_event_node(const yml_node_t *node, const char *yaml_key, const char *companion_key)
 {
     if (!node || !yaml_key) {
@@ -2448,98 +2937,260 @@ static lv_color_t yui_color_from_string(const char *hex, lv_color_t fallback)
     return lv_color_hex(value & 0xFFFFFFU);
 }
 
-static void yui_apply_style(lv_obj_t *obj, const yui_style_t *style)
+static void yui_style_compile(lv_style_t *dst, const yui_style_t *style)
 {
-    if (!obj || !style) {
+    lv_style_reset(dst);
+    if (!style) {
         return;
     }
     const lv_font_t *font = yui_font_pick(style->font_size, style->font_weight, style->text_font);
     if (font) {
-        lv_obj_set_style_text_font(obj, font, 0);
+        lv_style_set_text_font(dst, font);
     }
     if (style->background_color) {
-        lv_obj_set_style_bg_color(obj, yui_color_from_string(style->background_color, lv_color_hex(0x101018)), 0);
-        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_style_set_bg_color(dst, yui_color_from_string(style->background_color, lv_color_hex(0x101018)));
+        lv_style_set_bg_opa(dst, LV_OPA_COVER);
     }
     if (style->text_color) {
-        lv_obj_set_style_text_color(obj, yui_color_from_string(style->text_color, lv_color_hex(0xFFFFFF)), 0);
+        lv_style_set_text_color(dst, yui_color_from_string(style->text_color, lv_color_hex(0xFFFFFF)));
     }
     if (style->letter_spacing != 0) {
-        lv_obj_set_style_text_letter_space(obj, style->letter_spacing, 0);
+        lv_style_set_text_letter_space(dst, style->letter_spacing);
     }
     if (style->padding > 0) {
-        lv_obj_set_style_pad_all(obj, style->padding, 0);
+        lv_style_set_pad_all(dst, style->padding);
     }
     if (style->padding_x >= 0) {
-        lv_obj_set_style_pad_left(obj, style->padding_x, 0);
-        lv_obj_set_style_pad_right(obj, style->padding_x, 0);
+        lv_style_set_pad_left(dst, style->padding_x);
+        lv_style_set_pad_right(dst, style->padding_x);
     }
     if (style->padding_y >= 0) {
-        lv_obj_set_style_pad_top(obj, style->padding_y, 0);
-        lv_obj_set_style_pad_bottom(obj, style->padding_y, 0);
+        lv_style_set_pad_top(dst, style->padding_y);
+        lv_style_set_pad_bottom(dst, style->padding_y);
     }
     if (style->radius > 0) {
-        lv_obj_set_style_radius(obj, style->radius, 0);
+        lv_style_set_radius(dst, style->radius);
     }
 }
 
-static void yui_apply_layout(lv_obj_t *obj, const yml_node_t *layout_node, const char *default_type)
+static const char *yui_style_logical_name(const char *name)
 {
-    const char *type = layout_node ? yui_node_scalar(layout_node, "type") : NULL;
-    const char *mode = type ? type : default_type;
-    if (!mode || strcmp(mode, "column") == 0) {
-        lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_COLUMN);
-    } else if (strcmp(mode, "row") == 0) {
-        lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_ROW);
-    } else {
-        lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_COLUMN);
+    if (strncmp(name, "dark.", 5) == 0) {
+        return name + 5;
     }
-    int32_t gap = yui_node_i32(layout_node, "gap", 12);
-    lv_obj_set_style_pad_row(obj, gap, 0);
-    lv_obj_set_style_pad_column(obj, gap, 0);
-    const char *align = layout_node ? yui_node_scalar(layout_node, "align") : NULL;
-    const char *justify = layout_node ? yui_node_scalar(layout_node, "justify") : NULL;
-    lv_obj_set_flex_align(
-        obj,
-        yui_flex_align_from_string(justify, LV_FLEX_ALIGN_START),
-        yui_flex_align_from_string(align, LV_FLEX_ALIGN_START),
-        LV_FLEX_ALIGN_STRETCH);
+    if (strncmp(name, "light.", 6) == 0) {
+        return name + 6;
+    }
+    return name;
 }
 
-static bool yui_node_parse_size(const yml_node_t *node, const char *key, lv_coord_t *out_value)
+static yui_style_slot_t *yui_style_slot_find(const char *name)
 {
-    if (!node || !key || !out_value) {
-        return false;
+    for (size_t i = 0; i < s_style_slot_count; ++i) {
+        if (strcmp(s_style_slots[i]->name, name) == 0) {
+            return s_style_slots[i];
+        }
     }
-    const yml_node_t *child = yml_node_get_child(node, key);
-    if (!child) {
-        return false;
+    return NULL;
+}
+
+static yui_style_slot_t *yui_style_slot_ensure(const char *name)
+{
+    yui_style_slot_t *slot = yui_style_slot_find(name);
+    if (slot) {
+        return slot;
     }
-    const char *scalar = yml_node_get_scalar(child);
-    if (!scalar) {
-        return false;
+    if (s_style_slot_count == s_style_slot_capacity) {
+        size_t new_capacity = s_style_slot_capacity == 0U ? 16U : s_style_slot_capacity * 2U;
+        yui_style_slot_t **next = (yui_style_slot_t **)realloc(s_style_slots, new_capacity * sizeof(yui_style_slot_t *));
+        if (!next) {
+            return NULL;
+        }
+        s_style_slots = next;
+        s_style_slot_capacity = new_capacity;
     }
-    size_t len = strlen(scalar);
-    if (len > 1U && scalar[len - 1U] == '%') {
-        *out_value = LV_PCT(atoi(scalar));
-        return true;
+    slot = (yui_style_slot_t *)calloc(1, sizeof(yui_style_slot_t));
+    if (!slot) {
+        return NULL;
     }
-    *out_value = (lv_coord_t)atoi(scalar);
-    return true;
+    slot->name = yui_strdup_local(name);
+    if (!slot->name) {
+        free(slot);
+        return NULL;
+    }
+    lv_style_init(&slot->style);
+    s_style_slots[s_style_slot_count++] = slot;
+    return slot;
 }
 
-static bool yui_node_has_child(const yml_node_t *node, const char *key)
+static void yui_theme_styles_compile(void)
 {
-    if (!node || !key) {
-        return false;
+    if (!s_theme_styles_ready) {
+        lv_style_init(&s_theme_screen_style);
+        lv_style_init(&s_theme_overlay_style);
+        lv_style_init(&s_theme_panel_style);
+        s_theme_styles_ready = true;
     }
-    return yml_node_get_child(node, key) != NULL;
+    lv_style_set_bg_color(&s_theme_screen_style, yui_theme_screen_bg_color());
+    lv_style_set_bg_opa(&s_theme_screen_style, LV_OPA_COVER);
+    lv_style_set_bg_color(&s_theme_overlay_style, yui_theme_modal_overlay_color());
+    lv_style_set_bg_opa(&s_theme_overlay_style, LV_OPA_60);
+    lv_style_set_bg_color(&s_theme_panel_style, yui_theme_modal_panel_color());
+    lv_style_set_bg_opa(&s_theme_panel_style, LV_OPA_COVER);
 }
 
-static void yui_register_widget_id(const yml_node_t *node, lv_obj_t *obj)
+/* Recompiles every shared style for the current schema and theme, then lets LVGL restyle the
+ * objects that use them. Slots a schema no longer defines are emptied, never freed, since
+ * retained screens may still reference them. */
+static void yui_styles_rebuild(const yui_schema_runtime_t *schema)
 {
-    if (!node || !obj) {
-        return;
+    yui_theme_styles_compile();
+    if (schema) {
+        for (size_t i = 0; i < schema->schema.style_count; ++i) {
+            const char *name = schema->schema.styles[i].name;
+            if (name) {
+                (void)yui_style_slot_ensure(yui_style_logical_name(name));
+            }
+        }
+    }
+    for (size_t i = 0; i < s_style_slot_count; ++i) {
+        yui_style_slot_t *slot = s_style_slots[i];
+        const yui_style_t *style = schema ? yui_resolve_style(&schema->schema, slot->name) : NULL;
+        yui_style_compile(&slot->style, style);
+        lv_obj_report_style_change(&slot->style);
+    }
+    lv_obj_report_style_change(&s_theme_screen_style);
+    lv_obj_report_style_change(&s_theme_overlay_style);
+    lv_obj_report_style_change(&s_theme_panel_style);
+}
+
+/* Attaches the shared style for @p style_name; returns false when no schema style has that name. */
+static bool yui_attach_style(lv_obj_t *obj, const char *style_name)
+{
+    if (!obj || !style_name || style_name[0] == '\0') {
+        return false;
+    }
+    /* Slots are keyed by logical name; an explicit dark./light. prefix shares the same slot. */
+    yui_style_slot_t *slot = yui_style_slot_find(yui_style_logical_name(style_name));
+    if (!slot) {
+        return false;
+    }
+    lv_obj_add_style(obj, &slot->style, LV_PART_MAIN);
+    return true;
+}
+
+/* Built-in widget looks are shared styles too. They are added before the schema style in
+ * yui_apply_common_widget_attrs(), so a `style:` on the widget still overrides them. */
+static lv_style_t s_list_default_style;
+static lv_style_t s_camera_default_style;
+static lv_style_t s_vlist_root_style;
+static lv_style_t s_vtable_root_style;
+static lv_style_t s_layout_container_style;
+static bool s_widget_default_styles_ready;
+
+static void yui_widget_default_styles_init(void)
+{
+    if (s_widget_default_styles_ready) {
+        return;
+    }
+    lv_style_init(&s_list_default_style);
+    lv_style_set_bg_opa(&s_list_default_style, LV_OPA_TRANSP);
+    lv_style_set_border_opa(&s_list_default_style, LV_OPA_TRANSP);
+    lv_style_set_border_width(&s_list_default_style, 0);
+    lv_style_set_outline_opa(&s_list_default_style, LV_OPA_TRANSP);
+    lv_style_set_shadow_opa(&s_list_default_style, LV_OPA_TRANSP);
+    lv_style_set_radius(&s_list_default_style, 0);
+    lv_style_set_pad_all(&s_list_default_style, 0);
+
+    lv_style_init(&s_camera_default_style);
+    lv_style_set_clip_corner(&s_camera_default_style, true);
+    lv_style_set_pad_all(&s_camera_default_style, 0);
+    lv_style_set_border_width(&s_camera_default_style, 0);
+
+    lv_style_t *roots[] = {&s_vlist_root_style, &s_vtable_root_style};
+    for (size_t i = 0; i < sizeof(roots) / sizeof(roots[0]); ++i) {
+        bool table = roots[i] == &s_vtable_root_style;
+        lv_style_init(roots[i]);
+        lv_style_set_bg_color(roots[i], lv_color_hex(0x0F172A));
+        lv_style_set_bg_opa(roots[i], LV_OPA_COVER);
+        lv_style_set_border_color(roots[i], lv_color_hex(0x334155));
+        lv_style_set_border_width(roots[i], table ? 1 : 0);
+        lv_style_set_radius(roots[i], table ? 12 : 0);
+        lv_style_set_pad_all(roots[i], 0);
+        lv_style_set_pad_row(roots[i], 0);
+        lv_style_set_clip_corner(roots[i], true);
+    }
+
+    lv_style_init(&s_layout_container_style);
+    lv_style_set_bg_opa(&s_layout_container_style, LV_OPA_TRANSP);
+    lv_style_set_border_opa(&s_layout_container_style, LV_OPA_TRANSP);
+    lv_style_set_outline_opa(&s_layout_container_style, LV_OPA_TRANSP);
+    s_widget_default_styles_ready = true;
+}
+
+static void yui_add_widget_default_style(lv_obj_t *obj, lv_style_t *style)
+{
+    yui_widget_default_styles_init();
+    lv_obj_add_style(obj, style, LV_PART_MAIN);
+}
+
+static void yui_apply_layout(lv_obj_t *obj, const yml_node_t *layout_node, const char *default_type)
+{
+    const char *type = layout_node ? yui_node_scalar(layout_node, "type") : NULL;
+    const char *mode = type ? type : default_type;
+    if (!mode || strcmp(mode, "column") == 0) {
+        lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_COLUMN);
+    } else if (strcmp(mode, "row") == 0) {
+        lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_ROW);
+    } else {
+        lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_COLUMN);
+    }
+    int32_t gap = yui_node_i32(layout_node, "gap", 12);
+    lv_obj_set_style_pad_row(obj, gap, 0);
+    lv_obj_set_style_pad_column(obj, gap, 0);
+    const char *align = layout_node ? yui_node_scalar(layout_node, "align") : NULL;
+    const char *justify = layout_node ? yui_node_scalar(layout_node, "justify") : NULL;
+    lv_obj_set_flex_align(
+        obj,
+        yui_flex_align_from_string(justify, LV_FLEX_ALIGN_START),
+        yui_flex_align_from_string(align, LV_FLEX_ALIGN_START),
+        LV_FLEX_ALIGN_STRETCH);
+}
+
+static bool yui_node_parse_size(const yml_node_t *node, const char *key, lv_coord_t *out_value)
+{
+    if (!node || !key || !out_value) {
+        return false;
+    }
+    const yml_node_t *child = yml_node_get_child(node, key);
+    if (!child) {
+        return false;
+    }
+    const char *scalar = yml_node_get_scalar(child);
+    if (!scalar) {
+        return false;
+    }
+    size_t len = strlen(scalar);
+    if (len > 1U && scalar[len - 1U] == '%') {
+        *out_value = LV_PCT(atoi(scalar));
+        return true;
+    }
+    *out_value = (lv_coord_t)atoi(scalar);
+    return true;
+}
+
+static bool yui_node_has_child(const yml_node_t *node, const char *key)
+{
+    if (!node || !key) {
+        return false;
+    }
+    return yml_node_get_child(node, key) != NULL;
+}
+
+static void yui_register_widget_id(const yml_node_t *node, lv_obj_t *obj)
+{
+    if (!node || !obj) {
+        return;
     }
     const char *id = yui_node_scalar(node, "id");
     if (!id || id[0] == '\0') {
@@ -2609,16 +3260,8 @@ static void yui_apply_common_widget_attrs(lv_obj_t *obj, const yml_node_t *node,
         return;
     }
     const char *widget_type = yui_node_scalar(node, "type");
-    const char *theme_style_name = yui_schema_get_theme_default_style(&schema->schema, widget_type);
-    if (theme_style_name) {
-        const yui_style_t *theme_style = yui_resolve_style(&schema->schema, theme_style_name);
-        yui_apply_style(obj, theme_style);
-    }
-    const char *style_name = yui_node_scalar(node, "style");
-    if (style_name) {
-        const yui_style_t *style = yui_resolve_style(&schema->schema, style_name);
-        yui_apply_style(obj, style);
-    }
+    (void)yui_attach_style(obj, yui_schema_get_theme_default_style(&schema->schema, widget_type));
+    (void)yui_attach_style(obj, yui_node_scalar(node, "style"));
     lv_coord_t size_value = 0;
     if (yui_node_parse_size(node, "width", &size_value)) {
         lv_obj_set_width(obj, size_value);
@@ -2651,13 +3294,383 @@ static void yui_prepare_layout_container(lv_obj_t *obj)
         return;
     }
     lv_obj_remove_style_all(obj);
-    lv_obj_set_style_bg_opa(obj, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_opa(obj, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_outline_opa(obj, LV_OPA_TRANSP, 0);
+    /* Shared, not local, so a schema `style:` attached afterwards can give it a background. */
+    yui_add_widget_default_style(obj, &s_layout_container_style);
     lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
 }
 
+/* Virtualized list/table: a fixed pool of row objects is positioned over a spacer that
+ * gives the viewport the scroll extent of the whole collection. Row i always lives in
+ * slot i % slot_count, so scrolling only rebinds the slots whose index changed. */
+typedef struct {
+    lv_obj_t *row;
+    lv_obj_t *cells[YUI_COLLECTION_COLUMNS_MAX];
+    uint32_t bound_index;
+} yui_vlist_slot_t;
+
+typedef struct {
+    char source[YUI_COLLECTION_NAME_MAX];
+    lv_obj_t *root;
+    lv_obj_t *viewport;
+    lv_obj_t *spacer;
+    lv_style_t *row_style;
+    yui_vlist_slot_t *slots;
+    uint32_t slot_count;
+    uint32_t row_count;
+    uint32_t selected;
+    lv_coord_t row_height;
+    lv_coord_t column_widths[YUI_COLLECTION_COLUMNS_MAX];
+    uint16_t columns;
+    uint16_t overscan;
+    yui_state_watch_handle_t watch;
+    bool follow;
+    bool refresh_pending;
+    bool disposed;
+} yui_vlist_t;
+
+static void yui_vlist_style_cell(lv_obj_t *cell, const yui_vlist_t *vlist, uint16_t column)
+{
+    lv_label_set_long_mode(cell, LV_LABEL_LONG_DOT);
+    if (vlist->column_widths[column] > 0) {
+        lv_obj_set_width(cell, vlist->column_widths[column]);
+    } else if (column == 0U) {
+        lv_obj_set_flex_grow(cell, 1);
+    }
+}
+
+/* Row looks are shared styles so a `row_style` added later can override them. */
+static lv_style_t s_vlist_row_style;
+static lv_style_t s_vlist_row_checked_style;
+static bool s_vlist_styles_ready;
+
+static void yui_vlist_prepare_row(lv_obj_t *row, const yui_vlist_t *vlist)
+{
+    if (!s_vlist_styles_ready) {
+        lv_style_init(&s_vlist_row_style);
+        lv_style_set_pad_hor(&s_vlist_row_style, 8);
+        lv_style_set_pad_column(&s_vlist_row_style, 8);
+        lv_style_set_border_side(&s_vlist_row_style, LV_BORDER_SIDE_BOTTOM);
+        lv_style_set_border_color(&s_vlist_row_style, lv_color_hex(0x1E293B));
+        lv_style_set_border_width(&s_vlist_row_style, 1);
+        lv_style_set_text_color(&s_vlist_row_style, lv_color_hex(0xE2E8F0));
+        lv_style_init(&s_vlist_row_checked_style);
+        lv_style_set_bg_color(&s_vlist_row_checked_style, lv_color_hex(0x1E3A8A));
+        lv_style_set_bg_opa(&s_vlist_row_checked_style, LV_OPA_COVER);
+        s_vlist_styles_ready = true;
+    }
+    lv_obj_remove_style_all(row);
+    lv_obj_add_style(row, &s_vlist_row_style, LV_PART_MAIN);
+    lv_obj_set_size(row, LV_PCT(100), vlist->row_height);
+    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE);
+}
+
+static void yui_vlist_bind_slot(yui_vlist_t *vlist, yui_vlist_slot_t *slot, uint32_t index)
+{
+    char cell_buf[YUI_TEXT_BUFFER_MAX];
+    slot->bound_index = index;
+    lv_obj_set_y(slot->row, (lv_coord_t)index * vlist->row_height);
+    for (uint16_t col = 0; col < vlist->columns; ++col) {
+        (void)yui_collection_copy_cell(vlist->source, index, col, cell_buf, sizeof(cell_buf));
+        lv_label_set_text(slot->cells[col], cell_buf);
+    }
+    if (index == vlist->selected) {
+        lv_obj_add_state(slot->row, LV_STATE_CHECKED);
+    } else {
+        lv_obj_clear_state(slot->row, LV_STATE_CHECKED);
+    }
+    lv_obj_clear_flag(slot->row, LV_OBJ_FLAG_HIDDEN);
+}
+
+static void yui_vlist_row_event_cb(lv_event_t *event)
+{
+    yui_vlist_t *vlist = (yui_vlist_t *)lv_event_get_user_data(event);
+    lv_obj_t *row = lv_event_get_target(event);
+    if (!vlist || vlist->disposed) {
+        return;
+    }
+    for (uint32_t i = 0; i < vlist->slot_count; ++i) {
+        yui_vlist_slot_t *slot = &vlist->slots[i];
+        if (slot->row != row || slot->bound_index == UINT32_MAX) {
+            continue;
+        }
+        vlist->selected = slot->bound_index;
+        for (uint32_t j = 0; j < vlist->slot_count; ++j) {
+            if (vlist->slots[j].bound_index == vlist->selected) {
+                lv_obj_add_state(vlist->slots[j].row, LV_STATE_CHECKED);
+            } else {
+                lv_obj_clear_state(vlist->slots[j].row, LV_STATE_CHECKED);
+            }
+        }
+        char key[YUI_COLLECTION_NAME_MAX + 16];
+        snprintf(key, sizeof(key), "%s.selected", vlist->source);
+        (void)yui_state_set_int(key, (int32_t)vlist->selected);
+        lv_obj_send_event(vlist->root, LV_EVENT_VALUE_CHANGED, NULL);
+        return;
+    }
+}
+
+/* Grows the pool to cover the viewport plus overscan on both sides. */
+static void yui_vlist_ensure_pool(yui_vlist_t *vlist)
+{
+    lv_coord_t view_height = lv_obj_get_content_height(vlist->viewport);
+    uint32_t visible = (uint32_t)((view_height + vlist->row_height - 1) / vlist->row_height) + 1U;
+    uint32_t needed = visible + 2U * vlist->overscan;
+    if (needed > YUI_VLIST_POOL_MAX) {
+        needed = YUI_VLIST_POOL_MAX;
+    }
+    if (needed <= vlist->slot_count) {
+        return;
+    }
+    yui_vlist_slot_t *next = (yui_vlist_slot_t *)realloc(vlist->slots, needed * sizeof(yui_vlist_slot_t));
+    if (!next) {
+        return;
+    }
+    vlist->slots = next;
+    for (uint32_t i = vlist->slot_count; i < needed; ++i) {
+        yui_vlist_slot_t *slot = &vlist->slots[i];
+        memset(slot, 0, sizeof(*slot));
+        slot->bound_index = UINT32_MAX;
+        slot->row = lv_obj_create(vlist->viewport);
+        yui_vlist_prepare_row(slot->row, vlist);
+        lv_obj_add_style(slot->row, &s_vlist_row_checked_style, LV_PART_MAIN | LV_STATE_CHECKED);
+        if (vlist->row_style) {
+            lv_obj_add_style(slot->row, vlist->row_style, LV_PART_MAIN);
+        }
+        lv_obj_add_flag(slot->row, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(slot->row, yui_vlist_row_event_cb, LV_EVENT_CLICKED, vlist);
+        for (uint16_t col = 0; col < vlist->columns; ++col) {
+            slot->cells[col] = lv_label_create(slot->row);
+            yui_vlist_style_cell(slot->cells[col], vlist, col);
+        }
+    }
+    /* Slot assignment depends on the pool size, so every row has to be rebound. */
+    for (uint32_t i = 0; i < vlist->slot_count; ++i) {
+        vlist->slots[i].bound_index = UINT32_MAX;
+    }
+    vlist->slot_count = needed;
+}
+
+static void yui_vlist_refresh(yui_vlist_t *vlist, bool rebind)
+{
+    if (!vlist || vlist->disposed) {
+        return;
+    }
+    uint32_t count = yui_collection_count(vlist->source);
+    if (count != vlist->row_count) {
+        bool at_tail = lv_obj_get_scroll_bottom(vlist->viewport) <= vlist->row_height;
+        vlist->row_count = count;
+        lv_obj_set_height(vlist->spacer, count > 0U ? (lv_coord_t)count * vlist->row_height : 1);
+        if (vlist->follow && at_tail) {
+            lv_obj_update_layout(vlist->viewport);
+            lv_coord_t bottom = lv_obj_get_scroll_bottom(vlist->viewport);
+            if (bottom > 0) {
+                lv_obj_scroll_to_y(vlist->viewport, lv_obj_get_scroll_y(vlist->viewport) + bottom, LV_ANIM_OFF);
+            }
+        }
+        if (vlist->selected != UINT32_MAX && vlist->selected >= count) {
+            vlist->selected = UINT32_MAX;
+        }
+    }
+    yui_vlist_ensure_pool(vlist);
+    if (vlist->slot_count == 0U) {
+        return;
+    }
+    lv_coord_t scroll_y = lv_obj_get_scroll_y(vlist->viewport);
+    uint32_t first = scroll_y > 0 ? (uint32_t)(scroll_y / vlist->row_height) : 0U;
+    first = first > vlist->overscan ? first - vlist->overscan : 0U;
+    for (uint32_t index = first; index < first + vlist->slot_count; ++index) {
+        yui_vlist_slot_t *slot = &vlist->slots[index % vlist->slot_count];
+        if (index >= count) {
+            if (slot->bound_index != UINT32_MAX) {
+                slot->bound_index = UINT32_MAX;
+                lv_obj_add_flag(slot->row, LV_OBJ_FLAG_HIDDEN);
+            }
+            continue;
+        }
+        if (rebind || slot->bound_index != index) {
+            yui_vlist_bind_slot(vlist, slot, index);
+        }
+    }
+}
+
+static void yui_vlist_refresh_post_cb(const void *payload, size_t len)
+{
+    yui_vlist_t *vlist = NULL;
+    if (len != sizeof(vlist)) {
+        return;
+    }
+    memcpy(&vlist, payload, sizeof(vlist));
+    vlist->refresh_pending = false;
+    if (vlist->disposed) {
+        return;
+    }
+    yui_vlist_refresh(vlist, true);
+}
+
+/* Collection revisions may be published from any task; coalesce them into one GUI-side refresh.
+ * The post wakes the GUI task, which lv_async_call() from another task would not. */
+static void yui_vlist_state_cb(const char *key, const char *value, void *user_ctx)
+{
+    (void)key;
+    (void)value;
+    yui_vlist_t *vlist = (yui_vlist_t *)user_ctx;
+    if (!vlist || vlist->disposed || vlist->refresh_pending) {
+        return;
+    }
+    vlist->refresh_pending = true;
+    if (kc_touch_gui_post(yui_vlist_refresh_post_cb, &vlist, sizeof(vlist), 0) != ESP_OK) {
+        vlist->refresh_pending = false;
+    }
+}
+
+static void yui_vlist_event_cb(lv_event_t *event)
+{
+    yui_vlist_t *vlist = (yui_vlist_t *)lv_event_get_user_data(event);
+    lv_event_code_t code = lv_event_get_code(event);
+    if (code == LV_EVENT_DELETE) {
+        if (vlist->watch != 0U) {
+            yui_state_unwatch(vlist->watch);
+            vlist->watch = 0U;
+        }
+        free(vlist->slots);
+        vlist->slots = NULL;
+        vlist->slot_count = 0U;
+        /* Like widget runtimes, the struct is never freed: a watcher already running on the
+         * publisher task or a queued refresh may still hold it and must see it disposed. */
+        vlist->disposed = true;
+        return;
+    }
+    if (code == LV_EVENT_SCROLL || code == LV_EVENT_SIZE_CHANGED) {
+        yui_vlist_refresh(vlist, false);
+    }
+}
+
+static uint16_t yui_vlist_column_count(const yml_node_t *node, const yml_node_t *headers_node, const yml_node_t *widths_node)
+{
+    int32_t columns = yui_node_i32(node, "columns", 0);
+    if (columns <= 0 && headers_node && yml_node_get_type(headers_node) == YML_NODE_SEQUENCE) {
+        columns = (int32_t)yml_node_child_count(headers_node);
+    }
+    if (columns <= 0 && widths_node && yml_node_get_type(widths_node) == YML_NODE_SEQUENCE) {
+        columns = (int32_t)yml_node_child_count(widths_node);
+    }
+    if (columns <= 0) {
+        columns = 1;
+    }
+    return (uint16_t)(columns > YUI_COLLECTION_COLUMNS_MAX ? YUI_COLLECTION_COLUMNS_MAX : columns);
+}
+
+static esp_err_t yui_render_virtual_view(const yml_node_t *node,
+                                         yui_schema_runtime_t *schema,
+                                         lv_obj_t *parent,
+                                         yui_component_scope_t *scope,
+                                         bool table)
+{
+    char source_buf[YUI_COLLECTION_NAME_MAX];
+    const char *source = yui_node_resolved_scalar(node, "source", scope, source_buf, sizeof(source_buf));
+    if (!source || source[0] == '\0') {
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget '%s' requires a 'source' collection", table ? "virtual_table" : "virtual_list");
+        return ESP_OK;
+    }
+    yui_vlist_t *vlist = (yui_vlist_t *)calloc(1, sizeof(yui_vlist_t));
+    if (!vlist) {
+        return ESP_ERR_NO_MEM;
+    }
+    snprintf(vlist->source, sizeof(vlist->source), "%s", source);
+    vlist->selected = UINT32_MAX;
+    vlist->row_height = (lv_coord_t)yui_node_resolved_i32(node, "row_height", scope, YUI_VLIST_DEFAULT_ROW_HEIGHT);
+    if (vlist->row_height <= 0) {
+        vlist->row_height = YUI_VLIST_DEFAULT_ROW_HEIGHT;
+    }
+    int32_t overscan = yui_node_resolved_i32(node, "overscan", scope, YUI_VLIST_DEFAULT_OVERSCAN);
+    vlist->overscan = (uint16_t)(overscan < 0 ? 0 : (overscan > 16 ? 16 : overscan));
+    vlist->follow = yui_node_resolved_bool(node, "follow", scope, false);
+    const char *row_style_name = yui_node_scalar(node, "row_style");
+    yui_style_slot_t *row_style_slot = row_style_name ? yui_style_slot_find(yui_style_logical_name(row_style_name)) : NULL;
+    vlist->row_style = row_style_slot ? &row_style_slot->style : NULL;
+
+    const yml_node_t *headers_node = table ? yml_node_get_child(node, "headers") : NULL;
+    const yml_node_t *widths_node = yml_node_get_child(node, "column_widths");
+    vlist->columns = yui_vlist_column_count(node, headers_node, widths_node);
+    if (widths_node && yml_node_get_type(widths_node) == YML_NODE_SEQUENCE) {
+        size_t width_count = yml_node_child_count(widths_node);
+        for (size_t i = 0; i < width_count && i < vlist->columns; ++i) {
+            const char *width_text = yml_node_get_scalar(yml_node_child_at(widths_node, i));
+            vlist->column_widths[i] = width_text ? (lv_coord_t)atoi(width_text) : 0;
+        }
+    }
+
+    lv_obj_t *root = lv_obj_create(parent);
+    vlist->root = root;
+    yui_register_widget_id(node, root);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(root, LV_PCT(100));
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(root, 240);
+    }
+    yui_add_widget_default_style(root, table ? &s_vtable_root_style : &s_vlist_root_style);
+    yui_apply_common_widget_attrs(root, node, schema);
+
+    if (table) {
+        lv_obj_clear_flag(root, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_flex_flow(root, LV_FLEX_FLOW_COLUMN);
+        if (headers_node && yml_node_get_type(headers_node) == YML_NODE_SEQUENCE) {
+            lv_obj_t *header = lv_obj_create(root);
+            yui_vlist_prepare_row(header, vlist);
+            lv_obj_set_style_bg_color(header, lv_color_hex(0x111827), LV_PART_MAIN);
+            lv_obj_set_style_bg_opa(header, LV_OPA_COVER, LV_PART_MAIN);
+            lv_obj_set_style_border_color(header, lv_color_hex(0x334155), LV_PART_MAIN);
+            for (uint16_t col = 0; col < vlist->columns; ++col) {
+                char header_buf[YUI_TEXT_BUFFER_MAX];
+                const yml_node_t *header_node = yml_node_child_at(headers_node, col);
+                lv_obj_t *cell = lv_label_create(header);
+                yui_vlist_style_cell(cell, vlist, col);
+                lv_label_set_text(cell, yui_format_node_text(header_node, scope, header_buf, sizeof(header_buf)) ? header_buf : "");
+            }
+        }
+        vlist->viewport = lv_obj_create(root);
+        lv_obj_remove_style_all(vlist->viewport);
+        lv_obj_set_width(vlist->viewport, LV_PCT(100));
+        lv_obj_set_flex_grow(vlist->viewport, 1);
+    } else {
+        vlist->viewport = root;
+    }
+    lv_obj_set_layout(vlist->viewport, LV_LAYOUT_NONE);
+    lv_obj_set_scroll_dir(vlist->viewport, LV_DIR_VER);
+    lv_obj_add_flag(vlist->viewport, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_remove_flag(vlist->viewport, LV_OBJ_FLAG_SCROLL_CHAIN_VER);
+    lv_obj_remove_flag(vlist->viewport, LV_OBJ_FLAG_SCROLL_ELASTIC);
+
+    vlist->spacer = lv_obj_create(vlist->viewport);
+    lv_obj_remove_style_all(vlist->spacer);
+    lv_obj_clear_flag(vlist->spacer, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_size(vlist->spacer, 1, 1);
+
+    lv_obj_add_event_cb(root, yui_vlist_event_cb, LV_EVENT_DELETE, vlist);
+    lv_obj_add_event_cb(vlist->viewport, yui_vlist_event_cb, LV_EVENT_SCROLL, vlist);
+    lv_obj_add_event_cb(vlist->viewport, yui_vlist_event_cb, LV_EVENT_SIZE_CHANGED, vlist);
+
+    char revision_key[YUI_COLLECTION_NAME_MAX + 16];
+    snprintf(revision_key, sizeof(revision_key), "%s.revision", vlist->source);
+    esp_err_t err = yui_state_watch(revision_key, yui_vlist_state_cb, vlist, &vlist->watch);
+    if (err != ESP_OK) {
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Failed to watch collection '%s' (%s)", vlist->source, esp_err_to_name(err));
+    }
+    lv_obj_update_layout(root);
+    yui_vlist_refresh(vlist, true);
+
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(root, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, root);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
+}
+
 static esp_err_t yui_render_widget(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope);
 
 static esp_err_t yui_render_widget_list(const yml_node_t *widgets_node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
@@ -2665,6 +3678,9 @@ static esp_err_t yui_render_widget_list(const yml_node_t *widgets_node, yui_sche
     if (!widgets_node || yml_node_get_type(widgets_node) != YML_NODE_SEQUENCE) {
         return ESP_OK;
     }
+    if (s_build_deferring) {
+        return yui_build_push_frame(widgets_node, schema, parent, scope);
+    }
     for (const yml_node_t *child = yml_node_child_at(widgets_node, 0); child; child = yml_node_next(child)) {
         esp_err_t err = yui_render_widget(child, schema, parent, scope);
         if (err != ESP_OK) {
@@ -2703,1256 +3719,2361 @@ static esp_err_t yui_render_component_instance(const yui_component_def_t *compon
     return err;
 }
 
-static esp_err_t yui_render_widget(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
-{
-    if (!node || !schema || !parent || yml_node_get_type(node) != YML_NODE_MAPPING) {
-        return ESP_OK;
-    }
-    const char *type = yui_node_scalar(node, "type");
-    if (!type) {
-        return ESP_OK;
-    }
-    const yui_component_def_t *component = yui_schema_get_component(&schema->schema, type);
-    if (component) {
-        return yui_render_component_instance(component, node, schema, parent, scope);
-    }
-    if (strcmp(type, "label") == 0) {
-        lv_obj_t *label = lv_label_create(parent);
-        yui_register_widget_id(node, label);
-        yui_apply_common_widget_attrs(label, node, schema);
-        const char *raw_text = yui_node_scalar(node, "text");
-        const char *raw_text_key = yui_node_scalar(node, "text_key");
-        char text_buf[YUI_TEXT_BUFFER_MAX];
-        const char *text = yui_node_resolved_localized_scalar(node, "text", "text_key", scope, text_buf, sizeof(text_buf));
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(label, scope);
-        if (runtime && text) {
-            if (raw_text && strstr(raw_text, "{{") && strstr(raw_text, "}}")) {
-                (void)yui_widget_bind_text(runtime, raw_text, label, false);
-            } else if (raw_text_key && strstr(raw_text_key, "{{") && strstr(raw_text_key, "}}")) {
-                (void)yui_widget_bind_text(runtime, raw_text_key, label, true);
-            } else {
-                lv_label_set_text(label, text);
-            }
-        } else if (text) {
+static esp_err_t yui_render_label(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    lv_obj_t *label = lv_label_create(parent);
+    yui_register_widget_id(node, label);
+    yui_apply_common_widget_attrs(label, node, schema);
+    const char *raw_text = yui_node_scalar(node, "text");
+    const char *raw_text_key = yui_node_scalar(node, "text_key");
+    char text_buf[YUI_TEXT_BUFFER_MAX];
+    const char *text = yui_node_resolved_localized_scalar(node, "text", "text_key", scope, text_buf, sizeof(text_buf));
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(label, scope);
+    if (runtime && text) {
+        if (raw_text && strstr(raw_text, "{{") && strstr(raw_text, "}}")) {
+            (void)yui_widget_bind_text(runtime, raw_text, label, false);
+        } else if (raw_text_key && raw_text_key[0] != '\0') {
+            (void)yui_widget_bind_text(runtime, raw_text_key, label, true);
+        } else {
             lv_label_set_text(label, text);
         }
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, label);
-            (void)yui_widget_parse_events(node, runtime);
-        }
-        return ESP_OK;
+    } else if (text) {
+        lv_label_set_text(label, text);
     }
-    if (strcmp(type, "camera_preview") == 0) {
-        lv_obj_t *container = lv_obj_create(parent);
-        yui_register_widget_id(node, container);
-        lv_obj_clear_flag(container, LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_clip_corner(container, true, 0);
-        lv_obj_set_style_pad_all(container, 0, 0);
-        lv_obj_set_style_border_width(container, 0, 0);
-        if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
-            lv_obj_set_width(container, LV_PCT(100));
-        }
-        if (!yui_node_has_child(node, "height")) {
-            lv_obj_set_height(container, 240);
-        }
-        yui_apply_common_widget_attrs(container, node, schema);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, label);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
+}
 
-        lv_obj_t *image = lv_image_create(container);
-        lv_image_set_inner_align(image, LV_IMAGE_ALIGN_CENTER);
-        lv_obj_center(image);
+static esp_err_t yui_render_camera_preview(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    lv_obj_t *container = lv_obj_create(parent);
+    yui_register_widget_id(node, container);
+    lv_obj_clear_flag(container, LV_OBJ_FLAG_SCROLLABLE);
+    yui_add_widget_default_style(container, &s_camera_default_style);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(container, LV_PCT(100));
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(container, 240);
+    }
+    yui_apply_common_widget_attrs(container, node, schema);
 
-        lv_obj_t *placeholder = lv_label_create(container);
-        lv_label_set_text(placeholder, kc_touch_gui_camera_ready() ? "Starting camera preview..." : "Camera unavailable");
-        const yui_style_t *placeholder_style = yui_resolve_style(&schema->schema, "body");
-        if (placeholder_style) {
-            yui_apply_style(placeholder, placeholder_style);
-        }
-        lv_obj_center(placeholder);
+    lv_obj_t *image = lv_image_create(container);
+    lv_image_set_inner_align(image, LV_IMAGE_ALIGN_CENTER);
+    lv_obj_center(image);
 
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(container, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, container);
-        }
-        lv_obj_add_event_cb(container, yui_camera_preview_delete_cb, LV_EVENT_DELETE, NULL);
+    lv_obj_t *placeholder = lv_label_create(container);
+    lv_label_set_text(placeholder, kc_touch_gui_camera_ready() ? "Starting camera preview..." : "Camera unavailable");
+    (void)yui_attach_style(placeholder, "body");
+    lv_obj_center(placeholder);
 
-        esp_err_t preview_err = yui_camera_preview_start(container, image, placeholder);
-        if (preview_err != ESP_OK) {
-            yamui_log(YAMUI_LOG_LEVEL_WARN,
-                      YAMUI_LOG_CAT_LVGL,
-                      "camera_preview unavailable (%s)",
-                      esp_err_to_name(preview_err));
-            lv_label_set_text(placeholder, "Camera preview unavailable");
-        }
-        return ESP_OK;
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(container, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, container);
     }
-    if (strcmp(type, "img") == 0) {
-        const char *src = yui_node_scalar(node, "src");
-        if (!src) {
-            yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Image widget missing src");
-            return ESP_OK;
-        }
-        if (strncmp(src, "symbol:", 7) == 0) {
-            const char *glyph = yui_symbol_lookup(src + 7);
-            lv_obj_t *symbol = lv_label_create(parent);
-            yui_apply_common_widget_attrs(symbol, node, schema);
-            lv_label_set_text(symbol, glyph ? glyph : "");
-            yui_widget_runtime_t *runtime = yui_widget_runtime_create(symbol, scope);
-            if (runtime) {
-                (void)yui_widget_bind_conditions(runtime, node, symbol);
-            }
-            return ESP_OK;
-        }
-        lv_obj_t *img = lv_img_create(parent);
-        yui_register_widget_id(node, img);
-        yui_apply_common_widget_attrs(img, node, schema);
-        lv_img_set_src(img, src);
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(img, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, img);
-        }
-        return ESP_OK;
+    lv_obj_add_event_cb(container, yui_camera_preview_delete_cb, LV_EVENT_DELETE, NULL);
+
+    esp_err_t preview_err = yui_camera_preview_start(container, image, placeholder);
+    if (preview_err != ESP_OK) {
+        yamui_log(YAMUI_LOG_LEVEL_WARN,
+                  YAMUI_LOG_CAT_LVGL,
+                  "camera_preview unavailable (%s)",
+                  esp_err_to_name(preview_err));
+        lv_label_set_text(placeholder, "Camera preview unavailable");
     }
-    if (strcmp(type, "button") == 0) {
-        char text_buf[YUI_TEXT_BUFFER_MAX];
-        const char *raw_text = yui_node_scalar(node, "text");
-        const char *raw_text_key = yui_node_scalar(node, "text_key");
-        const char *text = yui_node_resolved_localized_scalar(node, "text", "text_key", scope, text_buf, sizeof(text_buf));
-        lv_obj_t *btn = lv_button_create(parent);
-        lv_obj_clear_flag(btn, LV_OBJ_FLAG_SCROLLABLE);
-        yui_register_widget_id(node, btn);
-        bool text_is_dynamic = (raw_text && strstr(raw_text, "{{") && strstr(raw_text, "}}"))
-            || (raw_text_key && strstr(raw_text_key, "{{") && strstr(raw_text_key, "}}"));
-        if (!yui_node_has_child(node, "width")) {
-            lv_flex_flow_t parent_flow = lv_obj_get_style_flex_flow(parent, LV_PART_MAIN);
-            if (parent_flow == LV_FLEX_FLOW_COLUMN || parent_flow == LV_FLEX_FLOW_COLUMN_WRAP) {
-                lv_obj_set_width(btn, LV_PCT(100));
-            } else {
-                lv_obj_set_width(btn, LV_SIZE_CONTENT);
-            }
-        }
-        yui_apply_common_widget_attrs(btn, node, schema);
-        lv_obj_t *label = lv_label_create(btn);
-        lv_label_set_long_mode(label, LV_LABEL_LONG_CLIP);
-        lv_obj_center(label);
-        if (text && !text_is_dynamic) {
-            lv_label_set_text(label, text);
-        }
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(btn, scope);
-        if (runtime) {
-            runtime->text_target = label;
-            if (text && text_is_dynamic) {
-                if (raw_text && strstr(raw_text, "{{") && strstr(raw_text, "}}")) {
-                    (void)yui_widget_bind_text(runtime, raw_text, label, false);
-                } else if (raw_text_key && strstr(raw_text_key, "{{") && strstr(raw_text_key, "}}")) {
-                    (void)yui_widget_bind_text(runtime, raw_text_key, label, true);
-                }
-            }
-            (void)yui_widget_bind_conditions(runtime, node, btn);
-            (void)yui_widget_parse_events(node, runtime);
-        } else if (text) {
-            lv_label_set_text(label, text);
-        }
+    return ESP_OK;
+}
+
+static esp_err_t yui_render_img(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    const char *src = yui_node_scalar(node, "src");
+    if (!src) {
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Image widget missing src");
         return ESP_OK;
     }
-    if (strcmp(type, "spacer") == 0) {
-        lv_obj_t *spacer = lv_obj_create(parent);
-        yui_register_widget_id(node, spacer);
-        lv_obj_remove_style_all(spacer);
-        lv_obj_set_height(spacer, yui_node_i32(node, "size", 12));
-        lv_obj_set_width(spacer, LV_PCT(100));
-        lv_obj_clear_flag(spacer, LV_OBJ_FLAG_CLICKABLE);
-        yui_apply_common_widget_attrs(spacer, node, schema);
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(spacer, scope);
+    if (strncmp(src, "symbol:", 7) == 0) {
+        const char *glyph = yui_symbol_lookup(src + 7);
+        lv_obj_t *symbol = lv_label_create(parent);
+        yui_apply_common_widget_attrs(symbol, node, schema);
+        lv_label_set_text(symbol, glyph ? glyph : "");
+        yui_widget_runtime_t *runtime = yui_widget_runtime_create(symbol, scope);
         if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, spacer);
+            (void)yui_widget_bind_conditions(runtime, node, symbol);
         }
         return ESP_OK;
     }
-    if (strcmp(type, "spinner") == 0) {
-#if LV_USE_SPINNER
-        lv_obj_t *spinner = lv_spinner_create(parent);
-        yui_register_widget_id(node, spinner);
-        if (!yui_node_has_child(node, "width")) {
-            lv_obj_set_width(spinner, 32);
-        }
-        if (!yui_node_has_child(node, "height")) {
-            lv_obj_set_height(spinner, 32);
-        }
-        yui_apply_common_widget_attrs(spinner, node, schema);
-        uint32_t duration = (uint32_t)yui_node_resolved_i32(node, "duration", scope, 1000);
-        uint32_t arc_sweep = (uint32_t)yui_node_resolved_i32(node, "arc_sweep", scope, 240);
-        lv_spinner_set_anim_params(spinner, duration, arc_sweep);
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(spinner, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, spinner);
-            (void)yui_widget_parse_events(node, runtime);
+    lv_obj_t *img = lv_img_create(parent);
+    yui_register_widget_id(node, img);
+    yui_apply_common_widget_attrs(img, node, schema);
+    lv_img_set_src(img, src);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(img, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, img);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t yui_render_button(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    char text_buf[YUI_TEXT_BUFFER_MAX];
+    const char *raw_text = yui_node_scalar(node, "text");
+    const char *raw_text_key = yui_node_scalar(node, "text_key");
+    const char *text = yui_node_resolved_localized_scalar(node, "text", "text_key", scope, text_buf, sizeof(text_buf));
+    lv_obj_t *btn = lv_button_create(parent);
+    lv_obj_clear_flag(btn, LV_OBJ_FLAG_SCROLLABLE);
+    yui_register_widget_id(node, btn);
+    bool text_is_dynamic = (raw_text && strstr(raw_text, "{{") && strstr(raw_text, "}}"))
+        || (raw_text_key && raw_text_key[0] != '\0');
+    if (!yui_node_has_child(node, "width")) {
+        lv_flex_flow_t parent_flow = lv_obj_get_style_flex_flow(parent, LV_PART_MAIN);
+        if (parent_flow == LV_FLEX_FLOW_COLUMN || parent_flow == LV_FLEX_FLOW_COLUMN_WRAP) {
+            lv_obj_set_width(btn, LV_PCT(100));
+        } else {
+            lv_obj_set_width(btn, LV_SIZE_CONTENT);
         }
-        return ESP_OK;
-#else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'spinner' unavailable: LV_USE_SPINNER=0");
-        return ESP_OK;
-#endif
     }
-    if (strcmp(type, "textarea") == 0) {
-#if LV_USE_TEXTAREA
-        lv_obj_t *ta = lv_textarea_create(parent);
-        yui_register_widget_id(node, ta);
-        yui_apply_common_widget_attrs(ta, node, schema);
-        char placeholder_buf[YUI_TEXT_BUFFER_MAX];
-        const char *placeholder = yui_node_resolved_localized_scalar(node, "placeholder", "placeholder_key", scope, placeholder_buf, sizeof(placeholder_buf));
-        if (placeholder) {
-            lv_textarea_set_placeholder_text(ta, placeholder);
-        }
-        lv_textarea_set_password_mode(ta, yui_node_resolved_bool(node, "password_mode", scope, false));
-        char text_buf[YUI_TEXT_BUFFER_MAX];
-        const char *initial_text = yui_node_resolved_scalar(node, "text", scope, text_buf, sizeof(text_buf));
-        if (!initial_text) {
-            initial_text = yui_node_resolved_scalar(node, "value", scope, text_buf, sizeof(text_buf));
-        }
-        if (initial_text) {
-            lv_textarea_set_text(ta, initial_text);
-        }
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(ta, scope);
-        if (runtime) {
-            const char *value_tmpl = yui_node_scalar(node, "text");
-            if (!value_tmpl) {
-                value_tmpl = yui_node_scalar(node, "value");
-            }
-            if (value_tmpl) {
-                (void)yui_widget_bind_value(runtime, value_tmpl, ta, YUI_VALUE_BIND_TEXTAREA);
+    yui_apply_common_widget_attrs(btn, node, schema);
+    lv_obj_t *label = lv_label_create(btn);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_CLIP);
+    lv_obj_center(label);
+    if (text && !text_is_dynamic) {
+        lv_label_set_text(label, text);
+    }
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(btn, scope);
+    if (runtime) {
+        runtime->text_target = label;
+        if (text && text_is_dynamic) {
+            if (raw_text && strstr(raw_text, "{{") && strstr(raw_text, "}}")) {
+                (void)yui_widget_bind_text(runtime, raw_text, label, false);
+            } else if (raw_text_key && raw_text_key[0] != '\0') {
+                (void)yui_widget_bind_text(runtime, raw_text_key, label, true);
             }
-            (void)yui_widget_bind_conditions(runtime, node, ta);
-            (void)yui_widget_parse_events(node, runtime);
         }
-        return ESP_OK;
+        (void)yui_widget_bind_conditions(runtime, node, btn);
+        (void)yui_widget_parse_events(node, runtime);
+    } else if (text) {
+        lv_label_set_text(label, text);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t yui_render_spacer(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    lv_obj_t *spacer = lv_obj_create(parent);
+    yui_register_widget_id(node, spacer);
+    lv_obj_remove_style_all(spacer);
+    lv_obj_set_height(spacer, yui_node_i32(node, "size", 12));
+    lv_obj_set_width(spacer, LV_PCT(100));
+    lv_obj_clear_flag(spacer, LV_OBJ_FLAG_CLICKABLE);
+    yui_apply_common_widget_attrs(spacer, node, schema);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(spacer, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, spacer);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t yui_render_spinner(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_SPINNER
+    lv_obj_t *spinner = lv_spinner_create(parent);
+    yui_register_widget_id(node, spinner);
+    if (!yui_node_has_child(node, "width")) {
+        lv_obj_set_width(spinner, 32);
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(spinner, 32);
+    }
+    yui_apply_common_widget_attrs(spinner, node, schema);
+    uint32_t duration = (uint32_t)yui_node_resolved_i32(node, "duration", scope, 1000);
+    uint32_t arc_sweep = (uint32_t)yui_node_resolved_i32(node, "arc_sweep", scope, 240);
+    lv_spinner_set_anim_params(spinner, duration, arc_sweep);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(spinner, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, spinner);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'textarea' unavailable: LV_USE_TEXTAREA=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'spinner' unavailable: LV_USE_SPINNER=0");
+    return ESP_OK;
+#endif
+}
+
+#if LV_USE_TEXTAREA
+static void yui_set_textarea_placeholder(lv_obj_t *target, uint32_t index, const char *text)
+{
+    (void)index;
+    lv_textarea_set_placeholder_text(target, text);
+}
 #endif
+
+static esp_err_t yui_render_textarea(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_TEXTAREA
+    lv_obj_t *ta = lv_textarea_create(parent);
+    yui_register_widget_id(node, ta);
+    yui_apply_common_widget_attrs(ta, node, schema);
+    char placeholder_buf[YUI_TEXT_BUFFER_MAX];
+    const char *placeholder = yui_node_resolved_localized_scalar(node, "placeholder", "placeholder_key", scope, placeholder_buf, sizeof(placeholder_buf));
+    if (placeholder) {
+        lv_textarea_set_placeholder_text(ta, placeholder);
+    }
+    lv_textarea_set_password_mode(ta, yui_node_resolved_bool(node, "password_mode", scope, false));
+    char text_buf[YUI_TEXT_BUFFER_MAX];
+    const char *initial_text = yui_node_resolved_scalar(node, "text", scope, text_buf, sizeof(text_buf));
+    if (!initial_text) {
+        initial_text = yui_node_resolved_scalar(node, "value", scope, text_buf, sizeof(text_buf));
+    }
+    if (initial_text) {
+        lv_textarea_set_text(ta, initial_text);
+    }
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(ta, scope);
+    if (runtime) {
+        (void)yui_widget_bind_localized(runtime, node, "placeholder_key", ta, 0U, yui_set_textarea_placeholder);
+        const char *value_tmpl = yui_node_scalar(node, "text");
+        if (!value_tmpl) {
+            value_tmpl = yui_node_scalar(node, "value");
+        }
+        if (value_tmpl) {
+            (void)yui_widget_bind_value(runtime, value_tmpl, ta, YUI_VALUE_BIND_TEXTAREA);
+        }
+        (void)yui_widget_bind_conditions(runtime, node, ta);
+        (void)yui_widget_parse_events(node, runtime);
     }
-    if (strcmp(type, "switch") == 0) {
-#if LV_USE_SWITCH
-        lv_obj_t *sw = lv_switch_create(parent);
-        yui_register_widget_id(node, sw);
-        yui_apply_common_widget_attrs(sw, node, schema);
-        if (yui_node_resolved_bool(node, "value", scope, false)) {
-            lv_obj_add_state(sw, LV_STATE_CHECKED);
-        }
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(sw, scope);
-        if (runtime) {
-            const char *value_tmpl = yui_node_scalar(node, "value");
-            if (value_tmpl) {
-                (void)yui_widget_bind_value(runtime, value_tmpl, sw, YUI_VALUE_BIND_SWITCH);
-            }
-            (void)yui_widget_bind_conditions(runtime, node, sw);
-            (void)yui_widget_parse_events(node, runtime);
-        }
-        return ESP_OK;
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'switch' unavailable: LV_USE_SWITCH=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'textarea' unavailable: LV_USE_TEXTAREA=0");
+    return ESP_OK;
 #endif
+}
+
+static esp_err_t yui_render_switch(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_SWITCH
+    lv_obj_t *sw = lv_switch_create(parent);
+    yui_register_widget_id(node, sw);
+    yui_apply_common_widget_attrs(sw, node, schema);
+    if (yui_node_resolved_bool(node, "value", scope, false)) {
+        lv_obj_add_state(sw, LV_STATE_CHECKED);
     }
-    if (strcmp(type, "checkbox") == 0) {
-#if LV_USE_CHECKBOX
-        lv_obj_t *cb = lv_checkbox_create(parent);
-        yui_register_widget_id(node, cb);
-        yui_apply_common_widget_attrs(cb, node, schema);
-        char text_buf[YUI_TEXT_BUFFER_MAX];
-        const char *text = yui_node_resolved_localized_scalar(node, "text", "text_key", scope, text_buf, sizeof(text_buf));
-        if (text) {
-            lv_checkbox_set_text(cb, text);
-        }
-        if (yui_node_resolved_bool(node, "value", scope, false)) {
-            lv_obj_add_state(cb, LV_STATE_CHECKED);
-        }
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(cb, scope);
-        if (runtime) {
-            const char *value_tmpl = yui_node_scalar(node, "value");
-            if (value_tmpl) {
-                (void)yui_widget_bind_value(runtime, value_tmpl, cb, YUI_VALUE_BIND_CHECKBOX);
-            }
-            (void)yui_widget_bind_conditions(runtime, node, cb);
-            (void)yui_widget_parse_events(node, runtime);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(sw, scope);
+    if (runtime) {
+        const char *value_tmpl = yui_node_scalar(node, "value");
+        if (value_tmpl) {
+            (void)yui_widget_bind_value(runtime, value_tmpl, sw, YUI_VALUE_BIND_SWITCH);
         }
-        return ESP_OK;
+        (void)yui_widget_bind_conditions(runtime, node, sw);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'checkbox' unavailable: LV_USE_CHECKBOX=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'switch' unavailable: LV_USE_SWITCH=0");
+    return ESP_OK;
+#endif
+}
+
+#if LV_USE_CHECKBOX
+static void yui_set_checkbox_text(lv_obj_t *target, uint32_t index, const char *text)
+{
+    (void)index;
+    lv_checkbox_set_text(target, text);
+}
 #endif
+
+static esp_err_t yui_render_checkbox(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_CHECKBOX
+    lv_obj_t *cb = lv_checkbox_create(parent);
+    yui_register_widget_id(node, cb);
+    yui_apply_common_widget_attrs(cb, node, schema);
+    char text_buf[YUI_TEXT_BUFFER_MAX];
+    const char *text = yui_node_resolved_localized_scalar(node, "text", "text_key", scope, text_buf, sizeof(text_buf));
+    if (text) {
+        lv_checkbox_set_text(cb, text);
+    }
+    if (yui_node_resolved_bool(node, "value", scope, false)) {
+        lv_obj_add_state(cb, LV_STATE_CHECKED);
+    }
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(cb, scope);
+    if (runtime) {
+        (void)yui_widget_bind_localized(runtime, node, "text_key", cb, 0U, yui_set_checkbox_text);
+        const char *value_tmpl = yui_node_scalar(node, "value");
+        if (value_tmpl) {
+            (void)yui_widget_bind_value(runtime, value_tmpl, cb, YUI_VALUE_BIND_CHECKBOX);
+        }
+        (void)yui_widget_bind_conditions(runtime, node, cb);
+        (void)yui_widget_parse_events(node, runtime);
     }
-    if (strcmp(type, "slider") == 0) {
-#if LV_USE_SLIDER
-        lv_obj_t *slider = lv_slider_create(parent);
-        yui_register_widget_id(node, slider);
-        yui_apply_common_widget_attrs(slider, node, schema);
-        int32_t min = yui_node_resolved_i32(node, "min", scope, 0);
-        int32_t max = yui_node_resolved_i32(node, "max", scope, 100);
-        if (max < min) {
-            int32_t tmp = min;
-            min = max;
-            max = tmp;
-        }
-        lv_slider_set_range(slider, min, max);
-        int32_t value = yui_node_resolved_i32(node, "value", scope, min);
-        if (value < min) {
-            value = min;
-        } else if (value > max) {
-            value = max;
-        }
-        lv_slider_set_value(slider, value, LV_ANIM_OFF);
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(slider, scope);
-        if (runtime) {
-            const char *value_tmpl = yui_node_scalar(node, "value");
-            if (value_tmpl) {
-                (void)yui_widget_bind_value(runtime, value_tmpl, slider, YUI_VALUE_BIND_SLIDER);
-            }
-            (void)yui_widget_bind_conditions(runtime, node, slider);
-            (void)yui_widget_parse_events(node, runtime);
-        }
-        return ESP_OK;
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'slider' unavailable: LV_USE_SLIDER=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'checkbox' unavailable: LV_USE_CHECKBOX=0");
+    return ESP_OK;
 #endif
+}
+
+static esp_err_t yui_render_slider(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_SLIDER
+    lv_obj_t *slider = lv_slider_create(parent);
+    yui_register_widget_id(node, slider);
+    yui_apply_common_widget_attrs(slider, node, schema);
+    int32_t min = yui_node_resolved_i32(node, "min", scope, 0);
+    int32_t max = yui_node_resolved_i32(node, "max", scope, 100);
+    if (max < min) {
+        int32_t tmp = min;
+        min = max;
+        max = tmp;
+    }
+    lv_slider_set_range(slider, min, max);
+    int32_t value = yui_node_resolved_i32(node, "value", scope, min);
+    if (value < min) {
+        value = min;
+    } else if (value > max) {
+        value = max;
+    }
+    lv_slider_set_value(slider, value, LV_ANIM_OFF);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(slider, scope);
+    if (runtime) {
+        const char *value_tmpl = yui_node_scalar(node, "value");
+        if (value_tmpl) {
+            (void)yui_widget_bind_value(runtime, value_tmpl, slider, YUI_VALUE_BIND_SLIDER);
+        }
+        (void)yui_widget_bind_conditions(runtime, node, slider);
+        (void)yui_widget_parse_events(node, runtime);
     }
-    if (strcmp(type, "bar") == 0) {
-#if LV_USE_BAR
-        lv_obj_t *bar = lv_bar_create(parent);
-        yui_register_widget_id(node, bar);
-        yui_apply_common_widget_attrs(bar, node, schema);
-        int32_t min = yui_node_resolved_i32(node, "min", scope, 0);
-        int32_t max = yui_node_resolved_i32(node, "max", scope, 100);
-        if (max < min) {
-            int32_t tmp = min;
-            min = max;
-            max = tmp;
-        }
-        lv_bar_set_range(bar, min, max);
-        int32_t value = yui_node_resolved_i32(node, "value", scope, min);
-        if (value < min) {
-            value = min;
-        } else if (value > max) {
-            value = max;
-        }
-        lv_bar_set_value(bar, value, LV_ANIM_OFF);
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(bar, scope);
-        if (runtime) {
-            const char *value_tmpl = yui_node_scalar(node, "value");
-            if (value_tmpl) {
-                (void)yui_widget_bind_value(runtime, value_tmpl, bar, YUI_VALUE_BIND_BAR);
-            }
-            (void)yui_widget_bind_conditions(runtime, node, bar);
-            (void)yui_widget_parse_events(node, runtime);
-        }
-        return ESP_OK;
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'bar' unavailable: LV_USE_BAR=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'slider' unavailable: LV_USE_SLIDER=0");
+    return ESP_OK;
 #endif
+}
+
+static esp_err_t yui_render_bar(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_BAR
+    lv_obj_t *bar = lv_bar_create(parent);
+    yui_register_widget_id(node, bar);
+    yui_apply_common_widget_attrs(bar, node, schema);
+    int32_t min = yui_node_resolved_i32(node, "min", scope, 0);
+    int32_t max = yui_node_resolved_i32(node, "max", scope, 100);
+    if (max < min) {
+        int32_t tmp = min;
+        min = max;
+        max = tmp;
+    }
+    lv_bar_set_range(bar, min, max);
+    int32_t value = yui_node_resolved_i32(node, "value", scope, min);
+    if (value < min) {
+        value = min;
+    } else if (value > max) {
+        value = max;
+    }
+    lv_bar_set_value(bar, value, LV_ANIM_OFF);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(bar, scope);
+    if (runtime) {
+        const char *value_tmpl = yui_node_scalar(node, "value");
+        if (value_tmpl) {
+            (void)yui_widget_bind_value(runtime, value_tmpl, bar, YUI_VALUE_BIND_BAR);
+        }
+        (void)yui_widget_bind_conditions(runtime, node, bar);
+        (void)yui_widget_parse_events(node, runtime);
     }
-    if (strcmp(type, "arc") == 0) {
-#if LV_USE_ARC
-        lv_obj_t *arc = lv_arc_create(parent);
-        yui_register_widget_id(node, arc);
-        yui_apply_common_widget_attrs(arc, node, schema);
-        int32_t min = yui_node_resolved_i32(node, "min", scope, 0);
-        int32_t max = yui_node_resolved_i32(node, "max", scope, 100);
-        if (max < min) {
-            int32_t tmp = min;
-            min = max;
-            max = tmp;
-        }
-        lv_arc_set_range(arc, min, max);
-        int32_t value = yui_node_resolved_i32(node, "value", scope, min);
-        if (value < min) {
-            value = min;
-        } else if (value > max) {
-            value = max;
-        }
-        lv_arc_set_value(arc, value);
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(arc, scope);
-        if (runtime) {
-            const char *value_tmpl = yui_node_scalar(node, "value");
-            if (value_tmpl) {
-                (void)yui_widget_bind_value(runtime, value_tmpl, arc, YUI_VALUE_BIND_ARC);
-            }
-            (void)yui_widget_bind_conditions(runtime, node, arc);
-            (void)yui_widget_parse_events(node, runtime);
-        }
-        return ESP_OK;
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'arc' unavailable: LV_USE_ARC=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'bar' unavailable: LV_USE_BAR=0");
+    return ESP_OK;
 #endif
+}
+
+static esp_err_t yui_render_arc(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_ARC
+    lv_obj_t *arc = lv_arc_create(parent);
+    yui_register_widget_id(node, arc);
+    yui_apply_common_widget_attrs(arc, node, schema);
+    int32_t min = yui_node_resolved_i32(node, "min", scope, 0);
+    int32_t max = yui_node_resolved_i32(node, "max", scope, 100);
+    if (max < min) {
+        int32_t tmp = min;
+        min = max;
+        max = tmp;
+    }
+    lv_arc_set_range(arc, min, max);
+    int32_t value = yui_node_resolved_i32(node, "value", scope, min);
+    if (value < min) {
+        value = min;
+    } else if (value > max) {
+        value = max;
+    }
+    lv_arc_set_value(arc, value);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(arc, scope);
+    if (runtime) {
+        const char *value_tmpl = yui_node_scalar(node, "value");
+        if (value_tmpl) {
+            (void)yui_widget_bind_value(runtime, value_tmpl, arc, YUI_VALUE_BIND_ARC);
+        }
+        (void)yui_widget_bind_conditions(runtime, node, arc);
+        (void)yui_widget_parse_events(node, runtime);
     }
-    if (strcmp(type, "dropdown") == 0) {
+    return ESP_OK;
+#else
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'arc' unavailable: LV_USE_ARC=0");
+    return ESP_OK;
+#endif
+}
+
+static esp_err_t yui_render_dropdown(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
 #if LV_USE_DROPDOWN
-        lv_obj_t *dd = lv_dropdown_create(parent);
-        yui_register_widget_id(node, dd);
-        yui_apply_common_widget_attrs(dd, node, schema);
-        char *options_joined = yui_node_join_sequence_scalar(node, "options");
-        const char *options = options_joined ? options_joined : yui_node_scalar(node, "options");
-        if (options && options[0] != '\0') {
-            lv_dropdown_set_options(dd, options);
-        }
-        char value_buf[YUI_TEXT_BUFFER_MAX];
-        const char *value = yui_node_resolved_scalar(node, "value", scope, value_buf, sizeof(value_buf));
-        if (value && value[0] != '\0') {
-            (void)yui_dropdown_select_value(dd, value);
-        }
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(dd, scope);
-        if (runtime) {
-            const char *value_tmpl = yui_node_scalar(node, "value");
-            if (value_tmpl) {
-                (void)yui_widget_bind_value(runtime, value_tmpl, dd, YUI_VALUE_BIND_DROPDOWN);
-            }
-            (void)yui_widget_bind_conditions(runtime, node, dd);
-            (void)yui_widget_parse_events(node, runtime);
+    lv_obj_t *dd = lv_dropdown_create(parent);
+    yui_register_widget_id(node, dd);
+    yui_apply_common_widget_attrs(dd, node, schema);
+    char *options_joined = yui_node_join_sequence_scalar(node, "options");
+    const char *options = options_joined ? options_joined : yui_node_scalar(node, "options");
+    if (options && options[0] != '\0') {
+        lv_dropdown_set_options(dd, options);
+    }
+    char value_buf[YUI_TEXT_BUFFER_MAX];
+    const char *value = yui_node_resolved_scalar(node, "value", scope, value_buf, sizeof(value_buf));
+    if (value && value[0] != '\0') {
+        (void)yui_dropdown_select_value(dd, value);
+    }
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(dd, scope);
+    if (runtime) {
+        const char *value_tmpl = yui_node_scalar(node, "value");
+        if (value_tmpl) {
+            (void)yui_widget_bind_value(runtime, value_tmpl, dd, YUI_VALUE_BIND_DROPDOWN);
         }
-        free(options_joined);
-        return ESP_OK;
+        (void)yui_widget_bind_conditions(runtime, node, dd);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    free(options_joined);
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'dropdown' unavailable: LV_USE_DROPDOWN=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'dropdown' unavailable: LV_USE_DROPDOWN=0");
+    return ESP_OK;
 #endif
-    }
-    if (strcmp(type, "roller") == 0) {
+}
+
+static esp_err_t yui_render_roller(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
 #if LV_USE_ROLLER
-        lv_obj_t *roller = lv_roller_create(parent);
-        yui_register_widget_id(node, roller);
-        yui_apply_common_widget_attrs(roller, node, schema);
-        char *options_joined = yui_node_join_sequence_scalar(node, "options");
-        const char *options = options_joined ? options_joined : yui_node_scalar(node, "options");
-        if (options && options[0] != '\0') {
-            const char *mode = yui_node_scalar(node, "mode");
-            lv_roller_set_options(roller,
-                                  options,
-                                  (mode && strcasecmp(mode, "infinite") == 0) ? LV_ROLLER_MODE_INFINITE : LV_ROLLER_MODE_NORMAL);
-        }
-        uint32_t visible_rows = (uint32_t)yui_node_resolved_i32(node, "visible_row_count", scope, 3);
-        if (visible_rows > 0U) {
-            lv_roller_set_visible_row_count(roller, visible_rows);
-        }
-        char value_buf[YUI_TEXT_BUFFER_MAX];
-        const char *value = yui_node_resolved_scalar(node, "value", scope, value_buf, sizeof(value_buf));
-        if (value && value[0] != '\0') {
-            (void)yui_roller_select_value(roller, value);
-        }
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(roller, scope);
-        if (runtime) {
-            const char *value_tmpl = yui_node_scalar(node, "value");
-            if (value_tmpl) {
-                (void)yui_widget_bind_value(runtime, value_tmpl, roller, YUI_VALUE_BIND_ROLLER);
-            }
-            (void)yui_widget_bind_conditions(runtime, node, roller);
-            (void)yui_widget_parse_events(node, runtime);
+    lv_obj_t *roller = lv_roller_create(parent);
+    yui_register_widget_id(node, roller);
+    yui_apply_common_widget_attrs(roller, node, schema);
+    char *options_joined = yui_node_join_sequence_scalar(node, "options");
+    const char *options = options_joined ? options_joined : yui_node_scalar(node, "options");
+    if (options && options[0] != '\0') {
+        const char *mode = yui_node_scalar(node, "mode");
+        lv_roller_set_options(roller,
+                              options,
+                              (mode && strcasecmp(mode, "infinite") == 0) ? LV_ROLLER_MODE_INFINITE : LV_ROLLER_MODE_NORMAL);
+    }
+    uint32_t visible_rows = (uint32_t)yui_node_resolved_i32(node, "visible_row_count", scope, 3);
+    if (visible_rows > 0U) {
+        lv_roller_set_visible_row_count(roller, visible_rows);
+    }
+    char value_buf[YUI_TEXT_BUFFER_MAX];
+    const char *value = yui_node_resolved_scalar(node, "value", scope, value_buf, sizeof(value_buf));
+    if (value && value[0] != '\0') {
+        (void)yui_roller_select_value(roller, value);
+    }
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(roller, scope);
+    if (runtime) {
+        const char *value_tmpl = yui_node_scalar(node, "value");
+        if (value_tmpl) {
+            (void)yui_widget_bind_value(runtime, value_tmpl, roller, YUI_VALUE_BIND_ROLLER);
         }
-        free(options_joined);
-        return ESP_OK;
+        (void)yui_widget_bind_conditions(runtime, node, roller);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    free(options_joined);
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'roller' unavailable: LV_USE_ROLLER=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'roller' unavailable: LV_USE_ROLLER=0");
+    return ESP_OK;
 #endif
-    }
-    if (strcmp(type, "led") == 0) {
+}
+
+static esp_err_t yui_render_led(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
 #if LV_USE_LED
-        lv_obj_t *led = lv_led_create(parent);
-        yui_register_widget_id(node, led);
-        if (!yui_node_has_child(node, "width")) {
-            lv_obj_set_width(led, 24);
-        }
-        if (!yui_node_has_child(node, "height")) {
-            lv_obj_set_height(led, 24);
-        }
-        yui_apply_common_widget_attrs(led, node, schema);
-        char color_buf[YUI_TEXT_BUFFER_MAX];
-        const char *color = yui_node_resolved_scalar(node, "color", scope, color_buf, sizeof(color_buf));
-        if (color && color[0] != '\0') {
-            lv_led_set_color(led, yui_color_from_string(color, lv_color_hex(0x22D3EE)));
-        }
-        char value_buf[YUI_TEXT_BUFFER_MAX];
-        const char *value = yui_node_resolved_scalar(node, "value", scope, value_buf, sizeof(value_buf));
-        if (value && value[0] != '\0') {
-            char *end = NULL;
-            long bright = strtol(value, &end, 10);
-            if (end && end != value) {
-                if (bright < 0) {
-                    bright = 0;
-                }
-                if (bright > 255) {
-                    bright = 255;
-                }
-                lv_led_set_brightness(led, (uint8_t)bright);
-                if (bright <= 0) {
-                    lv_led_off(led);
-                }
-            } else if (yui_parse_bool(value, false)) {
-                lv_led_on(led);
-            } else {
+    lv_obj_t *led = lv_led_create(parent);
+    yui_register_widget_id(node, led);
+    if (!yui_node_has_child(node, "width")) {
+        lv_obj_set_width(led, 24);
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(led, 24);
+    }
+    yui_apply_common_widget_attrs(led, node, schema);
+    char color_buf[YUI_TEXT_BUFFER_MAX];
+    const char *color = yui_node_resolved_scalar(node, "color", scope, color_buf, sizeof(color_buf));
+    if (color && color[0] != '\0') {
+        lv_led_set_color(led, yui_color_from_string(color, lv_color_hex(0x22D3EE)));
+    }
+    char value_buf[YUI_TEXT_BUFFER_MAX];
+    const char *value = yui_node_resolved_scalar(node, "value", scope, value_buf, sizeof(value_buf));
+    if (value && value[0] != '\0') {
+        char *end = NULL;
+        long bright = strtol(value, &end, 10);
+        if (end && end != value) {
+            if (bright < 0) {
+                bright = 0;
+            }
+            if (bright > 255) {
+                bright = 255;
+            }
+            lv_led_set_brightness(led, (uint8_t)bright);
+            if (bright <= 0) {
                 lv_led_off(led);
             }
+        } else if (yui_parse_bool(value, false)) {
+            lv_led_on(led);
+        } else {
+            lv_led_off(led);
         }
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(led, scope);
-        if (runtime) {
-            const char *value_tmpl = yui_node_scalar(node, "value");
-            if (value_tmpl) {
-                (void)yui_widget_bind_value(runtime, value_tmpl, led, YUI_VALUE_BIND_LED);
-            }
-            (void)yui_widget_bind_conditions(runtime, node, led);
-            (void)yui_widget_parse_events(node, runtime);
+    }
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(led, scope);
+    if (runtime) {
+        const char *value_tmpl = yui_node_scalar(node, "value");
+        if (value_tmpl) {
+            (void)yui_widget_bind_value(runtime, value_tmpl, led, YUI_VALUE_BIND_LED);
         }
-        return ESP_OK;
+        (void)yui_widget_bind_conditions(runtime, node, led);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'led' unavailable: LV_USE_LED=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'led' unavailable: LV_USE_LED=0");
+    return ESP_OK;
 #endif
-    }
-    if (strcmp(type, "chart") == 0) {
+}
+
+static esp_err_t yui_render_chart(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
 #if LV_USE_CHART
-        lv_obj_t *chart = lv_chart_create(parent);
-        yui_register_widget_id(node, chart);
-        if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
-            lv_obj_set_width(chart, LV_PCT(100));
-        }
-        if (!yui_node_has_child(node, "height")) {
-            lv_obj_set_height(chart, 180);
-        }
-        yui_apply_common_widget_attrs(chart, node, schema);
-        lv_chart_set_type(chart, yui_chart_type_from_string(yui_node_scalar(node, "chart_type")));
-        lv_chart_set_update_mode(chart, yui_chart_update_mode_from_string(yui_node_scalar(node, "update_mode")));
-        lv_chart_set_point_count(chart, (uint32_t)yui_node_resolved_i32(node, "point_count", scope, 7));
-        lv_chart_set_div_line_count(chart,
-                                    (uint32_t)yui_node_resolved_i32(node, "horizontal_dividers", scope, 4),
-                                    (uint32_t)yui_node_resolved_i32(node, "vertical_dividers", scope, 6));
-
-        int32_t y_min = yui_node_resolved_i32(node, "min", scope, 0);
-        int32_t y_max = yui_node_resolved_i32(node, "max", scope, 100);
-        lv_chart_set_axis_range(chart, LV_CHART_AXIS_PRIMARY_Y, y_min, y_max);
-
-        const yml_node_t *series_node = yml_node_get_child(node, "series");
-        if (series_node && yml_node_get_type(series_node) == YML_NODE_SEQUENCE) {
-            uint32_t series_count = (uint32_t)yml_node_child_count(series_node);
-            for (uint32_t i = 0; i < series_count; ++i) {
-                const yml_node_t *series_item = yml_node_child_at(series_node, i);
-                if (!series_item || yml_node_get_type(series_item) != YML_NODE_MAPPING) {
-                    continue;
-                }
+    lv_obj_t *chart = lv_chart_create(parent);
+    yui_register_widget_id(node, chart);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(chart, LV_PCT(100));
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(chart, 180);
+    }
+    yui_apply_common_widget_attrs(chart, node, schema);
+    lv_chart_set_type(chart, yui_chart_type_from_string(yui_node_scalar(node, "chart_type")));
+    lv_chart_set_update_mode(chart, yui_chart_update_mode_from_string(yui_node_scalar(node, "update_mode")));
+    lv_chart_set_point_count(chart, (uint32_t)yui_node_resolved_i32(node, "point_count", scope, 7));
+    lv_chart_set_div_line_count(chart,
+                                (uint32_t)yui_node_resolved_i32(node, "horizontal_dividers", scope, 4),
+                                (uint32_t)yui_node_resolved_i32(node, "vertical_dividers", scope, 6));
+
+    int32_t y_min = yui_node_resolved_i32(node, "min", scope, 0);
+    int32_t y_max = yui_node_resolved_i32(node, "max", scope, 100);
+    lv_chart_set_axis_range(chart, LV_CHART_AXIS_PRIMARY_Y, y_min, y_max);
+
+    const yml_node_t *series_node = yml_node_get_child(node, "series");
+    if (series_node && yml_node_get_type(series_node) == YML_NODE_SEQUENCE) {
+        uint32_t series_count = (uint32_t)yml_node_child_count(series_node);
+        for (uint32_t i = 0; i < series_count; ++i) {
+            const yml_node_t *series_item = yml_node_child_at(series_node, i);
+            if (!series_item || yml_node_get_type(series_item) != YML_NODE_MAPPING) {
+                continue;
+            }
 
-                const char *color_text = yui_node_scalar(series_item, "color");
-                lv_color_t color = yui_color_from_string(color_text, lv_palette_main((lv_palette_t)(LV_PALETTE_BLUE + (i % 5))));
-                lv_chart_axis_t axis = yui_chart_axis_from_string(yui_node_scalar(series_item, "axis"));
-                lv_chart_series_t *ser = lv_chart_add_series(chart, color, axis);
-                if (!ser) {
-                    continue;
-                }
+            const char *color_text = yui_node_scalar(series_item, "color");
+            lv_color_t color = yui_color_from_string(color_text, lv_palette_main((lv_palette_t)(LV_PALETTE_BLUE + (i % 5))));
+            lv_chart_axis_t axis = yui_chart_axis_from_string(yui_node_scalar(series_item, "axis"));
+            lv_chart_series_t *ser = lv_chart_add_series(chart, color, axis);
+            if (!ser) {
+                continue;
+            }
 
-                const yml_node_t *values_node = yml_node_get_child(series_item, "values");
-                if (values_node && yml_node_get_type(values_node) == YML_NODE_SEQUENCE) {
-                    uint32_t value_count = (uint32_t)yml_node_child_count(values_node);
-                    int32_t *series_values = lv_chart_get_series_y_array(chart, ser);
-                    uint32_t point_count = lv_chart_get_point_count(chart);
-                    if (series_values) {
-                        for (uint32_t point = 0; point < point_count; ++point) {
-                            series_values[point] = 0;
-                        }
-                        for (uint32_t point = 0; point < value_count && point < point_count; ++point) {
-                            const yml_node_t *value_node = yml_node_child_at(values_node, point);
-                            char value_buf[32];
-                            const char *value_text = yui_format_node_text(value_node, scope, value_buf, sizeof(value_buf)) ? value_buf : NULL;
-                            if (value_text && value_text[0] != '\0') {
-                                series_values[point] = atoi(value_text);
-                            }
+            const yml_node_t *values_node = yml_node_get_child(series_item, "values");
+            if (values_node && yml_node_get_type(values_node) == YML_NODE_SEQUENCE) {
+                uint32_t value_count = (uint32_t)yml_node_child_count(values_node);
+                int32_t *series_values = lv_chart_get_series_y_array(chart, ser);
+                uint32_t point_count = lv_chart_get_point_count(chart);
+                if (series_values) {
+                    for (uint32_t point = 0; point < point_count; ++point) {
+                        series_values[point] = 0;
+                    }
+                    for (uint32_t point = 0; point < value_count && point < point_count; ++point) {
+                        const yml_node_t *value_node = yml_node_child_at(values_node, point);
+                        char value_buf[32];
+                        const char *value_text = yui_format_node_text(value_node, scope, value_buf, sizeof(value_buf)) ? value_buf : NULL;
+                        if (value_text && value_text[0] != '\0') {
+                            series_values[point] = atoi(value_text);
                         }
                     }
                 }
             }
         }
+    }
 
-        lv_obj_set_style_bg_color(chart, lv_color_hex(0x0F172A), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(chart, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_border_color(chart, lv_color_hex(0x334155), LV_PART_MAIN);
-        lv_obj_set_style_border_width(chart, 1, LV_PART_MAIN);
-        lv_obj_set_style_radius(chart, 12, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(chart, 8, LV_PART_MAIN);
-        lv_obj_set_style_line_color(chart, lv_color_hex(0x334155), LV_PART_MAIN);
-        lv_obj_set_style_line_opa(chart, LV_OPA_60, LV_PART_MAIN);
-        lv_obj_set_style_text_color(chart, lv_color_hex(0xCBD5E1), LV_PART_MAIN);
-        lv_obj_set_style_size(chart, 0, 0, LV_PART_INDICATOR);
-        lv_chart_refresh(chart);
+    lv_obj_set_style_bg_color(chart, lv_color_hex(0x0F172A), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(chart, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_color(chart, lv_color_hex(0x334155), LV_PART_MAIN);
+    lv_obj_set_style_border_width(chart, 1, LV_PART_MAIN);
+    lv_obj_set_style_radius(chart, 12, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(chart, 8, LV_PART_MAIN);
+    lv_obj_set_style_line_color(chart, lv_color_hex(0x334155), LV_PART_MAIN);
+    lv_obj_set_style_line_opa(chart, LV_OPA_60, LV_PART_MAIN);
+    lv_obj_set_style_text_color(chart, lv_color_hex(0xCBD5E1), LV_PART_MAIN);
+    lv_obj_set_style_size(chart, 0, 0, LV_PART_INDICATOR);
+    lv_chart_refresh(chart);
 
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(chart, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, chart);
-            (void)yui_widget_parse_events(node, runtime);
-        }
-        return ESP_OK;
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(chart, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, chart);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'chart' unavailable: LV_USE_CHART=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'chart' unavailable: LV_USE_CHART=0");
+    return ESP_OK;
 #endif
-    }
-    if (strcmp(type, "calendar") == 0) {
+}
+
+static esp_err_t yui_render_calendar(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
 #if LV_USE_CALENDAR
-        lv_obj_t *calendar = lv_calendar_create(parent);
-        yui_register_widget_id(node, calendar);
-        if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
-            lv_obj_set_width(calendar, LV_PCT(100));
-        }
-        if (!yui_node_has_child(node, "height")) {
-            lv_obj_set_height(calendar, 260);
-        }
-        yui_apply_common_widget_attrs(calendar, node, schema);
-
-        lv_obj_set_style_bg_color(calendar, lv_color_hex(0x0F172A), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(calendar, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_border_color(calendar, lv_color_hex(0x334155), LV_PART_MAIN);
-        lv_obj_set_style_border_width(calendar, 1, LV_PART_MAIN);
-        lv_obj_set_style_radius(calendar, 12, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(calendar, 8, LV_PART_MAIN);
-        lv_obj_set_style_text_color(calendar, lv_color_hex(0xE2E8F0), LV_PART_MAIN);
-        lv_obj_set_style_bg_color(calendar, lv_color_hex(0x1E293B), LV_PART_ITEMS);
-        lv_obj_set_style_bg_opa(calendar, LV_OPA_COVER, LV_PART_ITEMS);
-        lv_obj_set_style_border_color(calendar, lv_color_hex(0x334155), LV_PART_ITEMS);
-        lv_obj_set_style_border_width(calendar, 1, LV_PART_ITEMS);
-        lv_obj_set_style_text_color(calendar, lv_color_hex(0xE2E8F0), LV_PART_ITEMS);
-
-        lv_calendar_date_t parsed_date;
-        char date_buf[32];
-        const char *today_text = yui_node_resolved_scalar(node, "today", scope, date_buf, sizeof(date_buf));
-        if (today_text && yui_parse_calendar_date_string(today_text, &parsed_date)) {
-            lv_calendar_set_today_date(calendar, parsed_date.year, parsed_date.month, parsed_date.day);
-        }
-
-        char shown_buf[32];
-        const char *shown_text = yui_node_resolved_scalar(node, "shown_month", scope, shown_buf, sizeof(shown_buf));
-        if (shown_text && yui_parse_calendar_date_string(shown_text, &parsed_date)) {
-            lv_calendar_set_month_shown(calendar, parsed_date.year, parsed_date.month);
-        } else if (today_text && yui_parse_calendar_date_string(today_text, &parsed_date)) {
-            lv_calendar_set_month_shown(calendar, parsed_date.year, parsed_date.month);
-        }
-
-        const yml_node_t *highlights_node = yml_node_get_child(node, "highlighted_dates");
-        if (highlights_node && yml_node_get_type(highlights_node) == YML_NODE_SEQUENCE) {
-            size_t highlight_count = yml_node_child_count(highlights_node);
-            if (highlight_count > 0U) {
-                yui_calendar_runtime_t *calendar_runtime = (yui_calendar_runtime_t *)calloc(1, sizeof(yui_calendar_runtime_t));
-                if (calendar_runtime) {
-                    calendar_runtime->highlighted_dates = (lv_calendar_date_t *)calloc(highlight_count, sizeof(lv_calendar_date_t));
-                    if (calendar_runtime->highlighted_dates) {
-                        size_t resolved_count = 0U;
-                        for (size_t i = 0; i < highlight_count; ++i) {
-                            const yml_node_t *highlight_node = yml_node_child_at(highlights_node, i);
-                            char highlight_buf[32];
-                            const char *highlight_text = yui_format_node_text(highlight_node, scope, highlight_buf, sizeof(highlight_buf)) ? highlight_buf : NULL;
-                            if (highlight_text && yui_parse_calendar_date_string(highlight_text, &calendar_runtime->highlighted_dates[resolved_count])) {
-                                resolved_count++;
-                            }
-                        }
-                        if (resolved_count > 0U) {
-                            calendar_runtime->highlighted_count = resolved_count;
-                            lv_calendar_set_highlighted_dates(calendar, calendar_runtime->highlighted_dates, calendar_runtime->highlighted_count);
-                            lv_obj_add_event_cb(calendar, yui_calendar_delete_cb, LV_EVENT_DELETE, calendar_runtime);
-                            calendar_runtime = NULL;
+    lv_obj_t *calendar = lv_calendar_create(parent);
+    yui_register_widget_id(node, calendar);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(calendar, LV_PCT(100));
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(calendar, 260);
+    }
+    yui_apply_common_widget_attrs(calendar, node, schema);
+
+    lv_obj_set_style_bg_color(calendar, lv_color_hex(0x0F172A), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(calendar, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_color(calendar, lv_color_hex(0x334155), LV_PART_MAIN);
+    lv_obj_set_style_border_width(calendar, 1, LV_PART_MAIN);
+    lv_obj_set_style_radius(calendar, 12, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(calendar, 8, LV_PART_MAIN);
+    lv_obj_set_style_text_color(calendar, lv_color_hex(0xE2E8F0), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(calendar, lv_color_hex(0x1E293B), LV_PART_ITEMS);
+    lv_obj_set_style_bg_opa(calendar, LV_OPA_COVER, LV_PART_ITEMS);
+    lv_obj_set_style_border_color(calendar, lv_color_hex(0x334155), LV_PART_ITEMS);
+    lv_obj_set_style_border_width(calendar, 1, LV_PART_ITEMS);
+    lv_obj_set_style_text_color(calendar, lv_color_hex(0xE2E8F0), LV_PART_ITEMS);
+
+    lv_calendar_date_t parsed_date;
+    char date_buf[32];
+    const char *today_text = yui_node_resolved_scalar(node, "today", scope, date_buf, sizeof(date_buf));
+    if (today_text && yui_parse_calendar_date_string(today_text, &parsed_date)) {
+        lv_calendar_set_today_date(calendar, parsed_date.year, parsed_date.month, parsed_date.day);
+    }
+
+    char shown_buf[32];
+    const char *shown_text = yui_node_resolved_scalar(node, "shown_month", scope, shown_buf, sizeof(shown_buf));
+    if (shown_text && yui_parse_calendar_date_string(shown_text, &parsed_date)) {
+        lv_calendar_set_month_shown(calendar, parsed_date.year, parsed_date.month);
+    } else if (today_text && yui_parse_calendar_date_string(today_text, &parsed_date)) {
+        lv_calendar_set_month_shown(calendar, parsed_date.year, parsed_date.month);
+    }
+
+    const yml_node_t *highlights_node = yml_node_get_child(node, "highlighted_dates");
+    if (highlights_node && yml_node_get_type(highlights_node) == YML_NODE_SEQUENCE) {
+        size_t highlight_count = yml_node_child_count(highlights_node);
+        if (highlight_count > 0U) {
+            yui_calendar_runtime_t *calendar_runtime = (yui_calendar_runtime_t *)calloc(1, sizeof(yui_calendar_runtime_t));
+            if (calendar_runtime) {
+                calendar_runtime->highlighted_dates = (lv_calendar_date_t *)calloc(highlight_count, sizeof(lv_calendar_date_t));
+                if (calendar_runtime->highlighted_dates) {
+                    size_t resolved_count = 0U;
+                    for (size_t i = 0; i < highlight_count; ++i) {
+                        const yml_node_t *highlight_node = yml_node_child_at(highlights_node, i);
+                        char highlight_buf[32];
+                        const char *highlight_text = yui_format_node_text(highlight_node, scope, highlight_buf, sizeof(highlight_buf)) ? highlight_buf : NULL;
+                        if (highlight_text && yui_parse_calendar_date_string(highlight_text, &calendar_runtime->highlighted_dates[resolved_count])) {
+                            resolved_count++;
                         }
                     }
-                    if (calendar_runtime) {
-                        free(calendar_runtime->highlighted_dates);
-                        free(calendar_runtime);
+                    if (resolved_count > 0U) {
+                        calendar_runtime->highlighted_count = resolved_count;
+                        lv_calendar_set_highlighted_dates(calendar, calendar_runtime->highlighted_dates, calendar_runtime->highlighted_count);
+                        lv_obj_add_event_cb(calendar, yui_calendar_delete_cb, LV_EVENT_DELETE, calendar_runtime);
+                        calendar_runtime = NULL;
                     }
                 }
+                if (calendar_runtime) {
+                    free(calendar_runtime->highlighted_dates);
+                    free(calendar_runtime);
+                }
             }
         }
+    }
 
 #if LV_USE_CALENDAR_HEADER_ARROW
-        lv_calendar_add_header_arrow(calendar);
+    lv_calendar_add_header_arrow(calendar);
 #elif LV_USE_CALENDAR_HEADER_DROPDOWN
-        lv_calendar_add_header_dropdown(calendar);
+    lv_calendar_add_header_dropdown(calendar);
 #endif
 
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(calendar, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, calendar);
-            (void)yui_widget_parse_events(node, runtime);
-        }
-        return ESP_OK;
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(calendar, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, calendar);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
 #else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'calendar' unavailable: LV_USE_CALENDAR=0");
-        return ESP_OK;
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'calendar' unavailable: LV_USE_CALENDAR=0");
+    return ESP_OK;
 #endif
-    }
-    if (strcmp(type, "menu") == 0) {
+}
+
 #if LV_USE_MENU
-        lv_obj_t *menu = lv_menu_create(parent);
-        yui_register_widget_id(node, menu);
-        if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
-            lv_obj_set_width(menu, LV_PCT(100));
-        }
-        if (!yui_node_has_child(node, "height")) {
-            lv_obj_set_height(menu, 320);
-        }
-        yui_apply_common_widget_attrs(menu, node, schema);
-
-        lv_menu_set_mode_header(menu, yui_menu_header_mode_from_string(yui_node_scalar(node, "header_mode")));
-        lv_menu_set_mode_root_back_button(menu,
-                                          yui_menu_root_back_button_mode_from_string(yui_node_scalar(node, "root_back_button")));
-
-        lv_obj_set_style_bg_color(menu, lv_color_hex(0x0F172A), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(menu, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_border_width(menu, 0, LV_PART_MAIN);
-        lv_obj_set_style_radius(menu, 0, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(menu, 0, LV_PART_MAIN);
-        lv_obj_set_style_shadow_width(menu, 0, LV_PART_MAIN);
-        lv_obj_set_style_shadow_opa(menu, LV_OPA_TRANSP, LV_PART_MAIN);
-
-        lv_obj_t *main_header = lv_menu_get_main_header(menu);
-        if (main_header) {
-            lv_obj_set_style_bg_color(main_header, lv_color_hex(0x111827), LV_PART_MAIN);
-            lv_obj_set_style_bg_opa(main_header, LV_OPA_COVER, LV_PART_MAIN);
-            lv_obj_set_style_border_width(main_header, 0, LV_PART_MAIN);
-            lv_obj_set_style_text_color(main_header, lv_color_hex(0xE2E8F0), LV_PART_MAIN);
-            lv_obj_set_style_shadow_width(main_header, 0, LV_PART_MAIN);
-            lv_obj_set_style_shadow_opa(main_header, LV_OPA_TRANSP, LV_PART_MAIN);
-        }
-
-        char root_title_buf[YUI_TEXT_BUFFER_MAX];
-        const char *root_title = yui_node_resolved_localized_scalar(node,
-                                                                    "root_title",
-                                                                    "root_title_key",
-                                                                    scope,
-                                                                    root_title_buf,
-                                                                    sizeof(root_title_buf));
-        lv_obj_t *root_page = lv_menu_page_create(menu, root_title && root_title[0] != '\0' ? root_title : NULL);
-        if (root_page) {
-            lv_obj_set_style_bg_color(root_page, lv_color_hex(0x0F172A), LV_PART_MAIN);
-            lv_obj_set_style_bg_opa(root_page, LV_OPA_COVER, LV_PART_MAIN);
-            lv_obj_set_style_pad_all(root_page, 8, LV_PART_MAIN);
-            lv_obj_set_style_shadow_width(root_page, 0, LV_PART_MAIN);
-            lv_obj_set_style_shadow_opa(root_page, LV_OPA_TRANSP, LV_PART_MAIN);
-        }
-
-        lv_obj_t *root_section = root_page ? lv_menu_section_create(root_page) : NULL;
-        if (root_section) {
-            lv_obj_set_style_bg_opa(root_section, LV_OPA_TRANSP, LV_PART_MAIN);
-            lv_obj_set_style_border_width(root_section, 0, LV_PART_MAIN);
-            lv_obj_set_style_pad_all(root_section, 0, LV_PART_MAIN);
-            lv_obj_set_style_shadow_width(root_section, 0, LV_PART_MAIN);
-            lv_obj_set_style_shadow_opa(root_section, LV_OPA_TRANSP, LV_PART_MAIN);
-        }
-
-        const yml_node_t *items_node = yml_node_get_child(node, "items");
-        if (root_page && root_section && items_node && yml_node_get_type(items_node) == YML_NODE_SEQUENCE) {
-            size_t item_count = yml_node_child_count(items_node);
-            for (size_t i = 0; i < item_count; ++i) {
-                const yml_node_t *item_node = yml_node_child_at(items_node, i);
-                if (!item_node || yml_node_get_type(item_node) != YML_NODE_MAPPING) {
-                    continue;
-                }
+static void yui_set_menu_page_title(lv_obj_t *target, uint32_t index, const char *text)
+{
+    (void)index;
+    lv_menu_set_page_title(target, text);
+}
+#endif
+
+static esp_err_t yui_render_menu(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_MENU
+    lv_obj_t *menu = lv_menu_create(parent);
+    yui_register_widget_id(node, menu);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(menu, LV_PCT(100));
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(menu, 320);
+    }
+    yui_apply_common_widget_attrs(menu, node, schema);
+
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(menu, scope);
+
+    lv_menu_set_mode_header(menu, yui_menu_header_mode_from_string(yui_node_scalar(node, "header_mode")));
+    lv_menu_set_mode_root_back_button(menu,
+                                      yui_menu_root_back_button_mode_from_string(yui_node_scalar(node, "root_back_button")));
+
+    lv_obj_set_style_bg_color(menu, lv_color_hex(0x0F172A), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(menu, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_width(menu, 0, LV_PART_MAIN);
+    lv_obj_set_style_radius(menu, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(menu, 0, LV_PART_MAIN);
+    lv_obj_set_style_shadow_width(menu, 0, LV_PART_MAIN);
+    lv_obj_set_style_shadow_opa(menu, LV_OPA_TRANSP, LV_PART_MAIN);
+
+    lv_obj_t *main_header = lv_menu_get_main_header(menu);
+    if (main_header) {
+        lv_obj_set_style_bg_color(main_header, lv_color_hex(0x111827), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(main_header, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_set_style_border_width(main_header, 0, LV_PART_MAIN);
+        lv_obj_set_style_text_color(main_header, lv_color_hex(0xE2E8F0), LV_PART_MAIN);
+        lv_obj_set_style_shadow_width(main_header, 0, LV_PART_MAIN);
+        lv_obj_set_style_shadow_opa(main_header, LV_OPA_TRANSP, LV_PART_MAIN);
+    }
+
+    char root_title_buf[YUI_TEXT_BUFFER_MAX];
+    const char *root_title = yui_node_resolved_localized_scalar(node,
+                                                                "root_title",
+                                                                "root_title_key",
+                                                                scope,
+                                                                root_title_buf,
+                                                                sizeof(root_title_buf));
+    lv_obj_t *root_page = lv_menu_page_create(menu, root_title && root_title[0] != '\0' ? root_title : NULL);
+    if (root_page) {
+        (void)yui_widget_bind_localized(runtime, node, "root_title_key", root_page, 0U, yui_set_menu_page_title);
+        lv_obj_set_style_bg_color(root_page, lv_color_hex(0x0F172A), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(root_page, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_set_style_pad_all(root_page, 8, LV_PART_MAIN);
+        lv_obj_set_style_shadow_width(root_page, 0, LV_PART_MAIN);
+        lv_obj_set_style_shadow_opa(root_page, LV_OPA_TRANSP, LV_PART_MAIN);
+    }
+
+    lv_obj_t *root_section = root_page ? lv_menu_section_create(root_page) : NULL;
+    if (root_section) {
+        lv_obj_set_style_bg_opa(root_section, LV_OPA_TRANSP, LV_PART_MAIN);
+        lv_obj_set_style_border_width(root_section, 0, LV_PART_MAIN);
+        lv_obj_set_style_pad_all(root_section, 0, LV_PART_MAIN);
+        lv_obj_set_style_shadow_width(root_section, 0, LV_PART_MAIN);
+        lv_obj_set_style_shadow_opa(root_section, LV_OPA_TRANSP, LV_PART_MAIN);
+    }
+
+    const yml_node_t *items_node = yml_node_get_child(node, "items");
+    if (root_page && root_section && items_node && yml_node_get_type(items_node) == YML_NODE_SEQUENCE) {
+        size_t item_count = yml_node_child_count(items_node);
+        for (size_t i = 0; i < item_count; ++i) {
+            const yml_node_t *item_node = yml_node_child_at(items_node, i);
+            if (!item_node || yml_node_get_type(item_node) != YML_NODE_MAPPING) {
+                continue;
+            }
+
+            char item_title_buf[YUI_TEXT_BUFFER_MAX];
+            const char *item_title = yui_node_resolved_localized_scalar(item_node,
+                                                                        "title",
+                                                                        "title_key",
+                                                                        scope,
+                                                                        item_title_buf,
+                                                                        sizeof(item_title_buf));
+            if (!item_title || item_title[0] == '\0') {
+                item_title = "Item";
+            }
 
-                char item_title_buf[YUI_TEXT_BUFFER_MAX];
-                const char *item_title = yui_node_resolved_localized_scalar(item_node,
+            lv_obj_t *dest_page = NULL;
+            const yml_node_t *page_node = yml_node_get_child(item_node, "page");
+            if (page_node && yml_node_get_type(page_node) == YML_NODE_MAPPING) {
+                char page_title_buf[YUI_TEXT_BUFFER_MAX];
+                const char *page_title = yui_node_resolved_localized_scalar(page_node,
                                                                             "title",
                                                                             "title_key",
                                                                             scope,
-                                                                            item_title_buf,
-                                                                            sizeof(item_title_buf));
-                if (!item_title || item_title[0] == '\0') {
-                    item_title = "Item";
+                                                                            page_title_buf,
+                                                                            sizeof(page_title_buf));
+                if (!page_title || page_title[0] == '\0') {
+                    page_title = item_title;
                 }
 
-                lv_obj_t *dest_page = NULL;
-                const yml_node_t *page_node = yml_node_get_child(item_node, "page");
-                if (page_node && yml_node_get_type(page_node) == YML_NODE_MAPPING) {
-                    char page_title_buf[YUI_TEXT_BUFFER_MAX];
-                    const char *page_title = yui_node_resolved_localized_scalar(page_node,
-                                                                                "title",
-                                                                                "title_key",
-                                                                                scope,
-                                                                                page_title_buf,
-                                                                                sizeof(page_title_buf));
-                    if (!page_title || page_title[0] == '\0') {
-                        page_title = item_title;
+                dest_page = lv_menu_page_create(menu, page_title);
+                if (dest_page) {
+                    if (!yui_widget_bind_localized(runtime, page_node, "title_key", dest_page, 0U, yui_set_menu_page_title)
+                        && !yui_node_has_child(page_node, "title")) {
+                        (void)yui_widget_bind_localized(runtime, item_node, "title_key", dest_page, 0U, yui_set_menu_page_title);
                     }
-
-                    dest_page = lv_menu_page_create(menu, page_title);
-                    if (dest_page) {
-                        lv_obj_set_style_bg_color(dest_page, lv_color_hex(0x0F172A), LV_PART_MAIN);
-                        lv_obj_set_style_bg_opa(dest_page, LV_OPA_COVER, LV_PART_MAIN);
-                        lv_obj_set_style_pad_all(dest_page, 12, LV_PART_MAIN);
-                        lv_obj_set_style_shadow_width(dest_page, 0, LV_PART_MAIN);
-                        lv_obj_set_style_shadow_opa(dest_page, LV_OPA_TRANSP, LV_PART_MAIN);
-                        lv_obj_t *page_section = lv_menu_section_create(dest_page);
-                        if (page_section) {
-                            lv_obj_set_style_bg_opa(page_section, LV_OPA_TRANSP, LV_PART_MAIN);
-                            lv_obj_set_style_border_width(page_section, 0, LV_PART_MAIN);
-                            lv_obj_set_style_pad_all(page_section, 0, LV_PART_MAIN);
-                            lv_obj_set_style_shadow_width(page_section, 0, LV_PART_MAIN);
-                            lv_obj_set_style_shadow_opa(page_section, LV_OPA_TRANSP, LV_PART_MAIN);
-
-                            lv_obj_t *page_container = lv_menu_cont_create(page_section);
-                            if (page_container) {
-                                lv_obj_set_style_bg_color(page_container, lv_color_hex(0x0F172A), LV_PART_MAIN);
-                                lv_obj_set_style_bg_opa(page_container, LV_OPA_COVER, LV_PART_MAIN);
-                                lv_obj_set_style_border_width(page_container, 0, LV_PART_MAIN);
-                                lv_obj_set_style_pad_all(page_container, 0, LV_PART_MAIN);
-                                lv_obj_set_style_shadow_width(page_container, 0, LV_PART_MAIN);
-                                lv_obj_set_style_shadow_opa(page_container, LV_OPA_TRANSP, LV_PART_MAIN);
-                                yui_apply_layout(page_container, yml_node_get_child(page_node, "layout"), "column");
-                                esp_err_t render_err = yui_render_widget_list(yml_node_get_child(page_node, "widgets"), schema, page_container, scope);
-                                if (render_err != ESP_OK) {
-                                    return render_err;
-                                }
+                    lv_obj_set_style_bg_color(dest_page, lv_color_hex(0x0F172A), LV_PART_MAIN);
+                    lv_obj_set_style_bg_opa(dest_page, LV_OPA_COVER, LV_PART_MAIN);
+                    lv_obj_set_style_pad_all(dest_page, 12, LV_PART_MAIN);
+                    lv_obj_set_style_shadow_width(dest_page, 0, LV_PART_MAIN);
+                    lv_obj_set_style_shadow_opa(dest_page, LV_OPA_TRANSP, LV_PART_MAIN);
+                    lv_obj_t *page_section = lv_menu_section_create(dest_page);
+                    if (page_section) {
+                        lv_obj_set_style_bg_opa(page_section, LV_OPA_TRANSP, LV_PART_MAIN);
+                        lv_obj_set_style_border_width(page_section, 0, LV_PART_MAIN);
+                        lv_obj_set_style_pad_all(page_section, 0, LV_PART_MAIN);
+                        lv_obj_set_style_shadow_width(page_section, 0, LV_PART_MAIN);
+                        lv_obj_set_style_shadow_opa(page_section, LV_OPA_TRANSP, LV_PART_MAIN);
+
+                        lv_obj_t *page_container = lv_menu_cont_create(page_section);
+                        if (page_container) {
+                            lv_obj_set_style_bg_color(page_container, lv_color_hex(0x0F172A), LV_PART_MAIN);
+                            lv_obj_set_style_bg_opa(page_container, LV_OPA_COVER, LV_PART_MAIN);
+                            lv_obj_set_style_border_width(page_container, 0, LV_PART_MAIN);
+                            lv_obj_set_style_pad_all(page_container, 0, LV_PART_MAIN);
+                            lv_obj_set_style_shadow_width(page_container, 0, LV_PART_MAIN);
+                            lv_obj_set_style_shadow_opa(page_container, LV_OPA_TRANSP, LV_PART_MAIN);
+                            yui_apply_layout(page_container, yml_node_get_child(page_node, "layout"), "column");
+                            esp_err_t render_err = yui_render_widget_list(yml_node_get_child(page_node, "widgets"), schema, page_container, scope);
+                            if (render_err != ESP_OK) {
+                                return render_err;
                             }
                         }
                     }
                 }
+            }
 
-                lv_obj_t *cont = lv_menu_cont_create(root_section);
-                if (!cont) {
-                    continue;
-                }
-                lv_obj_set_style_bg_color(cont, lv_color_hex(0x111827), LV_PART_MAIN);
-                lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, LV_PART_MAIN);
-                lv_obj_set_style_border_width(cont, 0, LV_PART_MAIN);
-                lv_obj_set_style_radius(cont, 0, LV_PART_MAIN);
-                lv_obj_set_style_pad_all(cont, 10, LV_PART_MAIN);
-                lv_obj_set_style_shadow_width(cont, 0, LV_PART_MAIN);
-                lv_obj_set_style_shadow_opa(cont, LV_OPA_TRANSP, LV_PART_MAIN);
-
-                lv_obj_t *label = lv_label_create(cont);
-                lv_label_set_text(label, item_title);
-                lv_obj_set_style_text_color(label, lv_color_hex(0xE2E8F0), LV_PART_MAIN);
-
-                char subtitle_buf[YUI_TEXT_BUFFER_MAX];
-                const char *subtitle = yui_node_resolved_localized_scalar(item_node,
-                                                                          "subtitle",
-                                                                          "subtitle_key",
-                                                                          scope,
-                                                                          subtitle_buf,
-                                                                          sizeof(subtitle_buf));
-                if (subtitle && subtitle[0] != '\0') {
-                    lv_obj_t *sub = lv_label_create(cont);
-                    lv_label_set_text(sub, subtitle);
-                    lv_obj_set_style_text_color(sub, lv_color_hex(0x94A3B8), LV_PART_MAIN);
-                }
+            lv_obj_t *cont = lv_menu_cont_create(root_section);
+            if (!cont) {
+                continue;
+            }
+            lv_obj_set_style_bg_color(cont, lv_color_hex(0x111827), LV_PART_MAIN);
+            lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, LV_PART_MAIN);
+            lv_obj_set_style_border_width(cont, 0, LV_PART_MAIN);
+            lv_obj_set_style_radius(cont, 0, LV_PART_MAIN);
+            lv_obj_set_style_pad_all(cont, 10, LV_PART_MAIN);
+            lv_obj_set_style_shadow_width(cont, 0, LV_PART_MAIN);
+            lv_obj_set_style_shadow_opa(cont, LV_OPA_TRANSP, LV_PART_MAIN);
+
+            lv_obj_t *label = lv_label_create(cont);
+            lv_label_set_text(label, item_title);
+            lv_obj_set_style_text_color(label, lv_color_hex(0xE2E8F0), LV_PART_MAIN);
+            (void)yui_widget_bind_localized(runtime, item_node, "title_key", label, 0U, yui_set_label_text);
+
+            char subtitle_buf[YUI_TEXT_BUFFER_MAX];
+            const char *subtitle = yui_node_resolved_localized_scalar(item_node,
+                                                                      "subtitle",
+                                                                      "subtitle_key",
+                                                                      scope,
+                                                                      subtitle_buf,
+                                                                      sizeof(subtitle_buf));
+            if (subtitle && subtitle[0] != '\0') {
+                lv_obj_t *sub = lv_label_create(cont);
+                lv_label_set_text(sub, subtitle);
+                lv_obj_set_style_text_color(sub, lv_color_hex(0x94A3B8), LV_PART_MAIN);
+                (void)yui_widget_bind_localized(runtime, item_node, "subtitle_key", sub, 0U, yui_set_label_text);
+            }
 
-                if (dest_page) {
-                    lv_menu_set_load_page_event(menu, cont, dest_page);
-                }
+            if (dest_page) {
+                lv_menu_set_load_page_event(menu, cont, dest_page);
+            }
+        }
+    }
+
+    lv_menu_set_page(menu, root_page);
+    yui_disable_shadows_recursive(menu);
+
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, menu);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
+#else
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'menu' unavailable: LV_USE_MENU=0");
+    return ESP_OK;
+#endif
+}
+
+#if LV_USE_TABVIEW
+static void yui_set_tab_title(lv_obj_t *target, uint32_t index, const char *text)
+{
+    lv_tabview_rename_tab(target, index, text);
+}
+#endif
+
+static esp_err_t yui_render_tabview(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_TABVIEW
+    lv_obj_t *tabview = lv_tabview_create(parent);
+    yui_register_widget_id(node, tabview);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(tabview, LV_PCT(100));
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(tabview, 280);
+    }
+    yui_apply_common_widget_attrs(tabview, node, schema);
+
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(tabview, scope);
+
+    lv_tabview_set_tab_bar_position(tabview, yui_dir_from_string(yui_node_scalar(node, "tab_bar_position"), LV_DIR_TOP));
+    lv_tabview_set_tab_bar_size(tabview, yui_node_resolved_i32(node, "tab_bar_size", scope, 44));
+
+    lv_obj_set_style_bg_color(tabview, lv_color_hex(0x0F172A), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(tabview, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_color(tabview, lv_color_hex(0x334155), LV_PART_MAIN);
+    lv_obj_set_style_border_width(tabview, 1, LV_PART_MAIN);
+    lv_obj_set_style_radius(tabview, 12, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(tabview, 0, LV_PART_MAIN);
+
+    lv_obj_t *tab_bar = lv_tabview_get_tab_bar(tabview);
+    if (tab_bar) {
+        lv_obj_set_style_bg_color(tab_bar, lv_color_hex(0x111827), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(tab_bar, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_set_style_border_width(tab_bar, 0, LV_PART_MAIN);
+        lv_obj_set_style_text_color(tab_bar, lv_color_hex(0xCBD5E1), LV_PART_MAIN);
+        lv_obj_set_style_bg_color(tab_bar, lv_color_hex(0x22D3EE), LV_PART_ITEMS | LV_STATE_CHECKED);
+        lv_obj_set_style_text_color(tab_bar, lv_color_hex(0x0F172A), LV_PART_ITEMS | LV_STATE_CHECKED);
+    }
+
+    lv_obj_t *content = lv_tabview_get_content(tabview);
+    if (content) {
+        lv_obj_set_style_bg_color(content, lv_color_hex(0x0F172A), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(content, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_set_style_border_width(content, 0, LV_PART_MAIN);
+    }
+
+    const yml_node_t *tabs_node = yml_node_get_child(node, "tabs");
+    if (tabs_node && yml_node_get_type(tabs_node) == YML_NODE_SEQUENCE) {
+        size_t tab_count = yml_node_child_count(tabs_node);
+        for (size_t i = 0; i < tab_count; ++i) {
+            const yml_node_t *tab_node = yml_node_child_at(tabs_node, i);
+            if (!tab_node || yml_node_get_type(tab_node) != YML_NODE_MAPPING) {
+                continue;
             }
+
+            char title_buf[YUI_TEXT_BUFFER_MAX];
+            const char *tab_title = yui_node_resolved_localized_scalar(tab_node, "title", "title_key", scope, title_buf, sizeof(title_buf));
+            if (!tab_title || tab_title[0] == '\0') {
+                tab_title = "Tab";
+            }
+
+            uint32_t tab_index = lv_tabview_get_tab_count(tabview);
+            lv_obj_t *tab = lv_tabview_add_tab(tabview, tab_title);
+            (void)yui_widget_bind_localized(runtime, tab_node, "title_key", tabview, tab_index, yui_set_tab_title);
+            lv_obj_set_style_bg_color(tab, lv_color_hex(0x0F172A), LV_PART_MAIN);
+            lv_obj_set_style_bg_opa(tab, LV_OPA_COVER, LV_PART_MAIN);
+            lv_obj_set_style_pad_all(tab, 12, LV_PART_MAIN);
+            yui_apply_layout(tab, yml_node_get_child(tab_node, "layout"), "column");
+            esp_err_t render_err = yui_render_widget_list(yml_node_get_child(tab_node, "widgets"), schema, tab, scope);
+            if (render_err != ESP_OK) {
+                return render_err;
+            }
+        }
+    }
+
+    lv_tabview_set_active(tabview, (uint32_t)yui_node_resolved_i32(node, "active_tab", scope, 0), LV_ANIM_OFF);
+
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, tabview);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
+#else
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'tabview' unavailable: LV_USE_TABVIEW=0");
+    return ESP_OK;
+#endif
+}
+
+static esp_err_t yui_render_table(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_TABLE
+    lv_obj_t *table = lv_table_create(parent);
+    yui_register_widget_id(node, table);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(table, LV_PCT(100));
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(table, 160);
+    }
+    yui_apply_common_widget_attrs(table, node, schema);
+    lv_obj_clear_flag(table, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(table, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_remove_flag(table, LV_OBJ_FLAG_SCROLL_CHAIN_VER);
+    lv_obj_remove_flag(table, LV_OBJ_FLAG_SCROLL_CHAIN_HOR);
+    lv_obj_remove_flag(table, LV_OBJ_FLAG_SCROLL_ELASTIC);
+    lv_obj_remove_flag(table, LV_OBJ_FLAG_SCROLL_MOMENTUM);
+    lv_obj_set_style_bg_color(table, lv_color_hex(0x0F172A), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(table, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_color(table, lv_color_hex(0x334155), LV_PART_MAIN);
+    lv_obj_set_style_border_width(table, 1, LV_PART_MAIN);
+    lv_obj_set_style_radius(table, 12, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(table, 6, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(table, lv_color_hex(0x0F172A), LV_PART_ITEMS);
+    lv_obj_set_style_bg_opa(table, LV_OPA_COVER, LV_PART_ITEMS);
+    lv_obj_set_style_text_color(table, lv_color_hex(0xE2E8F0), LV_PART_ITEMS);
+    lv_obj_set_style_border_color(table, lv_color_hex(0x334155), LV_PART_ITEMS);
+    lv_obj_set_style_border_width(table, 1, LV_PART_ITEMS);
+
+    const yml_node_t *widths_node = yml_node_get_child(node, "column_widths");
+    uint32_t max_cols = 0U;
+    if (widths_node && yml_node_get_type(widths_node) == YML_NODE_SEQUENCE) {
+        max_cols = (uint32_t)yml_node_child_count(widths_node);
+    }
+
+    if (widths_node && yml_node_get_type(widths_node) == YML_NODE_SEQUENCE) {
+        uint32_t width_count = (uint32_t)yml_node_child_count(widths_node);
+        max_cols = width_count > max_cols ? width_count : max_cols;
+    }
+
+    const yml_node_t *rows_node = yml_node_get_child(node, "rows");
+    if (rows_node && yml_node_get_type(rows_node) == YML_NODE_SEQUENCE) {
+        uint32_t row_count = (uint32_t)yml_node_child_count(rows_node);
+        lv_table_set_row_count(table, row_count);
+        for (uint32_t row = 0; row < row_count; ++row) {
+            const yml_node_t *row_node = yml_node_child_at(rows_node, row);
+            uint32_t col_count = yui_table_row_column_count(row_node);
+            if (col_count > max_cols) {
+                max_cols = col_count;
+            }
+        }
+
+        if (max_cols > 0U) {
+            lv_table_set_column_count(table, max_cols);
+        }
+        if (widths_node && yml_node_get_type(widths_node) == YML_NODE_SEQUENCE) {
+            uint32_t width_count = (uint32_t)yml_node_child_count(widths_node);
+            for (uint32_t i = 0; i < width_count; ++i) {
+                const yml_node_t *width_node = yml_node_child_at(widths_node, i);
+                const char *width_text = width_node ? yml_node_get_scalar(width_node) : NULL;
+                if (width_text && width_text[0] != '\0') {
+                    lv_table_set_column_width(table, i, atoi(width_text));
+                }
+            }
+        }
+
+        for (uint32_t row = 0; row < row_count; ++row) {
+            const yml_node_t *row_node = yml_node_child_at(rows_node, row);
+            uint32_t col_count = yui_table_row_column_count(row_node);
+            for (uint32_t col = 0; col < col_count; ++col) {
+                const yml_node_t *cell_node = yui_table_row_cell_at(row_node, col);
+                char cell_buf[YUI_TEXT_BUFFER_MAX];
+                const char *cell_text = yui_format_node_text(cell_node, scope, cell_buf, sizeof(cell_buf)) ? cell_buf : "";
+                lv_table_set_cell_value(table, row, col, cell_text ? cell_text : "");
+            }
+        }
+    }
+
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(table, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, table);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
+#else
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'table' unavailable: LV_USE_TABLE=0");
+    return ESP_OK;
+#endif
+}
+
+static esp_err_t yui_render_virtual_list(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    return yui_render_virtual_view(node, schema, parent, scope, false);
+}
+
+static esp_err_t yui_render_virtual_table(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    return yui_render_virtual_view(node, schema, parent, scope, true);
+}
+
+static esp_err_t yui_render_keyboard(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_KEYBOARD
+    bool overlay = yui_node_resolved_bool(node, "overlay", scope, false);
+    lv_obj_t *kb_parent = overlay ? lv_obj_get_screen(parent) : parent;
+    lv_obj_t *kb = lv_keyboard_create(kb_parent);
+    yui_register_widget_id(node, kb);
+    yui_apply_common_widget_attrs(kb, node, schema);
+    if (overlay) {
+        if (!yui_node_has_child(node, "width")) {
+            lv_obj_set_width(kb, LV_PCT(100));
+        }
+        if (!yui_node_has_child(node, "height")) {
+            lv_obj_set_height(kb, 300);
+        }
+        lv_obj_add_flag(kb, LV_OBJ_FLAG_FLOATING);
+        lv_obj_add_flag(kb, LV_OBJ_FLAG_IGNORE_LAYOUT);
+        lv_obj_align(kb, LV_ALIGN_BOTTOM_MID, 0, 0);
+        lv_obj_move_foreground(kb);
+    }
+    const char *target_id = yui_node_scalar(node, "target");
+    if (target_id && target_id[0] != '\0') {
+        lv_obj_t *target_obj = yui_widget_ref_find(target_id);
+        if (target_obj) {
+            lv_keyboard_set_textarea(kb, target_obj);
+        } else {
+            yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Keyboard target '%s' not found", target_id);
+        }
+    }
+    const char *mode = yui_node_scalar(node, "mode");
+    if (mode && mode[0] != '\0') {
+        if (strcasecmp(mode, "number") == 0) {
+            lv_keyboard_set_mode(kb, LV_KEYBOARD_MODE_NUMBER);
+        } else if (strcasecmp(mode, "text_lower") == 0) {
+            lv_keyboard_set_mode(kb, LV_KEYBOARD_MODE_TEXT_LOWER);
+        } else if (strcasecmp(mode, "text_upper") == 0) {
+            lv_keyboard_set_mode(kb, LV_KEYBOARD_MODE_TEXT_UPPER);
+        } else if (strcasecmp(mode, "special") == 0) {
+            lv_keyboard_set_mode(kb, LV_KEYBOARD_MODE_SPECIAL);
+        }
+    }
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(kb, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, kb);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
+#else
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'keyboard' unavailable: LV_USE_KEYBOARD=0");
+    return ESP_OK;
+#endif
+}
+
+static esp_err_t yui_render_flex_container(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope, const char *type)
+{
+    lv_obj_t *container = lv_obj_create(parent);
+    yui_register_widget_id(node, container);
+    yui_prepare_layout_container(container);
+    /* Size to fit content by default */
+    lv_obj_set_size(container, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(container, LV_PCT(100));
+    }
+    yui_apply_layout(container, yml_node_get_child(node, "layout"), type);
+    yui_apply_common_widget_attrs(container, node, schema);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(container, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, container);
+    }
+    return yui_render_widget_list(yml_node_get_child(node, "widgets"), schema, container, scope);
+}
+
+static esp_err_t yui_render_row(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    return yui_render_flex_container(node, schema, parent, scope, "row");
+}
+
+static esp_err_t yui_render_column(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    return yui_render_flex_container(node, schema, parent, scope, "column");
+}
+
+static esp_err_t yui_render_list(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+#if LV_USE_LIST
+    lv_obj_t *list = lv_list_create(parent);
+    yui_register_widget_id(node, list);
+    lv_obj_set_size(list, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_scroll_dir(list, LV_DIR_VER);
+    lv_obj_remove_flag(list, LV_OBJ_FLAG_SCROLL_CHAIN_VER);
+    lv_obj_remove_flag(list, LV_OBJ_FLAG_SCROLL_ELASTIC);
+    lv_obj_remove_flag(list, LV_OBJ_FLAG_SCROLL_MOMENTUM);
+    yui_add_widget_default_style(list, &s_list_default_style);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(list, LV_PCT(100));
+    }
+    if (!yui_node_has_child(node, "height")) {
+        lv_obj_set_height(list, LV_SIZE_CONTENT);
+    }
+    yui_apply_layout(list, yml_node_get_child(node, "layout"), "column");
+    yui_apply_common_widget_attrs(list, node, schema);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(list, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, list);
+    }
+    return yui_render_widget_list(yml_node_get_child(node, "widgets"), schema, list, scope);
+#else
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'list' unavailable: LV_USE_LIST=0");
+    return ESP_OK;
+#endif
+}
+
+static esp_err_t yui_render_panel(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    lv_obj_t *panel = lv_obj_create(parent);
+    yui_register_widget_id(node, panel);
+    lv_obj_set_size(panel, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+    if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
+        lv_obj_set_width(panel, LV_PCT(100));
+    }
+    yui_apply_common_widget_attrs(panel, node, schema);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(panel, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, panel);
+    }
+    const yml_node_t *layout = yml_node_get_child(node, "layout");
+    if (layout) {
+        yui_apply_layout(panel, layout, "column");
+    }
+
+    const yml_node_t *props_node = yml_node_get_child(node, "props");
+    char title_buf[YUI_TEXT_BUFFER_MAX];
+    const yml_node_t *title_node = node;
+    const char *title_key_field = "title_key";
+    const char *title = yui_node_resolved_localized_scalar(node, "title", "title_key", scope, title_buf, sizeof(title_buf));
+    if ((!title || title[0] == '\0') && props_node) {
+        title_node = props_node;
+        title = yui_node_resolved_localized_scalar(props_node, "title", "title_key", scope, title_buf, sizeof(title_buf));
+        if ((!title || title[0] == '\0')) {
+            title_key_field = "titleKey";
+            title = yui_node_resolved_localized_scalar(props_node, "title", "titleKey", scope, title_buf, sizeof(title_buf));
+        }
+    }
+    if (title && title[0] != '\0') {
+        lv_obj_t *label = lv_label_create(panel);
+        if (!yui_attach_style(label, "stat-label")) {
+            (void)yui_attach_style(label, "heading");
+        }
+        lv_label_set_text(label, title);
+        (void)yui_widget_bind_localized(runtime, title_node, title_key_field, label, 0U, yui_set_label_text);
+    }
+
+    return yui_render_widget_list(yml_node_get_child(node, "widgets"), schema, panel, scope);
+}
+
+static const yui_widget_handler_t s_widget_handlers[] = {
+    {"label", yui_render_label},
+    {"camera_preview", yui_render_camera_preview},
+    {"img", yui_render_img},
+    {"button", yui_render_button},
+    {"spacer", yui_render_spacer},
+    {"spinner", yui_render_spinner},
+    {"textarea", yui_render_textarea},
+    {"switch", yui_render_switch},
+    {"checkbox", yui_render_checkbox},
+    {"slider", yui_render_slider},
+    {"bar", yui_render_bar},
+    {"arc", yui_render_arc},
+    {"dropdown", yui_render_dropdown},
+    {"roller", yui_render_roller},
+    {"led", yui_render_led},
+    {"chart", yui_render_chart},
+    {"calendar", yui_render_calendar},
+    {"menu", yui_render_menu},
+    {"tabview", yui_render_tabview},
+    {"table", yui_render_table},
+    {"virtual_list", yui_render_virtual_list},
+    {"virtual_table", yui_render_virtual_table},
+    {"keyboard", yui_render_keyboard},
+    {"row", yui_render_row},
+    {"column", yui_render_column},
+    {"list", yui_render_list},
+    {"panel", yui_render_panel},
+};
+
+/* Built-in handlers are found through a small open-addressing index over their names. */
+#define YUI_WIDGET_HANDLER_SLOTS 64U
+#define YUI_WIDGET_TYPE_PRIME_DEPTH 32
+
+static uint8_t s_widget_handler_slots[YUI_WIDGET_HANDLER_SLOTS]; /* handler index + 1, 0 = empty */
+static bool s_widget_handler_slots_ready;
+
+static uint32_t yui_widget_type_name_hash(const char *name)
+{
+    uint32_t hash = 2166136261U;
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+static int16_t yui_widget_handler_find(const char *type)
+{
+    const size_t handler_count = sizeof(s_widget_handlers) / sizeof(s_widget_handlers[0]);
+    if (!s_widget_handler_slots_ready) {
+        for (size_t i = 0; i < handler_count; ++i) {
+            uint32_t pos = yui_widget_type_name_hash(s_widget_handlers[i].name) & (YUI_WIDGET_HANDLER_SLOTS - 1U);
+            while (s_widget_handler_slots[pos] != 0U) {
+                pos = (pos + 1U) & (YUI_WIDGET_HANDLER_SLOTS - 1U);
+            }
+            s_widget_handler_slots[pos] = (uint8_t)(i + 1U);
+        }
+        s_widget_handler_slots_ready = true;
+    }
+    uint32_t pos = yui_widget_type_name_hash(type) & (YUI_WIDGET_HANDLER_SLOTS - 1U);
+    while (s_widget_handler_slots[pos] != 0U) {
+        int16_t index = (int16_t)(s_widget_handler_slots[pos] - 1U);
+        if (strcmp(s_widget_handlers[index].name, type) == 0) {
+            return index;
+        }
+        pos = (pos + 1U) & (YUI_WIDGET_HANDLER_SLOTS - 1U);
+    }
+    return -1;
+}
+
+static void yui_widget_type_lookup(const yui_schema_runtime_t *schema, const char *type, yui_widget_type_slot_t *slot)
+{
+    memset(slot, 0, sizeof(*slot));
+    slot->type = type;
+    slot->builtin = -1;
+    slot->component = yui_schema_get_component(&schema->schema, type);
+    if (!slot->component && !yamui_runtime_find_widget(type, &slot->factory, &slot->factory_ctx)) {
+        slot->builtin = yui_widget_handler_find(type);
+    }
+}
+
+static size_t yui_widget_type_pointer_hash(const char *type)
+{
+    uintptr_t value = (uintptr_t)type;
+    value ^= value >> 16;
+    value *= 0x45D9F3BU;
+    value ^= value >> 16;
+    return (size_t)value;
+}
+
+static bool yui_widget_type_cache_grow(yui_widget_type_cache_t *cache)
+{
+    size_t capacity = cache->capacity ? cache->capacity * 2U : 32U;
+    yui_widget_type_slot_t *slots = (yui_widget_type_slot_t *)calloc(capacity, sizeof(yui_widget_type_slot_t));
+    if (!slots) {
+        return false;
+    }
+    for (size_t i = 0; i < cache->capacity; ++i) {
+        if (!cache->slots[i].type) {
+            continue;
+        }
+        size_t pos = yui_widget_type_pointer_hash(cache->slots[i].type) & (capacity - 1U);
+        while (slots[pos].type) {
+            pos = (pos + 1U) & (capacity - 1U);
+        }
+        slots[pos] = cache->slots[i];
+    }
+    free(cache->slots);
+    cache->slots = slots;
+    cache->capacity = capacity;
+    return true;
+}
+
+/* Type scalars are interned per document, so the cache is keyed by the scalar pointer and a
+ * render never hashes or compares the type string. Widget (un)registration bumps the runtime
+ * generation, which flushes resolutions made against the old registry. */
+static const yui_widget_type_slot_t *yui_widget_type_resolve(yui_schema_runtime_t *schema, const char *type)
+{
+    yui_widget_type_cache_t *cache = &schema->types;
+    uint32_t generation = yamui_runtime_widget_generation();
+    if (cache->generation != generation) {
+        if (cache->slots) {
+            memset(cache->slots, 0, cache->capacity * sizeof(yui_widget_type_slot_t));
+        }
+        cache->count = 0U;
+        cache->generation = generation;
+    }
+    if ((cache->count + 1U) * 2U > cache->capacity && !yui_widget_type_cache_grow(cache)) {
+        return NULL;
+    }
+    size_t mask = cache->capacity - 1U;
+    size_t pos = yui_widget_type_pointer_hash(type) & mask;
+    while (cache->slots[pos].type) {
+        if (cache->slots[pos].type == type) {
+            return &cache->slots[pos];
+        }
+        pos = (pos + 1U) & mask;
+    }
+    yui_widget_type_lookup(schema, type, &cache->slots[pos]);
+    cache->count++;
+    return &cache->slots[pos];
+}
+
+/* Resolves every `type:` scalar of a freshly loaded schema so the first render is already cached. */
+static void yui_widget_types_prime(yui_schema_runtime_t *schema, const yml_node_t *node, int depth)
+{
+    if (!node || depth > YUI_WIDGET_TYPE_PRIME_DEPTH) {
+        return;
+    }
+    if (yml_node_get_type(node) == YML_NODE_MAPPING) {
+        const char *type = yui_node_scalar(node, "type");
+        if (type) {
+            (void)yui_widget_type_resolve(schema, type);
+        }
+    }
+    for (const yml_node_t *child = yml_node_child_at(node, 0); child; child = yml_node_next(child)) {
+        if (yml_node_get_type(child) != YML_NODE_SCALAR) {
+            yui_widget_types_prime(schema, child, depth + 1);
+        }
+    }
+}
+
+static void yui_widget_type_cache_free(yui_widget_type_cache_t *cache)
+{
+    free(cache->slots);
+    memset(cache, 0, sizeof(*cache));
+}
+
+static esp_err_t yui_render_custom_widget(const yui_widget_type_slot_t *slot,
+                                          const yml_node_t *node,
+                                          yui_schema_runtime_t *schema,
+                                          lv_obj_t *parent,
+                                          yui_component_scope_t *scope)
+{
+    lv_obj_t *obj = (lv_obj_t *)slot->factory(parent, node, slot->factory_ctx);
+    if (!obj) {
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Custom widget '%s' created no object", slot->type);
+        return ESP_OK;
+    }
+    yui_register_widget_id(node, obj);
+    yui_apply_common_widget_attrs(obj, node, schema);
+    yui_widget_runtime_t *runtime = yui_widget_runtime_create(obj, scope);
+    if (runtime) {
+        (void)yui_widget_bind_conditions(runtime, node, obj);
+        (void)yui_widget_parse_events(node, runtime);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t yui_render_widget(const yml_node_t *node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    if (!node || !schema || !parent || yml_node_get_type(node) != YML_NODE_MAPPING) {
+        return ESP_OK;
+    }
+    const char *type = yui_node_scalar(node, "type");
+    if (!type) {
+        return ESP_OK;
+    }
+    yui_widget_type_slot_t uncached;
+    const yui_widget_type_slot_t *slot = yui_widget_type_resolve(schema, type);
+    if (!slot) {
+        yui_widget_type_lookup(schema, type, &uncached);
+        slot = &uncached;
+    }
+    if (slot->component) {
+        return yui_render_component_instance(slot->component, node, schema, parent, scope);
+    }
+    if (slot->factory) {
+        return yui_render_custom_widget(slot, node, schema, parent, scope);
+    }
+    if (slot->builtin >= 0) {
+        return s_widget_handlers[slot->builtin].render(node, schema, parent, scope);
+    }
+    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Unsupported widget type '%s'", type);
+    return ESP_OK;
+}
+
+#define YUI_SCREEN_CACHE_NONE ((size_t)-1)
+
+static size_t yui_screen_cache_index_of(lv_obj_t *screen)
+{
+    for (size_t i = 0; i < s_screen_cache_count; ++i) {
+        if (s_screen_cache[i].screen == screen) {
+            return i;
+        }
+    }
+    return YUI_SCREEN_CACHE_NONE;
+}
+
+static void yui_screen_cache_remove_at(size_t index)
+{
+    yui_screen_cache_entry_t *entry = &s_screen_cache[index];
+    lv_obj_t *screen = entry->screen;
+    for (size_t i = 0; i < entry->ref_count; ++i) {
+        free(entry->refs[i].id);
+    }
+    free(entry->refs);
+    free(entry->screen_name);
+    s_screen_cache_bytes -= entry->bytes;
+    s_screen_cache[index] = s_screen_cache[--s_screen_cache_count];
+    /* The active screen is deleted by the next navigation once it is no longer cached */
+    if (screen && screen != lv_scr_act()) {
+        lv_obj_del(screen);
+    }
+}
+
+static void yui_screen_cache_clear(void)
+{
+    yui_build_abort();
+    while (s_screen_cache_count > 0U) {
+        yui_screen_cache_remove_at(s_screen_cache_count - 1U);
+    }
+}
+
+/* Registered on each cached screen and on its first child: deleting the screen drops the entry,
+ * deleting the child means someone cleaned the tree (e.g. the provisioning QR view). */
+static void yui_screen_cache_delete_cb(lv_event_t *event)
+{
+    lv_obj_t *screen = (lv_obj_t *)lv_event_get_user_data(event);
+    size_t index = yui_screen_cache_index_of(screen);
+    if (index == YUI_SCREEN_CACHE_NONE) {
+        return;
+    }
+    if (lv_event_get_target(event) == screen) {
+        s_screen_cache[index].screen = NULL;
+        yui_screen_cache_remove_at(index);
+    } else {
+        s_screen_cache[index].stale = true;
+    }
+}
+
+static size_t yui_screen_cache_find(const yui_schema_runtime_t *schema, const char *screen_name)
+{
+    for (size_t i = 0; i < s_screen_cache_count; ++i) {
+        yui_screen_cache_entry_t *entry = &s_screen_cache[i];
+        if (entry->schema != schema || strcmp(entry->screen_name, screen_name) != 0) {
+            continue;
+        }
+        if (entry->stale) {
+            yui_screen_cache_remove_at(i);
+            return YUI_SCREEN_CACHE_NONE;
+        }
+        return i;
+    }
+    return YUI_SCREEN_CACHE_NONE;
+}
+
+static void yui_screen_cache_evict(void)
+{
+    const size_t budget = (size_t)CONFIG_YAMUI_SCREEN_CACHE_BUDGET_KB * 1024U;
+    while (s_screen_cache_bytes > budget || s_screen_cache_count > CONFIG_YAMUI_SCREEN_CACHE_MAX_SCREENS) {
+        size_t victim = YUI_SCREEN_CACHE_NONE;
+        for (size_t i = 0; i < s_screen_cache_count; ++i) {
+            if (s_screen_cache[i].screen == lv_scr_act()) {
+                continue;
+            }
+            if (victim == YUI_SCREEN_CACHE_NONE || s_screen_cache[i].last_used < s_screen_cache[victim].last_used) {
+                victim = i;
+            }
+        }
+        if (victim == YUI_SCREEN_CACHE_NONE) {
+            return;
+        }
+        yamui_log(YAMUI_LOG_LEVEL_DEBUG,
+                  YAMUI_LOG_CAT_NAV,
+                  "Evicting cached screen '%s' (%u bytes)",
+                  s_screen_cache[victim].screen_name,
+                  (unsigned)s_screen_cache[victim].bytes);
+        yui_screen_cache_remove_at(victim);
+    }
+}
+
+static void yui_screen_cache_insert(yui_schema_runtime_t *schema, const char *screen_name, lv_obj_t *screen, size_t bytes)
+{
+    lv_obj_t *anchor = lv_obj_get_child(screen, 0);
+    /* Empty screens are free to rebuild */
+    if (CONFIG_YAMUI_SCREEN_CACHE_BUDGET_KB == 0 || !anchor || bytes > (size_t)CONFIG_YAMUI_SCREEN_CACHE_BUDGET_KB * 1024U) {
+        return;
+    }
+    if (s_screen_cache_count == s_screen_cache_capacity) {
+        size_t new_capacity = s_screen_cache_capacity == 0U ? 4U : s_screen_cache_capacity * 2U;
+        yui_screen_cache_entry_t *next = (yui_screen_cache_entry_t *)realloc(s_screen_cache, new_capacity * sizeof(yui_screen_cache_entry_t));
+        if (!next) {
+            return;
+        }
+        s_screen_cache = next;
+        s_screen_cache_capacity = new_capacity;
+    }
+    char *name_copy = yui_strdup_local(screen_name);
+    if (!name_copy) {
+        return;
+    }
+    s_screen_cache[s_screen_cache_count++] = (yui_screen_cache_entry_t){
+        .schema = schema,
+        .screen_name = name_copy,
+        .screen = screen,
+        .bytes = bytes,
+        .last_used = ++s_screen_cache_clock,
+    };
+    s_screen_cache_bytes += bytes;
+    lv_obj_add_event_cb(screen, yui_screen_cache_delete_cb, LV_EVENT_DELETE, screen);
+    lv_obj_add_event_cb(anchor, yui_screen_cache_delete_cb, LV_EVENT_DELETE, screen);
+    yui_screen_cache_evict();
+}
+
+/* Parks the widget ids of the outgoing screen in its cache entry, or drops them if it is not cached. */
+static void yui_screen_cache_detach(lv_obj_t *screen)
+{
+    size_t index = yui_screen_cache_index_of(screen);
+    if (index == YUI_SCREEN_CACHE_NONE || s_screen_cache[index].stale) {
+        yui_widget_refs_clear();
+        return;
+    }
+    yui_screen_cache_entry_t *entry = &s_screen_cache[index];
+    entry->refs = s_widget_refs;
+    entry->ref_count = s_widget_ref_count;
+    entry->ref_capacity = s_widget_ref_capacity;
+    s_widget_refs = NULL;
+    s_widget_ref_count = 0U;
+    s_widget_ref_capacity = 0U;
+}
+
+static void yui_screen_cache_attach(yui_screen_cache_entry_t *entry)
+{
+    yui_widget_refs_clear();
+    s_widget_refs = entry->refs;
+    s_widget_ref_count = entry->ref_count;
+    s_widget_ref_capacity = entry->ref_capacity;
+    entry->refs = NULL;
+    entry->ref_count = 0U;
+    entry->ref_capacity = 0U;
+    entry->last_used = ++s_screen_cache_clock;
+}
+
+/* Shows @p screen and deletes the outgoing one unless the cache retains it. */
+static void yui_screen_activate(lv_obj_t *screen)
+{
+    lv_obj_t *previous = lv_scr_act();
+    lv_scr_load(screen);
+    if (previous && previous != screen) {
+        size_t index = yui_screen_cache_index_of(previous);
+        if (index == YUI_SCREEN_CACHE_NONE) {
+            lv_obj_del(previous);
+        } else if (s_screen_cache[index].stale) {
+            yui_screen_cache_remove_at(index);
+        }
+    }
+    yui_screen_resume_bindings(screen);
+}
+
+static void yui_screen_run_on_load(const yml_node_t *screen_node)
+{
+    const yml_node_t *on_load = yml_node_get_child(screen_node, "on_load");
+    if (!on_load) {
+        return;
+    }
+    yui_action_list_t list = {0};
+    if (yui_action_list_from_node(on_load, &list) == ESP_OK && list.count > 0U) {
+        yui_action_eval_ctx_t eval_ctx = {
+            .resolver = yui_event_symbol_resolver,
+            .resolver_ctx = NULL,
+        };
+        (void)yui_action_list_execute(&list, &eval_ctx);
+    }
+    yui_action_list_free(&list);
+}
+
+static lv_obj_t *yui_screen_create_root(const yml_node_t *screen_node)
+{
+    lv_obj_t *root = lv_obj_create(NULL);
+    if (!root) {
+        return NULL;
+    }
+    if (!s_theme_styles_ready) {
+        yui_theme_styles_compile();
+    }
+    lv_obj_add_style(root, &s_theme_screen_style, 0);
+    lv_obj_set_style_text_font(root, yui_font_default(), 0);
+
+    lv_obj_add_flag(root, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_scroll_dir(root, LV_DIR_VER);
+    lv_obj_set_scrollbar_mode(root, LV_SCROLLBAR_MODE_AUTO);
+    yui_apply_layout(root, yml_node_get_child(screen_node, "layout"), "column");
+    return root;
+}
+
+#define YUI_BUILD_SCAN_DEPTH 12
+#define YUI_BUILD_ASYNC_OP "screen_render"
+
+/* Screen builds are resumable: while a build step runs, nested widget lists are queued as frames
+ * instead of being rendered recursively, so a step can stop after any single widget. */
+typedef struct {
+    const yml_node_t *next;
+    yui_schema_runtime_t *schema;
+    lv_obj_t *parent;
+    yui_component_scope_t *scope;
+} yui_build_frame_t;
+
+typedef struct {
+    yui_schema_runtime_t *schema;
+    char *screen_name;
+    const yml_node_t *screen_node;
+    lv_obj_t *root;
+    yui_build_frame_t *frames;
+    size_t frame_count;
+    size_t frame_capacity;
+    yui_widget_ref_t *refs; /* background builds keep their widget ids apart from the active screen */
+    size_t ref_count;
+    size_t ref_capacity;
+    size_t bytes;
+    size_t widgets_built;
+    size_t widgets_total;
+    int64_t started_us;
+    esp_err_t error;
+    bool foreground;
+    bool reported;
+    bool invalidated;
+} yui_build_job_t;
+
+static yui_build_job_t s_build_job;
+static lv_timer_t *s_build_timer;
+
+static esp_err_t yui_build_push_frame(const yml_node_t *widgets_node, yui_schema_runtime_t *schema, lv_obj_t *parent, yui_component_scope_t *scope)
+{
+    yui_build_job_t *job = &s_build_job;
+    if (job->frame_count == job->frame_capacity) {
+        size_t new_capacity = job->frame_capacity == 0U ? 8U : job->frame_capacity * 2U;
+        yui_build_frame_t *next = (yui_build_frame_t *)realloc(job->frames, new_capacity * sizeof(yui_build_frame_t));
+        if (!next) {
+            return ESP_ERR_NO_MEM;
+        }
+        job->frames = next;
+        job->frame_capacity = new_capacity;
+    }
+    if (scope) {
+        yui_scope_acquire(scope);
+    }
+    job->frames[job->frame_count++] = (yui_build_frame_t){
+        .next = yml_node_child_at(widgets_node, 0),
+        .schema = schema,
+        .parent = parent,
+        .scope = scope,
+    };
+    return ESP_OK;
+}
+
+static void yui_build_pop_frame(yui_build_job_t *job)
+{
+    yui_build_frame_t *frame = &job->frames[--job->frame_count];
+    if (frame->scope) {
+        yui_scope_release(frame->scope);
+    }
+}
+
+/* Frees the job's bookkeeping; the caller decides what happens to the root object. */
+static void yui_build_release(void)
+{
+    yui_build_job_t *job = &s_build_job;
+    while (job->frame_count > 0U) {
+        yui_build_pop_frame(job);
+    }
+    free(job->frames);
+    for (size_t i = 0; i < job->ref_count; ++i) {
+        free(job->refs[i].id);
+    }
+    free(job->refs);
+    free(job->screen_name);
+    memset(job, 0, sizeof(*job));
+}
+
+static void yui_build_abort(void)
+{
+    yui_build_job_t *job = &s_build_job;
+    if (job->root) {
+        yamui_log(YAMUI_LOG_LEVEL_DEBUG, YAMUI_LOG_CAT_NAV, "Build of screen '%s' cancelled", job->screen_name);
+        if (job->reported) {
+            (void)yamui_async_reset(YUI_BUILD_ASYNC_OP, NULL);
+        }
+        /* A partially built active screen is deleted by the next navigation */
+        if (job->root != lv_scr_act()) {
+            lv_obj_del(job->root);
         }
+    }
+    yui_build_release();
+}
 
-        lv_menu_set_page(menu, root_page);
-        yui_disable_shadows_recursive(menu);
+static void yui_build_invalidate(lv_obj_t *screen)
+{
+    if (screen && screen == s_build_job.root) {
+        s_build_job.invalidated = true;
+    }
+}
 
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(menu, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, menu);
-            (void)yui_widget_parse_events(node, runtime);
+static void yui_build_swap_refs(void)
+{
+    yui_widget_ref_t *refs = s_widget_refs;
+    size_t count = s_widget_ref_count;
+    size_t capacity = s_widget_ref_capacity;
+    s_widget_refs = s_build_job.refs;
+    s_widget_ref_count = s_build_job.ref_count;
+    s_widget_ref_capacity = s_build_job.ref_capacity;
+    s_build_job.refs = refs;
+    s_build_job.ref_count = count;
+    s_build_job.ref_capacity = capacity;
+}
+
+static size_t yui_build_count_nested(const yml_node_t *node, const yui_schema_t *schema, int depth);
+
+/* Widgets a build will render, with components expanded; only used for progress reporting. */
+static size_t yui_build_count_list(const yml_node_t *widgets_node, const yui_schema_t *schema, int depth)
+{
+    if (depth > YUI_BUILD_SCAN_DEPTH || yml_node_get_type(widgets_node) != YML_NODE_SEQUENCE) {
+        return 0U;
+    }
+    size_t total = 0U;
+    for (const yml_node_t *item = yml_node_child_at(widgets_node, 0); item; item = yml_node_next(item)) {
+        const char *type = yui_node_scalar(item, "type");
+        const yui_component_def_t *component = type ? yui_schema_get_component(schema, type) : NULL;
+        total += 1U + yui_build_count_nested(item, schema, depth + 1);
+        if (component) {
+            total += yui_build_count_list(component->widgets_node, schema, depth + 1);
         }
-        return ESP_OK;
-#else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'menu' unavailable: LV_USE_MENU=0");
-        return ESP_OK;
-#endif
     }
-    if (strcmp(type, "tabview") == 0) {
-#if LV_USE_TABVIEW
-        lv_obj_t *tabview = lv_tabview_create(parent);
-        yui_register_widget_id(node, tabview);
-        if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
-            lv_obj_set_width(tabview, LV_PCT(100));
+    return total;
+}
+
+static size_t yui_build_count_nested(const yml_node_t *node, const yui_schema_t *schema, int depth)
+{
+    if (depth > YUI_BUILD_SCAN_DEPTH) {
+        return 0U;
+    }
+    size_t total = 0U;
+    for (const yml_node_t *child = yml_node_child_at(node, 0); child; child = yml_node_next(child)) {
+        const char *key = yml_node_get_key(child);
+        if (key && strcmp(key, "widgets") == 0) {
+            total += yui_build_count_list(child, schema, depth + 1);
+        } else if (yml_node_get_type(child) != YML_NODE_SCALAR) {
+            total += yui_build_count_nested(child, schema, depth + 1);
         }
-        if (!yui_node_has_child(node, "height")) {
-            lv_obj_set_height(tabview, 280);
-        }
-        yui_apply_common_widget_attrs(tabview, node, schema);
-
-        lv_tabview_set_tab_bar_position(tabview, yui_dir_from_string(yui_node_scalar(node, "tab_bar_position"), LV_DIR_TOP));
-        lv_tabview_set_tab_bar_size(tabview, yui_node_resolved_i32(node, "tab_bar_size", scope, 44));
-
-        lv_obj_set_style_bg_color(tabview, lv_color_hex(0x0F172A), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(tabview, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_border_color(tabview, lv_color_hex(0x334155), LV_PART_MAIN);
-        lv_obj_set_style_border_width(tabview, 1, LV_PART_MAIN);
-        lv_obj_set_style_radius(tabview, 12, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(tabview, 0, LV_PART_MAIN);
-
-        lv_obj_t *tab_bar = lv_tabview_get_tab_bar(tabview);
-        if (tab_bar) {
-            lv_obj_set_style_bg_color(tab_bar, lv_color_hex(0x111827), LV_PART_MAIN);
-            lv_obj_set_style_bg_opa(tab_bar, LV_OPA_COVER, LV_PART_MAIN);
-            lv_obj_set_style_border_width(tab_bar, 0, LV_PART_MAIN);
-            lv_obj_set_style_text_color(tab_bar, lv_color_hex(0xCBD5E1), LV_PART_MAIN);
-            lv_obj_set_style_bg_color(tab_bar, lv_color_hex(0x22D3EE), LV_PART_ITEMS | LV_STATE_CHECKED);
-            lv_obj_set_style_text_color(tab_bar, lv_color_hex(0x0F172A), LV_PART_ITEMS | LV_STATE_CHECKED);
-        }
-
-        lv_obj_t *content = lv_tabview_get_content(tabview);
-        if (content) {
-            lv_obj_set_style_bg_color(content, lv_color_hex(0x0F172A), LV_PART_MAIN);
-            lv_obj_set_style_bg_opa(content, LV_OPA_COVER, LV_PART_MAIN);
-            lv_obj_set_style_border_width(content, 0, LV_PART_MAIN);
-        }
-
-        const yml_node_t *tabs_node = yml_node_get_child(node, "tabs");
-        if (tabs_node && yml_node_get_type(tabs_node) == YML_NODE_SEQUENCE) {
-            size_t tab_count = yml_node_child_count(tabs_node);
-            for (size_t i = 0; i < tab_count; ++i) {
-                const yml_node_t *tab_node = yml_node_child_at(tabs_node, i);
-                if (!tab_node || yml_node_get_type(tab_node) != YML_NODE_MAPPING) {
-                    continue;
-                }
+    }
+    return total;
+}
 
-                char title_buf[YUI_TEXT_BUFFER_MAX];
-                const char *tab_title = yui_node_resolved_localized_scalar(tab_node, "title", "title_key", scope, title_buf, sizeof(title_buf));
-                if (!tab_title || tab_title[0] == '\0') {
-                    tab_title = "Tab";
-                }
+static void yui_build_report_progress(void)
+{
+    yui_build_job_t *job = &s_build_job;
+    if (!job->reported || job->widgets_total == 0U) {
+        return;
+    }
+    size_t percent = job->widgets_built * 100U / job->widgets_total;
+    (void)yamui_async_progress(YUI_BUILD_ASYNC_OP, (int32_t)(percent > 99U ? 99U : percent), NULL);
+}
 
-                lv_obj_t *tab = lv_tabview_add_tab(tabview, tab_title);
-                lv_obj_set_style_bg_color(tab, lv_color_hex(0x0F172A), LV_PART_MAIN);
-                lv_obj_set_style_bg_opa(tab, LV_OPA_COVER, LV_PART_MAIN);
-                lv_obj_set_style_pad_all(tab, 12, LV_PART_MAIN);
-                yui_apply_layout(tab, yml_node_get_child(tab_node, "layout"), "column");
-                esp_err_t render_err = yui_render_widget_list(yml_node_get_child(tab_node, "widgets"), schema, tab, scope);
-                if (render_err != ESP_OK) {
-                    return render_err;
-                }
-            }
+static bool yui_build_fold_filled(lv_obj_t *root)
+{
+    lv_obj_update_layout(root);
+    return lv_obj_get_scroll_bottom(root) > 0;
+}
+
+/* Renders up to @p max_widgets queued widgets, stopping at @p deadline_us (0: none) or, with
+ * @p stop_at_fold, once the top-level content overflows the screen. Returns true when done. */
+static bool yui_build_step(size_t max_widgets, int64_t deadline_us, bool stop_at_fold)
+{
+    yui_build_job_t *job = &s_build_job;
+    size_t built = 0U;
+    if (!job->foreground) {
+        yui_build_swap_refs();
+    }
+    s_build_deferring = true;
+    while (job->frame_count > 0U && built < max_widgets) {
+        yui_build_frame_t *frame = &job->frames[job->frame_count - 1U];
+        if (!frame->next) {
+            yui_build_pop_frame(job);
+            continue;
+        }
+        if (stop_at_fold && built > 0U && job->frame_count == 1U && yui_build_fold_filled(job->root)) {
+            break;
+        }
+        const yml_node_t *node = frame->next;
+        yui_schema_runtime_t *schema = frame->schema;
+        lv_obj_t *parent = frame->parent;
+        yui_component_scope_t *scope = frame->scope;
+        frame->next = yml_node_next(node);
+        size_t depth = job->frame_count;
+
+        size_t heap_before = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        esp_err_t err = yui_render_widget(node, schema, parent, scope);
+        size_t heap_after = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        job->bytes += heap_before > heap_after ? heap_before - heap_after : 0U;
+        built++;
+        job->widgets_built++;
+
+        /* Child lists were queued in document order; flip them so the first is rendered first */
+        for (size_t lo = depth, hi = job->frame_count; lo + 1U < hi; ++lo, --hi) {
+            yui_build_frame_t tmp = job->frames[lo];
+            job->frames[lo] = job->frames[hi - 1U];
+            job->frames[hi - 1U] = tmp;
+        }
+        if (job->foreground && parent == job->root && s_modal_count > 0U) {
+            yui_modal_raise_all();
+        }
+        if (err != ESP_OK) {
+            job->error = err;
+            break;
+        }
+        if (deadline_us != 0 && esp_timer_get_time() >= deadline_us) {
+            break;
         }
+    }
+    s_build_deferring = false;
+    if (!job->foreground) {
+        yui_build_swap_refs();
+    }
+    while (job->frame_count > 0U && !job->frames[job->frame_count - 1U].next) {
+        yui_build_pop_frame(job);
+    }
+    return job->frame_count == 0U;
+}
 
-        lv_tabview_set_active(tabview, (uint32_t)yui_node_resolved_i32(node, "active_tab", scope, 0), LV_ANIM_OFF);
+static bool yui_screen_cache_has_room(size_t extra)
+{
+    return s_screen_cache_count < CONFIG_YAMUI_SCREEN_CACHE_MAX_SCREENS &&
+           s_screen_cache_bytes + extra <= (size_t)CONFIG_YAMUI_SCREEN_CACHE_BUDGET_KB * 1024U;
+}
 
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(tabview, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, tabview);
-            (void)yui_widget_parse_events(node, runtime);
+static void yui_prefetch_schedule(yui_schema_runtime_t *schema, const char *screen_name);
+
+/* Hands a finished tree to the screen cache; foreground builds then run on_load. */
+static void yui_build_complete(void)
+{
+    yui_build_job_t *job = &s_build_job;
+    lv_obj_t *root = job->root;
+    yui_schema_runtime_t *schema = job->schema;
+    if (!job->foreground) {
+        yui_screen_cache_insert(schema, job->screen_name, root, job->bytes);
+        size_t index = yui_screen_cache_index_of(root);
+        if (index == YUI_SCREEN_CACHE_NONE) {
+            yui_build_abort();
+            return;
         }
-        return ESP_OK;
-#else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'tabview' unavailable: LV_USE_TABVIEW=0");
-        return ESP_OK;
-#endif
+        yui_screen_cache_entry_t *entry = &s_screen_cache[index];
+        entry->refs = job->refs;
+        entry->ref_count = job->ref_count;
+        entry->ref_capacity = job->ref_capacity;
+        job->refs = NULL;
+        job->ref_count = 0U;
+        yamui_log(YAMUI_LOG_LEVEL_DEBUG,
+                  YAMUI_LOG_CAT_NAV,
+                  "Prefetched screen '%s' (%u widgets, %u bytes)",
+                  job->screen_name,
+                  (unsigned)job->widgets_built,
+                  (unsigned)job->bytes);
+        yui_build_release();
+        return;
     }
-    if (strcmp(type, "table") == 0) {
-#if LV_USE_TABLE
-        lv_obj_t *table = lv_table_create(parent);
-        yui_register_widget_id(node, table);
-        if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
-            lv_obj_set_width(table, LV_PCT(100));
-        }
-        if (!yui_node_has_child(node, "height")) {
-            lv_obj_set_height(table, 160);
-        }
-        yui_apply_common_widget_attrs(table, node, schema);
-        lv_obj_clear_flag(table, LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_clear_flag(table, LV_OBJ_FLAG_CLICKABLE);
-        lv_obj_remove_flag(table, LV_OBJ_FLAG_SCROLL_CHAIN_VER);
-        lv_obj_remove_flag(table, LV_OBJ_FLAG_SCROLL_CHAIN_HOR);
-        lv_obj_remove_flag(table, LV_OBJ_FLAG_SCROLL_ELASTIC);
-        lv_obj_remove_flag(table, LV_OBJ_FLAG_SCROLL_MOMENTUM);
-        lv_obj_set_style_bg_color(table, lv_color_hex(0x0F172A), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(table, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_border_color(table, lv_color_hex(0x334155), LV_PART_MAIN);
-        lv_obj_set_style_border_width(table, 1, LV_PART_MAIN);
-        lv_obj_set_style_radius(table, 12, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(table, 6, LV_PART_MAIN);
-        lv_obj_set_style_bg_color(table, lv_color_hex(0x0F172A), LV_PART_ITEMS);
-        lv_obj_set_style_bg_opa(table, LV_OPA_COVER, LV_PART_ITEMS);
-        lv_obj_set_style_text_color(table, lv_color_hex(0xE2E8F0), LV_PART_ITEMS);
-        lv_obj_set_style_border_color(table, lv_color_hex(0x334155), LV_PART_ITEMS);
-        lv_obj_set_style_border_width(table, 1, LV_PART_ITEMS);
-
-        const yml_node_t *widths_node = yml_node_get_child(node, "column_widths");
-        uint32_t max_cols = 0U;
-        if (widths_node && yml_node_get_type(widths_node) == YML_NODE_SEQUENCE) {
-            max_cols = (uint32_t)yml_node_child_count(widths_node);
-        }
 
-        if (widths_node && yml_node_get_type(widths_node) == YML_NODE_SEQUENCE) {
-            uint32_t width_count = (uint32_t)yml_node_child_count(widths_node);
-            max_cols = width_count > max_cols ? width_count : max_cols;
-        }
-
-        const yml_node_t *rows_node = yml_node_get_child(node, "rows");
-        if (rows_node && yml_node_get_type(rows_node) == YML_NODE_SEQUENCE) {
-            uint32_t row_count = (uint32_t)yml_node_child_count(rows_node);
-            lv_table_set_row_count(table, row_count);
-            for (uint32_t row = 0; row < row_count; ++row) {
-                const yml_node_t *row_node = yml_node_child_at(rows_node, row);
-                uint32_t col_count = yui_table_row_column_count(row_node);
-                if (col_count > max_cols) {
-                    max_cols = col_count;
-                }
-            }
+    if (job->reported) {
+        (void)yamui_async_complete(YUI_BUILD_ASYNC_OP, job->screen_name);
+    }
+    yamui_prof_record(YAMUI_PROF_SCREEN_BUILD, (uint32_t)(esp_timer_get_time() - job->started_us));
+    /* Camera previews own a live stream */
+    if (!s_camera_preview.active) {
+        yui_screen_cache_insert(schema, job->screen_name, root, job->bytes);
+    }
+    const yml_node_t *screen_node = job->screen_node;
+    char *screen_name = job->screen_name;
+    job->screen_name = NULL;
+    yui_build_release();
+    yui_screen_run_on_load(screen_node);
+    yui_prefetch_schedule(schema, screen_name);
+    free(screen_name);
+}
+
+#if CONFIG_YAMUI_SCREEN_PREFETCH
+
+#define YUI_PREFETCH_SCAN_MAX 8U
+#define YUI_PREFETCH_HISTORY_MAX 16U
+
+typedef struct {
+    char *from;
+    char *to;
+    uint32_t count;
+} yui_nav_transition_t;
+
+typedef struct {
+    char *names[YUI_PREFETCH_SCAN_MAX];
+    uint32_t scores[YUI_PREFETCH_SCAN_MAX];
+    size_t count;
+    bool has_camera;
+} yui_prefetch_scan_t;
+
+static yui_prefetch_scan_t s_prefetch_plan;
+static size_t s_prefetch_cursor;
+static bool s_prefetch_planned;
+static yui_schema_runtime_t *s_prefetch_schema;
+static char *s_prefetch_from;
+static yui_nav_transition_t s_nav_transitions[YUI_PREFETCH_HISTORY_MAX];
+static size_t s_nav_transition_count;
+
+static void yui_prefetch_scan_reset(yui_prefetch_scan_t *scan)
+{
+    for (size_t i = 0; i < scan->count; ++i) {
+        free(scan->names[i]);
+    }
+    memset(scan, 0, sizeof(*scan));
+}
 
-            if (max_cols > 0U) {
-                lv_table_set_column_count(table, max_cols);
+static void yui_prefetch_scan_actions(const yml_node_t *node, yui_prefetch_scan_t *scan)
+{
+    yui_action_list_t list = {0};
+    if (yui_action_list_from_node(node, &list) == ESP_OK) {
+        for (size_t i = 0; i < list.count && scan->count < YUI_PREFETCH_SCAN_MAX; ++i) {
+            const yui_action_t *action = &list.items[i];
+            if ((action->type != YUI_ACTION_GOTO && action->type != YUI_ACTION_PUSH) || !action->arg0 ||
+                action->arg0[0] == '\0' || strstr(action->arg0, "{{")) {
+                continue;
             }
-            if (widths_node && yml_node_get_type(widths_node) == YML_NODE_SEQUENCE) {
-                uint32_t width_count = (uint32_t)yml_node_child_count(widths_node);
-                for (uint32_t i = 0; i < width_count; ++i) {
-                    const yml_node_t *width_node = yml_node_child_at(widths_node, i);
-                    const char *width_text = width_node ? yml_node_get_scalar(width_node) : NULL;
-                    if (width_text && width_text[0] != '\0') {
-                        lv_table_set_column_width(table, i, atoi(width_text));
-                    }
-                }
+            bool seen = false;
+            for (size_t j = 0; j < scan->count && !seen; ++j) {
+                seen = strcmp(scan->names[j], action->arg0) == 0;
             }
-
-            for (uint32_t row = 0; row < row_count; ++row) {
-                const yml_node_t *row_node = yml_node_child_at(rows_node, row);
-                uint32_t col_count = yui_table_row_column_count(row_node);
-                for (uint32_t col = 0; col < col_count; ++col) {
-                    const yml_node_t *cell_node = yui_table_row_cell_at(row_node, col);
-                    char cell_buf[YUI_TEXT_BUFFER_MAX];
-                    const char *cell_text = yui_format_node_text(cell_node, scope, cell_buf, sizeof(cell_buf)) ? cell_buf : "";
-                    lv_table_set_cell_value(table, row, col, cell_text ? cell_text : "");
+            if (!seen) {
+                char *copy = yui_strdup_local(action->arg0);
+                if (copy) {
+                    scan->names[scan->count++] = copy;
                 }
             }
         }
+    }
+    yui_action_list_free(&list);
+}
 
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(table, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, table);
-            (void)yui_widget_parse_events(node, runtime);
+static bool yui_prefetch_is_event_key(const char *key)
+{
+    for (size_t i = 0; key && i < s_widget_event_count; ++i) {
+        if (strcmp(key, s_widget_events[i].yaml_key) == 0 || strcmp(key, s_widget_events[i].companion_key) == 0) {
+            return true;
         }
-        return ESP_OK;
-#else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'table' unavailable: LV_USE_TABLE=0");
-        return ESP_OK;
-#endif
     }
-    if (strcmp(type, "keyboard") == 0) {
-#if LV_USE_KEYBOARD
-        bool overlay = yui_node_resolved_bool(node, "overlay", scope, false);
-        lv_obj_t *kb_parent = overlay ? lv_obj_get_screen(parent) : parent;
-        lv_obj_t *kb = lv_keyboard_create(kb_parent);
-        yui_register_widget_id(node, kb);
-        yui_apply_common_widget_attrs(kb, node, schema);
-        if (overlay) {
-            if (!yui_node_has_child(node, "width")) {
-                lv_obj_set_width(kb, LV_PCT(100));
-            }
-            if (!yui_node_has_child(node, "height")) {
-                lv_obj_set_height(kb, 300);
-            }
-            lv_obj_add_flag(kb, LV_OBJ_FLAG_FLOATING);
-            lv_obj_add_flag(kb, LV_OBJ_FLAG_IGNORE_LAYOUT);
-            lv_obj_align(kb, LV_ALIGN_BOTTOM_MID, 0, 0);
-            lv_obj_move_foreground(kb);
-        }
-        const char *target_id = yui_node_scalar(node, "target");
-        if (target_id && target_id[0] != '\0') {
-            lv_obj_t *target_obj = yui_widget_ref_find(target_id);
-            if (target_obj) {
-                lv_keyboard_set_textarea(kb, target_obj);
-            } else {
-                yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Keyboard target '%s' not found", target_id);
+    return false;
+}
+
+/* Collects static goto/push targets of widget events, descending into component definitions. */
+static void yui_prefetch_scan_node(const yml_node_t *node, const yui_schema_t *schema, yui_prefetch_scan_t *scan, int depth)
+{
+    if (!node || depth > YUI_BUILD_SCAN_DEPTH) {
+        return;
+    }
+    if (yml_node_get_type(node) == YML_NODE_MAPPING) {
+        const char *type = yui_node_scalar(node, "type");
+        if (type) {
+            if (strcmp(type, "camera_preview") == 0) {
+                scan->has_camera = true;
             }
-        }
-        const char *mode = yui_node_scalar(node, "mode");
-        if (mode && mode[0] != '\0') {
-            if (strcasecmp(mode, "number") == 0) {
-                lv_keyboard_set_mode(kb, LV_KEYBOARD_MODE_NUMBER);
-            } else if (strcasecmp(mode, "text_lower") == 0) {
-                lv_keyboard_set_mode(kb, LV_KEYBOARD_MODE_TEXT_LOWER);
-            } else if (strcasecmp(mode, "text_upper") == 0) {
-                lv_keyboard_set_mode(kb, LV_KEYBOARD_MODE_TEXT_UPPER);
-            } else if (strcasecmp(mode, "special") == 0) {
-                lv_keyboard_set_mode(kb, LV_KEYBOARD_MODE_SPECIAL);
+            const yui_component_def_t *component = yui_schema_get_component(schema, type);
+            if (component) {
+                yui_prefetch_scan_node(component->widgets_node, schema, scan, depth + 1);
             }
         }
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(kb, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, kb);
-            (void)yui_widget_parse_events(node, runtime);
+    }
+    for (const yml_node_t *child = yml_node_child_at(node, 0); child; child = yml_node_next(child)) {
+        if (yml_node_get_type(node) == YML_NODE_MAPPING && yui_prefetch_is_event_key(yml_node_get_key(child))) {
+            yui_prefetch_scan_actions(child, scan);
+        } else if (yml_node_get_type(child) != YML_NODE_SCALAR) {
+            yui_prefetch_scan_node(child, schema, scan, depth + 1);
         }
-        return ESP_OK;
-#else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'keyboard' unavailable: LV_USE_KEYBOARD=0");
-        return ESP_OK;
-#endif
     }
-    if (strcmp(type, "row") == 0 || strcmp(type, "column") == 0) {
-        lv_obj_t *container = lv_obj_create(parent);
-        yui_register_widget_id(node, container);
-        yui_prepare_layout_container(container);
-        /* Size to fit content by default */
-        lv_obj_set_size(container, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-        if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
-            lv_obj_set_width(container, LV_PCT(100));
-        }
-        yui_apply_layout(container, yml_node_get_child(node, "layout"), type);
-        yui_apply_common_widget_attrs(container, node, schema);
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(container, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, container);
+}
+
+static uint32_t yui_prefetch_transition_count(const char *from, const char *to)
+{
+    for (size_t i = 0; i < s_nav_transition_count; ++i) {
+        if (strcmp(s_nav_transitions[i].from, from) == 0 && strcmp(s_nav_transitions[i].to, to) == 0) {
+            return s_nav_transitions[i].count;
         }
-        return yui_render_widget_list(yml_node_get_child(node, "widgets"), schema, container, scope);
     }
-    if (strcmp(type, "list") == 0) {
-#if LV_USE_LIST
-        lv_obj_t *list = lv_list_create(parent);
-        yui_register_widget_id(node, list);
-        lv_obj_set_size(list, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-        lv_obj_set_scroll_dir(list, LV_DIR_VER);
-        lv_obj_remove_flag(list, LV_OBJ_FLAG_SCROLL_CHAIN_VER);
-        lv_obj_remove_flag(list, LV_OBJ_FLAG_SCROLL_ELASTIC);
-        lv_obj_remove_flag(list, LV_OBJ_FLAG_SCROLL_MOMENTUM);
-        lv_obj_set_style_bg_opa(list, LV_OPA_TRANSP, LV_PART_MAIN);
-        lv_obj_set_style_border_opa(list, LV_OPA_TRANSP, LV_PART_MAIN);
-        lv_obj_set_style_border_width(list, 0, LV_PART_MAIN);
-        lv_obj_set_style_outline_opa(list, LV_OPA_TRANSP, LV_PART_MAIN);
-        lv_obj_set_style_shadow_opa(list, LV_OPA_TRANSP, LV_PART_MAIN);
-        lv_obj_set_style_radius(list, 0, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(list, 0, LV_PART_MAIN);
-        if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
-            lv_obj_set_width(list, LV_PCT(100));
+    return 0U;
+}
+
+/* Keeps the most frequent transitions; a new pair replaces the rarest once the table is full. */
+static void yui_prefetch_record_transition(const char *from, const char *to)
+{
+    size_t slot = s_nav_transition_count;
+    for (size_t i = 0; i < s_nav_transition_count; ++i) {
+        if (strcmp(s_nav_transitions[i].from, from) == 0 && strcmp(s_nav_transitions[i].to, to) == 0) {
+            s_nav_transitions[i].count++;
+            return;
         }
-        if (!yui_node_has_child(node, "height")) {
-            lv_obj_set_height(list, LV_SIZE_CONTENT);
+        if (slot == s_nav_transition_count || s_nav_transitions[i].count < s_nav_transitions[slot].count) {
+            slot = i;
         }
-        yui_apply_layout(list, yml_node_get_child(node, "layout"), "column");
-        yui_apply_common_widget_attrs(list, node, schema);
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(list, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, list);
+    }
+    if (s_nav_transition_count < YUI_PREFETCH_HISTORY_MAX) {
+        slot = s_nav_transition_count;
+    }
+    char *from_copy = yui_strdup_local(from);
+    char *to_copy = yui_strdup_local(to);
+    if (!from_copy || !to_copy) {
+        free(from_copy);
+        free(to_copy);
+        return;
+    }
+    if (slot < s_nav_transition_count) {
+        free(s_nav_transitions[slot].from);
+        free(s_nav_transitions[slot].to);
+    } else {
+        s_nav_transition_count++;
+    }
+    s_nav_transitions[slot] = (yui_nav_transition_t){
+        .from = from_copy,
+        .to = to_copy,
+        .count = 1U,
+    };
+}
+
+/* Ranks the current screen's declared targets by how often each was taken from here. */
+static void yui_prefetch_plan(void)
+{
+    s_prefetch_planned = true;
+    const yml_node_t *screen_node = yui_schema_get_screen(&s_prefetch_schema->schema, s_prefetch_from);
+    yui_prefetch_scan_node(yml_node_get_child(screen_node, "widgets"), &s_prefetch_schema->schema, &s_prefetch_plan, 0);
+    for (size_t i = 0; i < s_prefetch_plan.count; ++i) {
+        s_prefetch_plan.scores[i] = yui_prefetch_transition_count(s_prefetch_from, s_prefetch_plan.names[i]);
+    }
+    for (size_t i = 1; i < s_prefetch_plan.count; ++i) {
+        for (size_t j = i; j > 0 && s_prefetch_plan.scores[j] > s_prefetch_plan.scores[j - 1U]; --j) {
+            char *name = s_prefetch_plan.names[j];
+            uint32_t score = s_prefetch_plan.scores[j];
+            s_prefetch_plan.names[j] = s_prefetch_plan.names[j - 1U];
+            s_prefetch_plan.scores[j] = s_prefetch_plan.scores[j - 1U];
+            s_prefetch_plan.names[j - 1U] = name;
+            s_prefetch_plan.scores[j - 1U] = score;
         }
-        return yui_render_widget_list(yml_node_get_child(node, "widgets"), schema, list, scope);
-#else
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Widget type 'list' unavailable: LV_USE_LIST=0");
-        return ESP_OK;
-#endif
     }
-    if (strcmp(type, "panel") == 0) {
-        lv_obj_t *panel = lv_obj_create(parent);
-        yui_register_widget_id(node, panel);
-        lv_obj_set_size(panel, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-        lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
-        if (!yui_node_has_child(node, "width") && yui_parent_flows_column(parent)) {
-            lv_obj_set_width(panel, LV_PCT(100));
+}
+
+static bool yui_prefetch_start_next(void)
+{
+    while (s_prefetch_cursor < s_prefetch_plan.count && s_prefetch_cursor < CONFIG_YAMUI_SCREEN_PREFETCH_TARGETS) {
+        const char *name = s_prefetch_plan.names[s_prefetch_cursor++];
+        const yml_node_t *screen_node = yui_schema_get_screen(&s_prefetch_schema->schema, name);
+        if (!screen_node || strcmp(name, s_prefetch_from) == 0 ||
+            yui_screen_cache_find(s_prefetch_schema, name) != YUI_SCREEN_CACHE_NONE || !yui_screen_cache_has_room(0U)) {
+            continue;
         }
-        yui_apply_common_widget_attrs(panel, node, schema);
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(panel, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, panel);
+        yui_prefetch_scan_t probe = {0};
+        yui_prefetch_scan_node(screen_node, &s_prefetch_schema->schema, &probe, 0);
+        bool has_camera = probe.has_camera;
+        yui_prefetch_scan_reset(&probe);
+        if (has_camera) {
+            continue;
         }
-        const yml_node_t *layout = yml_node_get_child(node, "layout");
-        if (layout) {
-            yui_apply_layout(panel, layout, "column");
+        yui_build_job_t *job = &s_build_job;
+        job->schema = s_prefetch_schema;
+        job->screen_name = yui_strdup_local(name);
+        job->screen_node = screen_node;
+        job->root = yui_screen_create_root(screen_node);
+        if (!job->screen_name || !job->root ||
+            yui_build_push_frame(yml_node_get_child(screen_node, "widgets"), s_prefetch_schema, job->root, NULL) != ESP_OK) {
+            yui_build_abort();
+            return false;
         }
+        return true;
+    }
+    return false;
+}
 
-        const yml_node_t *props_node = yml_node_get_child(node, "props");
-        char title_buf[YUI_TEXT_BUFFER_MAX];
-        const char *title = yui_node_resolved_localized_scalar(node, "title", "title_key", scope, title_buf, sizeof(title_buf));
-        if ((!title || title[0] == '\0') && props_node) {
-            title = yui_node_resolved_localized_scalar(props_node, "title", "title_key", scope, title_buf, sizeof(title_buf));
-            if ((!title || title[0] == '\0')) {
-                title = yui_node_resolved_localized_scalar(props_node, "title", "titleKey", scope, title_buf, sizeof(title_buf));
-            }
+static bool yui_prefetch_next(lv_timer_t *timer)
+{
+    if (!s_prefetch_schema || s_prefetch_schema != s_loaded_schema) {
+        return false;
+    }
+    if (!s_prefetch_planned) {
+        yui_prefetch_plan();
+        lv_timer_set_period(timer, CONFIG_YAMUI_SCREEN_PREFETCH_SLICE_MS);
+    }
+    return yui_prefetch_start_next();
+}
+
+#else
+
+static bool yui_prefetch_next(lv_timer_t *timer)
+{
+    (void)timer;
+    return false;
+}
+
+#endif /* CONFIG_YAMUI_SCREEN_PREFETCH */
+
+/* Foreground builds advance by a bounded number of widgets per GUI loop iteration. Background
+ * (prefetch) builds render widgets at any depth until the tick's time slice runs out, not one
+ * top-level widget per tick, and are dropped when their bound state changes. */
+static void yui_build_timer_cb(lv_timer_t *timer)
+{
+    yui_build_job_t *job = &s_build_job;
+    if (!job->root) {
+        if (!yui_prefetch_next(timer)) {
+            lv_timer_pause(timer);
+            return;
         }
-        if (title && title[0] != '\0') {
-            lv_obj_t *label = lv_label_create(panel);
-            const yui_style_t *title_style = yui_resolve_style(&schema->schema, "stat-label");
-            if (!title_style) {
-                title_style = yui_resolve_style(&schema->schema, "heading");
-            }
-            if (title_style) {
-                yui_apply_style(label, title_style);
-            }
-            lv_label_set_text(label, title);
+    }
+    if (job->foreground) {
+        bool done = yui_build_step(CONFIG_YAMUI_RENDER_WIDGETS_PER_STEP, 0, false);
+        if (job->error != ESP_OK) {
+            yamui_log(YAMUI_LOG_LEVEL_ERROR,
+                      YAMUI_LOG_CAT_LVGL,
+                      "Screen '%s' build failed (%s)",
+                      job->screen_name,
+                      esp_err_to_name(job->error));
+            (void)yamui_async_fail(YUI_BUILD_ASYNC_OP, esp_err_to_name(job->error));
+            job->reported = false;
+            yui_build_abort();
+            lv_timer_pause(timer);
+        } else if (done) {
+            lv_timer_pause(timer);
+            yui_build_complete();
+        } else {
+            yui_build_report_progress();
         }
-
-        return yui_render_widget_list(yml_node_get_child(node, "widgets"), schema, panel, scope);
+        return;
+    }
+    int64_t deadline_us = esp_timer_get_time() + (int64_t)CONFIG_YAMUI_SCREEN_PREFETCH_SLICE_MS * 1000;
+    bool done = yui_build_step(SIZE_MAX, deadline_us, false);
+    if (job->error != ESP_OK || job->invalidated || !yui_screen_cache_has_room(job->bytes)) {
+        yui_build_abort();
+    } else if (done) {
+        yui_build_complete();
     }
-    if (strcmp(type, "spacer") == 0) {
-        lv_obj_t *spacer = lv_obj_create(parent);
-        yui_register_widget_id(node, spacer);
-        lv_obj_remove_style_all(spacer);
-        lv_obj_clear_flag(spacer, LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_clear_flag(spacer, LV_OBJ_FLAG_CLICKABLE);
-        lv_obj_set_style_bg_opa(spacer, LV_OPA_TRANSP, 0);
-        yui_apply_common_widget_attrs(spacer, node, schema);
+}
 
-        lv_coord_t width = 0;
-        lv_coord_t height = 0;
-        bool has_width = yui_node_parse_size(node, "width", &width);
-        bool has_height = yui_node_parse_size(node, "height", &height);
-        int32_t size = yui_node_i32(node, "size", 8);
-        if (size < 0) {
-            size = 0;
+static bool yui_build_timer_arm(uint32_t period_ms)
+{
+    if (!s_build_timer) {
+        s_build_timer = lv_timer_create(yui_build_timer_cb, period_ms, NULL);
+        if (!s_build_timer) {
+            return false;
         }
+    }
+    lv_timer_set_period(s_build_timer, period_ms);
+    lv_timer_reset(s_build_timer);
+    lv_timer_resume(s_build_timer);
+    return true;
+}
 
-        if (!has_width && !has_height) {
-            lv_flex_flow_t parent_flow = lv_obj_get_style_flex_flow(parent, 0);
-            if (parent_flow == LV_FLEX_FLOW_ROW || parent_flow == LV_FLEX_FLOW_ROW_WRAP) {
-                lv_obj_set_size(spacer, (lv_coord_t)size, 1);
-            } else {
-                lv_obj_set_size(spacer, 1, (lv_coord_t)size);
-            }
-        } else {
-            if (!has_width) {
-                width = 1;
-            }
-            if (!has_height) {
-                height = 1;
-            }
-            lv_obj_set_size(spacer, width, height);
-        }
+#if CONFIG_YAMUI_SCREEN_PREFETCH
 
-        yui_widget_runtime_t *runtime = yui_widget_runtime_create(spacer, scope);
-        if (runtime) {
-            (void)yui_widget_bind_conditions(runtime, node, spacer);
+/* Records the transition and re-arms the settle timer for the newly shown screen. */
+static void yui_prefetch_schedule(yui_schema_runtime_t *schema, const char *screen_name)
+{
+    if (s_prefetch_schema != schema) {
+        for (size_t i = 0; i < s_nav_transition_count; ++i) {
+            free(s_nav_transitions[i].from);
+            free(s_nav_transitions[i].to);
         }
-        return ESP_OK;
+        s_nav_transition_count = 0U;
+        free(s_prefetch_from);
+        s_prefetch_from = NULL;
     }
-    yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Unsupported widget type '%s'", type);
-    return ESP_OK;
+    if (s_prefetch_from) {
+        yui_prefetch_record_transition(s_prefetch_from, screen_name);
+    }
+    free(s_prefetch_from);
+    s_prefetch_from = yui_strdup_local(screen_name);
+    s_prefetch_schema = s_prefetch_from ? schema : NULL;
+    yui_prefetch_scan_reset(&s_prefetch_plan);
+    s_prefetch_cursor = 0U;
+    s_prefetch_planned = false;
+    if (CONFIG_YAMUI_SCREEN_CACHE_BUDGET_KB == 0 || !s_prefetch_schema) {
+        return;
+    }
+    (void)yui_build_timer_arm(CONFIG_YAMUI_SCREEN_PREFETCH_DELAY_MS);
 }
 
-static esp_err_t yui_render_screen(const yml_node_t *screen_node, yui_schema_runtime_t *schema)
+#else
+
+static void yui_prefetch_schedule(yui_schema_runtime_t *schema, const char *screen_name)
 {
-    if (!screen_node || !schema) {
-        return ESP_ERR_INVALID_ARG;
+    (void)schema;
+    (void)screen_name;
+}
+
+#endif /* CONFIG_YAMUI_SCREEN_PREFETCH */
+
+/* Navigating to the screen being prefetched finishes its build synchronously; any other
+ * navigation drops the job in progress. */
+static void yui_build_claim(yui_schema_runtime_t *schema, const char *screen_name)
+{
+    yui_build_job_t *job = &s_build_job;
+    if (!job->root) {
+        return;
     }
-    lv_obj_t *root = lv_scr_act();
-    if (!root) {
-        return ESP_FAIL;
+    if (!job->foreground && !job->invalidated && job->schema == schema && strcmp(job->screen_name, screen_name) == 0 &&
+        yui_build_step(SIZE_MAX, 0, false) && job->error == ESP_OK) {
+        yui_build_complete();
+        return;
+    }
+    yui_build_abort();
+}
+
+/* Re-attaches a cached tree for @p screen_name when one exists. Otherwise the screen is built
+ * off-screen up to the fold, swapped in, and completed incrementally by the build timer while
+ * async.screen_render.* reports progress. on_load runs every time the screen becomes active,
+ * after its build has completed. */
+static esp_err_t yui_render_screen(const yml_node_t *screen_node, yui_schema_runtime_t *schema, const char *screen_name)
+{
+    if (!screen_node || !schema || !screen_name) {
+        return ESP_ERR_INVALID_ARG;
     }
+    yui_build_claim(schema, screen_name);
+    lv_obj_t *previous = lv_scr_act();
     kc_touch_display_reset_ui_state();
     yui_modal_close_all();
-    yui_widget_refs_clear();
-    lv_obj_clean(root);
-    lv_obj_set_style_bg_color(root, yui_theme_screen_bg_color(), 0);
-    lv_obj_set_style_bg_opa(root, LV_OPA_COVER, 0);
-    lv_obj_set_style_text_font(root, yui_font_default(), 0);
-
-    lv_obj_add_flag(root, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_scroll_dir(root, LV_DIR_VER);
-    lv_obj_set_scrollbar_mode(root, LV_SCROLLBAR_MODE_AUTO);
-    yui_apply_layout(root, yml_node_get_child(screen_node, "layout"), "column");
+    yui_screen_cache_detach(previous);
+
+    size_t cached = yui_screen_cache_find(schema, screen_name);
+    if (cached != YUI_SCREEN_CACHE_NONE && s_screen_cache[cached].screen == previous) {
+        /* Navigating to the screen already shown rebuilds it */
+        yui_screen_cache_remove_at(cached);
+        cached = YUI_SCREEN_CACHE_NONE;
+    }
+    if (cached != YUI_SCREEN_CACHE_NONE) {
+        yui_screen_cache_entry_t *entry = &s_screen_cache[cached];
+        lv_obj_t *screen = entry->screen;
+        yui_screen_cache_attach(entry);
+        yui_screen_activate(screen);
+        yamui_log(YAMUI_LOG_LEVEL_DEBUG, YAMUI_LOG_CAT_NAV, "Screen '%s' restored from cache", screen_name);
+        yui_screen_run_on_load(screen_node);
+        yui_prefetch_schedule(schema, screen_name);
+        return ESP_OK;
+    }
 
+    yui_build_job_t *job = &s_build_job;
     const yml_node_t *widgets = yml_node_get_child(screen_node, "widgets");
-    esp_err_t err = yui_render_widget_list(widgets, schema, root, NULL);
-    if (err != ESP_OK) {
+    job->foreground = true;
+    job->started_us = esp_timer_get_time();
+    job->schema = schema;
+    job->screen_node = screen_node;
+    job->screen_name = yui_strdup_local(screen_name);
+    job->root = yui_screen_create_root(screen_node);
+    if (!job->screen_name || !job->root || yui_build_push_frame(widgets, schema, job->root, NULL) != ESP_OK) {
+        yui_build_abort();
+        return ESP_ERR_NO_MEM;
+    }
+    bool incremental = CONFIG_YAMUI_RENDER_WIDGETS_PER_STEP > 0;
+    bool done = yui_build_step(SIZE_MAX, 0, incremental);
+    yui_screen_activate(job->root);
+    if (job->error != ESP_OK) {
+        esp_err_t err = job->error;
+        yui_build_abort();
         return err;
     }
-
-    const yml_node_t *on_load = yml_node_get_child(screen_node, "on_load");
-    if (on_load) {
-        yui_action_list_t list = {0};
-        if (yui_action_list_from_node(on_load, &list) == ESP_OK && list.count > 0U) {
-            yui_action_eval_ctx_t eval_ctx = {
-                .resolver = yui_event_symbol_resolver,
-                .resolver_ctx = NULL,
-            };
-            (void)yui_action_list_execute(&list, &eval_ctx);
+    if (done || !yui_build_timer_arm(0U)) {
+        if (!done) {
+            (void)yui_build_step(SIZE_MAX, 0, false);
         }
-        yui_action_list_free(&list);
+        yui_build_complete();
+        return ESP_OK;
     }
-
+    job->widgets_total = yui_build_count_list(widgets, &schema->schema, 0);
+    job->reported = yamui_async_begin(YUI_BUILD_ASYNC_OP, screen_name) == ESP_OK;
+    yui_build_report_progress();
     return ESP_OK;
 }
 
@@ -3971,11 +6092,14 @@ static void yui_schema_runtime_destroy(yui_schema_runtime_t *schema)
     if (!schema) {
         return;
     }
+    yui_translations_invalidate();
     free(schema->name);
     if (schema->root) {
         yml_node_free(schema->root);
     }
+    yui_widget_type_cache_free(&schema->types);
     yui_schema_free(&schema->schema);
+    free(schema->blob_storage);
     free(schema);
 }
 
@@ -3983,6 +6107,7 @@ static void yui_navigation_reset_stack(void)
 {
     yui_modal_close_all();
     yui_widget_refs_clear();
+    yui_screen_cache_clear();
     for (size_t i = 0; i < s_nav_count; ++i) {
         yui_screen_frame_destroy(&s_nav_stack[i]);
     }
@@ -3990,15 +6115,17 @@ static void yui_navigation_reset_stack(void)
     yui_nav_queue_reset();
 }
 
-static yui_schema_runtime_t *yui_schema_runtime_attach(const char *name, yml_node_t *root)
+static yui_schema_runtime_t *yui_schema_runtime_attach(const char *name, yml_node_t *root, void *blob_storage)
 {
     if (!root) {
+        free(blob_storage);
         return NULL;
     }
 
     yui_schema_t schema = {0};
     if (yui_schema_from_tree(root, &schema) != ESP_OK) {
         yml_node_free(root);
+        free(blob_storage);
         return NULL;
     }
 
@@ -4006,20 +6133,97 @@ static yui_schema_runtime_t *yui_schema_runtime_attach(const char *name, yml_nod
     if (!runtime) {
         yui_schema_free(&schema);
         yml_node_free(root);
+        free(blob_storage);
         return NULL;
     }
     runtime->name = yui_strdup_local(name);
     runtime->root = root;
+    runtime->blob_storage = blob_storage;
     runtime->schema = schema;
+    yui_widget_types_prime(runtime, root, 0);
+
+    yml_document_stats_t doc_stats;
+    if (yml_document_get_stats(yml_node_get_document(root), &doc_stats) == ESP_OK) {
+        yamui_log(YAMUI_LOG_LEVEL_DEBUG,
+                  YAMUI_LOG_CAT_PARSER,
+                  "Schema '%s': %u nodes in %u arena blocks (%u/%u bytes, %u strings interned)",
+                  name ? name : "",
+                  (unsigned)doc_stats.nodes,
+                  (unsigned)doc_stats.blocks,
+                  (unsigned)doc_stats.bytes_used,
+                  (unsigned)doc_stats.bytes_reserved,
+                  (unsigned)doc_stats.strings_interned);
+    }
 
     yui_navigation_reset_stack();
     if (s_loaded_schema) {
         yui_schema_runtime_destroy(s_loaded_schema);
     }
     s_loaded_schema = runtime;
+    yui_translations_invalidate();
+    yui_styles_rebuild(runtime);
     return runtime;
 }
 
+static void yui_log_parse_error(const char *name, const yml_parse_error_t *error)
+{
+    if (!error || !error->message) {
+        return;
+    }
+    yamui_log(YAMUI_LOG_LEVEL_ERROR,
+              YAMUI_LOG_CAT_PARSER,
+              "%s:%d (offset %u): %s",
+              name ? name : "schema",
+              error->line,
+              (unsigned)error->offset,
+              error->message);
+}
+
+/* Binary bundles are mapped in place, from a private aligned copy when @p data is
+ * transient or misaligned; YAML text is parsed. */
+static esp_err_t yui_schema_load_tree(const char *name,
+                                      const void *data,
+                                      size_t length,
+                                      bool persistent,
+                                      yml_node_t **out_root,
+                                      void **out_storage)
+{
+    *out_storage = NULL;
+    if (!yaml_core_is_blob(data, length)) {
+        yml_parse_error_t parse_error;
+        esp_err_t err = yaml_core_parse_buffer_ex((const char *)data, length, out_root, &parse_error);
+        if (err != ESP_OK) {
+            yui_log_parse_error(name, &parse_error);
+        }
+        return err;
+    }
+
+    const void *view = data;
+    if (!persistent || ((uintptr_t)data & 3U) != 0U) {
+        void *copy = malloc(length);
+        if (!copy) {
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(copy, data, length);
+        view = copy;
+        *out_storage = copy;
+    }
+    esp_err_t err = yaml_core_blob_view(view, length, out_root);
+    if (err != ESP_OK) {
+        yamui_log(YAMUI_LOG_LEVEL_ERROR, YAMUI_LOG_CAT_PARSER, "%s: invalid binary schema (%s)", name, esp_err_to_name(err));
+        free(*out_storage);
+        *out_storage = NULL;
+        return err;
+    }
+    yamui_log(YAMUI_LOG_LEVEL_DEBUG,
+              YAMUI_LOG_CAT_PARSER,
+              "Schema '%s': mapped %u-byte binary bundle%s",
+              name,
+              (unsigned)length,
+              *out_storage ? " (copied)" : "");
+    return ESP_OK;
+}
+
 static yui_schema_runtime_t *yui_schema_runtime_load_named(const char *name)
 {
     if (!name || name[0] == '\0') {
@@ -4034,10 +6238,12 @@ static yui_schema_runtime_t *yui_schema_runtime_load_named(const char *name)
         return NULL;
     }
     yml_node_t *root = NULL;
-    if (yaml_core_parse_buffer((const char *)blob, blob_size, &root) != ESP_OK) {
+    void *storage = NULL;
+    /* Embedded bundles live in flash for the lifetime of the firmware */
+    if (yui_schema_load_tree(name, blob, blob_size, true, &root, &storage) != ESP_OK) {
         return NULL;
     }
-    return yui_schema_runtime_attach(name, root);
+    return yui_schema_runtime_attach(name, root, storage);
 }
 
 static yui_schema_runtime_t *yui_schema_runtime_load_file(const char *path)
@@ -4049,7 +6255,7 @@ static yui_schema_runtime_t *yui_schema_runtime_load_file(const char *path)
     if (yaml_core_parse_file(path, &root) != ESP_OK) {
         return NULL;
     }
-    return yui_schema_runtime_attach(path, root);
+    return yui_schema_runtime_attach(path, root, NULL);
 }
 
 static const yml_node_t *yui_schema_resolve_screen(yui_schema_runtime_t *schema, const char *screen)
@@ -4095,11 +6301,15 @@ static esp_err_t yui_navigation_render_current(void)
     if (!screen_node) {
         return ESP_ERR_NOT_FOUND;
     }
+    const char *screen_name = frame->screen_name;
+    if (!screen_name || screen_name[0] == '\0') {
+        screen_name = yui_schema_default_screen(&frame->schema->schema);
+    }
     esp_err_t begin_err = yui_nav_queue_begin_render();
     if (begin_err != ESP_OK) {
         return begin_err;
     }
-    esp_err_t err = yui_render_screen(screen_node, frame->schema);
+    esp_err_t err = yui_render_screen(screen_node, frame->schema, screen_name);
     yui_nav_queue_end_render(err == ESP_OK);
     return err;
 }
@@ -4216,6 +6426,8 @@ static esp_err_t yui_navigation_execute_request(yui_nav_request_type_t type, con
         case YUI_NAV_REQUEST_POP:
             return yui_navigation_pop_internal();
         case YUI_NAV_REQUEST_REFRESH:
+            /* A full rebuild must not resurrect stale retained trees */
+            yui_screen_cache_clear();
             return yui_navigation_render_current();
         case YUI_NAV_REQUEST_SHOW_MODAL:
             return yui_modal_show_component(arg);
@@ -4317,15 +6529,13 @@ static esp_err_t yui_runtime_prepare(void)
     yui_register_builtin_natives();
     yui_nav_queue_init(yui_navigation_execute_request, NULL);
     yui_events_set_runtime(&s_runtime_vtable);
+    yui_perf_init();
+    (void)kc_touch_display_set_gesture_cb(yui_gesture_cb, NULL);
     esp_err_t err = yui_register_display_watchers();
     if (err != ESP_OK) {
         return err;
     }
-    err = yui_register_theme_watchers();
-    if (err != ESP_OK) {
-        return err;
-    }
-    return yui_register_locale_watchers();
+    return yui_register_theme_watchers();
 }
 
 static esp_err_t yui_boot_loaded_schema(yui_schema_runtime_t *schema)
@@ -4382,12 +6592,13 @@ esp_err_t lvgl_yaml_gui_load_from_buffer(const char *data, size_t length,
         return err;
     }
     yml_node_t *root = NULL;
-    err = yaml_core_parse_buffer(data, length, &root);
+    void *storage = NULL;
+    err = yui_schema_load_tree(name ? name : "buffer", data, length, false, &root, &storage);
     if (err != ESP_OK) {
         return err;
     }
     yui_schema_runtime_t *schema = yui_schema_runtime_attach(
-        name ? name : "buffer", root);
+        name ? name : "buffer", root, storage);
     return yui_boot_loaded_schema(schema);
 }
 
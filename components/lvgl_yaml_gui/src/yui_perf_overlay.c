@@ -0,0 +1,149 @@
+#include "yui_perf_overlay.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lvgl.h"
+#include "sdkconfig.h"
+#include "yamui_logging.h"
+#include "yamui_profiler.h"
+#include "yamui_runtime.h"
+#include "yui_fonts.h"
+
+#ifndef CONFIG_YAMUI_PROFILER
+#define CONFIG_YAMUI_PROFILER 0
+#endif
+
+#ifndef CONFIG_YAMUI_PROFILER_OVERLAY
+#define CONFIG_YAMUI_PROFILER_OVERLAY 0
+#endif
+
+#ifndef CONFIG_YAMUI_PROFILER_OVERLAY_PERIOD_MS
+#define CONFIG_YAMUI_PROFILER_OVERLAY_PERIOD_MS 1000
+#endif
+
+static lv_obj_t *s_overlay_label;
+static lv_timer_t *s_overlay_timer;
+static bool s_perf_ready;
+
+static const struct {
+    yamui_prof_metric_t metric;
+    const char *label;
+} s_overlay_rows[] = {
+    {YAMUI_PROF_FRAME, "frame"},
+    {YAMUI_PROF_FLUSH, "flush"},
+    {YAMUI_PROF_TIMER_HANDLER, "lvgl"},
+    {YAMUI_PROF_DISPATCH_LATENCY, "queue"},
+    {YAMUI_PROF_BINDING_REFRESH, "bind"},
+    {YAMUI_PROF_SCREEN_BUILD, "build"},
+    {YAMUI_PROF_TOUCH_LATENCY, "touch"},
+};
+
+static void yui_perf_overlay_refresh(lv_timer_t *timer)
+{
+    (void)timer;
+    if (!s_overlay_label) {
+        return;
+    }
+    char text[256];
+    size_t used = 0;
+    text[0] = '\0';
+    for (size_t i = 0; i < sizeof(s_overlay_rows) / sizeof(s_overlay_rows[0]) && used < sizeof(text); ++i) {
+        yamui_prof_summary_t summary;
+        yamui_prof_snapshot(s_overlay_rows[i].metric, &summary);
+        int written = snprintf(text + used,
+                               sizeof(text) - used,
+                               "%s%-5s %5" PRIu32 " %6" PRIu32 " %6" PRIu32,
+                               i ? "\n" : "",
+                               s_overlay_rows[i].label,
+                               summary.count,
+                               summary.p50_us,
+                               summary.p99_us);
+        if (written < 0) {
+            break;
+        }
+        used += (size_t)written;
+    }
+    lv_label_set_text(s_overlay_label, text);
+}
+
+void yui_perf_overlay_show(bool show)
+{
+    if (!show) {
+        if (s_overlay_timer) {
+            lv_timer_delete(s_overlay_timer);
+            s_overlay_timer = NULL;
+        }
+        if (s_overlay_label) {
+            lv_obj_delete(s_overlay_label);
+            s_overlay_label = NULL;
+        }
+        return;
+    }
+    if (s_overlay_label) {
+        return;
+    }
+    s_overlay_label = lv_label_create(lv_layer_top());
+    if (!s_overlay_label) {
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_LVGL, "Profiler overlay allocation failed");
+        return;
+    }
+    lv_obj_set_style_text_font(s_overlay_label, &yui_font_14, LV_PART_MAIN);
+    lv_obj_set_style_text_color(s_overlay_label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(s_overlay_label, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(s_overlay_label, LV_OPA_60, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(s_overlay_label, 4, LV_PART_MAIN);
+    lv_obj_remove_flag(s_overlay_label, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_align(s_overlay_label, LV_ALIGN_TOP_RIGHT, -4, 4);
+    s_overlay_timer = lv_timer_create(yui_perf_overlay_refresh, CONFIG_YAMUI_PROFILER_OVERLAY_PERIOD_MS, NULL);
+    yui_perf_overlay_refresh(NULL);
+}
+
+bool yui_perf_overlay_visible(void)
+{
+    return s_overlay_label != NULL;
+}
+
+/* perf_report [reset]: log every metric, publish telemetry + perf.* state, optionally reset. */
+static void yui_native_fn_perf_report(int argc, const char **argv)
+{
+    for (size_t m = 0; m < YAMUI_PROF_METRIC_COUNT; ++m) {
+        char line[128];
+        yamui_prof_format((yamui_prof_metric_t)m, line, sizeof(line));
+        yamui_log(YAMUI_LOG_LEVEL_INFO, YAMUI_LOG_CAT_NATIVE, "perf %s", line);
+    }
+    yamui_prof_publish();
+    if (argc > 0 && argv && argv[0] && strcmp(argv[0], "reset") == 0) {
+        yamui_prof_reset();
+    }
+}
+
+/* perf_overlay [on|off]: without an argument the overlay toggles. */
+static void yui_native_fn_perf_overlay(int argc, const char **argv)
+{
+    bool show = !yui_perf_overlay_visible();
+    if (argc > 0 && argv && argv[0]) {
+        show = strcmp(argv[0], "off") != 0 && strcmp(argv[0], "0") != 0;
+    }
+    if (show && !yamui_prof_enabled()) {
+        yamui_prof_set_enabled(true);
+    }
+    yui_perf_overlay_show(show);
+}
+
+void yui_perf_init(void)
+{
+    /* Runs on every runtime prepare; only the first applies the Kconfig defaults so a
+     * profiler or overlay switched at runtime survives screen reloads. */
+    if (s_perf_ready) {
+        return;
+    }
+    s_perf_ready = true;
+    yamui_prof_set_enabled(CONFIG_YAMUI_PROFILER);
+    yamui_runtime_register_function("perf_report", yui_native_fn_perf_report);
+    yamui_runtime_register_function("perf_overlay", yui_native_fn_perf_overlay);
+    if (CONFIG_YAMUI_PROFILER_OVERLAY) {
+        yui_perf_overlay_show(true);
+    }
+}
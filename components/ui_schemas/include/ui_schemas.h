@@ -7,6 +7,8 @@
 extern "C" {
 #endif
 
+/* Returned bytes are YAML text, or a binary document when CONFIG_YAMUI_SCHEMAS_BINARY is set
+ * (check with yaml_core_is_blob()). */
 const uint8_t *ui_schemas_get_home(size_t *out_size);
 const uint8_t *ui_schemas_get_named(const char *name, size_t *out_size);
 const char *ui_schemas_get_default_name(void);
@@ -4,8 +4,19 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "sdkconfig.h"
+
+#if CONFIG_YAMUI_SCHEMAS_BINARY
+extern const uint8_t _binary_yamui_bundle_ymlb_start[];
+extern const uint8_t _binary_yamui_bundle_ymlb_end[];
+#define YUI_BUNDLE_START _binary_yamui_bundle_ymlb_start
+#define YUI_BUNDLE_END _binary_yamui_bundle_ymlb_end
+#else
 extern const uint8_t _binary_yamui_bundle_yml_start[];
 extern const uint8_t _binary_yamui_bundle_yml_end[];
+#define YUI_BUNDLE_START _binary_yamui_bundle_yml_start
+#define YUI_BUNDLE_END _binary_yamui_bundle_yml_end
+#endif
 
 typedef struct {
     const char *name;
@@ -14,7 +25,7 @@ typedef struct {
 } yui_schema_blob_t;
 
 static const yui_schema_blob_t s_schema_blobs[] = {
-    {"home", _binary_yamui_bundle_yml_start, _binary_yamui_bundle_yml_end},
+    {"home", YUI_BUNDLE_START, YUI_BUNDLE_END},
 };
 
 static const char *s_default_schema_name = "home";
@@ -16,6 +16,25 @@ typedef enum {
 } yml_node_type_t;
 
 typedef struct yml_node yml_node_t;
+/** Parsed tree plus the arena that backs its nodes and strings. */
+typedef struct yml_document yml_document_t;
+
+/** Location of a parse failure, for diagnostics. */
+typedef struct {
+    int line;            /**< 1-based line number, 0 when unknown. */
+    size_t offset;       /**< Byte offset of the start of that line in the input. */
+    const char *message; /**< Static description, NULL when no error was recorded. */
+} yml_parse_error_t;
+
+typedef struct {
+    size_t nodes;            /**< Nodes in the tree, including the root. */
+    size_t blocks;           /**< Arena blocks backing the document. */
+    size_t bytes_reserved;   /**< Total arena capacity. */
+    size_t bytes_used;       /**< Arena bytes handed out to nodes and strings. */
+    size_t strings_interned; /**< Unique keys and short scalars stored once. */
+    size_t intern_hits;      /**< String copies avoided by interning. */
+    size_t indexed_mappings; /**< Mappings large enough to carry a key hash index. */
+} yml_document_stats_t;
 
 yml_node_type_t yml_node_get_type(const yml_node_t *node);
 const char *yml_node_get_key(const yml_node_t *node);
@@ -26,10 +45,31 @@ const yml_node_t *yml_node_get_child(const yml_node_t *node, const char *key);
 const yml_node_t *yml_node_next(const yml_node_t *node);
 
 esp_err_t yaml_core_parse_buffer(const char *data, size_t length, yml_node_t **out_root);
+/** Same as yaml_core_parse_buffer() but reports where parsing failed in @p out_error (optional). */
+esp_err_t yaml_core_parse_buffer_ex(const char *data, size_t length, yml_node_t **out_root, yml_parse_error_t *out_error);
 esp_err_t yaml_core_parse_string(const char *data, yml_node_t **out_root);
 esp_err_t yaml_core_parse_file(const char *path, yml_node_t **out_root);
+/** Frees the document owning @p node when it is a root; inner nodes are ignored. */
 void yml_node_free(yml_node_t *node);
 
+/** Parses into an arena-backed document; release it with yml_document_free(). */
+esp_err_t yaml_core_document_parse(const char *data, size_t length, yml_document_t **out_doc, yml_parse_error_t *out_error);
+yml_node_t *yml_document_root(yml_document_t *doc);
+/** Returns the document a node belongs to (walks up to the root). */
+const yml_document_t *yml_node_get_document(const yml_node_t *node);
+esp_err_t yml_document_get_stats(const yml_document_t *doc, yml_document_stats_t *out_stats);
+/** Releases every node and string of @p doc; cost scales with block count, not node count. */
+void yml_document_free(yml_document_t *doc);
+
+/** True when @p data starts like a binary document from `tools/yamui_bundle.py --output-blob`. */
+bool yaml_core_is_blob(const void *data, size_t length);
+/**
+ * Validates a binary document and returns its root in place: no parsing, no allocation.
+ * @p data must be 4-byte aligned and outlive the tree; the nodes are read-only and
+ * yml_node_free() ignores them.
+ */
+esp_err_t yaml_core_blob_view(const void *data, size_t length, yml_node_t **out_root);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,38 +2,139 @@
 
 #include <ctype.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
 #include "esp_log.h"
+#include "sdkconfig.h"
+
+#if CONFIG_YAML_CORE_ARENA_PSRAM
+#include "esp_heap_caps.h"
+#endif
+
+#ifndef CONFIG_YAML_CORE_ARENA_BLOCK_SIZE
+#define CONFIG_YAML_CORE_ARENA_BLOCK_SIZE 4096
+#endif
 
 #define YML_MAX_STACK_DEPTH 32
+#define YML_ARENA_BLOCK_MAX (64U * 1024U)
+#define YML_INTERN_DEFAULT_CAPACITY 128U
+/* Longer scalars are mostly free text and rarely repeat */
+#define YML_INTERN_SCALAR_MAX 32U
+/* Smaller mappings are cheaper to scan with strcmp than to hash the query */
+#define YML_KEY_INDEX_MIN_CHILDREN 8U
+
+#define YML_BLOB_VERSION 1U
+/* Set in the type word of every blob node; parsed nodes only use the low values */
+#define YML_BLOB_NODE_FLAG 0x100U
+#define YML_BLOB_TYPE_MASK 0xFFU
+
+typedef struct {
+    uint32_t hash;
+    uint32_t position; /* child index + 1, 0 = empty */
+} yml_key_slot_t;
+
+/* Binary documents written by tools/yamui_bundle.py. Little-endian, 4-byte aligned.
+ * Node references are byte offsets relative to the referencing node, so the blob can
+ * be used straight from flash at whatever address it is mapped. Children of a
+ * container are contiguous records, and mapping key indexes use yml_key_slot_t. */
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t total_size;
+    uint32_t node_offset;
+    uint32_t node_count;
+    uint32_t index_offset;
+    uint32_t index_size;
+    uint32_t string_offset;
+    uint32_t string_size;
+} yml_blob_header_t;
+
+typedef struct {
+    uint32_t type;   /* yml_node_type_t | YML_BLOB_NODE_FLAG */
+    int32_t key;     /* string, 0 = none */
+    int32_t value;   /* scalar string, or first child for containers */
+    uint32_t count;  /* children */
+    int32_t parent;  /* 0 for the root */
+    int32_t index;   /* key index of large mappings, 0 = none */
+} yml_blob_node_t;
+
+_Static_assert(sizeof(yml_node_type_t) == sizeof(uint32_t), "blob nodes share the type word with parsed nodes");
 
 struct yml_node {
     yml_node_type_t type;
-    char *key;
+    const char *key;
     union {
-        char *scalar;
+        const char *scalar;
         struct {
             struct yml_node *head;
             struct yml_node *tail;
             size_t count;
+            /* Filled in once the document is complete */
+            struct yml_node **items;
+            yml_key_slot_t *index;
+            uint32_t index_mask;
         } children;
     } data;
     struct yml_node *parent;
     struct yml_node *next;
 };
 
+typedef struct yml_arena_block {
+    struct yml_arena_block *next;
+    size_t used;
+    size_t capacity;
+    max_align_t data[];
+} yml_arena_block_t;
+
+typedef struct {
+    const char *str;
+    size_t len;
+    uint32_t hash;
+} yml_intern_slot_t;
+
+/* The root node comes first so a root pointer converts back to its document.
+ * Nodes and strings are bump-allocated from the block chain and never freed
+ * individually; the intern table only lives for the duration of the parse. */
+struct yml_document {
+    yml_node_t root;
+    yml_arena_block_t *blocks;
+    size_t next_block_size;
+    yml_document_stats_t stats;
+    yml_intern_slot_t *intern;
+    size_t intern_capacity;
+};
+
+typedef struct {
+    const char *ptr;
+    size_t len;
+} yml_slice_t;
+
+/* One logical YAML line. Key and value are slices into the source buffer, so
+ * tokenizing never allocates; nodes copy them out when they are attached. */
 typedef struct {
     int indent;
     int line_number;
+    size_t offset;
     bool is_sequence;
     bool has_colon;
-    char *key;
-    char *value;
+    bool has_key;
+    bool has_value;
+    yml_slice_t key;
+    yml_slice_t value;
 } yml_line_t;
 
+/* Single-pass cursor over the input; line_number always matches cursor. */
+typedef struct {
+    const char *data;
+    size_t length;
+    size_t cursor;
+    int line_number;
+} yml_reader_t;
+
 typedef struct {
     yml_node_t *node;
     int indent;
@@ -41,14 +142,53 @@ typedef struct {
 
 static const char *TAG = "yaml_core";
 
-static inline void *yml_alloc(size_t size)
+static void *yml_block_malloc(size_t size)
+{
+#if CONFIG_YAML_CORE_ARENA_PSRAM
+    void *ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ptr) {
+        return ptr;
+    }
+#endif
+    return malloc(size);
+}
+
+static void *yml_arena_alloc(yml_document_t *doc, size_t size, size_t align)
 {
-    return calloc(1, size);
+    yml_arena_block_t *block = doc->blocks;
+    if (block) {
+        size_t offset = (block->used + align - 1U) & ~(align - 1U);
+        if (offset + size <= block->capacity) {
+            block->used = offset + size;
+            doc->stats.bytes_used += size;
+            return (unsigned char *)block->data + offset;
+        }
+    }
+
+    size_t capacity = doc->next_block_size;
+    while (capacity < size) {
+        capacity *= 2U;
+    }
+    block = (yml_arena_block_t *)yml_block_malloc(sizeof(yml_arena_block_t) + capacity);
+    if (!block) {
+        return NULL;
+    }
+    block->next = doc->blocks;
+    block->used = size;
+    block->capacity = capacity;
+    doc->blocks = block;
+    if (doc->next_block_size < YML_ARENA_BLOCK_MAX) {
+        doc->next_block_size *= 2U;
+    }
+    doc->stats.blocks++;
+    doc->stats.bytes_reserved += capacity;
+    doc->stats.bytes_used += size;
+    return block->data;
 }
 
-static char *yml_strdup_range(const char *src, size_t len)
+static char *yml_arena_strdup(yml_document_t *doc, const char *src, size_t len)
 {
-    char *out = (char *)malloc(len + 1);
+    char *out = (char *)yml_arena_alloc(doc, len + 1U, 1U);
     if (!out) {
         return NULL;
     }
@@ -57,88 +197,144 @@ static char *yml_strdup_range(const char *src, size_t len)
     return out;
 }
 
-static void yml_trim(char *str)
+static uint32_t yml_hash(const char *str, size_t len)
 {
-    if (!str) {
-        return;
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= (uint8_t)str[i];
+        hash *= 16777619U;
     }
-    size_t len = strlen(str);
-    size_t start = 0;
-    while (start < len && isspace((int)str[start])) {
-        start++;
+    return hash;
+}
+
+static bool yml_intern_grow(yml_document_t *doc)
+{
+    size_t capacity = doc->intern_capacity ? doc->intern_capacity * 2U : YML_INTERN_DEFAULT_CAPACITY;
+    yml_intern_slot_t *table = (yml_intern_slot_t *)calloc(capacity, sizeof(yml_intern_slot_t));
+    if (!table) {
+        return false;
+    }
+    for (size_t i = 0; i < doc->intern_capacity; ++i) {
+        const yml_intern_slot_t *slot = &doc->intern[i];
+        if (!slot->str) {
+            continue;
+        }
+        size_t pos = slot->hash & (capacity - 1U);
+        while (table[pos].str) {
+            pos = (pos + 1U) & (capacity - 1U);
+        }
+        table[pos] = *slot;
+    }
+    free(doc->intern);
+    doc->intern = table;
+    doc->intern_capacity = capacity;
+    return true;
+}
+
+/* Returns the document's single copy of @p slice, storing it on first use. */
+static const char *yml_intern(yml_document_t *doc, yml_slice_t slice)
+{
+    if ((doc->stats.strings_interned + 1U) * 2U > doc->intern_capacity && !yml_intern_grow(doc)) {
+        return NULL;
     }
-    size_t end = len;
-    while (end > start && isspace((int)str[end - 1])) {
-        end--;
+    uint32_t hash = yml_hash(slice.ptr, slice.len);
+    size_t mask = doc->intern_capacity - 1U;
+    size_t pos = hash & mask;
+    while (doc->intern[pos].str) {
+        const yml_intern_slot_t *slot = &doc->intern[pos];
+        if (slot->hash == hash && slot->len == slice.len && memcmp(slot->str, slice.ptr, slice.len) == 0) {
+            doc->stats.intern_hits++;
+            return slot->str;
+        }
+        pos = (pos + 1U) & mask;
     }
-    if (start > 0 || end < len) {
-        memmove(str, str + start, end - start);
-        str[end - start] = '\0';
+    char *copy = yml_arena_strdup(doc, slice.ptr, slice.len);
+    if (!copy) {
+        return NULL;
     }
-    if (str[0] == '\0') {
+    doc->intern[pos].str = copy;
+    doc->intern[pos].len = slice.len;
+    doc->intern[pos].hash = hash;
+    doc->stats.strings_interned++;
+    return copy;
+}
+
+static void yml_set_error(yml_parse_error_t *error, const yml_line_t *line, const char *message)
+{
+    if (!error) {
         return;
     }
-    size_t new_len = strlen(str);
-    if ((str[0] == '"' && str[new_len - 1] == '"') || (str[0] == '\'' && str[new_len - 1] == '\'')) {
-        if (new_len >= 2) {
-            memmove(str, str + 1, new_len - 2);
-            str[new_len - 2] = '\0';
-        }
+    error->line = line ? line->line_number : 0;
+    error->offset = line ? line->offset : 0U;
+    error->message = message;
+}
+
+/* Strips surrounding whitespace and one level of matching quotes. */
+static yml_slice_t yml_slice_trim(const char *ptr, size_t len)
+{
+    while (len > 0U && isspace((unsigned char)*ptr)) {
+        ptr++;
+        len--;
     }
+    while (len > 0U && isspace((unsigned char)ptr[len - 1U])) {
+        len--;
+    }
+    if (len >= 2U && ((ptr[0] == '"' && ptr[len - 1U] == '"') || (ptr[0] == '\'' && ptr[len - 1U] == '\''))) {
+        ptr++;
+        len -= 2U;
+    }
+    yml_slice_t slice = {
+        .ptr = ptr,
+        .len = len,
+    };
+    return slice;
 }
 
-static char *yml_find_unquoted_colon(char *str)
+/* Returns the index of the first unquoted @p stop character in @p str, or @p len. */
+static size_t yml_scan_unquoted(const char *str, size_t len, char stop)
 {
     bool in_quote = false;
     char quote_char = '\0';
-    for (char *p = str; *p; ++p) {
-        if ((*p == '"' || *p == '\'') && (p == str || p[-1] != '\\')) {
-            if (in_quote && *p == quote_char) {
+    for (size_t i = 0; i < len; ++i) {
+        char c = str[i];
+        if ((c == '"' || c == '\'') && (i == 0 || str[i - 1U] != '\\')) {
+            if (in_quote && c == quote_char) {
                 in_quote = false;
                 quote_char = '\0';
             } else if (!in_quote) {
                 in_quote = true;
-                quote_char = *p;
+                quote_char = c;
             }
-        } else if (*p == ':' && !in_quote) {
-            return p;
+        } else if (c == stop && !in_quote) {
+            return i;
         }
     }
-    return NULL;
-}
-
-static void yml_line_cleanup(yml_line_t *line)
-{
-    if (!line) {
-        return;
-    }
-    free(line->key);
-    free(line->value);
-    memset(line, 0, sizeof(*line));
+    return len;
 }
 
-static esp_err_t yml_next_line(const char *data, size_t length, size_t *cursor, yml_line_t *out)
+static esp_err_t yml_next_line(yml_reader_t *reader, yml_line_t *out, yml_parse_error_t *error)
 {
-    int line_number = 1;
-    if (*cursor > 0) {
-        for (size_t i = 0; i < *cursor && i < length; ++i) {
-            if (data[i] == '\n') {
-                line_number++;
-            }
-        }
-    }
-    while (*cursor < length) {
-        int current_line_number = line_number++;
-        size_t line_start = *cursor;
+    const char *data = reader->data;
+    size_t length = reader->length;
+    while (reader->cursor < length) {
+        int current_line_number = reader->line_number;
+        size_t line_start = reader->cursor;
         size_t line_end = line_start;
         while (line_end < length && data[line_end] != '\n' && data[line_end] != '\r') {
             line_end++;
         }
         size_t next = line_end;
         while (next < length && (data[next] == '\n' || data[next] == '\r')) {
+            if (data[next] == '\n') {
+                reader->line_number++;
+            }
             next++;
         }
-        *cursor = next;
+        if (next > line_end && data[next - 1U] == '\r') {
+            /* Bare CR line endings. */
+            reader->line_number++;
+        }
+        reader->cursor = next;
         if (line_end == line_start) {
             continue;
         }
@@ -150,7 +346,12 @@ static esp_err_t yml_next_line(const char *data, size_t length, size_t *cursor,
             if (c == ' ') {
                 indent++;
             } else if (c == '\t') {
-                ESP_LOGE(TAG, "Tabs are not supported in YAML input on line %d", current_line_number);
+                yml_line_t where = {
+                    .line_number = current_line_number,
+                    .offset = line_start + indent,
+                };
+                yml_set_error(error, &where, "tabs are not supported");
+                ESP_LOGE(TAG, "Tabs are not supported in YAML input on line %d (offset %u)", current_line_number, (unsigned)(line_start + indent));
                 return ESP_ERR_INVALID_RESPONSE;
             } else {
                 seen_char = true;
@@ -160,109 +361,58 @@ static esp_err_t yml_next_line(const char *data, size_t length, size_t *cursor,
         if (!seen_char) {
             continue;
         }
-        size_t content_len = line_end - (line_start + indent);
-        if (content_len == 0) {
-            continue;
-        }
 
-        char *content = yml_strdup_range(data + line_start + indent, content_len);
-        if (!content) {
-            return ESP_ERR_NO_MEM;
-        }
-
-        bool in_quote = false;
-        char quote_char = '\0';
-        for (size_t i = 0; content[i]; ++i) {
-            char c = content[i];
-            if ((c == '"' || c == '\'') && (i == 0 || content[i - 1] != '\\')) {
-                if (in_quote && c == quote_char) {
-                    in_quote = false;
-                    quote_char = '\0';
-                } else if (!in_quote) {
-                    in_quote = true;
-                    quote_char = c;
-                }
-            } else if (c == '#' && !in_quote) {
-                content[i] = '\0';
-                break;
-            }
-        }
-        yml_trim(content);
-        if (content[0] == '\0') {
-            free(content);
+        const char *content = data + line_start + indent;
+        size_t content_len = yml_scan_unquoted(content, line_end - (line_start + indent), '#');
+        yml_slice_t payload = yml_slice_trim(content, content_len);
+        if (payload.len == 0U) {
             continue;
         }
 
-        char *payload = content;
-        bool is_sequence = false;
-        if (payload[0] == '-' && (payload[1] == '\0' || isspace((int)payload[1]))) {
-            is_sequence = true;
-            payload++;
-            while (isspace((int)*payload)) {
-                payload++;
+        memset(out, 0, sizeof(*out));
+        out->indent = (int)indent;
+        out->line_number = current_line_number;
+        out->offset = line_start;
+        if (payload.ptr[0] == '-' && (payload.len == 1U || isspace((unsigned char)payload.ptr[1]))) {
+            out->is_sequence = true;
+            payload.ptr++;
+            payload.len--;
+            while (payload.len > 0U && isspace((unsigned char)*payload.ptr)) {
+                payload.ptr++;
+                payload.len--;
             }
         }
 
-        char *key = NULL;
-        char *value = NULL;
-        bool has_colon = false;
-        char *colon = yml_find_unquoted_colon(payload);
-        if (colon) {
-            has_colon = true;
-            key = yml_strdup_range(payload, colon - payload);
-            if (!key) {
-                free(content);
-                return ESP_ERR_NO_MEM;
-            }
-            yml_trim(key);
-            value = strdup(colon + 1);
-            if (!value) {
-                free(key);
-                free(content);
-                return ESP_ERR_NO_MEM;
-            }
-            yml_trim(value);
-            if (value[0] == '\0') {
-                free(value);
-                value = NULL;
-            }
+        size_t colon = yml_scan_unquoted(payload.ptr, payload.len, ':');
+        if (colon < payload.len) {
+            out->has_colon = true;
+            out->has_key = true;
+            out->key = yml_slice_trim(payload.ptr, colon);
+            out->value = yml_slice_trim(payload.ptr + colon + 1U, payload.len - colon - 1U);
         } else {
-            if (!is_sequence) {
-                ESP_LOGE(TAG, "Invalid YAML line %d, missing ':' separator: %s", current_line_number, payload);
-                free(content);
+            if (!out->is_sequence) {
+                yml_set_error(error, out, "missing ':' separator");
+                ESP_LOGE(TAG, "Invalid YAML line %d (offset %u), missing ':' separator: %.*s", current_line_number, (unsigned)line_start,
+                         (int)payload.len, payload.ptr);
                 return ESP_ERR_INVALID_RESPONSE;
             }
-            value = strdup(payload);
-            if (!value) {
-                free(content);
-                return ESP_ERR_NO_MEM;
-            }
-            yml_trim(value);
-            if (value[0] == '\0') {
-                free(value);
-                value = NULL;
-            }
+            out->value = yml_slice_trim(payload.ptr, payload.len);
         }
-
-        out->indent = (int)indent;
-        out->line_number = current_line_number;
-        out->is_sequence = is_sequence;
-        out->has_colon = has_colon;
-        out->key = key;
-        out->value = value;
-        free(content);
+        out->has_value = out->value.len > 0U;
         return ESP_OK;
     }
     return ESP_ERR_NOT_FOUND;
 }
 
-static yml_node_t *yml_node_create(yml_node_type_t type)
+static yml_node_t *yml_node_create(yml_document_t *doc, yml_node_type_t type)
 {
-    yml_node_t *node = (yml_node_t *)yml_alloc(sizeof(yml_node_t));
+    yml_node_t *node = (yml_node_t *)yml_arena_alloc(doc, sizeof(yml_node_t), _Alignof(yml_node_t));
     if (!node) {
         return NULL;
     }
+    memset(node, 0, sizeof(*node));
     node->type = type;
+    doc->stats.nodes++;
     return node;
 }
 
@@ -283,14 +433,38 @@ static void yml_node_append_child(yml_node_t *parent, yml_node_t *child)
     parent->data.children.count++;
 }
 
-static esp_err_t yml_attach_scalar(yml_node_t *node, char *value)
+static esp_err_t yml_attach_scalar(yml_document_t *doc, yml_node_t *node, yml_slice_t value)
 {
+    const char *copy = value.len <= YML_INTERN_SCALAR_MAX ? yml_intern(doc, value)
+                                                          : yml_arena_strdup(doc, value.ptr, value.len);
+    if (!copy) {
+        return ESP_ERR_NO_MEM;
+    }
     node->type = YML_NODE_SCALAR;
-    node->data.scalar = value;
+    node->data.scalar = copy;
+    return ESP_OK;
+}
+
+static esp_err_t yml_attach_key(yml_document_t *doc, yml_node_t *node, yml_slice_t key)
+{
+    node->key = yml_intern(doc, key);
+    return node->key ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t yml_push(const yml_line_t *line, yml_node_t *node, yml_stack_entry_t *stack, size_t *depth, yml_parse_error_t *error)
+{
+    if (*depth >= YML_MAX_STACK_DEPTH) {
+        yml_set_error(error, line, "nesting too deep");
+        ESP_LOGE(TAG, "YAML nesting too deep on line %d (offset %u)", line->line_number, (unsigned)line->offset);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    stack[*depth].node = node;
+    stack[*depth].indent = line->indent;
+    (*depth)++;
     return ESP_OK;
 }
 
-static esp_err_t yml_process_sequence_line(yml_line_t *line, yml_stack_entry_t *stack, size_t *depth)
+static esp_err_t yml_process_sequence_line(yml_document_t *doc, const yml_line_t *line, yml_stack_entry_t *stack, size_t *depth, yml_parse_error_t *error)
 {
     if (*depth == 0) {
         return ESP_ERR_INVALID_RESPONSE;
@@ -300,58 +474,43 @@ static esp_err_t yml_process_sequence_line(yml_line_t *line, yml_stack_entry_t *
         parent->type = YML_NODE_SEQUENCE;
     }
     if (parent->type != YML_NODE_SEQUENCE) {
-        ESP_LOGE(TAG, "Sequence entry encountered but parent is not a sequence");
+        yml_set_error(error, line, "sequence entry inside a mapping");
+        ESP_LOGE(TAG, "Sequence entry encountered but parent is not a sequence (line %d, offset %u)", line->line_number, (unsigned)line->offset);
         return ESP_ERR_INVALID_RESPONSE;
     }
 
-    yml_node_t *entry = yml_node_create(YML_NODE_UNSET);
+    yml_node_t *entry = yml_node_create(doc, YML_NODE_UNSET);
     if (!entry) {
         return ESP_ERR_NO_MEM;
     }
     yml_node_append_child(parent, entry);
 
-    if (line->has_colon && line->key) {
+    if (line->has_colon && line->has_key) {
         entry->type = YML_NODE_MAPPING;
-        yml_node_t *child = yml_node_create(YML_NODE_UNSET);
+        yml_node_t *child = yml_node_create(doc, YML_NODE_UNSET);
         if (!child) {
             return ESP_ERR_NO_MEM;
         }
-        child->key = line->key;
-        line->key = NULL;
-        if (line->value) {
-            yml_attach_scalar(child, line->value);
-            line->value = NULL;
-        }
         yml_node_append_child(entry, child);
-        if (*depth >= YML_MAX_STACK_DEPTH) {
-            ESP_LOGE(TAG, "YAML nesting too deep");
-            return ESP_ERR_INVALID_RESPONSE;
+        esp_err_t err = yml_attach_key(doc, child, line->key);
+        if (err == ESP_OK && line->has_value) {
+            err = yml_attach_scalar(doc, child, line->value);
         }
-        stack[*depth].node = entry;
-        stack[*depth].indent = line->indent;
-        (*depth)++;
-        return ESP_OK;
-    }
-
-    if (line->value) {
-        yml_attach_scalar(entry, line->value);
-        line->value = NULL;
-        return ESP_OK;
+        if (err != ESP_OK) {
+            return err;
+        }
+        return yml_push(line, entry, stack, depth, error);
     }
 
-    if (*depth >= YML_MAX_STACK_DEPTH) {
-        ESP_LOGE(TAG, "YAML nesting too deep");
-        return ESP_ERR_INVALID_RESPONSE;
+    if (line->has_value) {
+        return yml_attach_scalar(doc, entry, line->value);
     }
-    stack[*depth].node = entry;
-    stack[*depth].indent = line->indent;
-    (*depth)++;
-    return ESP_OK;
+    return yml_push(line, entry, stack, depth, error);
 }
 
-static esp_err_t yml_process_mapping_line(yml_line_t *line, yml_stack_entry_t *stack, size_t *depth)
+static esp_err_t yml_process_mapping_line(yml_document_t *doc, const yml_line_t *line, yml_stack_entry_t *stack, size_t *depth, yml_parse_error_t *error)
 {
-    if (!line->key) {
+    if (!line->has_key) {
         return ESP_ERR_INVALID_RESPONSE;
     }
     if (*depth == 0) {
@@ -362,59 +521,145 @@ static esp_err_t yml_process_mapping_line(yml_line_t *line, yml_stack_entry_t *s
         parent->type = YML_NODE_MAPPING;
     }
     if (parent->type != YML_NODE_MAPPING) {
-        ESP_LOGE(TAG, "Mapping entry encountered but parent is not a mapping");
+        yml_set_error(error, line, "mapping entry inside a sequence");
+        ESP_LOGE(TAG, "Mapping entry encountered but parent is not a mapping (line %d, offset %u)", line->line_number, (unsigned)line->offset);
         return ESP_ERR_INVALID_RESPONSE;
     }
 
-    yml_node_t *node = yml_node_create(YML_NODE_UNSET);
+    yml_node_t *node = yml_node_create(doc, YML_NODE_UNSET);
     if (!node) {
         return ESP_ERR_NO_MEM;
     }
-    node->key = line->key;
-    line->key = NULL;
-    if (line->value) {
-        yml_attach_scalar(node, line->value);
-        line->value = NULL;
-    }
     yml_node_append_child(parent, node);
+    esp_err_t err = yml_attach_key(doc, node, line->key);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (line->has_value) {
+        return yml_attach_scalar(doc, node, line->value);
+    }
+    return yml_push(line, node, stack, depth, error);
+}
 
-    if (node->type != YML_NODE_SCALAR) {
-        if (*depth >= YML_MAX_STACK_DEPTH) {
-            ESP_LOGE(TAG, "YAML nesting too deep");
-            return ESP_ERR_INVALID_RESPONSE;
+static yml_document_t *yml_document_create(void)
+{
+    yml_document_t bootstrap = {
+        .next_block_size = CONFIG_YAML_CORE_ARENA_BLOCK_SIZE,
+    };
+    yml_document_t *doc = (yml_document_t *)yml_arena_alloc(&bootstrap, sizeof(yml_document_t), _Alignof(yml_document_t));
+    if (!doc) {
+        return NULL;
+    }
+    *doc = bootstrap;
+    doc->root.type = YML_NODE_MAPPING;
+    doc->stats.nodes = 1U;
+    return doc;
+}
+
+static size_t yml_key_index_capacity(size_t count)
+{
+    size_t capacity = YML_KEY_INDEX_MIN_CHILDREN * 2U;
+    while (capacity < count * 2U) {
+        capacity *= 2U;
+    }
+    return capacity;
+}
+
+static bool yml_node_is_container(const yml_node_t *node)
+{
+    return node->type == YML_NODE_MAPPING || node->type == YML_NODE_SEQUENCE;
+}
+
+/* Gives every container a child array and large mappings a key index. */
+static esp_err_t yml_node_build_index(yml_document_t *doc, yml_node_t *node)
+{
+    size_t count = node->data.children.count;
+    if (count == 0U) {
+        return ESP_OK;
+    }
+    yml_node_t **items = (yml_node_t **)yml_arena_alloc(doc, count * sizeof(yml_node_t *), _Alignof(yml_node_t *));
+    if (!items) {
+        return ESP_ERR_NO_MEM;
+    }
+    size_t i = 0;
+    for (yml_node_t *child = node->data.children.head; child; child = child->next) {
+        items[i++] = child;
+    }
+    node->data.children.items = items;
+
+    if (node->type == YML_NODE_MAPPING && count >= YML_KEY_INDEX_MIN_CHILDREN) {
+        size_t capacity = yml_key_index_capacity(count);
+        yml_key_slot_t *slots = (yml_key_slot_t *)yml_arena_alloc(doc, capacity * sizeof(yml_key_slot_t), _Alignof(yml_key_slot_t));
+        if (!slots) {
+            return ESP_ERR_NO_MEM;
+        }
+        memset(slots, 0, capacity * sizeof(yml_key_slot_t));
+        uint32_t mask = (uint32_t)(capacity - 1U);
+        /* Earlier duplicates claim earlier probe slots, so lookups keep first-match semantics */
+        for (i = 0; i < count; ++i) {
+            uint32_t hash = yml_hash(items[i]->key, strlen(items[i]->key));
+            uint32_t pos = hash & mask;
+            while (slots[pos].position != 0U) {
+                pos = (pos + 1U) & mask;
+            }
+            slots[pos].hash = hash;
+            slots[pos].position = (uint32_t)(i + 1U);
+        }
+        node->data.children.index = slots;
+        node->data.children.index_mask = mask;
+        doc->stats.indexed_mappings++;
+    }
+
+    for (i = 0; i < count; ++i) {
+        if (yml_node_is_container(items[i])) {
+            esp_err_t err = yml_node_build_index(doc, items[i]);
+            if (err != ESP_OK) {
+                return err;
+            }
         }
-        stack[*depth].node = node;
-        stack[*depth].indent = line->indent;
-        (*depth)++;
     }
     return ESP_OK;
 }
 
-esp_err_t yaml_core_parse_buffer(const char *data, size_t length, yml_node_t **out_root)
+static esp_err_t yml_document_finish_parse(yml_document_t *doc)
+{
+    free(doc->intern);
+    doc->intern = NULL;
+    doc->intern_capacity = 0U;
+    return yml_node_build_index(doc, &doc->root);
+}
+
+esp_err_t yaml_core_document_parse(const char *data, size_t length, yml_document_t **out_doc, yml_parse_error_t *out_error)
 {
-    if (!data || !out_root) {
+    if (out_error) {
+        memset(out_error, 0, sizeof(*out_error));
+    }
+    if (!data || !out_doc) {
         return ESP_ERR_INVALID_ARG;
     }
-    yml_node_t *root = yml_node_create(YML_NODE_MAPPING);
-    if (!root) {
+    yml_document_t *doc = yml_document_create();
+    if (!doc) {
         return ESP_ERR_NO_MEM;
     }
 
     yml_stack_entry_t stack[YML_MAX_STACK_DEPTH] = {
-        {.node = root, .indent = -1},
+        {.node = &doc->root, .indent = -1},
     };
     size_t depth = 1;
-    size_t cursor = 0;
-    yml_line_t line = {0};
+    yml_reader_t reader = {
+        .data = data,
+        .length = length,
+        .cursor = 0,
+        .line_number = 1,
+    };
+    yml_line_t line;
 
     while (true) {
-        yml_line_cleanup(&line);
-        esp_err_t err = yml_next_line(data, length, &cursor, &line);
+        esp_err_t err = yml_next_line(&reader, &line, out_error);
         if (err == ESP_ERR_NOT_FOUND) {
             break;
         } else if (err != ESP_OK) {
-            yml_node_free(root);
-            yml_line_cleanup(&line);
+            yml_document_free(doc);
             return err;
         }
 
@@ -422,27 +667,54 @@ esp_err_t yaml_core_parse_buffer(const char *data, size_t length, yml_node_t **o
             depth--;
         }
         if (depth == 0) {
-            yml_node_free(root);
+            yml_set_error(out_error, &line, "invalid indentation");
+            yml_document_free(doc);
             return ESP_ERR_INVALID_RESPONSE;
         }
 
         if (line.is_sequence) {
-            err = yml_process_sequence_line(&line, stack, &depth);
+            err = yml_process_sequence_line(doc, &line, stack, &depth, out_error);
         } else {
-            err = yml_process_mapping_line(&line, stack, &depth);
+            err = yml_process_mapping_line(doc, &line, stack, &depth, out_error);
         }
         if (err != ESP_OK) {
-            yml_node_free(root);
-            yml_line_cleanup(&line);
+            if (err == ESP_ERR_NO_MEM) {
+                yml_set_error(out_error, &line, "out of memory");
+            }
+            yml_document_free(doc);
             return err;
         }
     }
 
-    yml_line_cleanup(&line);
-    *out_root = root;
+    esp_err_t err = yml_document_finish_parse(doc);
+    if (err != ESP_OK) {
+        yml_set_error(out_error, NULL, "out of memory");
+        yml_document_free(doc);
+        return err;
+    }
+    *out_doc = doc;
+    return ESP_OK;
+}
+
+esp_err_t yaml_core_parse_buffer_ex(const char *data, size_t length, yml_node_t **out_root, yml_parse_error_t *out_error)
+{
+    if (!out_root) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    yml_document_t *doc = NULL;
+    esp_err_t err = yaml_core_document_parse(data, length, &doc, out_error);
+    if (err != ESP_OK) {
+        return err;
+    }
+    *out_root = &doc->root;
     return ESP_OK;
 }
 
+esp_err_t yaml_core_parse_buffer(const char *data, size_t length, yml_node_t **out_root)
+{
+    return yaml_core_parse_buffer_ex(data, length, out_root, NULL);
+}
+
 esp_err_t yaml_core_parse_string(const char *data, yml_node_t **out_root)
 {
     if (!data) {
@@ -490,28 +762,177 @@ esp_err_t yaml_core_parse_file(const char *path, yml_node_t **out_root)
         return ESP_ERR_INVALID_RESPONSE;
     }
 
+    if (yaml_core_is_blob(buffer, read_size)) {
+        /* A view cannot own the buffer it points into */
+        ESP_LOGE(TAG, "%s is a binary document; load it with yaml_core_blob_view()", path);
+        free(buffer);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
     esp_err_t err = yaml_core_parse_buffer(buffer, read_size, out_root);
     free(buffer);
     return err;
 }
 
-void yml_node_free(yml_node_t *node)
+static bool yml_node_is_blob(const yml_node_t *node)
 {
-    if (!node) {
-        return;
+    uint32_t type;
+    memcpy(&type, node, sizeof(type));
+    return (type & YML_BLOB_NODE_FLAG) != 0U;
+}
+
+static const yml_blob_node_t *yml_blob_node(const yml_node_t *node)
+{
+    return (const yml_blob_node_t *)(const void *)node;
+}
+
+static const void *yml_blob_ref(const yml_blob_node_t *node, int32_t offset)
+{
+    return offset != 0 ? (const uint8_t *)node + offset : NULL;
+}
+
+static const yml_blob_node_t *yml_blob_first_child(const yml_blob_node_t *node)
+{
+    return (const yml_blob_node_t *)yml_blob_ref(node, node->value);
+}
+
+/* Checks that the @p len bytes at @p from + @p offset lie inside [start, start + size). */
+static bool yml_blob_target_ok(uint32_t from, int32_t offset, uint32_t start, uint32_t size, uint64_t len)
+{
+    int64_t target = (int64_t)from + offset;
+    return target >= (int64_t)start && (uint64_t)(target - (int64_t)start) + len <= size;
+}
+
+bool yaml_core_is_blob(const void *data, size_t length)
+{
+    return data && length >= sizeof(yml_blob_header_t) && memcmp(data, "YMLB", 4U) == 0;
+}
+
+esp_err_t yaml_core_blob_view(const void *data, size_t length, yml_node_t **out_root)
+{
+    if (!out_root || !yaml_core_is_blob(data, length)) {
+        return ESP_ERR_INVALID_ARG;
     }
-    if (node->type == YML_NODE_SCALAR) {
-        free(node->data.scalar);
-    } else {
-        yml_node_t *child = node->data.children.head;
-        while (child) {
-            yml_node_t *next = child->next;
-            yml_node_free(child);
-            child = next;
+    if (((uintptr_t)data & 3U) != 0U) {
+        ESP_LOGE(TAG, "Binary YAML document must be 4-byte aligned");
+        return ESP_ERR_INVALID_ARG;
+    }
+    const uint8_t *base = (const uint8_t *)data;
+    const yml_blob_header_t *header = (const yml_blob_header_t *)data;
+    if (header->version != YML_BLOB_VERSION) {
+        ESP_LOGE(TAG, "Unsupported binary YAML version %u", (unsigned)header->version);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    /* Sections must fit, and the string table must end in a terminator so any
+     * string that starts inside it also ends inside it */
+    uint32_t total = header->total_size;
+    bool header_ok = total <= length &&
+                     header->node_offset >= sizeof(yml_blob_header_t) && header->node_offset % 4U == 0U &&
+                     header->node_offset <= total && header->node_count > 0U &&
+                     header->node_count <= (total - header->node_offset) / sizeof(yml_blob_node_t) &&
+                     header->index_offset % 4U == 0U && header->index_offset <= total &&
+                     header->index_size <= total - header->index_offset &&
+                     header->string_offset <= total && header->string_size > 0U &&
+                     header->string_size <= total - header->string_offset &&
+                     base[header->string_offset + header->string_size - 1U] == '\0';
+    if (!header_ok) {
+        ESP_LOGE(TAG, "Corrupt binary YAML header");
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    const yml_blob_node_t *nodes = (const yml_blob_node_t *)(base + header->node_offset);
+    const uint32_t node_size = (uint32_t)sizeof(yml_blob_node_t);
+    uint32_t node_bytes = header->node_count * node_size;
+    for (uint32_t i = 0; i < header->node_count; ++i) {
+        const yml_blob_node_t *node = &nodes[i];
+        uint32_t at = header->node_offset + i * node_size;
+        uint32_t type = node->type & YML_BLOB_TYPE_MASK;
+        bool ok = (node->type & ~YML_BLOB_TYPE_MASK) == YML_BLOB_NODE_FLAG && type <= YML_NODE_SEQUENCE;
+        ok = ok && (node->key == 0 || yml_blob_target_ok(at, node->key, header->string_offset, header->string_size, 1U));
+        ok = ok && ((i == 0U) == (node->parent == 0));
+        if (ok && type == YML_NODE_SCALAR) {
+            ok = yml_blob_target_ok(at, node->value, header->string_offset, header->string_size, 1U);
+        } else if (ok && node->count > 0U) {
+            /* Children always come after their parent, which rules out cycles */
+            ok = (type == YML_NODE_MAPPING || type == YML_NODE_SEQUENCE) && node->value > 0 &&
+                 node->value % (int32_t)node_size == 0 &&
+                 yml_blob_target_ok(at, node->value, header->node_offset, node_bytes, (uint64_t)node->count * node_size);
+            const yml_blob_node_t *first = ok ? yml_blob_first_child(node) : NULL;
+            for (uint32_t c = 0; ok && c < node->count; ++c) {
+                int64_t child_at = (int64_t)at + node->value + (int64_t)c * node_size;
+                ok = child_at + first[c].parent == (int64_t)at &&
+                     (type != YML_NODE_MAPPING || first[c].key != 0);
+            }
+        }
+        if (ok && node->index != 0) {
+            size_t capacity = yml_key_index_capacity(node->count);
+            ok = type == YML_NODE_MAPPING && node->count >= YML_KEY_INDEX_MIN_CHILDREN && node->index % 4 == 0 &&
+                 yml_blob_target_ok(at, node->index, header->index_offset, header->index_size, (uint64_t)capacity * sizeof(yml_key_slot_t));
+            const yml_key_slot_t *slots = ok ? (const yml_key_slot_t *)yml_blob_ref(node, node->index) : NULL;
+            bool has_empty = false;
+            for (size_t slot = 0; ok && slot < capacity; ++slot) {
+                ok = slots[slot].position <= node->count;
+                has_empty = has_empty || slots[slot].position == 0U;
+            }
+            /* Probing stops at an empty slot, so a full table would never terminate */
+            ok = ok && has_empty;
+        }
+        if (!ok) {
+            ESP_LOGE(TAG, "Corrupt binary YAML node %u", (unsigned)i);
+            return ESP_ERR_INVALID_RESPONSE;
         }
     }
-    free(node->key);
-    free(node);
+    *out_root = (yml_node_t *)(uintptr_t)nodes;
+    return ESP_OK;
+}
+
+void yml_document_free(yml_document_t *doc)
+{
+    if (!doc) {
+        return;
+    }
+    free(doc->intern);
+    /* The document header lives in its own first block */
+    yml_arena_block_t *block = doc->blocks;
+    while (block) {
+        yml_arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+yml_node_t *yml_document_root(yml_document_t *doc)
+{
+    return doc ? &doc->root : NULL;
+}
+
+const yml_document_t *yml_node_get_document(const yml_node_t *node)
+{
+    if (!node || yml_node_is_blob(node)) {
+        return NULL;
+    }
+    while (node->parent) {
+        node = node->parent;
+    }
+    return (const yml_document_t *)node;
+}
+
+esp_err_t yml_document_get_stats(const yml_document_t *doc, yml_document_stats_t *out_stats)
+{
+    if (!doc || !out_stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_stats = doc->stats;
+    return ESP_OK;
+}
+
+void yml_node_free(yml_node_t *node)
+{
+    /* Only a document root owns memory; inner nodes go away with their document
+     * and blob nodes belong to whoever supplied the blob */
+    if (!node || yml_node_is_blob(node) || node->parent) {
+        return;
+    }
+    yml_document_free((yml_document_t *)node);
 }
 
 yml_node_type_t yml_node_get_type(const yml_node_t *node)
@@ -519,51 +940,109 @@ yml_node_type_t yml_node_get_type(const yml_node_t *node)
     if (!node) {
         return YML_NODE_UNSET;
     }
+    if (yml_node_is_blob(node)) {
+        return (yml_node_type_t)(yml_blob_node(node)->type & YML_BLOB_TYPE_MASK);
+    }
     return node->type;
 }
 
 const char *yml_node_get_key(const yml_node_t *node)
 {
-    return node ? node->key : NULL;
+    if (!node) {
+        return NULL;
+    }
+    if (yml_node_is_blob(node)) {
+        return (const char *)yml_blob_ref(yml_blob_node(node), yml_blob_node(node)->key);
+    }
+    return node->key;
 }
 
 const char *yml_node_get_scalar(const yml_node_t *node)
 {
-    if (!node || node->type != YML_NODE_SCALAR) {
+    if (yml_node_get_type(node) != YML_NODE_SCALAR) {
         return NULL;
     }
+    if (yml_node_is_blob(node)) {
+        return (const char *)yml_blob_ref(yml_blob_node(node), yml_blob_node(node)->value);
+    }
     return node->data.scalar;
 }
 
 size_t yml_node_child_count(const yml_node_t *node)
 {
-    if (!node || (node->type != YML_NODE_MAPPING && node->type != YML_NODE_SEQUENCE)) {
+    yml_node_type_t type = yml_node_get_type(node);
+    if (type != YML_NODE_MAPPING && type != YML_NODE_SEQUENCE) {
         return 0;
     }
+    if (yml_node_is_blob(node)) {
+        return yml_blob_node(node)->count;
+    }
     return node->data.children.count;
 }
 
 const yml_node_t *yml_node_child_at(const yml_node_t *node, size_t index)
 {
-    if (!node || (node->type != YML_NODE_MAPPING && node->type != YML_NODE_SEQUENCE)) {
+    if (index >= yml_node_child_count(node)) {
+        return NULL;
+    }
+    if (yml_node_is_blob(node)) {
+        return (const yml_node_t *)(const void *)&yml_blob_first_child(yml_blob_node(node))[index];
+    }
+    return node->data.children.items[index];
+}
+
+static const yml_node_t *yml_blob_get_child(const yml_blob_node_t *node, const char *key)
+{
+    const yml_blob_node_t *first = yml_blob_first_child(node);
+    if (node->index != 0) {
+        const yml_key_slot_t *slots = (const yml_key_slot_t *)yml_blob_ref(node, node->index);
+        uint32_t mask = (uint32_t)(yml_key_index_capacity(node->count) - 1U);
+        uint32_t hash = yml_hash(key, strlen(key));
+        for (uint32_t pos = hash & mask; slots[pos].position != 0U; pos = (pos + 1U) & mask) {
+            if (slots[pos].hash == hash) {
+                const yml_blob_node_t *child = &first[slots[pos].position - 1U];
+                if (strcmp((const char *)yml_blob_ref(child, child->key), key) == 0) {
+                    return (const yml_node_t *)(const void *)child;
+                }
+            }
+        }
         return NULL;
     }
-    const yml_node_t *child = node->data.children.head;
-    size_t idx = 0;
-    while (child && idx < index) {
-        child = child->next;
-        idx++;
+    for (uint32_t i = 0; i < node->count; ++i) {
+        const char *child_key = (const char *)yml_blob_ref(&first[i], first[i].key);
+        if (child_key[0] == key[0] && strcmp(child_key, key) == 0) {
+            return (const yml_node_t *)(const void *)&first[i];
+        }
     }
-    return child;
+    return NULL;
 }
 
 const yml_node_t *yml_node_get_child(const yml_node_t *node, const char *key)
 {
-    if (!node || node->type != YML_NODE_MAPPING || !key) {
+    if (!key || yml_node_get_type(node) != YML_NODE_MAPPING || yml_node_child_count(node) == 0U) {
+        return NULL;
+    }
+    if (yml_node_is_blob(node)) {
+        return yml_blob_get_child(yml_blob_node(node), key);
+    }
+    yml_node_t *const *items = node->data.children.items;
+    const yml_key_slot_t *slots = node->data.children.index;
+    if (slots) {
+        uint32_t hash = yml_hash(key, strlen(key));
+        uint32_t mask = node->data.children.index_mask;
+        for (uint32_t pos = hash & mask; slots[pos].position != 0U; pos = (pos + 1U) & mask) {
+            if (slots[pos].hash == hash) {
+                const yml_node_t *child = items[slots[pos].position - 1U];
+                if (strcmp(child->key, key) == 0) {
+                    return child;
+                }
+            }
+        }
         return NULL;
     }
-    for (const yml_node_t *child = node->data.children.head; child; child = child->next) {
-        if (child->key && strcmp(child->key, key) == 0) {
+    for (size_t i = 0; i < node->data.children.count; ++i) {
+        const yml_node_t *child = items[i];
+        if (child->key && child->key[0] == key[0] && strcmp(child->key, key) == 0) {
             return child;
         }
     }
@@ -572,5 +1051,16 @@ const yml_node_t *yml_node_get_child(const yml_node_t *node, const char *key)
 
 const yml_node_t *yml_node_next(const yml_node_t *node)
 {
-    return node ? node->next : NULL;
+    if (!node) {
+        return NULL;
+    }
+    if (yml_node_is_blob(node)) {
+        const yml_blob_node_t *blob = yml_blob_node(node);
+        const yml_blob_node_t *parent = (const yml_blob_node_t *)yml_blob_ref(blob, blob->parent);
+        if (!parent || (size_t)(blob - yml_blob_first_child(parent)) + 1U >= parent->count) {
+            return NULL;
+        }
+        return (const yml_node_t *)(const void *)(blob + 1);
+    }
+    return node->next;
 }
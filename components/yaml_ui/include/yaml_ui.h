@@ -25,6 +25,9 @@ typedef enum {
     YUI_WIDGET_EVENT_FOCUS,
     YUI_WIDGET_EVENT_BLUR,
     YUI_WIDGET_EVENT_LOAD,
+    YUI_WIDGET_EVENT_LONG_PRESS,
+    YUI_WIDGET_EVENT_PINCH,
+    YUI_WIDGET_EVENT_SWIPE,
     YUI_WIDGET_EVENT_COUNT,
     YUI_WIDGET_EVENT_INVALID = -1,
 } yui_widget_event_type_t;
@@ -41,6 +44,11 @@ typedef struct {
     const yml_node_t *widgets_node;
 } yui_component_def_t;
 
+/* Index into the schema-wide translation key set; the same handle is valid in every locale. */
+typedef uint32_t yui_translation_handle_t;
+
+#define YUI_TRANSLATION_HANDLE_INVALID UINT32_MAX
+
 typedef struct {
     char *key;
     char *value;
@@ -51,8 +59,18 @@ typedef struct {
     char *label;
     yui_translation_entry_t *entries;
     size_t entry_count;
+    const char **values; /* indexed by handle, NULL where the locale has no entry */
+    size_t value_count;
 } yui_translation_locale_t;
 
+typedef struct {
+    const char **keys;   /* handle -> key, borrowed from the locale entries */
+    uint32_t *hashes;
+    uint32_t *slots;     /* open addressing, stores handle + 1 (0 = empty) */
+    size_t key_count;
+    size_t slot_count;
+} yui_translation_index_t;
+
 typedef struct {
     char *name;
     char *background_color;
@@ -93,6 +111,7 @@ typedef struct {
     size_t style_count;
     yui_translation_locale_t *translations;
     size_t translation_count;
+    yui_translation_index_t translation_index;
     yui_component_def_t *components;
     size_t component_count;
 } yui_schema_t;
@@ -106,6 +125,11 @@ const char *yui_schema_get_theme_default_style(const yui_schema_t *schema, const
 const char *yui_schema_default_screen(const yui_schema_t *schema);
 const char *yui_schema_locale(const yui_schema_t *schema);
 const char *yui_schema_translate(const yui_schema_t *schema, const char *locale, const char *key);
+/** Locale bundle for @p locale (NULL selects the app default), or NULL when the schema has none. */
+const yui_translation_locale_t *yui_schema_find_locale(const yui_schema_t *schema, const char *locale);
+/** Resolves @p key once so later lookups skip hashing; YUI_TRANSLATION_HANDLE_INVALID when no locale defines it. */
+yui_translation_handle_t yui_schema_translation_handle(const yui_schema_t *schema, const char *key);
+const char *yui_translation_lookup(const yui_translation_locale_t *locale, yui_translation_handle_t handle);
 
 #ifdef __cplusplus
 }
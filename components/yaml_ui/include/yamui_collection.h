@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define YUI_COLLECTION_NAME_MAX 48
+#define YUI_COLLECTION_COLUMNS_MAX 8
+
+/**
+ * Row-oriented data sets that are too large for individual state keys (logs, sensor
+ * history, scan results). Rows are stored outside the state store, preferably in PSRAM;
+ * every mutation publishes `<name>.count` and `<name>.revision` so bound widgets such as
+ * `virtual_list` / `virtual_table` know when to re-read their visible rows.
+ *
+ * All functions are thread-safe.
+ */
+
+/**
+ * @brief Create (or reconfigure) the collection @p name.
+ *
+ * @p capacity > 0 turns the collection into a ring that drops its oldest row once full;
+ * 0 lets it grow without bound. Recreating an existing collection clears it.
+ */
+esp_err_t yui_collection_create(const char *name, uint16_t columns, uint32_t capacity);
+
+/** Release the collection and its rows. `<name>.count` drops to 0. */
+esp_err_t yui_collection_destroy(const char *name);
+
+/** Remove every row while keeping the collection configured. */
+esp_err_t yui_collection_clear(const char *name);
+
+/**
+ * @brief Append one row. Missing cells are stored empty; extra cells are ignored.
+ */
+esp_err_t yui_collection_append(const char *name, const char *const *cells, uint16_t cell_count);
+
+/**
+ * @brief Append @p row_count rows from a row-major @p cells array of @p columns per row.
+ *
+ * Publishes a single revision for the whole block.
+ */
+esp_err_t yui_collection_append_rows(const char *name, const char *const *cells, uint16_t columns, uint32_t row_count);
+
+/** Replace row @p row (0 = oldest). */
+esp_err_t yui_collection_set_row(const char *name, uint32_t row, const char *const *cells, uint16_t cell_count);
+
+/** Number of rows, or 0 for an unknown collection. */
+uint32_t yui_collection_count(const char *name);
+
+/** Configured column count, or 0 for an unknown collection. */
+uint16_t yui_collection_columns(const char *name);
+
+/**
+ * @brief Copy one cell into @p buffer (always NUL terminated, truncated to fit).
+ *
+ * Returns false and writes an empty string when the row or column does not exist.
+ */
+bool yui_collection_copy_cell(const char *name, uint32_t row, uint16_t column, char *buffer, size_t buffer_len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -27,6 +27,9 @@ typedef struct {
 typedef bool (*yui_expr_symbol_resolver_t)(const char *identifier, void *ctx, yui_expr_value_t *out);
 typedef void (*yui_expr_identifier_cb_t)(const char *identifier, void *ctx);
 
+/** Opaque compiled expression (stack bytecode plus constant and identifier pools). */
+typedef struct yui_expr_program yui_expr_program_t;
+
 void yui_expr_value_reset(yui_expr_value_t *value);
 void yui_expr_value_set_string_copy(yui_expr_value_t *value, const char *text);
 void yui_expr_value_set_string_ref(yui_expr_value_t *value, const char *text);
@@ -37,6 +40,18 @@ esp_err_t yui_expr_eval(const char *expression, yui_expr_symbol_resolver_t resol
 esp_err_t yui_expr_eval_to_string(const char *expression, yui_expr_symbol_resolver_t resolver, void *ctx, char *out, size_t out_len);
 esp_err_t yui_expr_collect_identifiers(const char *expression, yui_expr_identifier_cb_t cb, void *ctx);
 
+/**
+ * Compile an expression once so it can be evaluated repeatedly with yui_expr_run
+ * without re-tokenizing. The program keeps a private copy of the source text.
+ */
+esp_err_t yui_expr_compile(const char *expression, yui_expr_program_t **out_program);
+esp_err_t yui_expr_run(const yui_expr_program_t *program, yui_expr_symbol_resolver_t resolver, void *ctx, yui_expr_value_t *out_value);
+esp_err_t yui_expr_run_to_string(const yui_expr_program_t *program, yui_expr_symbol_resolver_t resolver, void *ctx, char *out, size_t out_len);
+/** Invoke cb once per distinct identifier referenced by the program. */
+esp_err_t yui_expr_program_collect_identifiers(const yui_expr_program_t *program, yui_expr_identifier_cb_t cb, void *ctx);
+const char *yui_expr_program_source(const yui_expr_program_t *program);
+void yui_expr_program_free(yui_expr_program_t *program);
+
 #ifdef __cplusplus
 }
 #endif
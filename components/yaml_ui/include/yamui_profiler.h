@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * GUI hot-path profiler. Each metric is a histogram of durations in microseconds with
+ * power-of-two buckets; recording is a handful of relaxed atomic updates, so it is safe
+ * from any task. Recording is off until yamui_prof_set_enabled(true).
+ */
+typedef enum {
+    YAMUI_PROF_FRAME = 0,        /**< LVGL render of one frame (refresh start to ready) */
+    YAMUI_PROF_FLUSH,            /**< One buffer handed to the panel until its transfer finished */
+    YAMUI_PROF_TIMER_HANDLER,    /**< One lv_timer_handler() pass */
+    YAMUI_PROF_DISPATCH_LATENCY, /**< GUI dispatch/post until the GUI task ran it */
+    YAMUI_PROF_BINDING_REFRESH,  /**< One widget binding refresh */
+    YAMUI_PROF_SCREEN_BUILD,     /**< Building a screen tree, including incremental steps */
+    YAMUI_PROF_TOUCH_LATENCY,    /**< Touch controller scan until a frame showing it was flushed */
+    YAMUI_PROF_METRIC_COUNT,
+} yamui_prof_metric_t;
+
+/** Bucket 0 holds <= 1 us, bucket b holds (2^(b-1), 2^b] us; the last one is open-ended. */
+#define YAMUI_PROF_BUCKETS 21
+
+typedef struct {
+    uint32_t count;
+    uint32_t total_us; /**< Wraps after ~71 minutes of accumulated time; reset between reads */
+    uint32_t max_us;
+    uint32_t p50_us;   /**< Percentiles are bucket upper bounds */
+    uint32_t p90_us;
+    uint32_t p99_us;
+    uint32_t buckets[YAMUI_PROF_BUCKETS];
+} yamui_prof_summary_t;
+
+void yamui_prof_set_enabled(bool enabled);
+bool yamui_prof_enabled(void);
+
+void yamui_prof_record(yamui_prof_metric_t metric, uint32_t duration_us);
+
+/** Counters are read one by one, so a snapshot taken during recording can be off by a sample. */
+void yamui_prof_snapshot(yamui_prof_metric_t metric, yamui_prof_summary_t *out);
+void yamui_prof_reset(void);
+
+/** Short identifier used for telemetry subjects and state keys ("frame", "flush", ...). */
+const char *yamui_prof_metric_name(yamui_prof_metric_t metric);
+
+/** One-line summary such as "frame n=120 p50=4096 p90=8192 p99=16384 max=15020 us". */
+size_t yamui_prof_format(yamui_prof_metric_t metric, char *buffer, size_t buffer_len);
+
+/**
+ * Emit every metric with samples as YAMUI_TELEMETRY_PERF events (subject = metric name,
+ * detail = "p50" / "p90" / "p99" / "max" / "count") and mirror them into the state store as
+ * `perf.<metric>.<field>` so screens can bind to them.
+ */
+void yamui_prof_publish(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "esp_err.h"
+#include "yaml_core.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,11 +15,29 @@ typedef void (*yamui_native_fn_t)(int argc, const char **argv);
 
 typedef void (*yamui_event_listener_t)(const char *event, const char **args, size_t arg_count, void *user_ctx);
 
+/**
+ * Factory for a native widget type. Called on the GUI task with the parent `lv_obj_t *`
+ * and the widget's YAML node; returns the created root object (as `lv_obj_t *`) or NULL.
+ * The builder applies `id`, `style`, sizing, `visible`/`enabled` and `on_*` events to the
+ * returned object, so factories only create and configure their own content.
+ */
+typedef void *(*yamui_widget_factory_t)(void *parent, const yml_node_t *node, void *user_ctx);
+
 esp_err_t yamui_runtime_init(void);
 esp_err_t yamui_runtime_register_function(const char *name, yamui_native_fn_t fn);
 esp_err_t yamui_runtime_unregister_function(const char *name);
 esp_err_t yamui_runtime_call_function(const char *name, const char **args, size_t arg_count);
 
+/**
+ * @brief Register @p type as a custom widget. Overrides a built-in type of the same name;
+ *        schema components still take precedence.
+ */
+esp_err_t yamui_runtime_register_widget(const char *type, yamui_widget_factory_t factory, void *user_ctx);
+esp_err_t yamui_runtime_unregister_widget(const char *type);
+bool yamui_runtime_find_widget(const char *type, yamui_widget_factory_t *out_factory, void **out_user_ctx);
+/** Bumped on every widget (un)registration so cached type resolutions can be revalidated. */
+uint32_t yamui_runtime_widget_generation(void);
+
 esp_err_t yamui_runtime_add_event_listener(const char *event, yamui_event_listener_t listener, void *user_ctx);
 void yamui_runtime_remove_event_listener(yamui_event_listener_t listener, void *user_ctx);
 esp_err_t yamui_runtime_emit_event(const char *event, const char **args, size_t arg_count);
@@ -17,7 +17,30 @@ extern "C" {
 typedef void (*yui_state_watch_cb_t)(const char *key, const char *value, void *user_ctx);
 /** Listener handle used to unsubscribe from state changes. */
 typedef uint32_t yui_state_watch_handle_t;
+/** Interned key handle returned by yui_state_key_resolve; 0 is never a valid key. */
+typedef uint32_t yui_state_key_t;
 
+#define YUI_STATE_KEY_INVALID 0U
+
+/** Native representation of a stored value. */
+typedef enum {
+    YUI_STATE_VALUE_STRING = 0,
+    YUI_STATE_VALUE_INT,
+    YUI_STATE_VALUE_FLOAT,
+    YUI_STATE_VALUE_BOOL,
+} yui_state_value_type_t;
+
+/**
+ * Tagged state value. Only the field matching @ref type is meaningful; @ref string
+ * points into the store and follows the same lifetime rules as yui_state_get().
+ */
+typedef struct {
+    yui_state_value_type_t type;
+    const char *string;
+    int32_t int_value;
+    double float_value;
+    bool bool_value;
+} yui_state_value_t;
 
 /** Optional helper used when seeding the state store programmatically. */
 typedef struct {
@@ -25,6 +48,14 @@ typedef struct {
     const char *value;
 } yui_state_seed_t;
 
+/** Counters exposed for benchmarks and diagnostics. */
+typedef struct {
+    uint32_t lock_acquisitions; /**< Outermost state mutex acquisitions. */
+    uint32_t updates;           /**< Stores that changed a value. */
+    uint32_t notifications;     /**< Watcher callbacks dispatched. */
+    uint32_t batches;           /**< Committed outermost batches. */
+} yui_state_stats_t;
+
 /**
  * @brief Initialize the global YamUI state store.
  *
@@ -57,8 +88,43 @@ esp_err_t yui_state_seed_from_yaml(const yml_node_t *state_node);
  */
 esp_err_t yui_state_set(const char *key, const char *value);
 
+/**
+ * @brief Apply several updates under a single lock acquisition.
+ *
+ * Equivalent to wrapping yui_state_set() calls in a begin/commit batch. Entries with an
+ * empty key are skipped.
+ */
+esp_err_t yui_state_set_many(const yui_state_seed_t *entries, size_t entry_count);
+
+/**
+ * @brief Open a state transaction.
+ *
+ * The state lock is held until the matching yui_state_commit_batch(), so other tasks
+ * block on state access in between; keep batches short. Sets inside a batch are visible
+ * immediately to the calling task but watchers are deferred to the commit, where each
+ * watcher callback/context pair is notified once. Batches may nest.
+ */
+esp_err_t yui_state_begin_batch(void);
+
+/**
+ * @brief Close the innermost batch; the outermost commit delivers the coalesced notifications.
+ *
+ * Returns ESP_ERR_INVALID_STATE when no batch is open.
+ */
+esp_err_t yui_state_commit_batch(void);
+
+/**
+ * @brief Store a typed value.
+ *
+ * Numbers and booleans are kept natively; their text form is only rendered when a
+ * string reader (yui_state_get, a watcher, telemetry) needs it. A typed value that
+ * renders to the current text does not count as a change.
+ */
+esp_err_t yui_state_set_value(const char *key, const yui_state_value_t *value);
+
 /** Convenience helpers for numeric and boolean values. */
 esp_err_t yui_state_set_int(const char *key, int32_t value);
+esp_err_t yui_state_set_float(const char *key, double value);
 esp_err_t yui_state_set_bool(const char *key, bool value);
 
 /**
@@ -66,8 +132,35 @@ esp_err_t yui_state_set_bool(const char *key, bool value);
  */
 const char *yui_state_get(const char *key, const char *default_value);
 int32_t yui_state_get_int(const char *key, int32_t default_value);
+double yui_state_get_float(const char *key, double default_value);
 bool yui_state_get_bool(const char *key, bool default_value);
 
+/**
+ * @brief Fetch the native value for @p key without converting it.
+ *
+ * Returns false when the key is unknown. String values are returned as-is; callers that
+ * need numbers from text state still parse them.
+ */
+bool yui_state_get_value(const char *key, yui_state_value_t *out_value);
+
+/**
+ * @brief Resolve @p key to a stable handle, reserving the slot if the key is not set yet.
+ *
+ * Handles skip hashing and key normalization on every access and stay valid until
+ * yui_state_deinit(); yui_state_clear() keeps them. Resolving does not define the key,
+ * so yui_state_get() keeps returning its default until a value is stored.
+ */
+esp_err_t yui_state_key_resolve(const char *key, yui_state_key_t *out_key);
+
+/** Return the normalized key name for @p key, or NULL for an unknown handle. */
+const char *yui_state_key_name(yui_state_key_t key);
+
+/** Handle-based equivalents of yui_state_set() / yui_state_get() and their typed forms. */
+esp_err_t yui_state_set_by_key(yui_state_key_t key, const char *value);
+const char *yui_state_get_by_key(yui_state_key_t key, const char *default_value);
+esp_err_t yui_state_set_value_by_key(yui_state_key_t key, const yui_state_value_t *value);
+bool yui_state_get_value_by_key(yui_state_key_t key, yui_state_value_t *out_value);
+
 /**
  * @brief Register a watcher for @p key.
  *
@@ -75,11 +168,23 @@ bool yui_state_get_bool(const char *key, bool default_value);
  */
 esp_err_t yui_state_watch(const char *key, yui_state_watch_cb_t cb, void *user_ctx, yui_state_watch_handle_t *out_handle);
 
+/**
+ * @brief Register a watcher for a resolved key handle.
+ *
+ * Watchers are indexed per key, so a change only wakes the subscribers of that key plus
+ * any wildcard watchers.
+ */
+esp_err_t yui_state_watch_key(yui_state_key_t key, yui_state_watch_cb_t cb, void *user_ctx, yui_state_watch_handle_t *out_handle);
+
 /**
  * @brief Remove a previously registered watcher.
  */
 void yui_state_unwatch(yui_state_watch_handle_t handle);
 
+/** Snapshot or reset the state store counters. */
+void yui_state_get_stats(yui_state_stats_t *out_stats);
+void yui_state_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -268,6 +268,45 @@ static void yui_translation_locale_free(yui_translation_locale_t *locale)
     }
     locale->entries = NULL;
     locale->entry_count = 0U;
+    free(locale->values);
+    locale->values = NULL;
+    locale->value_count = 0U;
+}
+
+static void yui_translation_index_free(yui_translation_index_t *index)
+{
+    free(index->keys);
+    free(index->hashes);
+    free(index->slots);
+    memset(index, 0, sizeof(*index));
+}
+
+static uint32_t yui_translation_hash(const char *key)
+{
+    uint32_t hash = 2166136261U;
+    for (const unsigned char *p = (const unsigned char *)key; *p; ++p) {
+        hash ^= *p;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+static uint32_t yui_translation_index_find(const yui_translation_index_t *index, const char *key, uint32_t hash)
+{
+    if (!index->slots) {
+        return YUI_TRANSLATION_HANDLE_INVALID;
+    }
+    size_t mask = index->slot_count - 1U;
+    for (size_t probe = hash & mask;; probe = (probe + 1U) & mask) {
+        uint32_t slot = index->slots[probe];
+        if (slot == 0U) {
+            return YUI_TRANSLATION_HANDLE_INVALID;
+        }
+        uint32_t handle = slot - 1U;
+        if (index->hashes[handle] == hash && strcmp(index->keys[handle], key) == 0) {
+            return handle;
+        }
+    }
 }
 
 static esp_err_t yui_parse_styles(const yml_node_t *node, yui_schema_t *schema)
@@ -356,6 +395,65 @@ static esp_err_t yui_parse_translation_entries(const yml_node_t *node, yui_trans
     return ESP_OK;
 }
 
+/* Merges the keys of every locale into one hash index and gives each locale a dense
+ * handle -> value table, so widgets resolve a key once and switch locales by indexing. */
+static esp_err_t yui_build_translation_index(yui_schema_t *schema)
+{
+    size_t total = 0U;
+    for (size_t i = 0; i < schema->translation_count; ++i) {
+        total += schema->translations[i].entry_count;
+    }
+    if (total == 0U) {
+        return ESP_OK;
+    }
+    yui_translation_index_t *index = &schema->translation_index;
+    size_t slot_count = 16U;
+    while (slot_count < total * 2U) {
+        slot_count <<= 1U;
+    }
+    index->keys = (const char **)malloc(total * sizeof(const char *));
+    index->hashes = (uint32_t *)malloc(total * sizeof(uint32_t));
+    index->slots = (uint32_t *)calloc(slot_count, sizeof(uint32_t));
+    if (!index->keys || !index->hashes || !index->slots) {
+        return ESP_ERR_NO_MEM;
+    }
+    index->slot_count = slot_count;
+    for (size_t i = 0; i < schema->translation_count; ++i) {
+        const yui_translation_locale_t *locale = &schema->translations[i];
+        for (size_t j = 0; j < locale->entry_count; ++j) {
+            const char *key = locale->entries[j].key;
+            uint32_t hash = yui_translation_hash(key);
+            if (yui_translation_index_find(index, key, hash) != YUI_TRANSLATION_HANDLE_INVALID) {
+                continue;
+            }
+            uint32_t handle = (uint32_t)index->key_count++;
+            index->keys[handle] = key;
+            index->hashes[handle] = hash;
+            size_t probe = hash & (slot_count - 1U);
+            while (index->slots[probe] != 0U) {
+                probe = (probe + 1U) & (slot_count - 1U);
+            }
+            index->slots[probe] = handle + 1U;
+        }
+    }
+    for (size_t i = 0; i < schema->translation_count; ++i) {
+        yui_translation_locale_t *locale = &schema->translations[i];
+        locale->values = (const char **)calloc(index->key_count, sizeof(const char *));
+        if (!locale->values) {
+            return ESP_ERR_NO_MEM;
+        }
+        locale->value_count = index->key_count;
+        for (size_t j = 0; j < locale->entry_count; ++j) {
+            const yui_translation_entry_t *entry = &locale->entries[j];
+            uint32_t handle = yui_translation_index_find(index, entry->key, yui_translation_hash(entry->key));
+            if (handle != YUI_TRANSLATION_HANDLE_INVALID && !locale->values[handle]) {
+                locale->values[handle] = entry->value;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
 static esp_err_t yui_parse_translations(const yml_node_t *node, yui_schema_t *schema)
 {
     if (!schema) {
@@ -392,7 +490,7 @@ static esp_err_t yui_parse_translations(const yml_node_t *node, yui_schema_t *sc
         }
     }
     schema->translation_count = idx;
-    return ESP_OK;
+    return yui_build_translation_index(schema);
 }
 
 static void yui_component_def_free(yui_component_def_t *component)
@@ -643,6 +741,7 @@ void yui_schema_free(yui_schema_t *schema)
     }
     schema->translations = NULL;
     schema->translation_count = 0U;
+    yui_translation_index_free(&schema->translation_index);
 
     if (schema->components) {
         for (size_t i = 0; i < schema->component_count; ++i) {
@@ -739,21 +838,39 @@ const char *yui_schema_translate(const yui_schema_t *schema, const char *locale,
     if (!schema || !key || key[0] == '\0') {
         return NULL;
     }
+    return yui_translation_lookup(yui_schema_find_locale(schema, locale), yui_schema_translation_handle(schema, key));
+}
+
+const yui_translation_locale_t *yui_schema_find_locale(const yui_schema_t *schema, const char *locale)
+{
+    if (!schema || !schema->translations) {
+        return NULL;
+    }
     const char *target_locale = (locale && locale[0] != '\0') ? locale : schema->app.locale;
-    if (!target_locale || target_locale[0] == '\0' || !schema->translations) {
+    if (!target_locale || target_locale[0] == '\0') {
         return NULL;
     }
     for (size_t i = 0; i < schema->translation_count; ++i) {
         const yui_translation_locale_t *bucket = &schema->translations[i];
-        if (!bucket->locale || strcmp(bucket->locale, target_locale) != 0) {
-            continue;
-        }
-        for (size_t j = 0; j < bucket->entry_count; ++j) {
-            if (bucket->entries[j].key && strcmp(bucket->entries[j].key, key) == 0) {
-                return bucket->entries[j].value;
-            }
+        if (bucket->locale && strcmp(bucket->locale, target_locale) == 0) {
+            return bucket;
         }
-        break;
     }
     return NULL;
 }
+
+yui_translation_handle_t yui_schema_translation_handle(const yui_schema_t *schema, const char *key)
+{
+    if (!schema || !key || key[0] == '\0') {
+        return YUI_TRANSLATION_HANDLE_INVALID;
+    }
+    return yui_translation_index_find(&schema->translation_index, key, yui_translation_hash(key));
+}
+
+const char *yui_translation_lookup(const yui_translation_locale_t *locale, yui_translation_handle_t handle)
+{
+    if (!locale || handle >= locale->value_count) {
+        return NULL;
+    }
+    return locale->values[handle];
+}
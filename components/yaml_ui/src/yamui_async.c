@@ -64,6 +64,19 @@ static esp_err_t yui_async_set_int_field(const char *operation, const char *fiel
     return yui_state_set_int(key, value);
 }
 
+/* Each lifecycle call updates several async.<op>.* keys; batching them means bound
+ * widgets refresh once per call instead of once per field. */
+static esp_err_t yui_async_commit(bool batched, esp_err_t first_err)
+{
+    if (batched) {
+        esp_err_t err = yui_state_commit_batch();
+        if (first_err == ESP_OK && err != ESP_OK) {
+            first_err = err;
+        }
+    }
+    return first_err;
+}
+
 static int32_t yui_async_clamp_progress(int32_t progress)
 {
     if (progress < 0) {
@@ -77,6 +90,7 @@ static int32_t yui_async_clamp_progress(int32_t progress)
 
 esp_err_t yamui_async_reset(const char *operation, const char *message)
 {
+    bool batched = yui_state_begin_batch() == ESP_OK;
     esp_err_t first_err = yui_async_set_bool_field(operation, "running", false);
     esp_err_t err = yui_async_set_int_field(operation, "progress", 0);
     if (first_err == ESP_OK && err != ESP_OK) {
@@ -94,11 +108,12 @@ esp_err_t yamui_async_reset(const char *operation, const char *message)
     if (first_err == ESP_OK && err != ESP_OK) {
         first_err = err;
     }
-    return first_err;
+    return yui_async_commit(batched, first_err);
 }
 
 esp_err_t yamui_async_begin(const char *operation, const char *message)
 {
+    bool batched = yui_state_begin_batch() == ESP_OK;
     esp_err_t first_err = yui_async_set_bool_field(operation, "running", true);
     esp_err_t err = yui_async_set_int_field(operation, "progress", 0);
     if (first_err == ESP_OK && err != ESP_OK) {
@@ -116,11 +131,12 @@ esp_err_t yamui_async_begin(const char *operation, const char *message)
     if (first_err == ESP_OK && err != ESP_OK) {
         first_err = err;
     }
-    return first_err;
+    return yui_async_commit(batched, first_err);
 }
 
 esp_err_t yamui_async_progress(const char *operation, int32_t progress, const char *message)
 {
+    bool batched = yui_state_begin_batch() == ESP_OK;
     esp_err_t first_err = yui_async_set_bool_field(operation, "running", true);
     esp_err_t err = yui_async_set_int_field(operation, "progress", yui_async_clamp_progress(progress));
     if (first_err == ESP_OK && err != ESP_OK) {
@@ -136,11 +152,12 @@ esp_err_t yamui_async_progress(const char *operation, int32_t progress, const ch
             first_err = err;
         }
     }
-    return first_err;
+    return yui_async_commit(batched, first_err);
 }
 
 esp_err_t yamui_async_complete(const char *operation, const char *message)
 {
+    bool batched = yui_state_begin_batch() == ESP_OK;
     esp_err_t first_err = yui_async_set_bool_field(operation, "running", false);
     esp_err_t err = yui_async_set_int_field(operation, "progress", 100);
     if (first_err == ESP_OK && err != ESP_OK) {
@@ -158,11 +175,12 @@ esp_err_t yamui_async_complete(const char *operation, const char *message)
     if (first_err == ESP_OK && err != ESP_OK) {
         first_err = err;
     }
-    return first_err;
+    return yui_async_commit(batched, first_err);
 }
 
 esp_err_t yamui_async_fail(const char *operation, const char *message)
 {
+    bool batched = yui_state_begin_batch() == ESP_OK;
     esp_err_t first_err = yui_async_set_bool_field(operation, "running", false);
     esp_err_t err = yui_async_set_string_field(operation, "status", "error");
     if (first_err == ESP_OK && err != ESP_OK) {
@@ -176,5 +194,5 @@ esp_err_t yamui_async_fail(const char *operation, const char *message)
     if (first_err == ESP_OK && err != ESP_OK) {
         first_err = err;
     }
-    return first_err;
+    return yui_async_commit(batched, first_err);
 }
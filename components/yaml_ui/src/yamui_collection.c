@@ -0,0 +1,389 @@
+#include "yamui_collection.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "yamui_logging.h"
+#include "yamui_state.h"
+
+#define YUI_COLLECTION_KEY_BUFFER_MAX (YUI_COLLECTION_NAME_MAX + 16)
+
+/* Each row is one allocation holding its cells back to back as NUL-terminated strings,
+ * so a row costs a single heap block regardless of its column count. Ring collections
+ * address rows through @ref head; unbounded ones always keep head at 0. */
+typedef struct {
+    char name[YUI_COLLECTION_NAME_MAX];
+    uint16_t columns;
+    uint32_t capacity; /* 0 = unbounded */
+    char **rows;
+    uint32_t row_capacity;
+    uint32_t head;
+    uint32_t count;
+    uint32_t revision;
+} yui_collection_t;
+
+typedef struct {
+    char name[YUI_COLLECTION_NAME_MAX];
+    uint32_t count;
+    uint32_t revision;
+} yui_collection_publish_t;
+
+static yui_collection_t *s_collections;
+static size_t s_collection_count;
+static size_t s_collection_capacity;
+static SemaphoreHandle_t s_collection_lock;
+static StaticSemaphore_t s_collection_lock_buffer;
+static portMUX_TYPE s_collection_init_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static bool yui_collection_lock(void)
+{
+    if (!s_collection_lock) {
+        portENTER_CRITICAL(&s_collection_init_mux);
+        if (!s_collection_lock) {
+            s_collection_lock = xSemaphoreCreateMutexStatic(&s_collection_lock_buffer);
+        }
+        portEXIT_CRITICAL(&s_collection_init_mux);
+    }
+    return s_collection_lock && xSemaphoreTake(s_collection_lock, portMAX_DELAY) == pdTRUE;
+}
+
+static void yui_collection_unlock(void)
+{
+    xSemaphoreGive(s_collection_lock);
+}
+
+static bool yui_collection_name_valid(const char *name)
+{
+    return name && name[0] != '\0' && strlen(name) < YUI_COLLECTION_NAME_MAX;
+}
+
+static yui_collection_t *yui_collection_find_locked(const char *name)
+{
+    for (size_t i = 0; i < s_collection_count; ++i) {
+        if (strcmp(s_collections[i].name, name) == 0) {
+            return &s_collections[i];
+        }
+    }
+    return NULL;
+}
+
+static char **yui_collection_slot(yui_collection_t *collection, uint32_t row)
+{
+    uint32_t index = collection->head + row;
+    if (index >= collection->row_capacity) {
+        index -= collection->row_capacity;
+    }
+    return &collection->rows[index];
+}
+
+static char *yui_collection_row_pack(const yui_collection_t *collection, const char *const *cells, uint16_t cell_count)
+{
+    size_t total = 0U;
+    for (uint16_t col = 0; col < collection->columns; ++col) {
+        const char *cell = (cells && col < cell_count && cells[col]) ? cells[col] : "";
+        total += strlen(cell) + 1U;
+    }
+    char *row = (char *)heap_caps_malloc_prefer(total, 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_8BIT);
+    if (!row) {
+        return NULL;
+    }
+    char *cursor = row;
+    for (uint16_t col = 0; col < collection->columns; ++col) {
+        const char *cell = (cells && col < cell_count && cells[col]) ? cells[col] : "";
+        size_t len = strlen(cell) + 1U;
+        memcpy(cursor, cell, len);
+        cursor += len;
+    }
+    return row;
+}
+
+static void yui_collection_release_rows(yui_collection_t *collection)
+{
+    for (uint32_t row = 0; row < collection->count; ++row) {
+        char **slot = yui_collection_slot(collection, row);
+        heap_caps_free(*slot);
+        *slot = NULL;
+    }
+    collection->head = 0U;
+    collection->count = 0U;
+}
+
+static esp_err_t yui_collection_push_locked(yui_collection_t *collection, char *row)
+{
+    if (collection->capacity > 0U && collection->count == collection->capacity) {
+        char **oldest = yui_collection_slot(collection, 0U);
+        heap_caps_free(*oldest);
+        *oldest = row;
+        collection->head = (collection->head + 1U) % collection->row_capacity;
+        return ESP_OK;
+    }
+    if (collection->count == collection->row_capacity) {
+        /* Only unbounded collections grow; ring buffers are sized up front with head == 0. */
+        uint32_t new_capacity = collection->row_capacity == 0U ? 64U : collection->row_capacity * 2U;
+        char **next = (char **)heap_caps_realloc_prefer(collection->rows, new_capacity * sizeof(char *), 2,
+                                                         MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_8BIT);
+        if (!next) {
+            return ESP_ERR_NO_MEM;
+        }
+        collection->rows = next;
+        collection->row_capacity = new_capacity;
+    }
+    *yui_collection_slot(collection, collection->count) = row;
+    collection->count++;
+    return ESP_OK;
+}
+
+static void yui_collection_snapshot(yui_collection_t *collection, yui_collection_publish_t *out)
+{
+    memcpy(out->name, collection->name, sizeof(out->name));
+    out->count = collection->count;
+    out->revision = ++collection->revision;
+}
+
+/* Runs outside the collection lock so watchers may read rows back. Concurrent mutators
+ * can reach this in any order, so the live count and revision are re-read while the
+ * batch holds the state lock; the last publisher then always writes the newest values.
+ * The snapshot only stands in once the collection has been destroyed. */
+static void yui_collection_publish(const yui_collection_publish_t *snapshot)
+{
+    char key[YUI_COLLECTION_KEY_BUFFER_MAX];
+    (void)yui_state_begin_batch();
+    uint32_t count = snapshot->count;
+    uint32_t revision = snapshot->revision;
+    if (yui_collection_lock()) {
+        const yui_collection_t *collection = yui_collection_find_locked(snapshot->name);
+        if (collection) {
+            count = collection->count;
+            revision = collection->revision;
+        }
+        yui_collection_unlock();
+    }
+    snprintf(key, sizeof(key), "%s.count", snapshot->name);
+    (void)yui_state_set_int(key, (int32_t)count);
+    snprintf(key, sizeof(key), "%s.revision", snapshot->name);
+    (void)yui_state_set_int(key, (int32_t)revision);
+    (void)yui_state_commit_batch();
+}
+
+esp_err_t yui_collection_create(const char *name, uint16_t columns, uint32_t capacity)
+{
+    if (!yui_collection_name_valid(name) || columns == 0U || columns > YUI_COLLECTION_COLUMNS_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    char **rows = NULL;
+    if (capacity > 0U) {
+        rows = (char **)heap_caps_calloc_prefer(capacity, sizeof(char *), 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_8BIT);
+        if (!rows) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    if (!yui_collection_lock()) {
+        heap_caps_free(rows);
+        return ESP_ERR_INVALID_STATE;
+    }
+    yui_collection_t *collection = yui_collection_find_locked(name);
+    if (!collection) {
+        if (s_collection_count == s_collection_capacity) {
+            size_t new_capacity = s_collection_capacity == 0U ? 4U : s_collection_capacity * 2U;
+            yui_collection_t *next = (yui_collection_t *)realloc(s_collections, new_capacity * sizeof(yui_collection_t));
+            if (!next) {
+                yui_collection_unlock();
+                heap_caps_free(rows);
+                return ESP_ERR_NO_MEM;
+            }
+            s_collections = next;
+            s_collection_capacity = new_capacity;
+        }
+        collection = &s_collections[s_collection_count++];
+        memset(collection, 0, sizeof(*collection));
+        strcpy(collection->name, name);
+    } else {
+        yui_collection_release_rows(collection);
+        heap_caps_free(collection->rows);
+    }
+    collection->columns = columns;
+    collection->capacity = capacity;
+    collection->rows = rows;
+    collection->row_capacity = capacity;
+    yui_collection_publish_t snapshot;
+    yui_collection_snapshot(collection, &snapshot);
+    yui_collection_unlock();
+    yui_collection_publish(&snapshot);
+    return ESP_OK;
+}
+
+esp_err_t yui_collection_destroy(const char *name)
+{
+    if (!yui_collection_name_valid(name)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!yui_collection_lock()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    yui_collection_t *collection = yui_collection_find_locked(name);
+    if (!collection) {
+        yui_collection_unlock();
+        return ESP_ERR_NOT_FOUND;
+    }
+    yui_collection_release_rows(collection);
+    heap_caps_free(collection->rows);
+    yui_collection_publish_t snapshot;
+    yui_collection_snapshot(collection, &snapshot);
+    size_t index = (size_t)(collection - s_collections);
+    s_collections[index] = s_collections[--s_collection_count];
+    yui_collection_unlock();
+    yui_collection_publish(&snapshot);
+    return ESP_OK;
+}
+
+esp_err_t yui_collection_clear(const char *name)
+{
+    if (!yui_collection_name_valid(name)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!yui_collection_lock()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    yui_collection_t *collection = yui_collection_find_locked(name);
+    if (!collection) {
+        yui_collection_unlock();
+        return ESP_ERR_NOT_FOUND;
+    }
+    yui_collection_release_rows(collection);
+    yui_collection_publish_t snapshot;
+    yui_collection_snapshot(collection, &snapshot);
+    yui_collection_unlock();
+    yui_collection_publish(&snapshot);
+    return ESP_OK;
+}
+
+esp_err_t yui_collection_append(const char *name, const char *const *cells, uint16_t cell_count)
+{
+    return yui_collection_append_rows(name, cells, cell_count, 1U);
+}
+
+esp_err_t yui_collection_append_rows(const char *name, const char *const *cells, uint16_t columns, uint32_t row_count)
+{
+    if (!yui_collection_name_valid(name) || (!cells && columns > 0U)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (row_count == 0U) {
+        return ESP_OK;
+    }
+    if (!yui_collection_lock()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    yui_collection_t *collection = yui_collection_find_locked(name);
+    if (!collection) {
+        yui_collection_unlock();
+        return ESP_ERR_NOT_FOUND;
+    }
+    esp_err_t err = ESP_OK;
+    uint32_t appended = 0U;
+    for (; appended < row_count; ++appended) {
+        char *row = yui_collection_row_pack(collection, cells ? cells + (size_t)appended * columns : NULL, columns);
+        if (!row) {
+            err = ESP_ERR_NO_MEM;
+            break;
+        }
+        err = yui_collection_push_locked(collection, row);
+        if (err != ESP_OK) {
+            heap_caps_free(row);
+            break;
+        }
+    }
+    yui_collection_publish_t snapshot;
+    if (appended > 0U) {
+        yui_collection_snapshot(collection, &snapshot);
+    }
+    yui_collection_unlock();
+    if (appended > 0U) {
+        yui_collection_publish(&snapshot);
+    }
+    if (err != ESP_OK) {
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_STATE, "Collection '%s' append stopped after %u rows", name, (unsigned)appended);
+    }
+    return err;
+}
+
+esp_err_t yui_collection_set_row(const char *name, uint32_t row, const char *const *cells, uint16_t cell_count)
+{
+    if (!yui_collection_name_valid(name)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!yui_collection_lock()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    yui_collection_t *collection = yui_collection_find_locked(name);
+    if (!collection || row >= collection->count) {
+        yui_collection_unlock();
+        return collection ? ESP_ERR_INVALID_ARG : ESP_ERR_NOT_FOUND;
+    }
+    char *packed = yui_collection_row_pack(collection, cells, cell_count);
+    if (!packed) {
+        yui_collection_unlock();
+        return ESP_ERR_NO_MEM;
+    }
+    char **slot = yui_collection_slot(collection, row);
+    heap_caps_free(*slot);
+    *slot = packed;
+    yui_collection_publish_t snapshot;
+    yui_collection_snapshot(collection, &snapshot);
+    yui_collection_unlock();
+    yui_collection_publish(&snapshot);
+    return ESP_OK;
+}
+
+uint32_t yui_collection_count(const char *name)
+{
+    if (!yui_collection_name_valid(name) || !yui_collection_lock()) {
+        return 0U;
+    }
+    yui_collection_t *collection = yui_collection_find_locked(name);
+    uint32_t count = collection ? collection->count : 0U;
+    yui_collection_unlock();
+    return count;
+}
+
+uint16_t yui_collection_columns(const char *name)
+{
+    if (!yui_collection_name_valid(name) || !yui_collection_lock()) {
+        return 0U;
+    }
+    yui_collection_t *collection = yui_collection_find_locked(name);
+    uint16_t columns = collection ? collection->columns : 0U;
+    yui_collection_unlock();
+    return columns;
+}
+
+bool yui_collection_copy_cell(const char *name, uint32_t row, uint16_t column, char *buffer, size_t buffer_len)
+{
+    if (!buffer || buffer_len == 0U) {
+        return false;
+    }
+    buffer[0] = '\0';
+    if (!yui_collection_name_valid(name) || !yui_collection_lock()) {
+        return false;
+    }
+    yui_collection_t *collection = yui_collection_find_locked(name);
+    if (!collection || row >= collection->count || column >= collection->columns) {
+        yui_collection_unlock();
+        return false;
+    }
+    const char *cell = *yui_collection_slot(collection, row);
+    for (uint16_t col = 0; col < column; ++col) {
+        cell += strlen(cell) + 1U;
+    }
+    size_t len = strlen(cell);
+    if (len >= buffer_len) {
+        len = buffer_len - 1U;
+    }
+    memcpy(buffer, cell, len);
+    buffer[len] = '\0';
+    yui_collection_unlock();
+    return true;
+}
@@ -199,11 +199,50 @@ typedef struct {
     const char *cursor;
 } yui_expr_lexer_t;
 
+typedef enum {
+    YUI_EXPR_OP_CONST = 0,
+    YUI_EXPR_OP_LOAD,
+    YUI_EXPR_OP_NOT,
+    YUI_EXPR_OP_NEG,
+    YUI_EXPR_OP_MUL,
+    YUI_EXPR_OP_DIV,
+    YUI_EXPR_OP_ADD,
+    YUI_EXPR_OP_SUB,
+    YUI_EXPR_OP_GT,
+    YUI_EXPR_OP_GE,
+    YUI_EXPR_OP_LT,
+    YUI_EXPR_OP_LE,
+    YUI_EXPR_OP_EQ,
+    YUI_EXPR_OP_NE,
+    YUI_EXPR_OP_AND,
+    YUI_EXPR_OP_OR,
+    YUI_EXPR_OP_COALESCE,
+    YUI_EXPR_OP_SELECT,
+} yui_expr_opcode_t;
+
+typedef struct {
+    uint8_t op;
+    uint16_t operand;
+} yui_expr_instr_t;
+
+struct yui_expr_program {
+    char *source;
+    yui_expr_instr_t *code;
+    size_t code_count;
+    size_t code_capacity;
+    yui_expr_value_t *constants;
+    size_t constant_count;
+    size_t constant_capacity;
+    char **symbols;
+    size_t symbol_count;
+    size_t symbol_capacity;
+};
+
 typedef struct {
     yui_expr_lexer_t lexer;
     yui_expr_token_t current;
-    yui_expr_symbol_resolver_t resolver;
-    void *resolver_ctx;
+    yui_expr_program_t *program;
+    size_t depth;
     esp_err_t status;
 } yui_expr_parser_t;
 
@@ -506,7 +545,7 @@ static bool yui_expr_parser_expect(yui_expr_parser_t *parser, yui_expr_token_typ
     return false;
 }
 
-static yui_expr_value_t yui_expr_parse_expression(yui_expr_parser_t *parser);
+static void yui_expr_parse_expression(yui_expr_parser_t *parser);
 
 static yui_expr_value_t yui_expr_make_null(void)
 {
@@ -520,291 +559,307 @@ static yui_expr_value_t yui_expr_make_null(void)
     return value;
 }
 
-static yui_expr_value_t yui_expr_parse_primary(yui_expr_parser_t *parser)
+static void yui_expr_emit(yui_expr_parser_t *parser, yui_expr_opcode_t op, size_t operand, int stack_effect)
+{
+    if (parser->status != ESP_OK) {
+        return;
+    }
+    yui_expr_program_t *program = parser->program;
+    if (operand > UINT16_MAX) {
+        parser->status = ESP_ERR_INVALID_SIZE;
+        return;
+    }
+    if (stack_effect > 0) {
+        parser->depth += (size_t)stack_effect;
+        if (parser->depth > YUI_EXPR_MAX_STACK_DEPTH) {
+            parser->status = ESP_ERR_INVALID_SIZE;
+            return;
+        }
+    } else {
+        parser->depth -= (size_t)(-stack_effect);
+    }
+    if (program->code_count == program->code_capacity) {
+        size_t new_capacity = program->code_capacity == 0U ? 8U : program->code_capacity * 2U;
+        yui_expr_instr_t *resized = (yui_expr_instr_t *)realloc(program->code, new_capacity * sizeof(yui_expr_instr_t));
+        if (!resized) {
+            parser->status = ESP_ERR_NO_MEM;
+            return;
+        }
+        program->code = resized;
+        program->code_capacity = new_capacity;
+    }
+    program->code[program->code_count].op = (uint8_t)op;
+    program->code[program->code_count].operand = (uint16_t)operand;
+    program->code_count++;
+}
+
+static void yui_expr_emit_constant(yui_expr_parser_t *parser, yui_expr_value_t *value)
+{
+    yui_expr_program_t *program = parser->program;
+    if (parser->status != ESP_OK) {
+        yui_expr_value_reset(value);
+        return;
+    }
+    if (program->constant_count == program->constant_capacity) {
+        size_t new_capacity = program->constant_capacity == 0U ? 4U : program->constant_capacity * 2U;
+        yui_expr_value_t *resized = (yui_expr_value_t *)realloc(program->constants, new_capacity * sizeof(yui_expr_value_t));
+        if (!resized) {
+            yui_expr_value_reset(value);
+            parser->status = ESP_ERR_NO_MEM;
+            return;
+        }
+        program->constants = resized;
+        program->constant_capacity = new_capacity;
+    }
+    size_t index = program->constant_count++;
+    program->constants[index] = *value;
+    *value = yui_expr_make_null();
+    yui_expr_emit(parser, YUI_EXPR_OP_CONST, index, 1);
+}
+
+static void yui_expr_emit_load(yui_expr_parser_t *parser, const char *symbol)
 {
+    yui_expr_program_t *program = parser->program;
     if (parser->status != ESP_OK) {
-        return yui_expr_make_null();
+        return;
+    }
+    for (size_t i = 0; i < program->symbol_count; ++i) {
+        if (strcmp(program->symbols[i], symbol) == 0) {
+            yui_expr_emit(parser, YUI_EXPR_OP_LOAD, i, 1);
+            return;
+        }
+    }
+    if (program->symbol_count == program->symbol_capacity) {
+        size_t new_capacity = program->symbol_capacity == 0U ? 4U : program->symbol_capacity * 2U;
+        char **resized = (char **)realloc(program->symbols, new_capacity * sizeof(char *));
+        if (!resized) {
+            parser->status = ESP_ERR_NO_MEM;
+            return;
+        }
+        program->symbols = resized;
+        program->symbol_capacity = new_capacity;
+    }
+    char *copy = yui_expr_strndup(symbol, strlen(symbol));
+    if (!copy) {
+        parser->status = ESP_ERR_NO_MEM;
+        return;
+    }
+    size_t index = program->symbol_count++;
+    program->symbols[index] = copy;
+    yui_expr_emit(parser, YUI_EXPR_OP_LOAD, index, 1);
+}
+
+static void yui_expr_parse_primary(yui_expr_parser_t *parser)
+{
+    if (parser->status != ESP_OK) {
+        return;
     }
     yui_expr_value_t value = yui_expr_make_null();
     switch (parser->current.type) {
         case YUI_EXPR_TOKEN_NUMBER:
             yui_expr_value_set_number(&value, parser->current.number);
             yui_expr_parser_advance(parser);
-            return value;
+            yui_expr_emit_constant(parser, &value);
+            return;
         case YUI_EXPR_TOKEN_TRUE:
             yui_expr_value_set_bool(&value, true);
             yui_expr_parser_advance(parser);
-            return value;
+            yui_expr_emit_constant(parser, &value);
+            return;
         case YUI_EXPR_TOKEN_FALSE:
             yui_expr_value_set_bool(&value, false);
             yui_expr_parser_advance(parser);
-            return value;
+            yui_expr_emit_constant(parser, &value);
+            return;
         case YUI_EXPR_TOKEN_NULL:
             yui_expr_parser_advance(parser);
-            return value;
+            yui_expr_emit_constant(parser, &value);
+            return;
         case YUI_EXPR_TOKEN_STRING:
             yui_expr_value_set_string_copy(&value, parser->current.text);
             yui_expr_parser_advance(parser);
-            return value;
-        case YUI_EXPR_TOKEN_IDENTIFIER: {
-            const char *raw = parser->current.text ? parser->current.text : "";
-            char *symbol = yui_expr_strndup(raw, strlen(raw));
-            yui_expr_parser_advance(parser);
-            if (!symbol) {
+            if (value.type != YUI_EXPR_VALUE_STRING) {
                 parser->status = ESP_ERR_NO_MEM;
-                return value;
-            }
-            if (parser->resolver && parser->resolver(symbol, parser->resolver_ctx, &value)) {
-                /* resolver populated value */
-            } else {
-                yui_expr_value_set_string_ref(&value, "");
+                return;
             }
-            free(symbol);
-            return value;
-        }
+            yui_expr_emit_constant(parser, &value);
+            return;
+        case YUI_EXPR_TOKEN_IDENTIFIER:
+            yui_expr_emit_load(parser, parser->current.text ? parser->current.text : "");
+            yui_expr_parser_advance(parser);
+            return;
         case YUI_EXPR_TOKEN_LPAREN:
             yui_expr_parser_advance(parser);
-            value = yui_expr_parse_expression(parser);
+            yui_expr_parse_expression(parser);
             yui_expr_parser_expect(parser, YUI_EXPR_TOKEN_RPAREN);
-            return value;
+            return;
         default:
             parser->status = ESP_ERR_INVALID_ARG;
-            return value;
+            return;
     }
 }
 
-static yui_expr_value_t yui_expr_parse_unary(yui_expr_parser_t *parser)
+static void yui_expr_parse_unary(yui_expr_parser_t *parser)
 {
     if (parser->status != ESP_OK) {
-        return yui_expr_make_null();
+        return;
     }
     if (parser->current.type == YUI_EXPR_TOKEN_BANG) {
         yui_expr_parser_advance(parser);
-        yui_expr_value_t operand = yui_expr_parse_unary(parser);
-        bool flag = !yui_expr_as_bool(&operand);
-        yui_expr_value_reset(&operand);
-        yui_expr_value_t result = yui_expr_make_null();
-        yui_expr_value_set_bool(&result, flag);
-        return result;
+        yui_expr_parse_unary(parser);
+        yui_expr_emit(parser, YUI_EXPR_OP_NOT, 0U, 0);
+        return;
     }
     if (parser->current.type == YUI_EXPR_TOKEN_MINUS) {
         yui_expr_parser_advance(parser);
-        yui_expr_value_t operand = yui_expr_parse_unary(parser);
-        double number = -yui_expr_as_number(&operand);
-        yui_expr_value_reset(&operand);
-        yui_expr_value_t result = yui_expr_make_null();
-        yui_expr_value_set_number(&result, number);
-        return result;
+        yui_expr_parse_unary(parser);
+        yui_expr_emit(parser, YUI_EXPR_OP_NEG, 0U, 0);
+        return;
     }
-    return yui_expr_parse_primary(parser);
+    yui_expr_parse_primary(parser);
 }
 
-static yui_expr_value_t yui_expr_parse_factor(yui_expr_parser_t *parser)
+static void yui_expr_parse_factor(yui_expr_parser_t *parser)
 {
-    yui_expr_value_t value = yui_expr_parse_unary(parser);
+    yui_expr_parse_unary(parser);
     while (parser->status == ESP_OK && (parser->current.type == YUI_EXPR_TOKEN_STAR || parser->current.type == YUI_EXPR_TOKEN_SLASH)) {
         yui_expr_token_type_t type = parser->current.type;
         yui_expr_parser_advance(parser);
-        yui_expr_value_t rhs = yui_expr_parse_unary(parser);
-        double left = yui_expr_as_number(&value);
-        double right = yui_expr_as_number(&rhs);
-        double result = 0.0;
-        if (type == YUI_EXPR_TOKEN_STAR) {
-            result = left * right;
-        } else if (right != 0.0) {
-            result = left / right;
-        } else {
-            parser->status = ESP_ERR_INVALID_ARG;
-        }
-        yui_expr_value_reset(&value);
-        yui_expr_value_set_number(&value, result);
-        yui_expr_value_reset(&rhs);
+        yui_expr_parse_unary(parser);
+        yui_expr_emit(parser, type == YUI_EXPR_TOKEN_STAR ? YUI_EXPR_OP_MUL : YUI_EXPR_OP_DIV, 0U, -1);
     }
-    return value;
 }
 
-static yui_expr_value_t yui_expr_parse_term(yui_expr_parser_t *parser)
+static void yui_expr_parse_term(yui_expr_parser_t *parser)
 {
-    yui_expr_value_t value = yui_expr_parse_factor(parser);
+    yui_expr_parse_factor(parser);
     while (parser->status == ESP_OK && (parser->current.type == YUI_EXPR_TOKEN_PLUS || parser->current.type == YUI_EXPR_TOKEN_MINUS)) {
         yui_expr_token_type_t type = parser->current.type;
         yui_expr_parser_advance(parser);
-        yui_expr_value_t rhs = yui_expr_parse_factor(parser);
-        if (type == YUI_EXPR_TOKEN_PLUS && (value.type == YUI_EXPR_VALUE_STRING || rhs.type == YUI_EXPR_VALUE_STRING)) {
-            char left_buf[64];
-            char right_buf[64];
-            const char *left = yui_expr_as_cstring(&value, left_buf, sizeof(left_buf));
-            const char *right = yui_expr_as_cstring(&rhs, right_buf, sizeof(right_buf));
-            size_t left_len = strlen(left);
-            size_t right_len = strlen(right);
-            size_t total = left_len + right_len;
-            char *joined = (char *)malloc(total + 1U);
-            if (!joined) {
-                parser->status = ESP_ERR_NO_MEM;
-            } else {
-                memcpy(joined, left, left_len);
-                memcpy(joined + left_len, right, right_len);
-                joined[total] = '\0';
-                yui_expr_value_reset(&value);
-                value.type = YUI_EXPR_VALUE_STRING;
-                value.owned_string = joined;
-                value.string = joined;
-            }
-        } else {
-            double left_num = yui_expr_as_number(&value);
-            double right_num = yui_expr_as_number(&rhs);
-            double result = (type == YUI_EXPR_TOKEN_PLUS) ? (left_num + right_num) : (left_num - right_num);
-            yui_expr_value_reset(&value);
-            yui_expr_value_set_number(&value, result);
-        }
-        yui_expr_value_reset(&rhs);
+        yui_expr_parse_factor(parser);
+        yui_expr_emit(parser, type == YUI_EXPR_TOKEN_PLUS ? YUI_EXPR_OP_ADD : YUI_EXPR_OP_SUB, 0U, -1);
     }
-    return value;
 }
 
-static yui_expr_value_t yui_expr_parse_comparison(yui_expr_parser_t *parser)
+static void yui_expr_parse_comparison(yui_expr_parser_t *parser)
 {
-    yui_expr_value_t value = yui_expr_parse_term(parser);
+    yui_expr_parse_term(parser);
     while (parser->status == ESP_OK && (parser->current.type == YUI_EXPR_TOKEN_GREATER || parser->current.type == YUI_EXPR_TOKEN_GREATER_EQUAL || parser->current.type == YUI_EXPR_TOKEN_LESS || parser->current.type == YUI_EXPR_TOKEN_LESS_EQUAL)) {
         yui_expr_token_type_t type = parser->current.type;
         yui_expr_parser_advance(parser);
-        yui_expr_value_t rhs = yui_expr_parse_term(parser);
-        double left = yui_expr_as_number(&value);
-        double right = yui_expr_as_number(&rhs);
-        bool result = false;
+        yui_expr_parse_term(parser);
+        yui_expr_opcode_t op = YUI_EXPR_OP_GT;
         switch (type) {
-            case YUI_EXPR_TOKEN_GREATER:
-                result = left > right;
-                break;
             case YUI_EXPR_TOKEN_GREATER_EQUAL:
-                result = left >= right;
+                op = YUI_EXPR_OP_GE;
                 break;
             case YUI_EXPR_TOKEN_LESS:
-                result = left < right;
+                op = YUI_EXPR_OP_LT;
                 break;
             case YUI_EXPR_TOKEN_LESS_EQUAL:
-                result = left <= right;
+                op = YUI_EXPR_OP_LE;
                 break;
             default:
                 break;
         }
-        yui_expr_value_reset(&value);
-        yui_expr_value_set_bool(&value, result);
-        yui_expr_value_reset(&rhs);
+        yui_expr_emit(parser, op, 0U, -1);
     }
-    return value;
 }
 
-static bool yui_expr_values_equal(const yui_expr_value_t *lhs, const yui_expr_value_t *rhs)
+static void yui_expr_parse_equality(yui_expr_parser_t *parser)
 {
-    if (lhs->type == YUI_EXPR_VALUE_STRING || rhs->type == YUI_EXPR_VALUE_STRING) {
-        char left_buf[64];
-        char right_buf[64];
-        const char *l = yui_expr_as_cstring(lhs, left_buf, sizeof(left_buf));
-        const char *r = yui_expr_as_cstring(rhs, right_buf, sizeof(right_buf));
-        return strcmp(l, r) == 0;
-    }
-    if (lhs->type == YUI_EXPR_VALUE_BOOL || rhs->type == YUI_EXPR_VALUE_BOOL) {
-        return yui_expr_as_bool(lhs) == yui_expr_as_bool(rhs);
-    }
-    return fabs(yui_expr_as_number(lhs) - yui_expr_as_number(rhs)) < 1e-6;
-}
-
-static yui_expr_value_t yui_expr_parse_equality(yui_expr_parser_t *parser)
-{
-    yui_expr_value_t value = yui_expr_parse_comparison(parser);
+    yui_expr_parse_comparison(parser);
     while (parser->status == ESP_OK && (parser->current.type == YUI_EXPR_TOKEN_EQUAL_EQUAL || parser->current.type == YUI_EXPR_TOKEN_BANG_EQUAL)) {
         yui_expr_token_type_t type = parser->current.type;
         yui_expr_parser_advance(parser);
-        yui_expr_value_t rhs = yui_expr_parse_comparison(parser);
-        bool eq = yui_expr_values_equal(&value, &rhs);
-        if (type == YUI_EXPR_TOKEN_BANG_EQUAL) {
-            eq = !eq;
-        }
-        yui_expr_value_reset(&value);
-        yui_expr_value_set_bool(&value, eq);
-        yui_expr_value_reset(&rhs);
+        yui_expr_parse_comparison(parser);
+        yui_expr_emit(parser, type == YUI_EXPR_TOKEN_BANG_EQUAL ? YUI_EXPR_OP_NE : YUI_EXPR_OP_EQ, 0U, -1);
     }
-    return value;
 }
 
-static yui_expr_value_t yui_expr_parse_and(yui_expr_parser_t *parser)
+static void yui_expr_parse_and(yui_expr_parser_t *parser)
 {
-    yui_expr_value_t value = yui_expr_parse_equality(parser);
+    yui_expr_parse_equality(parser);
     while (parser->status == ESP_OK && parser->current.type == YUI_EXPR_TOKEN_AND) {
         yui_expr_parser_advance(parser);
-        yui_expr_value_t rhs = yui_expr_parse_equality(parser);
-        bool result = yui_expr_as_bool(&value) && yui_expr_as_bool(&rhs);
-        yui_expr_value_reset(&value);
-        yui_expr_value_set_bool(&value, result);
-        yui_expr_value_reset(&rhs);
+        yui_expr_parse_equality(parser);
+        yui_expr_emit(parser, YUI_EXPR_OP_AND, 0U, -1);
     }
-    return value;
 }
 
-static yui_expr_value_t yui_expr_parse_or(yui_expr_parser_t *parser)
+static void yui_expr_parse_or(yui_expr_parser_t *parser)
 {
-    yui_expr_value_t value = yui_expr_parse_and(parser);
+    yui_expr_parse_and(parser);
     while (parser->status == ESP_OK && parser->current.type == YUI_EXPR_TOKEN_OR) {
         yui_expr_parser_advance(parser);
-        yui_expr_value_t rhs = yui_expr_parse_and(parser);
-        bool result = yui_expr_as_bool(&value) || yui_expr_as_bool(&rhs);
-        yui_expr_value_reset(&value);
-        yui_expr_value_set_bool(&value, result);
-        yui_expr_value_reset(&rhs);
+        yui_expr_parse_and(parser);
+        yui_expr_emit(parser, YUI_EXPR_OP_OR, 0U, -1);
     }
-    return value;
 }
 
-static yui_expr_value_t yui_expr_parse_coalesce(yui_expr_parser_t *parser)
+static void yui_expr_parse_coalesce(yui_expr_parser_t *parser)
 {
-    yui_expr_value_t value = yui_expr_parse_or(parser);
+    yui_expr_parse_or(parser);
     while (parser->status == ESP_OK && parser->current.type == YUI_EXPR_TOKEN_COALESCE) {
         yui_expr_parser_advance(parser);
-        if (value.type != YUI_EXPR_VALUE_NULL && !(value.type == YUI_EXPR_VALUE_STRING && (!value.string || value.string[0] == '\0'))) {
-            yui_expr_value_t skipped = yui_expr_parse_or(parser);
-            yui_expr_value_reset(&skipped);
-            continue;
-        }
-        yui_expr_value_reset(&value);
-        value = yui_expr_parse_or(parser);
+        yui_expr_parse_or(parser);
+        yui_expr_emit(parser, YUI_EXPR_OP_COALESCE, 0U, -1);
     }
-    return value;
 }
 
-static yui_expr_value_t yui_expr_parse_ternary(yui_expr_parser_t *parser)
+static void yui_expr_parse_ternary(yui_expr_parser_t *parser)
 {
-    yui_expr_value_t condition = yui_expr_parse_coalesce(parser);
+    yui_expr_parse_coalesce(parser);
     if (parser->status == ESP_OK && parser->current.type == YUI_EXPR_TOKEN_QUESTION) {
-        bool cond = yui_expr_as_bool(&condition);
         yui_expr_parser_advance(parser);
-        yui_expr_value_t true_branch = yui_expr_parse_expression(parser);
+        yui_expr_parse_expression(parser);
         yui_expr_parser_expect(parser, YUI_EXPR_TOKEN_COLON);
-        yui_expr_value_t false_branch = yui_expr_parse_expression(parser);
-        yui_expr_value_reset(&condition);
-        condition = cond ? true_branch : false_branch;
-        if (cond) {
-            yui_expr_value_reset(&false_branch);
-        } else {
-            yui_expr_value_reset(&true_branch);
-        }
+        yui_expr_parse_expression(parser);
+        yui_expr_emit(parser, YUI_EXPR_OP_SELECT, 0U, -2);
     }
-    return condition;
 }
 
-static yui_expr_value_t yui_expr_parse_expression(yui_expr_parser_t *parser)
+static void yui_expr_parse_expression(yui_expr_parser_t *parser)
 {
-    return yui_expr_parse_ternary(parser);
+    yui_expr_parse_ternary(parser);
 }
 
-esp_err_t yui_expr_eval(const char *expression, yui_expr_symbol_resolver_t resolver, void *ctx, yui_expr_value_t *out_value)
+void yui_expr_program_free(yui_expr_program_t *program)
 {
-    if (!expression || !out_value) {
+    if (!program) {
+        return;
+    }
+    for (size_t i = 0; i < program->constant_count; ++i) {
+        yui_expr_value_reset(&program->constants[i]);
+    }
+    for (size_t i = 0; i < program->symbol_count; ++i) {
+        free(program->symbols[i]);
+    }
+    free(program->constants);
+    free(program->symbols);
+    free(program->code);
+    free(program->source);
+    free(program);
+}
+
+esp_err_t yui_expr_compile(const char *expression, yui_expr_program_t **out_program)
+{
+    if (!expression || !out_program) {
         return ESP_ERR_INVALID_ARG;
     }
+    *out_program = NULL;
+    yui_expr_program_t *program = (yui_expr_program_t *)calloc(1, sizeof(yui_expr_program_t));
+    if (!program) {
+        return ESP_ERR_NO_MEM;
+    }
+    program->source = yui_expr_strndup(expression, strlen(expression));
+    if (!program->source) {
+        free(program);
+        return ESP_ERR_NO_MEM;
+    }
     yui_expr_parser_t parser = {
-        .resolver = resolver,
-        .resolver_ctx = ctx,
+        .program = program,
+        .depth = 0U,
         .status = ESP_OK,
     };
     yui_expr_lexer_init(&parser.lexer, expression);
@@ -812,27 +867,218 @@ esp_err_t yui_expr_eval(const char *expression, yui_expr_symbol_resolver_t resol
     parser.current.text = NULL;
     parser.current.number = 0.0;
     yui_expr_parser_advance(&parser);
-    yui_expr_value_t value = yui_expr_parse_expression(&parser);
+    yui_expr_parse_expression(&parser);
+    yui_expr_token_reset(&parser.current);
+    if (parser.status == ESP_OK && parser.depth != 1U) {
+        parser.status = ESP_ERR_INVALID_ARG;
+    }
     if (parser.status != ESP_OK) {
-        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_EXPR, "Failed to evaluate expression '%s'", expression);
-        yamui_telemetry_error("expr", "eval_failed");
-        yui_expr_value_reset(&value);
-        yui_expr_token_reset(&parser.current);
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_EXPR, "Failed to compile expression '%s'", expression);
+        yamui_telemetry_error("expr", "compile_failed");
+        yui_expr_program_free(program);
         return parser.status;
     }
-    *out_value = value;
-    yui_expr_token_reset(&parser.current);
+    *out_program = program;
     return ESP_OK;
 }
 
-esp_err_t yui_expr_eval_to_string(const char *expression, yui_expr_symbol_resolver_t resolver, void *ctx, char *out, size_t out_len)
+const char *yui_expr_program_source(const yui_expr_program_t *program)
+{
+    return program ? program->source : NULL;
+}
+
+esp_err_t yui_expr_program_collect_identifiers(const yui_expr_program_t *program, yui_expr_identifier_cb_t cb, void *ctx)
+{
+    if (!program || !cb) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < program->symbol_count; ++i) {
+        cb(program->symbols[i], ctx);
+    }
+    return ESP_OK;
+}
+
+static bool yui_expr_values_equal(const yui_expr_value_t *lhs, const yui_expr_value_t *rhs)
+{
+    if (lhs->type == YUI_EXPR_VALUE_STRING || rhs->type == YUI_EXPR_VALUE_STRING) {
+        char left_buf[64];
+        char right_buf[64];
+        const char *l = yui_expr_as_cstring(lhs, left_buf, sizeof(left_buf));
+        const char *r = yui_expr_as_cstring(rhs, right_buf, sizeof(right_buf));
+        return strcmp(l, r) == 0;
+    }
+    if (lhs->type == YUI_EXPR_VALUE_BOOL || rhs->type == YUI_EXPR_VALUE_BOOL) {
+        return yui_expr_as_bool(lhs) == yui_expr_as_bool(rhs);
+    }
+    return fabs(yui_expr_as_number(lhs) - yui_expr_as_number(rhs)) < 1e-6;
+}
+
+static bool yui_expr_value_is_present(const yui_expr_value_t *value)
+{
+    if (value->type == YUI_EXPR_VALUE_NULL) {
+        return false;
+    }
+    return !(value->type == YUI_EXPR_VALUE_STRING && (!value->string || value->string[0] == '\0'));
+}
+
+static esp_err_t yui_expr_concat(yui_expr_value_t *lhs, const yui_expr_value_t *rhs)
+{
+    char left_buf[64];
+    char right_buf[64];
+    const char *left = yui_expr_as_cstring(lhs, left_buf, sizeof(left_buf));
+    const char *right = yui_expr_as_cstring(rhs, right_buf, sizeof(right_buf));
+    size_t left_len = strlen(left);
+    size_t right_len = strlen(right);
+    size_t total = left_len + right_len;
+    char *joined = (char *)malloc(total + 1U);
+    if (!joined) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(joined, left, left_len);
+    memcpy(joined + left_len, right, right_len);
+    joined[total] = '\0';
+    yui_expr_value_reset(lhs);
+    lhs->type = YUI_EXPR_VALUE_STRING;
+    lhs->owned_string = joined;
+    lhs->string = joined;
+    return ESP_OK;
+}
+
+static esp_err_t yui_expr_exec_binary(yui_expr_opcode_t op, yui_expr_value_t *lhs, yui_expr_value_t *rhs)
+{
+    switch (op) {
+        case YUI_EXPR_OP_MUL:
+            yui_expr_value_set_number(lhs, yui_expr_as_number(lhs) * yui_expr_as_number(rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_DIV: {
+            double right = yui_expr_as_number(rhs);
+            if (right == 0.0) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            yui_expr_value_set_number(lhs, yui_expr_as_number(lhs) / right);
+            return ESP_OK;
+        }
+        case YUI_EXPR_OP_ADD:
+            if (lhs->type == YUI_EXPR_VALUE_STRING || rhs->type == YUI_EXPR_VALUE_STRING) {
+                return yui_expr_concat(lhs, rhs);
+            }
+            yui_expr_value_set_number(lhs, yui_expr_as_number(lhs) + yui_expr_as_number(rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_SUB:
+            yui_expr_value_set_number(lhs, yui_expr_as_number(lhs) - yui_expr_as_number(rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_GT:
+            yui_expr_value_set_bool(lhs, yui_expr_as_number(lhs) > yui_expr_as_number(rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_GE:
+            yui_expr_value_set_bool(lhs, yui_expr_as_number(lhs) >= yui_expr_as_number(rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_LT:
+            yui_expr_value_set_bool(lhs, yui_expr_as_number(lhs) < yui_expr_as_number(rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_LE:
+            yui_expr_value_set_bool(lhs, yui_expr_as_number(lhs) <= yui_expr_as_number(rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_EQ:
+            yui_expr_value_set_bool(lhs, yui_expr_values_equal(lhs, rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_NE:
+            yui_expr_value_set_bool(lhs, !yui_expr_values_equal(lhs, rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_AND:
+            yui_expr_value_set_bool(lhs, yui_expr_as_bool(lhs) && yui_expr_as_bool(rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_OR:
+            yui_expr_value_set_bool(lhs, yui_expr_as_bool(lhs) || yui_expr_as_bool(rhs));
+            return ESP_OK;
+        case YUI_EXPR_OP_COALESCE:
+            if (!yui_expr_value_is_present(lhs)) {
+                yui_expr_value_reset(lhs);
+                *lhs = *rhs;
+                *rhs = yui_expr_make_null();
+            }
+            return ESP_OK;
+        default:
+            return ESP_ERR_INVALID_STATE;
+    }
+}
+
+esp_err_t yui_expr_run(const yui_expr_program_t *program, yui_expr_symbol_resolver_t resolver, void *ctx, yui_expr_value_t *out_value)
+{
+    if (!program || !out_value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    yui_expr_value_t stack[YUI_EXPR_MAX_STACK_DEPTH];
+    size_t sp = 0U;
+    esp_err_t status = ESP_OK;
+    for (size_t pc = 0; pc < program->code_count && status == ESP_OK; ++pc) {
+        const yui_expr_instr_t *instr = &program->code[pc];
+        switch ((yui_expr_opcode_t)instr->op) {
+            case YUI_EXPR_OP_CONST: {
+                /* Constants are pushed by reference; the program owns the string storage. */
+                const yui_expr_value_t *constant = &program->constants[instr->operand];
+                stack[sp] = *constant;
+                stack[sp].owned_string = NULL;
+                sp++;
+                break;
+            }
+            case YUI_EXPR_OP_LOAD:
+                stack[sp] = yui_expr_make_null();
+                if (!resolver || !resolver(program->symbols[instr->operand], ctx, &stack[sp])) {
+                    yui_expr_value_set_string_ref(&stack[sp], "");
+                }
+                sp++;
+                break;
+            case YUI_EXPR_OP_NOT: {
+                bool flag = !yui_expr_as_bool(&stack[sp - 1U]);
+                yui_expr_value_set_bool(&stack[sp - 1U], flag);
+                break;
+            }
+            case YUI_EXPR_OP_NEG: {
+                double number = -yui_expr_as_number(&stack[sp - 1U]);
+                yui_expr_value_set_number(&stack[sp - 1U], number);
+                break;
+            }
+            case YUI_EXPR_OP_SELECT: {
+                bool cond = yui_expr_as_bool(&stack[sp - 3U]);
+                yui_expr_value_reset(&stack[sp - 3U]);
+                if (cond) {
+                    stack[sp - 3U] = stack[sp - 2U];
+                    yui_expr_value_reset(&stack[sp - 1U]);
+                } else {
+                    stack[sp - 3U] = stack[sp - 1U];
+                    yui_expr_value_reset(&stack[sp - 2U]);
+                }
+                sp -= 2U;
+                break;
+            }
+            default:
+                status = yui_expr_exec_binary((yui_expr_opcode_t)instr->op, &stack[sp - 2U], &stack[sp - 1U]);
+                yui_expr_value_reset(&stack[sp - 1U]);
+                sp--;
+                break;
+        }
+    }
+    if (status != ESP_OK) {
+        while (sp > 0U) {
+            yui_expr_value_reset(&stack[--sp]);
+        }
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_EXPR, "Failed to evaluate expression '%s'", program->source);
+        yamui_telemetry_error("expr", "eval_failed");
+        return status;
+    }
+    *out_value = stack[0];
+    return ESP_OK;
+}
+
+esp_err_t yui_expr_run_to_string(const yui_expr_program_t *program, yui_expr_symbol_resolver_t resolver, void *ctx, char *out, size_t out_len)
 {
     if (!out || out_len == 0U) {
         return ESP_ERR_INVALID_ARG;
     }
     out[0] = '\0';
     yui_expr_value_t value = yui_expr_make_null();
-    esp_err_t err = yui_expr_eval(expression, resolver, ctx, &value);
+    esp_err_t err = yui_expr_run(program, resolver, ctx, &value);
     if (err != ESP_OK) {
         yui_expr_value_reset(&value);
         return err;
@@ -852,6 +1098,52 @@ esp_err_t yui_expr_eval_to_string(const char *expression, yui_expr_symbol_resolv
     return ESP_OK;
 }
 
+esp_err_t yui_expr_eval(const char *expression, yui_expr_symbol_resolver_t resolver, void *ctx, yui_expr_value_t *out_value)
+{
+    if (!expression || !out_value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    yui_expr_program_t *program = NULL;
+    esp_err_t err = yui_expr_compile(expression, &program);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = yui_expr_run(program, resolver, ctx, out_value);
+    if (err == ESP_OK && out_value->type == YUI_EXPR_VALUE_STRING && !out_value->owned_string) {
+        /* A string literal result borrows the constant pool freed below. */
+        for (size_t i = 0; i < program->constant_count; ++i) {
+            if (program->constants[i].string == out_value->string) {
+                yui_expr_value_set_string_copy(out_value, out_value->string);
+                if (out_value->type != YUI_EXPR_VALUE_STRING) {
+                    err = ESP_ERR_NO_MEM;
+                }
+                break;
+            }
+        }
+    }
+    yui_expr_program_free(program);
+    return err;
+}
+
+esp_err_t yui_expr_eval_to_string(const char *expression, yui_expr_symbol_resolver_t resolver, void *ctx, char *out, size_t out_len)
+{
+    if (!out || out_len == 0U) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    out[0] = '\0';
+    if (!expression) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    yui_expr_program_t *program = NULL;
+    esp_err_t err = yui_expr_compile(expression, &program);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = yui_expr_run_to_string(program, resolver, ctx, out, out_len);
+    yui_expr_program_free(program);
+    return err;
+}
+
 esp_err_t yui_expr_collect_identifiers(const char *expression, yui_expr_identifier_cb_t cb, void *ctx)
 {
     if (!expression || !cb) {
@@ -0,0 +1,184 @@
+#include "yamui_profiler.h"
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "yamui_logging.h"
+#include "yamui_state.h"
+
+typedef struct {
+    _Atomic uint32_t count;
+    _Atomic uint32_t total_us;
+    _Atomic uint32_t max_us;
+    _Atomic uint32_t buckets[YAMUI_PROF_BUCKETS];
+} yamui_prof_histogram_t;
+
+static yamui_prof_histogram_t s_histograms[YAMUI_PROF_METRIC_COUNT];
+static atomic_bool s_enabled;
+
+static const char *const s_metric_names[YAMUI_PROF_METRIC_COUNT] = {
+    [YAMUI_PROF_FRAME] = "frame",
+    [YAMUI_PROF_FLUSH] = "flush",
+    [YAMUI_PROF_TIMER_HANDLER] = "timer_handler",
+    [YAMUI_PROF_DISPATCH_LATENCY] = "dispatch",
+    [YAMUI_PROF_BINDING_REFRESH] = "binding",
+    [YAMUI_PROF_SCREEN_BUILD] = "screen_build",
+    [YAMUI_PROF_TOUCH_LATENCY] = "touch",
+};
+
+static uint32_t yamui_prof_bucket_of(uint32_t duration_us)
+{
+    if (duration_us <= 1U) {
+        return 0U;
+    }
+    uint32_t bucket = 32U - (uint32_t)__builtin_clz(duration_us - 1U);
+    return bucket < YAMUI_PROF_BUCKETS ? bucket : YAMUI_PROF_BUCKETS - 1U;
+}
+
+static uint32_t yamui_prof_bucket_limit(uint32_t bucket)
+{
+    return 1U << bucket;
+}
+
+void yamui_prof_set_enabled(bool enabled)
+{
+    atomic_store_explicit(&s_enabled, enabled, memory_order_relaxed);
+}
+
+bool yamui_prof_enabled(void)
+{
+    return atomic_load_explicit(&s_enabled, memory_order_relaxed);
+}
+
+void yamui_prof_record(yamui_prof_metric_t metric, uint32_t duration_us)
+{
+    if (metric >= YAMUI_PROF_METRIC_COUNT || !atomic_load_explicit(&s_enabled, memory_order_relaxed)) {
+        return;
+    }
+    yamui_prof_histogram_t *hist = &s_histograms[metric];
+    atomic_fetch_add_explicit(&hist->buckets[yamui_prof_bucket_of(duration_us)], 1U, memory_order_relaxed);
+    atomic_fetch_add_explicit(&hist->total_us, duration_us, memory_order_relaxed);
+    atomic_fetch_add_explicit(&hist->count, 1U, memory_order_relaxed);
+    uint32_t seen = atomic_load_explicit(&hist->max_us, memory_order_relaxed);
+    while (duration_us > seen &&
+           !atomic_compare_exchange_weak_explicit(&hist->max_us, &seen, duration_us, memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+void yamui_prof_snapshot(yamui_prof_metric_t metric, yamui_prof_summary_t *out)
+{
+    if (!out) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    if (metric >= YAMUI_PROF_METRIC_COUNT) {
+        return;
+    }
+    yamui_prof_histogram_t *hist = &s_histograms[metric];
+    uint32_t samples = 0;
+    for (uint32_t i = 0; i < YAMUI_PROF_BUCKETS; ++i) {
+        out->buckets[i] = atomic_load_explicit(&hist->buckets[i], memory_order_relaxed);
+        samples += out->buckets[i];
+    }
+    out->count = samples;
+    out->total_us = atomic_load_explicit(&hist->total_us, memory_order_relaxed);
+    out->max_us = atomic_load_explicit(&hist->max_us, memory_order_relaxed);
+
+    /* Ranks are 1-based: p50 of 10 samples is the 5th. */
+    const uint32_t percents[3] = {50U, 90U, 99U};
+    uint32_t *targets[3] = {&out->p50_us, &out->p90_us, &out->p99_us};
+    uint32_t cumulative = 0;
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < YAMUI_PROF_BUCKETS && next < 3U; ++i) {
+        cumulative += out->buckets[i];
+        while (next < 3U && samples && (uint64_t)cumulative * 100U >= (uint64_t)samples * percents[next]) {
+            uint32_t limit = yamui_prof_bucket_limit(i);
+            *targets[next++] = (i == YAMUI_PROF_BUCKETS - 1U || limit > out->max_us) ? out->max_us : limit;
+        }
+    }
+}
+
+void yamui_prof_reset(void)
+{
+    for (size_t m = 0; m < YAMUI_PROF_METRIC_COUNT; ++m) {
+        yamui_prof_histogram_t *hist = &s_histograms[m];
+        atomic_store_explicit(&hist->count, 0U, memory_order_relaxed);
+        atomic_store_explicit(&hist->total_us, 0U, memory_order_relaxed);
+        atomic_store_explicit(&hist->max_us, 0U, memory_order_relaxed);
+        for (uint32_t i = 0; i < YAMUI_PROF_BUCKETS; ++i) {
+            atomic_store_explicit(&hist->buckets[i], 0U, memory_order_relaxed);
+        }
+    }
+}
+
+const char *yamui_prof_metric_name(yamui_prof_metric_t metric)
+{
+    return metric < YAMUI_PROF_METRIC_COUNT ? s_metric_names[metric] : "unknown";
+}
+
+size_t yamui_prof_format(yamui_prof_metric_t metric, char *buffer, size_t buffer_len)
+{
+    if (!buffer || buffer_len == 0U) {
+        return 0U;
+    }
+    yamui_prof_summary_t summary;
+    yamui_prof_snapshot(metric, &summary);
+    int written = snprintf(buffer,
+                           buffer_len,
+                           "%s n=%" PRIu32 " p50=%" PRIu32 " p90=%" PRIu32 " p99=%" PRIu32 " max=%" PRIu32 " us",
+                           yamui_prof_metric_name(metric),
+                           summary.count,
+                           summary.p50_us,
+                           summary.p90_us,
+                           summary.p99_us,
+                           summary.max_us);
+    if (written < 0) {
+        buffer[0] = '\0';
+        return 0U;
+    }
+    return (size_t)written < buffer_len ? (size_t)written : buffer_len - 1U;
+}
+
+void yamui_prof_publish(void)
+{
+    static const char *const fields[] = {"count", "p50", "p90", "p99", "max"};
+    enum { FIELD_COUNT = sizeof(fields) / sizeof(fields[0]) };
+    uint32_t values[YAMUI_PROF_METRIC_COUNT][FIELD_COUNT];
+    bool present[YAMUI_PROF_METRIC_COUNT];
+    for (size_t m = 0; m < YAMUI_PROF_METRIC_COUNT; ++m) {
+        yamui_prof_summary_t summary;
+        yamui_prof_snapshot((yamui_prof_metric_t)m, &summary);
+        present[m] = summary.count > 0U;
+        values[m][0] = summary.count;
+        values[m][1] = summary.p50_us;
+        values[m][2] = summary.p90_us;
+        values[m][3] = summary.p99_us;
+        values[m][4] = summary.max_us;
+    }
+
+    (void)yui_state_begin_batch();
+    for (size_t m = 0; m < YAMUI_PROF_METRIC_COUNT; ++m) {
+        if (!present[m]) {
+            continue;
+        }
+        for (size_t f = 0; f < FIELD_COUNT; ++f) {
+            char key[48];
+            snprintf(key, sizeof(key), "perf.%s.%s", s_metric_names[m], fields[f]);
+            (void)yui_state_set_int(key, (int32_t)(values[m][f] > INT32_MAX ? INT32_MAX : values[m][f]));
+        }
+    }
+    (void)yui_state_commit_batch();
+
+    /* Telemetry may block on I/O, so it only runs once the state lock is released. */
+    for (size_t m = 0; m < YAMUI_PROF_METRIC_COUNT; ++m) {
+        if (!present[m]) {
+            continue;
+        }
+        for (size_t f = 0; f < FIELD_COUNT; ++f) {
+            yamui_telemetry_perf(s_metric_names[m], fields[f], (double)values[m][f]);
+        }
+    }
+}
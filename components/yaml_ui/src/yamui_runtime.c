@@ -10,6 +10,12 @@ typedef struct {
     yamui_native_fn_t fn;
 } yui_native_entry_t;
 
+typedef struct {
+    char *type;
+    yamui_widget_factory_t factory;
+    void *user_ctx;
+} yui_widget_entry_t;
+
 typedef struct {
     char *event;
     yamui_event_listener_t listener;
@@ -18,6 +24,9 @@ typedef struct {
 
 static yui_native_entry_t *s_native_functions;
 static size_t s_native_count;
+static yui_widget_entry_t *s_widgets;
+static size_t s_widget_count;
+static uint32_t s_widget_generation;
 static yui_event_listener_entry_t *s_event_listeners;
 static size_t s_event_listener_count;
 
@@ -132,6 +141,80 @@ esp_err_t yamui_runtime_call_function(const char *name, const char **args, size_
     return ESP_ERR_NOT_FOUND;
 }
 
+esp_err_t yamui_runtime_register_widget(const char *type, yamui_widget_factory_t factory, void *user_ctx)
+{
+    if (!type || type[0] == '\0' || !factory) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < s_widget_count; ++i) {
+        if (strcmp(s_widgets[i].type, type) == 0) {
+            s_widgets[i].factory = factory;
+            s_widgets[i].user_ctx = user_ctx;
+            s_widget_generation++;
+            yamui_log(YAMUI_LOG_LEVEL_DEBUG, YAMUI_LOG_CAT_NATIVE, "Updated widget type '%s'", type);
+            return ESP_OK;
+        }
+    }
+    yui_widget_entry_t *resized = (yui_widget_entry_t *)realloc(s_widgets, (s_widget_count + 1U) * sizeof(yui_widget_entry_t));
+    if (!resized) {
+        yamui_log(YAMUI_LOG_LEVEL_ERROR, YAMUI_LOG_CAT_NATIVE, "Failed to allocate slot for widget '%s'", type);
+        return ESP_ERR_NO_MEM;
+    }
+    s_widgets = resized;
+    s_widgets[s_widget_count].type = yui_strdup(type);
+    if (!s_widgets[s_widget_count].type) {
+        yamui_log(YAMUI_LOG_LEVEL_ERROR, YAMUI_LOG_CAT_NATIVE, "Failed to store widget type '%s'", type);
+        return ESP_ERR_NO_MEM;
+    }
+    s_widgets[s_widget_count].factory = factory;
+    s_widgets[s_widget_count].user_ctx = user_ctx;
+    s_widget_count++;
+    s_widget_generation++;
+    yamui_log(YAMUI_LOG_LEVEL_INFO, YAMUI_LOG_CAT_NATIVE, "Registered widget type '%s'", type);
+    return ESP_OK;
+}
+
+esp_err_t yamui_runtime_unregister_widget(const char *type)
+{
+    if (!type) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < s_widget_count; ++i) {
+        if (strcmp(s_widgets[i].type, type) == 0) {
+            free(s_widgets[i].type);
+            s_widgets[i] = s_widgets[--s_widget_count];
+            s_widget_generation++;
+            yamui_log(YAMUI_LOG_LEVEL_INFO, YAMUI_LOG_CAT_NATIVE, "Unregistered widget type '%s'", type);
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+bool yamui_runtime_find_widget(const char *type, yamui_widget_factory_t *out_factory, void **out_user_ctx)
+{
+    if (!type) {
+        return false;
+    }
+    for (size_t i = 0; i < s_widget_count; ++i) {
+        if (strcmp(s_widgets[i].type, type) == 0) {
+            if (out_factory) {
+                *out_factory = s_widgets[i].factory;
+            }
+            if (out_user_ctx) {
+                *out_user_ctx = s_widgets[i].user_ctx;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t yamui_runtime_widget_generation(void)
+{
+    return s_widget_generation;
+}
+
 esp_err_t yamui_runtime_add_event_listener(const char *event, yamui_event_listener_t listener, void *user_ctx)
 {
     if (!event || !listener) {
@@ -1,5 +1,7 @@
 #include "yamui_state.h"
 
+#include <math.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -9,18 +11,56 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 
-#define YUI_STATE_DEFAULT_CAPACITY 8
 #define YUI_STATE_WATCH_DEFAULT_CAPACITY 4
 #define YUI_STATE_KEY_BUFFER_MAX 256
+#define YUI_STATE_ENTRY_PAGE_SIZE 16U
+#define YUI_STATE_INDEX_DEFAULT_CAPACITY 32U
+#define YUI_STATE_KEY_POOL_CHUNK_SIZE 1024U
 
+#define YUI_STATE_WATCH_SLOT_MAX 0xFFFFU
+#define YUI_STATE_WATCH_SLOT_NONE UINT32_MAX
+
+/* Watchers are bucketed by the key they observe (wildcards get their own bucket), so a
+ * set only visits the subscribers of that key. Buckets hold indices into s_watch_slots. */
+typedef struct {
+    uint32_t *slots;
+    uint32_t count;
+    uint32_t capacity;
+} yui_state_watch_bucket_t;
+
+/* Entries live in fixed-size pages that are never moved, so value pointers handed
+ * out by yui_state_get and yui_state_key_t handles stay valid while the store grows. */
 typedef struct {
-    char *key;
-    char *value;
+    const char *key;
+    uint32_t hash;
+    bool defined;
+    bool batch_dirty;
+    uint8_t type;      /* yui_state_value_type_t of the authoritative value */
+    bool string_valid; /* inline/heap string holds the current value */
+    union {
+        int32_t int_value;
+        double float_value;
+        bool bool_value;
+    } native;
+    char *heap_value;
+    yui_state_watch_bucket_t watchers;
+    char inline_value[YUI_STATE_VALUE_MAX];
 } yui_state_entry_t;
 
+typedef struct yui_state_key_chunk {
+    struct yui_state_key_chunk *next;
+    size_t used;
+    size_t capacity;
+    char data[];
+} yui_state_key_chunk_t;
+
+/* Handles encode (generation << 16) | (slot + 1) so a stale handle never removes a
+ * watcher that later reused the same slot. */
 struct yui_state_watch {
-    uint32_t id;
-    char *key;
+    uint16_t generation;
+    bool active;
+    uint32_t bucket;   /* entry index + 1, or 0 for wildcard watchers */
+    uint32_t position; /* index inside the bucket, or next free slot when inactive */
     yui_state_watch_cb_t cb;
     void *user_ctx;
 };
@@ -30,14 +70,40 @@ typedef struct {
     void *user_ctx;
 } yui_state_notification_t;
 
+typedef struct {
+    yui_state_watch_cb_t cb;
+    void *user_ctx;
+    uint32_t entry;
+} yui_state_batch_notification_t;
+
 static SemaphoreHandle_t s_lock;
-static yui_state_entry_t *s_entries;
+static yui_state_entry_t **s_entry_pages;
+static size_t s_entry_page_count;
 static size_t s_entry_count;
-static size_t s_entry_capacity;
-static struct yui_state_watch *s_watchers;
-static size_t s_watch_count;
-static size_t s_watch_capacity;
-static uint32_t s_watch_next_id = 1;
+static uint32_t *s_index;
+static size_t s_index_capacity;
+static yui_state_key_chunk_t *s_key_chunks;
+static struct yui_state_watch *s_watch_slots;
+static uint32_t s_watch_slot_count;
+static uint32_t s_watch_slot_capacity;
+static uint32_t s_watch_free_head = YUI_STATE_WATCH_SLOT_NONE;
+static yui_state_watch_bucket_t s_wildcard_watchers;
+static uint32_t s_watch_max_bucket;
+static yui_state_notification_t *s_notify_arena;
+static uint32_t s_notify_arena_capacity;
+/* Claimed under the lock, but released by the dispatcher without it once its watchers ran. */
+static atomic_bool s_notify_arena_busy;
+/* Batch commits reuse one block for their snapshot, grown on demand and handed out like the
+ * notify arena; a commit nested in a watcher falls back to the heap. */
+static uint8_t *s_batch_block;
+static size_t s_batch_block_capacity;
+static atomic_bool s_batch_block_busy;
+static uint32_t s_lock_depth;
+static uint32_t s_batch_depth;
+static uint32_t *s_batch_dirty;
+static uint32_t s_batch_dirty_count;
+static uint32_t s_batch_dirty_capacity;
+static yui_state_stats_t s_stats;
 
 static inline const char *yui_empty_if_null(const char *value)
 {
@@ -80,188 +146,522 @@ static esp_err_t yui_state_ensure_mutex(void)
     return ESP_OK;
 }
 
+/* Only outermost takes count as acquisitions; nested takes by the holder (for example
+ * sets inside a batch) never contend. */
 static inline void yui_state_lock(void)
 {
     if (s_lock) {
         xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+        if (s_lock_depth++ == 0U) {
+            s_stats.lock_acquisitions++;
+        }
     }
 }
 
 static inline void yui_state_unlock(void)
 {
     if (s_lock) {
+        s_lock_depth--;
         xSemaphoreGiveRecursive(s_lock);
     }
 }
 
-static esp_err_t yui_state_reserve_entries(size_t desired)
+static inline yui_state_entry_t *yui_state_entry_at(size_t index)
 {
-    if (desired <= s_entry_capacity) {
+    return &s_entry_pages[index / YUI_STATE_ENTRY_PAGE_SIZE][index % YUI_STATE_ENTRY_PAGE_SIZE];
+}
+
+/* Formats a typed value the way text bindings display it; numbers match the
+ * expression engine's trimmed "%.3f" rendering. */
+static const char *yui_state_format_value(const yui_state_value_t *value, char *scratch, size_t scratch_len)
+{
+    switch (value->type) {
+        case YUI_STATE_VALUE_INT:
+            snprintf(scratch, scratch_len, "%ld", (long)value->int_value);
+            return scratch;
+        case YUI_STATE_VALUE_FLOAT: {
+            if (fabs(value->float_value) >= 1e15) {
+                snprintf(scratch, scratch_len, "%g", value->float_value);
+                return scratch;
+            }
+            snprintf(scratch, scratch_len, "%.3f", value->float_value);
+            size_t len = strlen(scratch);
+            while (len > 0U && scratch[len - 1U] == '0') {
+                scratch[--len] = '\0';
+            }
+            if (len > 0U && scratch[len - 1U] == '.') {
+                scratch[len - 1U] = '\0';
+            }
+            return scratch;
+        }
+        case YUI_STATE_VALUE_BOOL:
+            return value->bool_value ? "true" : "false";
+        case YUI_STATE_VALUE_STRING:
+        default:
+            return yui_empty_if_null(value->string);
+    }
+}
+
+static void yui_state_entry_read(const yui_state_entry_t *entry, yui_state_value_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->type = (yui_state_value_type_t)entry->type;
+    switch (out->type) {
+        case YUI_STATE_VALUE_INT:
+            out->int_value = entry->native.int_value;
+            break;
+        case YUI_STATE_VALUE_FLOAT:
+            out->float_value = entry->native.float_value;
+            break;
+        case YUI_STATE_VALUE_BOOL:
+            out->bool_value = entry->native.bool_value;
+            break;
+        case YUI_STATE_VALUE_STRING:
+        default:
+            out->string = entry->heap_value ? entry->heap_value : entry->inline_value;
+            break;
+    }
+}
+
+/* Caller holds the lock. Typed values only render their string form on demand. */
+static const char *yui_state_entry_string(yui_state_entry_t *entry)
+{
+    if (!entry->string_valid) {
+        yui_state_value_t value;
+        yui_state_entry_read(entry, &value);
+        const char *formatted = yui_state_format_value(&value, entry->inline_value, sizeof(entry->inline_value));
+        if (formatted != entry->inline_value) {
+            snprintf(entry->inline_value, sizeof(entry->inline_value), "%s", formatted);
+        }
+        entry->string_valid = true;
+    }
+    return entry->heap_value ? entry->heap_value : entry->inline_value;
+}
+
+static uint32_t yui_state_hash(const char *key, size_t len)
+{
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+static const char *yui_state_intern_key(const char *key, size_t len)
+{
+    yui_state_key_chunk_t *chunk = s_key_chunks;
+    if (!chunk || chunk->capacity - chunk->used < len + 1U) {
+        size_t capacity = len + 1U > YUI_STATE_KEY_POOL_CHUNK_SIZE ? len + 1U : YUI_STATE_KEY_POOL_CHUNK_SIZE;
+        chunk = (yui_state_key_chunk_t *)malloc(sizeof(yui_state_key_chunk_t) + capacity);
+        if (!chunk) {
+            return NULL;
+        }
+        chunk->next = s_key_chunks;
+        chunk->used = 0;
+        chunk->capacity = capacity;
+        s_key_chunks = chunk;
+    }
+    char *copy = &chunk->data[chunk->used];
+    memcpy(copy, key, len);
+    copy[len] = '\0';
+    chunk->used += len + 1U;
+    return copy;
+}
+
+static void yui_state_index_insert(uint32_t *index, size_t capacity, uint32_t hash, size_t entry_index)
+{
+    size_t mask = capacity - 1U;
+    size_t slot = hash & mask;
+    while (index[slot] != 0U) {
+        slot = (slot + 1U) & mask;
+    }
+    index[slot] = (uint32_t)(entry_index + 1U);
+}
+
+static esp_err_t yui_state_reserve_index(size_t desired_entries)
+{
+    /* Keep the load factor at or below one half so probe chains stay short. */
+    if (desired_entries * 2U <= s_index_capacity) {
         return ESP_OK;
     }
-    size_t new_capacity = s_entry_capacity == 0 ? YUI_STATE_DEFAULT_CAPACITY : s_entry_capacity * 2U;
-    while (new_capacity < desired) {
+    size_t new_capacity = s_index_capacity == 0 ? YUI_STATE_INDEX_DEFAULT_CAPACITY : s_index_capacity * 2U;
+    while (new_capacity < desired_entries * 2U) {
         new_capacity *= 2U;
     }
-    yui_state_entry_t *next = (yui_state_entry_t *)realloc(s_entries, new_capacity * sizeof(yui_state_entry_t));
+    uint32_t *next = (uint32_t *)calloc(new_capacity, sizeof(uint32_t));
     if (!next) {
         return ESP_ERR_NO_MEM;
     }
-    s_entries = next;
-    s_entry_capacity = new_capacity;
+    for (size_t i = 0; i < s_entry_count; ++i) {
+        yui_state_index_insert(next, new_capacity, yui_state_entry_at(i)->hash, i);
+    }
+    free(s_index);
+    s_index = next;
+    s_index_capacity = new_capacity;
     return ESP_OK;
 }
 
-static esp_err_t yui_state_reserve_watchers(size_t desired)
+static esp_err_t yui_state_reserve_entries(size_t desired)
 {
-    if (desired <= s_watch_capacity) {
+    size_t pages_needed = (desired + YUI_STATE_ENTRY_PAGE_SIZE - 1U) / YUI_STATE_ENTRY_PAGE_SIZE;
+    if (pages_needed <= s_entry_page_count) {
         return ESP_OK;
     }
-    size_t new_capacity = s_watch_capacity == 0 ? YUI_STATE_WATCH_DEFAULT_CAPACITY : s_watch_capacity * 2U;
-    while (new_capacity < desired) {
-        new_capacity *= 2U;
+    yui_state_entry_t **pages = (yui_state_entry_t **)realloc(s_entry_pages, pages_needed * sizeof(yui_state_entry_t *));
+    if (!pages) {
+        return ESP_ERR_NO_MEM;
     }
-    struct yui_state_watch *next = (struct yui_state_watch *)realloc(s_watchers, new_capacity * sizeof(struct yui_state_watch));
-    if (!next) {
+    s_entry_pages = pages;
+    while (s_entry_page_count < pages_needed) {
+        yui_state_entry_t *page = (yui_state_entry_t *)calloc(YUI_STATE_ENTRY_PAGE_SIZE, sizeof(yui_state_entry_t));
+        if (!page) {
+            return ESP_ERR_NO_MEM;
+        }
+        s_entry_pages[s_entry_page_count++] = page;
+    }
+    return ESP_OK;
+}
+
+static int yui_state_find_index(const char *key, size_t len, uint32_t hash)
+{
+    if (s_index_capacity == 0U) {
+        return -1;
+    }
+    size_t mask = s_index_capacity - 1U;
+    for (size_t slot = hash & mask; s_index[slot] != 0U; slot = (slot + 1U) & mask) {
+        const yui_state_entry_t *entry = yui_state_entry_at(s_index[slot] - 1U);
+        if (entry->hash == hash && strncmp(entry->key, key, len) == 0 && entry->key[len] == '\0') {
+            return (int)(s_index[slot] - 1U);
+        }
+    }
+    return -1;
+}
+
+/* Caller holds the lock. Returns the entry index for key, reserving an undefined
+ * entry when the key has never been seen before. */
+static esp_err_t yui_state_lookup_or_insert(const char *key, size_t *out_index)
+{
+    size_t len = strlen(key);
+    uint32_t hash = yui_state_hash(key, len);
+    int found = yui_state_find_index(key, len, hash);
+    if (found >= 0) {
+        *out_index = (size_t)found;
+        return ESP_OK;
+    }
+    esp_err_t err = yui_state_reserve_entries(s_entry_count + 1U);
+    if (err == ESP_OK) {
+        err = yui_state_reserve_index(s_entry_count + 1U);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    const char *interned = yui_state_intern_key(key, len);
+    if (!interned) {
         return ESP_ERR_NO_MEM;
     }
-    s_watchers = next;
-    s_watch_capacity = new_capacity;
+    yui_state_entry_t *entry = yui_state_entry_at(s_entry_count);
+    memset(entry, 0, sizeof(*entry));
+    entry->key = interned;
+    entry->hash = hash;
+    yui_state_index_insert(s_index, s_index_capacity, hash, s_entry_count);
+    *out_index = s_entry_count++;
+    return ESP_OK;
+}
+
+static bool yui_state_entry_equals(yui_state_entry_t *entry, const yui_state_value_t *value)
+{
+    if (!entry->defined) {
+        return false;
+    }
+    if (entry->type == (uint8_t)value->type) {
+        switch (value->type) {
+            case YUI_STATE_VALUE_INT:
+                return entry->native.int_value == value->int_value;
+            case YUI_STATE_VALUE_FLOAT:
+                return entry->native.float_value == value->float_value;
+            case YUI_STATE_VALUE_BOOL:
+                return entry->native.bool_value == value->bool_value;
+            case YUI_STATE_VALUE_STRING:
+            default:
+                return strcmp(yui_state_entry_string(entry), yui_empty_if_null(value->string)) == 0;
+        }
+    }
+    /* Mixed representations compare by their text form, as the store always did. */
+    char scratch[48];
+    return strcmp(yui_state_entry_string(entry), yui_state_format_value(value, scratch, sizeof(scratch))) == 0;
+}
+
+static esp_err_t yui_state_entry_store(yui_state_entry_t *entry, const yui_state_value_t *typed)
+{
+    if (typed->type != YUI_STATE_VALUE_STRING) {
+        free(entry->heap_value);
+        entry->heap_value = NULL;
+        entry->inline_value[0] = '\0';
+        entry->string_valid = false;
+        entry->type = (uint8_t)typed->type;
+        switch (typed->type) {
+            case YUI_STATE_VALUE_INT:
+                entry->native.int_value = typed->int_value;
+                break;
+            case YUI_STATE_VALUE_FLOAT:
+                entry->native.float_value = typed->float_value;
+                break;
+            default:
+                entry->native.bool_value = typed->bool_value;
+                break;
+        }
+        entry->defined = true;
+        return ESP_OK;
+    }
+    const char *value = yui_empty_if_null(typed->string);
+    size_t len = strlen(value);
+    if (len < sizeof(entry->inline_value)) {
+        memcpy(entry->inline_value, value, len + 1U);
+        free(entry->heap_value);
+        entry->heap_value = NULL;
+    } else {
+        char *copy = yui_state_strdup(value);
+        if (!copy) {
+            return ESP_ERR_NO_MEM;
+        }
+        free(entry->heap_value);
+        entry->heap_value = copy;
+    }
+    entry->type = YUI_STATE_VALUE_STRING;
+    entry->string_valid = true;
+    entry->defined = true;
     return ESP_OK;
 }
 
-static int yui_state_find_index(const char *key)
+static void yui_state_free_entries(void)
 {
     for (size_t i = 0; i < s_entry_count; ++i) {
-        if (strcmp(s_entries[i].key, key) == 0) {
-            return (int)i;
+        free(yui_state_entry_at(i)->heap_value);
+    }
+    for (size_t i = 0; i < s_entry_page_count; ++i) {
+        free(s_entry_pages[i]);
+    }
+    free(s_entry_pages);
+    s_entry_pages = NULL;
+    s_entry_page_count = 0;
+    s_entry_count = 0;
+    free(s_index);
+    s_index = NULL;
+    s_index_capacity = 0;
+    while (s_key_chunks) {
+        yui_state_key_chunk_t *next = s_key_chunks->next;
+        free(s_key_chunks);
+        s_key_chunks = next;
+    }
+}
+
+static yui_state_watch_bucket_t *yui_state_watch_bucket(uint32_t bucket)
+{
+    return bucket == 0U ? &s_wildcard_watchers : &yui_state_entry_at(bucket - 1U)->watchers;
+}
+
+static esp_err_t yui_state_bucket_push(yui_state_watch_bucket_t *bucket, uint32_t slot)
+{
+    if (bucket->count == bucket->capacity) {
+        uint32_t new_capacity = bucket->capacity == 0U ? YUI_STATE_WATCH_DEFAULT_CAPACITY : bucket->capacity * 2U;
+        uint32_t *next = (uint32_t *)realloc(bucket->slots, new_capacity * sizeof(uint32_t));
+        if (!next) {
+            return ESP_ERR_NO_MEM;
         }
+        bucket->slots = next;
+        bucket->capacity = new_capacity;
     }
-    return -1;
+    s_watch_slots[slot].position = bucket->count;
+    bucket->slots[bucket->count++] = slot;
+    return ESP_OK;
 }
 
-static void yui_state_free_entry(yui_state_entry_t *entry)
+static void yui_state_bucket_remove(yui_state_watch_bucket_t *bucket, uint32_t position)
 {
-    if (!entry) {
-        return;
+    uint32_t last = bucket->count - 1U;
+    if (position != last) {
+        uint32_t moved = bucket->slots[last];
+        bucket->slots[position] = moved;
+        s_watch_slots[moved].position = position;
     }
-    free(entry->key);
-    free(entry->value);
-    entry->key = NULL;
-    entry->value = NULL;
+    bucket->count = last;
 }
 
-static void yui_state_free_watch(struct yui_state_watch *watch)
+static void yui_state_bucket_free(yui_state_watch_bucket_t *bucket)
 {
-    if (!watch) {
-        return;
+    free(bucket->slots);
+    bucket->slots = NULL;
+    bucket->count = 0U;
+    bucket->capacity = 0U;
+}
+
+static esp_err_t yui_state_alloc_watch_slot(uint32_t *out_slot)
+{
+    if (s_watch_free_head != YUI_STATE_WATCH_SLOT_NONE) {
+        *out_slot = s_watch_free_head;
+        s_watch_free_head = s_watch_slots[*out_slot].position;
+        return ESP_OK;
+    }
+    if (s_watch_slot_count >= YUI_STATE_WATCH_SLOT_MAX) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (s_watch_slot_count == s_watch_slot_capacity) {
+        uint32_t new_capacity = s_watch_slot_capacity == 0U ? YUI_STATE_WATCH_DEFAULT_CAPACITY : s_watch_slot_capacity * 2U;
+        struct yui_state_watch *next = (struct yui_state_watch *)realloc(s_watch_slots, new_capacity * sizeof(struct yui_state_watch));
+        if (!next) {
+            return ESP_ERR_NO_MEM;
+        }
+        s_watch_slots = next;
+        s_watch_slot_capacity = new_capacity;
     }
-    free(watch->key);
-    watch->key = NULL;
+    memset(&s_watch_slots[s_watch_slot_count], 0, sizeof(struct yui_state_watch));
+    *out_slot = s_watch_slot_count++;
+    return ESP_OK;
+}
+
+static void yui_state_release_watch_slot(uint32_t slot)
+{
+    struct yui_state_watch *watch = &s_watch_slots[slot];
+    watch->active = false;
     watch->cb = NULL;
     watch->user_ctx = NULL;
-    watch->id = 0;
+    watch->generation++;
+    watch->position = s_watch_free_head;
+    s_watch_free_head = slot;
 }
 
-static bool yui_state_is_wildcard(const struct yui_state_watch *watch)
+/* Size the notification arena for the largest possible fan-out so steady-state sets
+ * never allocate. Growth happens on the (rare) watch path; failure only means sets
+ * fall back to a heap snapshot. */
+static void yui_state_reserve_notify_arena(uint32_t bucket_count)
 {
-    if (!watch || !watch->key) {
-        return true;
+    if (bucket_count > s_watch_max_bucket) {
+        s_watch_max_bucket = bucket_count;
+    }
+    uint32_t desired = s_watch_max_bucket + s_wildcard_watchers.count;
+    if (desired <= s_notify_arena_capacity || atomic_load_explicit(&s_notify_arena_busy, memory_order_acquire)) {
+        return;
+    }
+    uint32_t new_capacity = s_notify_arena_capacity == 0U ? YUI_STATE_WATCH_DEFAULT_CAPACITY : s_notify_arena_capacity;
+    while (new_capacity < desired) {
+        new_capacity *= 2U;
+    }
+    yui_state_notification_t *next = (yui_state_notification_t *)realloc(s_notify_arena, new_capacity * sizeof(yui_state_notification_t));
+    if (!next) {
+        return;
     }
-    return watch->key[0] == '\0';
+    s_notify_arena = next;
+    s_notify_arena_capacity = new_capacity;
 }
 
-static bool yui_state_watch_matches(const struct yui_state_watch *watch, const char *key)
+static void yui_state_free_watchers(void)
 {
-    if (!watch || !watch->cb) {
-        return false;
+    for (size_t i = 0; i < s_entry_count; ++i) {
+        yui_state_bucket_free(&yui_state_entry_at(i)->watchers);
     }
-    if (yui_state_is_wildcard(watch)) {
-        return true;
+    yui_state_bucket_free(&s_wildcard_watchers);
+    free(s_watch_slots);
+    s_watch_slots = NULL;
+    s_watch_slot_count = 0U;
+    s_watch_slot_capacity = 0U;
+    s_watch_free_head = YUI_STATE_WATCH_SLOT_NONE;
+    s_watch_max_bucket = 0U;
+    free(s_notify_arena);
+    s_notify_arena = NULL;
+    s_notify_arena_capacity = 0U;
+    atomic_store_explicit(&s_notify_arena_busy, false, memory_order_relaxed);
+    free(s_batch_block);
+    s_batch_block = NULL;
+    s_batch_block_capacity = 0U;
+    atomic_store_explicit(&s_batch_block_busy, false, memory_order_relaxed);
+}
+
+static uint32_t yui_state_snapshot_bucket(const yui_state_watch_bucket_t *bucket, yui_state_notification_t *out, uint32_t cursor)
+{
+    for (uint32_t i = 0; i < bucket->count; ++i) {
+        const struct yui_state_watch *watch = &s_watch_slots[bucket->slots[i]];
+        out[cursor].cb = watch->cb;
+        out[cursor].user_ctx = watch->user_ctx;
+        cursor++;
     }
-    return strcmp(watch->key, key) == 0;
+    return cursor;
 }
 
-static esp_err_t yui_state_set_internal(const char *key, const char *value, bool notify)
+static void yui_state_batch_mark_dirty(size_t index)
 {
-    if (!key || key[0] == '\0') {
-        return ESP_ERR_INVALID_ARG;
+    yui_state_entry_t *entry = yui_state_entry_at(index);
+    if (entry->batch_dirty) {
+        return;
     }
-    esp_err_t err = yui_state_ensure_mutex();
-    if (err != ESP_OK) {
-        return err;
+    if (s_batch_dirty_count == s_batch_dirty_capacity) {
+        uint32_t new_capacity = s_batch_dirty_capacity == 0U ? YUI_STATE_WATCH_DEFAULT_CAPACITY : s_batch_dirty_capacity * 2U;
+        uint32_t *next = (uint32_t *)realloc(s_batch_dirty, new_capacity * sizeof(uint32_t));
+        if (!next) {
+            yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_STATE, "State updated but notifications dropped (OOM)");
+            return;
+        }
+        s_batch_dirty = next;
+        s_batch_dirty_capacity = new_capacity;
     }
+    entry->batch_dirty = true;
+    s_batch_dirty[s_batch_dirty_count++] = (uint32_t)index;
+}
 
-    key = yui_state_normalize_key(yui_empty_if_null(key));
-    value = yui_empty_if_null(value);
-
-    yui_state_lock();
-
-    int index = yui_state_find_index(key);
-    char *new_value = NULL;
+/* Caller holds the lock; it is released before watchers run. */
+static esp_err_t yui_state_apply_locked(size_t index, const yui_state_value_t *value, bool notify)
+{
+    yui_state_entry_t *entry = yui_state_entry_at(index);
+    const char *key = entry->key;
     bool updated = false;
 
-    if (index >= 0) {
-        if (strcmp(s_entries[index].value, value) == 0) {
-            notify = false;
-        } else {
-            new_value = yui_state_strdup(value);
-            if (!new_value) {
-                yui_state_unlock();
-                return ESP_ERR_NO_MEM;
-            }
-            free(s_entries[index].value);
-            s_entries[index].value = new_value;
-            updated = true;
-        }
+    if (yui_state_entry_equals(entry, value)) {
+        notify = false;
     } else {
-        err = yui_state_reserve_entries(s_entry_count + 1);
+        esp_err_t err = yui_state_entry_store(entry, value);
         if (err != ESP_OK) {
             yui_state_unlock();
             return err;
         }
-        char *key_copy = yui_state_strdup(key);
-        char *value_copy = yui_state_strdup(value);
-        if (!key_copy || !value_copy) {
-            free(key_copy);
-            free(value_copy);
-            yui_state_unlock();
-            return ESP_ERR_NO_MEM;
-        }
-        s_entries[s_entry_count].key = key_copy;
-        s_entries[s_entry_count].value = value_copy;
-        index = (int)s_entry_count;
-        s_entry_count++;
         updated = true;
+        s_stats.updates++;
     }
 
-    yui_state_notification_t *notifications = NULL;
-    size_t notify_count = 0;
-    if (notify && updated && s_watch_count > 0U) {
-        for (size_t i = 0; i < s_watch_count; ++i) {
-            if (yui_state_watch_matches(&s_watchers[i], key)) {
-                notify_count++;
-            }
+    if (notify && s_batch_depth > 0U) {
+        if (updated) {
+            yui_state_batch_mark_dirty(index);
         }
-        if (notify_count > 0U) {
+        yui_state_unlock();
+        return ESP_OK;
+    }
+
+    yui_state_notification_t *notifications = NULL;
+    uint32_t notify_count = 0;
+    bool arena_owned = false;
+    if (notify && updated) {
+        notify_count = entry->watchers.count + s_wildcard_watchers.count;
+    }
+    if (notify_count > 0U) {
+        /* The shared arena is handed to one dispatch at a time; a watcher that sets state
+         * from its callback (or a concurrent setter) snapshots onto the heap instead. */
+        if (!atomic_load_explicit(&s_notify_arena_busy, memory_order_acquire) && notify_count <= s_notify_arena_capacity) {
+            notifications = s_notify_arena;
+            atomic_store_explicit(&s_notify_arena_busy, true, memory_order_relaxed);
+            arena_owned = true;
+        } else {
             notifications = (yui_state_notification_t *)malloc(notify_count * sizeof(yui_state_notification_t));
-            if (!notifications) {
-                yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_STATE, "State updated but notifications dropped (OOM)");
-                notify_count = 0;
-            } else {
-                size_t cursor = 0;
-                for (size_t i = 0; i < s_watch_count; ++i) {
-                    if (yui_state_watch_matches(&s_watchers[i], key)) {
-                        notifications[cursor].cb = s_watchers[i].cb;
-                        notifications[cursor].user_ctx = s_watchers[i].user_ctx;
-                        cursor++;
-                    }
-                }
-            }
+        }
+        if (!notifications) {
+            yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_STATE, "State updated but notifications dropped (OOM)");
+            notify_count = 0;
+        } else {
+            uint32_t cursor = yui_state_snapshot_bucket(&entry->watchers, notifications, 0U);
+            (void)yui_state_snapshot_bucket(&s_wildcard_watchers, notifications, cursor);
+            s_stats.notifications += notify_count;
         }
     }
 
-    const char *final_value = s_entries[index].value;
+    const char *final_value = notify && updated ? yui_state_entry_string(entry) : NULL;
     yui_state_unlock();
 
     if (notify && updated) {
@@ -269,16 +669,52 @@ static esp_err_t yui_state_set_internal(const char *key, const char *value, bool
         yamui_log(YAMUI_LOG_LEVEL_DEBUG, YAMUI_LOG_CAT_STATE, "%s = %s", key, final_value ? final_value : "");
     }
 
-    for (size_t i = 0; i < notify_count; ++i) {
+    for (uint32_t i = 0; i < notify_count; ++i) {
         if (notifications[i].cb) {
             notifications[i].cb(key, final_value, notifications[i].user_ctx);
         }
     }
-    free(notifications);
+    if (arena_owned) {
+        /* Only lock holders claim or grow the arena, and they skip it while it is busy. */
+        atomic_store_explicit(&s_notify_arena_busy, false, memory_order_release);
+    } else {
+        free(notifications);
+    }
 
     return ESP_OK;
 }
 
+static esp_err_t yui_state_set_value_internal(const char *key, const yui_state_value_t *value, bool notify)
+{
+    if (!key || key[0] == '\0') {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = yui_state_ensure_mutex();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    key = yui_state_normalize_key(yui_empty_if_null(key));
+
+    yui_state_lock();
+    size_t index = 0;
+    err = yui_state_lookup_or_insert(key, &index);
+    if (err != ESP_OK) {
+        yui_state_unlock();
+        return err;
+    }
+    return yui_state_apply_locked(index, value, notify);
+}
+
+static esp_err_t yui_state_set_internal(const char *key, const char *value, bool notify)
+{
+    yui_state_value_t typed = {
+        .type = YUI_STATE_VALUE_STRING,
+        .string = yui_empty_if_null(value),
+    };
+    return yui_state_set_value_internal(key, &typed, notify);
+}
+
 static esp_err_t yui_state_seed_node_recursive(const yml_node_t *node, const char *prefix)
 {
     if (!node) {
@@ -330,22 +766,13 @@ void yui_state_deinit(void)
         return;
     }
     yui_state_lock();
-    for (size_t i = 0; i < s_entry_count; ++i) {
-        yui_state_free_entry(&s_entries[i]);
-    }
-    free(s_entries);
-    s_entries = NULL;
-    s_entry_count = 0;
-    s_entry_capacity = 0;
-
-    for (size_t i = 0; i < s_watch_count; ++i) {
-        yui_state_free_watch(&s_watchers[i]);
-    }
-    free(s_watchers);
-    s_watchers = NULL;
-    s_watch_count = 0;
-    s_watch_capacity = 0;
-    s_watch_next_id = 1;
+    yui_state_free_watchers();
+    yui_state_free_entries();
+    free(s_batch_dirty);
+    s_batch_dirty = NULL;
+    s_batch_dirty_count = 0U;
+    s_batch_dirty_capacity = 0U;
+    s_batch_depth = 0U;
 
     yui_state_unlock();
     vSemaphoreDelete(s_lock);
@@ -358,13 +785,14 @@ void yui_state_clear(void)
         return;
     }
     yui_state_lock();
+    /* Keys stay interned so outstanding yui_state_key_t handles remain valid. */
     for (size_t i = 0; i < s_entry_count; ++i) {
-        yui_state_free_entry(&s_entries[i]);
+        yui_state_entry_t *entry = yui_state_entry_at(i);
+        free(entry->heap_value);
+        entry->heap_value = NULL;
+        entry->inline_value[0] = '\0';
+        entry->defined = false;
     }
-    free(s_entries);
-    s_entries = NULL;
-    s_entry_count = 0;
-    s_entry_capacity = 0;
     yui_state_unlock();
 }
 
@@ -407,16 +835,225 @@ esp_err_t yui_state_set(const char *key, const char *value)
     return yui_state_set_internal(key, value, true);
 }
 
+esp_err_t yui_state_set_many(const yui_state_seed_t *entries, size_t entry_count)
+{
+    if (!entries && entry_count > 0U) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = yui_state_begin_batch();
+    if (err != ESP_OK) {
+        return err;
+    }
+    for (size_t i = 0; i < entry_count && err == ESP_OK; ++i) {
+        const char *key = entries[i].key;
+        if (!key || key[0] == '\0') {
+            continue;
+        }
+        err = yui_state_set_internal(key, entries[i].value, true);
+    }
+    esp_err_t commit_err = yui_state_commit_batch();
+    return err != ESP_OK ? err : commit_err;
+}
+
+esp_err_t yui_state_begin_batch(void)
+{
+    esp_err_t err = yui_state_ensure_mutex();
+    if (err != ESP_OK) {
+        return err;
+    }
+    /* The lock stays held until the matching commit so the batch applies atomically. */
+    yui_state_lock();
+    s_batch_depth++;
+    return ESP_OK;
+}
+
+static uint32_t yui_state_batch_collect(const yui_state_watch_bucket_t *bucket, uint32_t entry, yui_state_batch_notification_t *out,
+                                        uint32_t cursor, uint32_t *dedupe, uint32_t dedupe_mask)
+{
+    for (uint32_t i = 0; i < bucket->count; ++i) {
+        const struct yui_state_watch *watch = &s_watch_slots[bucket->slots[i]];
+        uint32_t hash = (uint32_t)(((uintptr_t)watch->cb ^ (uintptr_t)watch->user_ctx) * 2654435761U);
+        uint32_t slot = hash & dedupe_mask;
+        bool duplicate = false;
+        while (dedupe[slot] != 0U) {
+            yui_state_batch_notification_t *existing = &out[dedupe[slot] - 1U];
+            if (existing->cb == watch->cb && existing->user_ctx == watch->user_ctx) {
+                existing->entry = entry;
+                duplicate = true;
+                break;
+            }
+            slot = (slot + 1U) & dedupe_mask;
+        }
+        if (duplicate) {
+            continue;
+        }
+        out[cursor].cb = watch->cb;
+        out[cursor].user_ctx = watch->user_ctx;
+        out[cursor].entry = entry;
+        dedupe[slot] = ++cursor;
+    }
+    return cursor;
+}
+
+esp_err_t yui_state_commit_batch(void)
+{
+    if (!s_lock) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    yui_state_lock();
+    if (s_batch_depth == 0U) {
+        yui_state_unlock();
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_batch_depth--;
+    if (s_batch_depth > 0U) {
+        yui_state_unlock();
+        yui_state_unlock();
+        return ESP_OK;
+    }
+
+    /* A watcher registered on several changed keys (or a wildcard watcher) is notified
+     * once, with the last changed key it observes. */
+    uint32_t dirty_count = s_batch_dirty_count;
+    uint32_t upper_bound = s_wildcard_watchers.count;
+    for (uint32_t i = 0; i < dirty_count; ++i) {
+        upper_bound += yui_state_entry_at(s_batch_dirty[i])->watchers.count;
+    }
+    uint32_t dedupe_capacity = 8U;
+    while (dedupe_capacity < upper_bound * 2U) {
+        dedupe_capacity *= 2U;
+    }
+    size_t block_size = dirty_count * sizeof(uint32_t) + upper_bound * sizeof(yui_state_batch_notification_t) + dedupe_capacity * sizeof(uint32_t);
+    uint8_t *block = NULL;
+    bool block_owned = false;
+    if (dirty_count > 0U) {
+        if (!atomic_load_explicit(&s_batch_block_busy, memory_order_acquire)) {
+            if (block_size > s_batch_block_capacity) {
+                uint8_t *next = (uint8_t *)realloc(s_batch_block, block_size);
+                if (next) {
+                    s_batch_block = next;
+                    s_batch_block_capacity = block_size;
+                }
+            }
+            if (block_size <= s_batch_block_capacity) {
+                block = s_batch_block;
+                block_owned = true;
+                atomic_store_explicit(&s_batch_block_busy, true, memory_order_relaxed);
+            }
+        }
+        if (!block) {
+            block = (uint8_t *)malloc(block_size);
+        }
+    }
+    yui_state_batch_notification_t *notifications = NULL;
+    uint32_t *dirty = NULL;
+    uint32_t notify_count = 0;
+    if (block) {
+        notifications = (yui_state_batch_notification_t *)block;
+        dirty = (uint32_t *)(block + upper_bound * sizeof(yui_state_batch_notification_t));
+        uint32_t *dedupe = dirty + dirty_count;
+        memset(dedupe, 0, dedupe_capacity * sizeof(uint32_t));
+        memcpy(dirty, s_batch_dirty, dirty_count * sizeof(uint32_t));
+        for (uint32_t i = 0; i < dirty_count; ++i) {
+            notify_count = yui_state_batch_collect(&yui_state_entry_at(dirty[i])->watchers, dirty[i], notifications, notify_count, dedupe, dedupe_capacity - 1U);
+        }
+        if (dirty_count > 0U) {
+            notify_count = yui_state_batch_collect(&s_wildcard_watchers, dirty[dirty_count - 1U], notifications, notify_count, dedupe, dedupe_capacity - 1U);
+        }
+        s_stats.notifications += notify_count;
+    } else if (dirty_count > 0U) {
+        yamui_log(YAMUI_LOG_LEVEL_WARN, YAMUI_LOG_CAT_STATE, "State updated but notifications dropped (OOM)");
+        dirty_count = 0U;
+    }
+    for (uint32_t i = 0; i < s_batch_dirty_count; ++i) {
+        yui_state_entry_t *entry = yui_state_entry_at(s_batch_dirty[i]);
+        entry->batch_dirty = false;
+        (void)yui_state_entry_string(entry);
+    }
+    s_batch_dirty_count = 0U;
+    s_stats.batches++;
+    yui_state_unlock();
+    yui_state_unlock();
+
+    for (uint32_t i = 0; i < dirty_count; ++i) {
+        const yui_state_entry_t *entry = yui_state_entry_at(dirty[i]);
+        const char *value = entry->heap_value ? entry->heap_value : entry->inline_value;
+        yamui_telemetry_state_change(entry->key, value);
+        yamui_log(YAMUI_LOG_LEVEL_DEBUG, YAMUI_LOG_CAT_STATE, "%s = %s", entry->key, value);
+    }
+    for (uint32_t i = 0; i < notify_count; ++i) {
+        const yui_state_entry_t *entry = yui_state_entry_at(notifications[i].entry);
+        if (notifications[i].cb) {
+            notifications[i].cb(entry->key, entry->heap_value ? entry->heap_value : entry->inline_value, notifications[i].user_ctx);
+        }
+    }
+    if (block_owned) {
+        atomic_store_explicit(&s_batch_block_busy, false, memory_order_release);
+    } else {
+        free(block);
+    }
+    return ESP_OK;
+}
+
+void yui_state_get_stats(yui_state_stats_t *out_stats)
+{
+    if (!out_stats) {
+        return;
+    }
+    /* Reading the counters takes the mutex directly so it does not count itself. */
+    if (s_lock) {
+        xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    }
+    *out_stats = s_stats;
+    if (s_lock) {
+        xSemaphoreGiveRecursive(s_lock);
+    }
+}
+
+void yui_state_reset_stats(void)
+{
+    if (s_lock) {
+        xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    }
+    memset(&s_stats, 0, sizeof(s_stats));
+    if (s_lock) {
+        xSemaphoreGiveRecursive(s_lock);
+    }
+}
+
+esp_err_t yui_state_set_value(const char *key, const yui_state_value_t *value)
+{
+    if (!value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return yui_state_set_value_internal(key, value, true);
+}
+
 esp_err_t yui_state_set_int(const char *key, int32_t value)
 {
-    char buffer[16];
-    snprintf(buffer, sizeof(buffer), "%ld", (long)value);
-    return yui_state_set(key, buffer);
+    yui_state_value_t typed = {
+        .type = YUI_STATE_VALUE_INT,
+        .int_value = value,
+    };
+    return yui_state_set_value_internal(key, &typed, true);
+}
+
+esp_err_t yui_state_set_float(const char *key, double value)
+{
+    yui_state_value_t typed = {
+        .type = YUI_STATE_VALUE_FLOAT,
+        .float_value = value,
+    };
+    return yui_state_set_value_internal(key, &typed, true);
 }
 
 esp_err_t yui_state_set_bool(const char *key, bool value)
 {
-    return yui_state_set(key, value ? "true" : "false");
+    yui_state_value_t typed = {
+        .type = YUI_STATE_VALUE_BOOL,
+        .bool_value = value,
+    };
+    return yui_state_set_value_internal(key, &typed, true);
 }
 
 const char *yui_state_get(const char *key, const char *default_value)
@@ -426,39 +1063,226 @@ const char *yui_state_get(const char *key, const char *default_value)
         return default_value;
     }
     const char *result = default_value;
+    size_t len = strlen(key);
+    uint32_t hash = yui_state_hash(key, len);
     yui_state_lock();
-    int index = yui_state_find_index(key);
-    if (index >= 0) {
-        result = s_entries[index].value;
+    int index = yui_state_find_index(key, len, hash);
+    if (index >= 0 && yui_state_entry_at((size_t)index)->defined) {
+        result = yui_state_entry_string(yui_state_entry_at((size_t)index));
     }
     yui_state_unlock();
     return result;
 }
 
+bool yui_state_get_value(const char *key, yui_state_value_t *out_value)
+{
+    key = yui_state_normalize_key(key);
+    if (!key || key[0] == '\0' || !out_value || yui_state_ensure_mutex() != ESP_OK) {
+        return false;
+    }
+    bool found = false;
+    size_t len = strlen(key);
+    uint32_t hash = yui_state_hash(key, len);
+    yui_state_lock();
+    int index = yui_state_find_index(key, len, hash);
+    if (index >= 0 && yui_state_entry_at((size_t)index)->defined) {
+        yui_state_entry_read(yui_state_entry_at((size_t)index), out_value);
+        found = true;
+    }
+    yui_state_unlock();
+    return found;
+}
+
+esp_err_t yui_state_key_resolve(const char *key, yui_state_key_t *out_key)
+{
+    key = yui_state_normalize_key(key);
+    if (!key || key[0] == '\0' || !out_key) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = yui_state_ensure_mutex();
+    if (err != ESP_OK) {
+        return err;
+    }
+    size_t index = 0;
+    yui_state_lock();
+    err = yui_state_lookup_or_insert(key, &index);
+    yui_state_unlock();
+    if (err != ESP_OK) {
+        return err;
+    }
+    *out_key = (yui_state_key_t)(index + 1U);
+    return ESP_OK;
+}
+
+const char *yui_state_key_name(yui_state_key_t key)
+{
+    const char *name = NULL;
+    yui_state_lock();
+    if (key != YUI_STATE_KEY_INVALID && key <= s_entry_count) {
+        name = yui_state_entry_at(key - 1U)->key;
+    }
+    yui_state_unlock();
+    return name;
+}
+
+esp_err_t yui_state_set_by_key(yui_state_key_t key, const char *value)
+{
+    if (key == YUI_STATE_KEY_INVALID || !s_lock) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    yui_state_lock();
+    if (key > s_entry_count) {
+        yui_state_unlock();
+        return ESP_ERR_INVALID_ARG;
+    }
+    yui_state_value_t typed = {
+        .type = YUI_STATE_VALUE_STRING,
+        .string = yui_empty_if_null(value),
+    };
+    return yui_state_apply_locked(key - 1U, &typed, true);
+}
+
+esp_err_t yui_state_set_value_by_key(yui_state_key_t key, const yui_state_value_t *value)
+{
+    if (key == YUI_STATE_KEY_INVALID || !value || !s_lock) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    yui_state_lock();
+    if (key > s_entry_count) {
+        yui_state_unlock();
+        return ESP_ERR_INVALID_ARG;
+    }
+    return yui_state_apply_locked(key - 1U, value, true);
+}
+
+const char *yui_state_get_by_key(yui_state_key_t key, const char *default_value)
+{
+    if (key == YUI_STATE_KEY_INVALID || !s_lock) {
+        return default_value;
+    }
+    const char *result = default_value;
+    yui_state_lock();
+    if (key <= s_entry_count && yui_state_entry_at(key - 1U)->defined) {
+        result = yui_state_entry_string(yui_state_entry_at(key - 1U));
+    }
+    yui_state_unlock();
+    return result;
+}
+
+bool yui_state_get_value_by_key(yui_state_key_t key, yui_state_value_t *out_value)
+{
+    if (key == YUI_STATE_KEY_INVALID || !out_value || !s_lock) {
+        return false;
+    }
+    bool found = false;
+    yui_state_lock();
+    if (key <= s_entry_count && yui_state_entry_at(key - 1U)->defined) {
+        yui_state_entry_read(yui_state_entry_at(key - 1U), out_value);
+        found = true;
+    }
+    yui_state_unlock();
+    return found;
+}
+
 int32_t yui_state_get_int(const char *key, int32_t default_value)
 {
-    const char *value = yui_state_get(key, NULL);
-    if (!value || value[0] == '\0') {
+    yui_state_value_t value;
+    if (!yui_state_get_value(key, &value)) {
+        return default_value;
+    }
+    switch (value.type) {
+        case YUI_STATE_VALUE_INT:
+            return value.int_value;
+        case YUI_STATE_VALUE_FLOAT:
+            return (int32_t)value.float_value;
+        case YUI_STATE_VALUE_BOOL:
+            return value.bool_value ? 1 : 0;
+        case YUI_STATE_VALUE_STRING:
+        default:
+            if (!value.string || value.string[0] == '\0') {
+                return default_value;
+            }
+            return (int32_t)strtol(value.string, NULL, 10);
+    }
+}
+
+double yui_state_get_float(const char *key, double default_value)
+{
+    yui_state_value_t value;
+    if (!yui_state_get_value(key, &value)) {
         return default_value;
     }
-    return (int32_t)strtol(value, NULL, 10);
+    switch (value.type) {
+        case YUI_STATE_VALUE_INT:
+            return (double)value.int_value;
+        case YUI_STATE_VALUE_FLOAT:
+            return value.float_value;
+        case YUI_STATE_VALUE_BOOL:
+            return value.bool_value ? 1.0 : 0.0;
+        case YUI_STATE_VALUE_STRING:
+        default: {
+            if (!value.string) {
+                return default_value;
+            }
+            char *end = NULL;
+            double number = strtod(value.string, &end);
+            return end && end != value.string ? number : default_value;
+        }
+    }
 }
 
 bool yui_state_get_bool(const char *key, bool default_value)
 {
-    const char *value = yui_state_get(key, NULL);
-    if (!value) {
+    yui_state_value_t value;
+    if (!yui_state_get_value(key, &value)) {
+        return default_value;
+    }
+    switch (value.type) {
+        case YUI_STATE_VALUE_BOOL:
+            return value.bool_value;
+        case YUI_STATE_VALUE_INT:
+            return value.int_value == 1 ? true : (value.int_value == 0 ? false : default_value);
+        case YUI_STATE_VALUE_FLOAT:
+            return value.float_value == 1.0 ? true : (value.float_value == 0.0 ? false : default_value);
+        case YUI_STATE_VALUE_STRING:
+        default:
+            break;
+    }
+    if (!value.string) {
         return default_value;
     }
-    if (strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0) {
+    if (strcasecmp(value.string, "true") == 0 || strcmp(value.string, "1") == 0) {
         return true;
     }
-    if (strcasecmp(value, "false") == 0 || strcmp(value, "0") == 0) {
+    if (strcasecmp(value.string, "false") == 0 || strcmp(value.string, "0") == 0) {
         return false;
     }
     return default_value;
 }
 
+static esp_err_t yui_state_watch_bucket_locked(uint32_t bucket_id, yui_state_watch_cb_t cb, void *user_ctx, yui_state_watch_handle_t *out_handle)
+{
+    uint32_t slot = 0;
+    esp_err_t err = yui_state_alloc_watch_slot(&slot);
+    if (err != ESP_OK) {
+        return err;
+    }
+    yui_state_watch_bucket_t *bucket = yui_state_watch_bucket(bucket_id);
+    err = yui_state_bucket_push(bucket, slot);
+    if (err != ESP_OK) {
+        yui_state_release_watch_slot(slot);
+        return err;
+    }
+    struct yui_state_watch *watch = &s_watch_slots[slot];
+    watch->active = true;
+    watch->bucket = bucket_id;
+    watch->cb = cb;
+    watch->user_ctx = user_ctx;
+    yui_state_reserve_notify_arena(bucket_id == 0U ? 0U : bucket->count);
+    *out_handle = ((uint32_t)watch->generation << 16) | (slot + 1U);
+    return ESP_OK;
+}
+
 esp_err_t yui_state_watch(const char *key, yui_state_watch_cb_t cb, void *user_ctx, yui_state_watch_handle_t *out_handle)
 {
     if (!cb) {
@@ -469,30 +1293,44 @@ esp_err_t yui_state_watch(const char *key, yui_state_watch_cb_t cb, void *user_c
         return err;
     }
 
-    char *key_copy = NULL;
     key = yui_state_normalize_key(key);
+    yui_state_watch_handle_t handle = 0;
+    yui_state_lock();
+    uint32_t bucket_id = 0;
     if (key && key[0] != '\0') {
-        key_copy = yui_state_strdup(key);
-        if (!key_copy) {
-            return ESP_ERR_NO_MEM;
-        }
+        size_t index = 0;
+        err = yui_state_lookup_or_insert(key, &index);
+        bucket_id = (uint32_t)index + 1U;
+    }
+    if (err == ESP_OK) {
+        err = yui_state_watch_bucket_locked(bucket_id, cb, user_ctx, &handle);
     }
+    yui_state_unlock();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    if (out_handle) {
+        *out_handle = handle;
+    }
+    return ESP_OK;
+}
 
+esp_err_t yui_state_watch_key(yui_state_key_t key, yui_state_watch_cb_t cb, void *user_ctx, yui_state_watch_handle_t *out_handle)
+{
+    if (!cb || key == YUI_STATE_KEY_INVALID || !s_lock) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    yui_state_watch_handle_t handle = 0;
+    esp_err_t err = ESP_ERR_INVALID_ARG;
     yui_state_lock();
-    err = yui_state_reserve_watchers(s_watch_count + 1U);
+    if (key <= s_entry_count) {
+        err = yui_state_watch_bucket_locked(key, cb, user_ctx, &handle);
+    }
+    yui_state_unlock();
     if (err != ESP_OK) {
-        yui_state_unlock();
-        free(key_copy);
         return err;
     }
-    struct yui_state_watch *watch = &s_watchers[s_watch_count++];
-    watch->id = s_watch_next_id++;
-    watch->key = key_copy;
-    watch->cb = cb;
-    watch->user_ctx = user_ctx;
-    uint32_t handle = watch->id;
-    yui_state_unlock();
-
     if (out_handle) {
         *out_handle = handle;
     }
@@ -504,15 +1342,14 @@ void yui_state_unwatch(yui_state_watch_handle_t handle)
     if (handle == 0U || !s_lock) {
         return;
     }
+    uint32_t slot = (handle & 0xFFFFU) - 1U;
+    uint16_t generation = (uint16_t)(handle >> 16);
     yui_state_lock();
-    for (size_t i = 0; i < s_watch_count; ++i) {
-        if (s_watchers[i].id == handle) {
-            yui_state_free_watch(&s_watchers[i]);
-            if (i + 1U < s_watch_count) {
-                s_watchers[i] = s_watchers[s_watch_count - 1U];
-            }
-            s_watch_count--;
-            break;
+    if (slot < s_watch_slot_count) {
+        struct yui_state_watch *watch = &s_watch_slots[slot];
+        if (watch->active && watch->generation == generation) {
+            yui_state_bucket_remove(yui_state_watch_bucket(watch->bucket), watch->position);
+            yui_state_release_watch_slot(slot);
         }
     }
     yui_state_unlock();
@@ -28,26 +28,29 @@ typedef struct {
     char message[64];
 } yui_demo_sync_ctx_t;
 
-static void yui_demo_sync_apply(void *arg)
+_Static_assert(sizeof(yui_demo_sync_ctx_t) <= KC_TOUCH_GUI_PAYLOAD_MAX, "demo sync step must fit a GUI post");
+
+static void yui_demo_sync_apply(const void *payload, size_t len)
 {
-    yui_demo_sync_ctx_t *ctx = (yui_demo_sync_ctx_t *)arg;
-    if (!ctx) {
+    const yui_demo_sync_ctx_t *ctx = (const yui_demo_sync_ctx_t *)payload;
+    if (!ctx || len != sizeof(*ctx)) {
         return;
     }
     const char *operation = ctx->operation[0] != '\0' ? ctx->operation : "sync_demo";
 
     if (ctx->mark_complete) {
+        /* Publish the counter and the completion fields as one state transaction. */
+        (void)yui_state_begin_batch();
         if (ctx->increment_sync_count) {
             (void)yui_state_set_int("ui.sync_count", yui_state_get_int("ui.sync_count", 0) + 1);
         }
         (void)yamui_async_complete(operation, ctx->message);
-        free(ctx);
+        (void)yui_state_commit_batch();
         return;
     }
 
     if (ctx->mark_failed) {
         (void)yamui_async_fail(operation, ctx->message);
-        free(ctx);
         return;
     }
 
@@ -56,7 +59,6 @@ static void yui_demo_sync_apply(void *arg)
     } else {
         (void)yamui_async_progress(operation, ctx->progress, ctx->message);
     }
-    free(ctx);
 }
 
 static bool yui_demo_sync_dispatch_step(const char *operation,
@@ -66,23 +68,17 @@ static bool yui_demo_sync_dispatch_step(const char *operation,
                                         bool increment_sync_count,
                                         bool mark_failed)
 {
-    yui_demo_sync_ctx_t *ctx = (yui_demo_sync_ctx_t *)calloc(1, sizeof(yui_demo_sync_ctx_t));
-    if (!ctx) {
-        return false;
-    }
-    snprintf(ctx->operation, sizeof(ctx->operation), "%s", operation ? operation : "sync_demo");
-    ctx->progress = progress;
-    ctx->mark_complete = mark_complete;
-    ctx->increment_sync_count = increment_sync_count;
-    ctx->mark_failed = mark_failed;
-    snprintf(ctx->message, sizeof(ctx->message), "%s", message ? message : "");
-
-    esp_err_t err = kc_touch_gui_dispatch(yui_demo_sync_apply, ctx, pdMS_TO_TICKS(250));
-    if (err != ESP_OK) {
-        free(ctx);
-        return false;
-    }
-    return true;
+    yui_demo_sync_ctx_t step = {
+        .progress = progress,
+        .mark_complete = mark_complete,
+        .increment_sync_count = increment_sync_count,
+        .mark_failed = mark_failed,
+    };
+    snprintf(step.operation, sizeof(step.operation), "%s", operation ? operation : "sync_demo");
+    snprintf(step.message, sizeof(step.message), "%s", message ? message : "");
+
+    /* Copied into the GUI ring, so nothing to allocate or free. */
+    return kc_touch_gui_post(yui_demo_sync_apply, &step, sizeof(step), 0) == ESP_OK;
 }
 
 static void yui_demo_sync_task(void *arg)
@@ -0,0 +1,188 @@
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "unity.h"
+
+#include "kc_touch_gui_ring.h"
+
+#define RING_PRODUCERS 3U
+#define RING_ITEMS_PER_PRODUCER 5000U
+
+typedef struct {
+    uint32_t producer;
+    uint32_t seq;
+} ring_test_payload_t;
+
+static kc_touch_gui_ring_t s_ring;
+static SemaphoreHandle_t s_done;
+
+static void ring_test_cb(const void *payload, size_t len)
+{
+    (void)payload;
+    (void)len;
+}
+
+static void ring_test_noop(void *ctx)
+{
+    (void)ctx;
+}
+
+static kc_touch_gui_ring_item_t ring_test_item(uint32_t producer, uint32_t seq)
+{
+    kc_touch_gui_ring_item_t item = {
+        .kind = KC_TOUCH_GUI_RING_POST,
+        .len = sizeof(ring_test_payload_t),
+        .cb.post = ring_test_cb,
+    };
+    ring_test_payload_t payload = {producer, seq};
+    memcpy(item.payload.bytes, &payload, sizeof(payload));
+    return item;
+}
+
+static void ring_test_producer(void *arg)
+{
+    uint32_t producer = (uint32_t)(uintptr_t)arg;
+    for (uint32_t seq = 0; seq < RING_ITEMS_PER_PRODUCER; ++seq) {
+        kc_touch_gui_ring_item_t item = ring_test_item(producer, seq);
+        while (!kc_touch_gui_ring_push(&s_ring, &item)) {
+            taskYIELD();
+        }
+    }
+    xSemaphoreGive(s_done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("ring keeps per-producer order under contention", "[gui][ring]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, kc_touch_gui_ring_init(&s_ring, 16, 0));
+    s_done = xSemaphoreCreateCounting(RING_PRODUCERS, 0);
+    TEST_ASSERT_NOT_NULL(s_done);
+
+    for (uint32_t p = 0; p < RING_PRODUCERS; ++p) {
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(ring_test_producer, "ring_prod", 3072, (void *)(uintptr_t)p,
+                                                          uxTaskPriorityGet(NULL), NULL,
+                                                          (BaseType_t)(p % portNUM_PROCESSORS)));
+    }
+
+    uint32_t next_seq[RING_PRODUCERS] = {0};
+    uint32_t received = 0;
+    kc_touch_gui_ring_item_t out;
+    while (received < RING_PRODUCERS * RING_ITEMS_PER_PRODUCER) {
+        if (!kc_touch_gui_ring_pop(&s_ring, &out)) {
+            taskYIELD();
+            continue;
+        }
+        ring_test_payload_t payload;
+        TEST_ASSERT_EQUAL(KC_TOUCH_GUI_RING_POST, out.kind);
+        TEST_ASSERT_EQUAL(sizeof(payload), out.len);
+        memcpy(&payload, out.payload.bytes, sizeof(payload));
+        TEST_ASSERT_LESS_THAN_UINT32(RING_PRODUCERS, payload.producer);
+        TEST_ASSERT_EQUAL_UINT32(next_seq[payload.producer], payload.seq);
+        next_seq[payload.producer]++;
+        received++;
+    }
+    for (uint32_t p = 0; p < RING_PRODUCERS; ++p) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(s_done, pdMS_TO_TICKS(1000)));
+    }
+    TEST_ASSERT_FALSE(kc_touch_gui_ring_pop(&s_ring, &out));
+
+    kc_touch_gui_dispatch_stats_t stats;
+    kc_touch_gui_ring_get_stats(&s_ring, &stats);
+    TEST_ASSERT_EQUAL_UINT32(RING_PRODUCERS * RING_ITEMS_PER_PRODUCER, stats.posted);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.depth);
+    /* A producer that publishes and is drained before it samples the depth must not
+     * record a wrapped value. */
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, stats.high_water);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stats.capacity, stats.high_water);
+
+    vSemaphoreDelete(s_done);
+    kc_touch_gui_ring_deinit(&s_ring);
+}
+
+TEST_CASE("ring reports full and tracks high water", "[gui][ring]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, kc_touch_gui_ring_init(&s_ring, 5, 0));
+    kc_touch_gui_ring_item_t work = {
+        .kind = KC_TOUCH_GUI_RING_WORK,
+        .cb.work = ring_test_noop,
+    };
+    /* Rounded up to 8 slots. */
+    for (uint32_t i = 0; i < 8U; ++i) {
+        work.ctx = (void *)(uintptr_t)(i + 1U);
+        TEST_ASSERT_TRUE(kc_touch_gui_ring_push(&s_ring, &work));
+    }
+    TEST_ASSERT_FALSE(kc_touch_gui_ring_push(&s_ring, &work));
+
+    kc_touch_gui_dispatch_stats_t stats;
+    kc_touch_gui_ring_get_stats(&s_ring, &stats);
+    TEST_ASSERT_EQUAL_UINT32(8, stats.capacity);
+    TEST_ASSERT_EQUAL_UINT32(8, stats.depth);
+    TEST_ASSERT_EQUAL_UINT32(8, stats.high_water);
+    TEST_ASSERT_EQUAL_UINT32(8, stats.posted);
+
+    kc_touch_gui_ring_item_t out;
+    for (uint32_t i = 0; i < 8U; ++i) {
+        TEST_ASSERT_TRUE(kc_touch_gui_ring_pop(&s_ring, &out));
+        TEST_ASSERT_EQUAL(KC_TOUCH_GUI_RING_WORK, out.kind);
+        TEST_ASSERT_EQUAL_PTR((void *)(uintptr_t)(i + 1U), out.ctx);
+    }
+    TEST_ASSERT_FALSE(kc_touch_gui_ring_pop(&s_ring, &out));
+
+    /* Wrapping around keeps working and a reset restarts the high-water mark at the depth. */
+    kc_touch_gui_ring_reset_stats(&s_ring);
+    TEST_ASSERT_TRUE(kc_touch_gui_ring_push(&s_ring, &work));
+    TEST_ASSERT_TRUE(kc_touch_gui_ring_push(&s_ring, &work));
+    kc_touch_gui_ring_get_stats(&s_ring, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.high_water);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.posted);
+    kc_touch_gui_ring_deinit(&s_ring);
+}
+
+TEST_CASE("ring mailboxes coalesce to the newest payload", "[gui][ring]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, kc_touch_gui_ring_init(&s_ring, 4, 2));
+    for (uint32_t v = 1; v <= 3U; ++v) {
+        TEST_ASSERT_EQUAL(ESP_OK, kc_touch_gui_ring_post_coalesced(&s_ring, 0x10, ring_test_cb, &v, sizeof(v), 0));
+    }
+    uint32_t other = 42;
+    TEST_ASSERT_EQUAL(ESP_OK, kc_touch_gui_ring_post_coalesced(&s_ring, 0x20, ring_test_cb, &other, sizeof(other), 0));
+    /* Both mailboxes are claimed, so a third key has nowhere to go. */
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND,
+                      kc_touch_gui_ring_post_coalesced(&s_ring, 0x30, ring_test_cb, &other, sizeof(other), 0));
+
+    kc_touch_gui_dispatch_stats_t stats;
+    kc_touch_gui_ring_get_stats(&s_ring, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.depth);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.coalesced);
+
+    kc_touch_gui_ring_item_t out;
+    uint32_t value = 0;
+    TEST_ASSERT_TRUE(kc_touch_gui_ring_pop(&s_ring, &out));
+    TEST_ASSERT_EQUAL(KC_TOUCH_GUI_RING_POST, out.kind);
+    TEST_ASSERT_EQUAL(sizeof(value), out.len);
+    memcpy(&value, out.payload.bytes, sizeof(value));
+    TEST_ASSERT_EQUAL_UINT32(3, value);
+    TEST_ASSERT_TRUE(kc_touch_gui_ring_pop(&s_ring, &out));
+    memcpy(&value, out.payload.bytes, sizeof(value));
+    TEST_ASSERT_EQUAL_UINT32(42, value);
+
+    /* Once popped, the next post for the key queues a fresh slot. */
+    value = 4;
+    TEST_ASSERT_EQUAL(ESP_OK, kc_touch_gui_ring_post_coalesced(&s_ring, 0x10, ring_test_cb, &value, sizeof(value), 0));
+    kc_touch_gui_ring_get_stats(&s_ring, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.depth);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.coalesced);
+    TEST_ASSERT_TRUE(kc_touch_gui_ring_pop(&s_ring, &out));
+    memcpy(&value, out.payload.bytes, sizeof(value));
+    TEST_ASSERT_EQUAL_UINT32(4, value);
+    kc_touch_gui_ring_deinit(&s_ring);
+}
+
+void app_main(void)
+{
+    UNITY_BEGIN();
+    unity_run_menu();
+    UNITY_END();
+}
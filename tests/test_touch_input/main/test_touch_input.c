@@ -0,0 +1,316 @@
+#include <math.h>
+#include <string.h>
+
+#include "unity.h"
+
+#include "kc_touch_input.h"
+
+#define FRAME_MS 10
+
+static kc_touch_gesture_recognizer_t s_rec;
+static kc_touch_gesture_t s_events[32];
+static size_t s_event_count;
+static int64_t s_now_us;
+
+static void touch_reset(void)
+{
+    kc_touch_gesture_config_t cfg = {
+        .long_press_ms = 500,
+        .slop_px = 10,
+        .swipe_min_px = 60,
+        .pinch_min_pct = 10,
+    };
+    kc_touch_gesture_init(&s_rec, &cfg);
+    s_event_count = 0;
+    s_now_us = 1000000;
+}
+
+/* Feeds one frame with @p count points (x0, y0, x1, y1) and advances the clock. */
+static void touch_feed(uint8_t count, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    kc_touch_frame_t frame = {
+        .timestamp_us = s_now_us,
+        .count = count,
+        .points = {{x0, y0}, {x1, y1}},
+    };
+    s_event_count += kc_touch_gesture_feed(&s_rec, &frame, &s_events[s_event_count],
+                                           sizeof(s_events) / sizeof(s_events[0]) - s_event_count);
+    s_now_us += FRAME_MS * 1000;
+}
+
+static void touch_hold(uint16_t x, uint16_t y, uint32_t ms)
+{
+    for (uint32_t t = 0; t <= ms; t += FRAME_MS) {
+        touch_feed(1, x, y, 0, 0);
+    }
+}
+
+TEST_CASE("long press fires once after the hold time", "[touch]")
+{
+    touch_reset();
+    touch_hold(200, 300, 400);
+    TEST_ASSERT_EQUAL_UINT32(0, s_event_count);
+    touch_hold(203, 302, 200);
+    TEST_ASSERT_EQUAL_UINT32(1, s_event_count);
+    TEST_ASSERT_EQUAL(KC_TOUCH_GESTURE_LONG_PRESS, s_events[0].type);
+    TEST_ASSERT_EQUAL_INT32(200, s_events[0].x - s_events[0].dx);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(500, s_events[0].duration_ms);
+    touch_hold(203, 302, 1000);
+    TEST_ASSERT_EQUAL_UINT32(1, s_event_count);
+    touch_feed(0, 0, 0, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(1, s_event_count);
+}
+
+TEST_CASE("dragging cancels long press", "[touch]")
+{
+    touch_reset();
+    for (uint16_t i = 0; i < 80; ++i) {
+        touch_feed(1, (uint16_t)(100 + i * 2), 100, 0, 0);
+    }
+    touch_hold(260, 100, 800);
+    touch_feed(0, 0, 0, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, s_event_count);
+}
+
+TEST_CASE("pinch reports begin, updates and end", "[touch]")
+{
+    touch_reset();
+    touch_feed(1, 300, 400, 0, 0);
+    /* Second finger lands 100 px away, then both spread to 200 px. */
+    for (uint16_t d = 50; d <= 100; d += 5) {
+        touch_feed(2, (uint16_t)(400 - d), 400, (uint16_t)(400 + d), 400);
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, s_event_count);
+    TEST_ASSERT_EQUAL(KC_TOUCH_GESTURE_PINCH_BEGIN, s_events[0].type);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.1f, s_events[0].scale);
+    const kc_touch_gesture_t *last = &s_events[s_event_count - 1];
+    TEST_ASSERT_EQUAL(KC_TOUCH_GESTURE_PINCH_UPDATE, last->type);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.0f, last->scale);
+    TEST_ASSERT_EQUAL_INT32(400, last->x);
+
+    size_t before = s_event_count;
+    touch_feed(1, 300, 400, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(before + 1, s_event_count);
+    TEST_ASSERT_EQUAL(KC_TOUCH_GESTURE_PINCH_END, s_events[before].type);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.0f, s_events[before].scale);
+    /* The remaining finger must lift before a new gesture starts. */
+    touch_hold(300, 400, 800);
+    touch_feed(0, 0, 0, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(before + 1, s_event_count);
+}
+
+TEST_CASE("two fingers moving together swipe", "[touch]")
+{
+    touch_reset();
+    for (uint16_t i = 0; i <= 10; ++i) {
+        touch_feed(2, 500, (uint16_t)(600 - i * 8), 600, (uint16_t)(600 - i * 8));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, s_event_count);
+    TEST_ASSERT_EQUAL(KC_TOUCH_GESTURE_SWIPE, s_events[0].type);
+    TEST_ASSERT_EQUAL(KC_TOUCH_GESTURE_DIR_UP, s_events[0].direction);
+    TEST_ASSERT_LESS_OR_EQUAL_INT32(-60, s_events[0].dy);
+    touch_feed(0, 0, 0, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(1, s_event_count);
+}
+
+TEST_CASE("resting two fingers report nothing", "[touch]")
+{
+    touch_reset();
+    for (int i = 0; i < 100; ++i) {
+        touch_feed(2, 100, 100, 200, 102);
+    }
+    touch_feed(0, 0, 0, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, s_event_count);
+    TEST_ASSERT_EQUAL(KC_TOUCH_GESTURE_DIR_LEFT, kc_touch_gesture_direction(-10, 3));
+    TEST_ASSERT_EQUAL(KC_TOUCH_GESTURE_DIR_DOWN, kc_touch_gesture_direction(2, 9));
+}
+
+/*
+ * Simulated touch source: a finger dragged at a constant velocity, scanned every FRAME_MS
+ * with the +-1 px jitter a GT911 shows on a steady swipe.
+ */
+typedef struct {
+    float x0;
+    float y0;
+    float vx; /* px per ms */
+    float vy;
+} sim_drag_t;
+
+static float sim_x(const sim_drag_t *d, float t_ms)
+{
+    return d->x0 + d->vx * t_ms;
+}
+
+static float sim_y(const sim_drag_t *d, float t_ms)
+{
+    return d->y0 + d->vy * t_ms;
+}
+
+static kc_touch_frame_t sim_scan(const sim_drag_t *d, uint32_t i)
+{
+    float t_ms = (float)(i * FRAME_MS);
+    int noise = (int)(i % 3U) - 1;
+    kc_touch_frame_t frame = {
+        .timestamp_us = 1000000 + (int64_t)t_ms * 1000,
+        .count = 1,
+        .points = {{(uint16_t)lroundf(sim_x(d, t_ms) + noise), (uint16_t)lroundf(sim_y(d, t_ms) - noise)}},
+    };
+    return frame;
+}
+
+static void predictor_reset(kc_touch_predictor_t *pred)
+{
+    kc_touch_predictor_config_t cfg = {
+        .horizon_ms = 16,
+        .max_px = 48,
+        .max_x = 719,
+        .max_y = 1279,
+    };
+    kc_touch_predictor_init(pred, &cfg);
+}
+
+TEST_CASE("prediction halves the drag lag", "[touch]")
+{
+    kc_touch_predictor_t pred;
+    predictor_reset(&pred);
+    const sim_drag_t drag = {.x0 = 100, .y0 = 900, .vx = 0.8f, .vy = -0.3f};
+    float raw_err = 0.0f;
+    float pred_err = 0.0f;
+    for (uint32_t i = 0; i < 60; ++i) {
+        kc_touch_frame_t frame = sim_scan(&drag, i);
+        kc_touch_frame_t raw = frame;
+        kc_touch_predictor_apply(&pred, &frame);
+        if (i < 4) {
+            continue;
+        }
+        /* Where the finger is by the time the frame can be on screen. */
+        float t_ms = (float)(i * FRAME_MS + 16);
+        raw_err += hypotf(raw.points[0].x - sim_x(&drag, t_ms), raw.points[0].y - sim_y(&drag, t_ms));
+        pred_err += hypotf(frame.points[0].x - sim_x(&drag, t_ms), frame.points[0].y - sim_y(&drag, t_ms));
+    }
+    TEST_ASSERT_TRUE(pred_err * 2.0f <= raw_err);
+}
+
+TEST_CASE("prediction leaves resting fingers and taps alone", "[touch]")
+{
+    kc_touch_predictor_t pred;
+    predictor_reset(&pred);
+    const sim_drag_t rest = {.x0 = 300, .y0 = 300};
+    for (uint32_t i = 0; i < 50; ++i) {
+        kc_touch_frame_t frame = sim_scan(&rest, i);
+        kc_touch_frame_t raw = frame;
+        kc_touch_predictor_apply(&pred, &frame);
+        TEST_ASSERT_EQUAL_UINT32(raw.points[0].x, frame.points[0].x);
+        TEST_ASSERT_EQUAL_UINT32(raw.points[0].y, frame.points[0].y);
+    }
+
+    /* Release, then a fast drag: the first two frames after touch-down have no history. */
+    kc_touch_frame_t up = {.timestamp_us = 3000000, .count = 0};
+    kc_touch_predictor_apply(&pred, &up);
+    const sim_drag_t fast = {.x0 = 100, .y0 = 600, .vx = 5.0f};
+    for (uint32_t i = 0; i < 2; ++i) {
+        kc_touch_frame_t frame = sim_scan(&fast, i + 300);
+        kc_touch_frame_t raw = frame;
+        kc_touch_predictor_apply(&pred, &frame);
+        TEST_ASSERT_EQUAL_UINT32(raw.points[0].x, frame.points[0].x);
+    }
+}
+
+TEST_CASE("prediction is clamped to max_px and the panel", "[touch]")
+{
+    kc_touch_predictor_t pred;
+    predictor_reset(&pred);
+    const sim_drag_t fast = {.x0 = 100, .y0 = 600, .vx = 5.0f};
+    kc_touch_frame_t frame;
+    kc_touch_frame_t raw;
+    for (uint32_t i = 0; i < 6; ++i) {
+        frame = sim_scan(&fast, i);
+        raw = frame;
+        kc_touch_predictor_apply(&pred, &frame);
+    }
+    TEST_ASSERT_EQUAL_INT32(48, (int32_t)frame.points[0].x - raw.points[0].x);
+
+    const sim_drag_t edge = {.x0 = 600, .y0 = 600, .vx = 2.0f};
+    for (uint32_t i = 0; i < 6; ++i) {
+        frame = sim_scan(&edge, i + 100);
+        kc_touch_predictor_apply(&pred, &frame);
+    }
+    TEST_ASSERT_EQUAL_UINT32(719, frame.points[0].x);
+}
+
+TEST_CASE("latency tracker splits touch-to-photon into stages", "[touch]")
+{
+    kc_touch_latency_t lat;
+    kc_touch_latency_reset(&lat);
+    const int64_t t = 5000000;
+    uint32_t photon = 0;
+
+    kc_touch_latency_on_read(&lat, t, t + 5000);
+    kc_touch_latency_on_event(&lat, t + 5100);
+    /* A frame already rendering when the sample was read cannot show it. */
+    TEST_ASSERT_FALSE(kc_touch_latency_on_frame_shown(&lat, t + 4000, t + 9000, &photon));
+    /* A newer sample read meanwhile does not restart the clock. */
+    kc_touch_latency_on_read(&lat, t + 10000, t + 11000);
+    TEST_ASSERT_TRUE(kc_touch_latency_on_frame_shown(&lat, t + 6000, t + 20000, &photon));
+    TEST_ASSERT_EQUAL_UINT32(20000, photon);
+
+    kc_touch_latency_stats_t stats;
+    kc_touch_latency_get(&lat, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.to_read.count);
+    TEST_ASSERT_EQUAL_UINT32(3000, stats.to_read.avg_us);
+    TEST_ASSERT_EQUAL_UINT32(5000, stats.to_read.max_us);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.to_event.count);
+    TEST_ASSERT_EQUAL_UINT32(5100, stats.to_event.max_us);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.to_photon.count);
+    TEST_ASSERT_EQUAL_UINT32(20000, stats.to_photon.avg_us);
+
+    /* Input that produced no event is not charged to a later frame. */
+    kc_touch_latency_on_read(&lat, t + 30000, t + 31000);
+    TEST_ASSERT_FALSE(kc_touch_latency_on_frame_shown(&lat, t + 32000, t + 40000, &photon));
+    kc_touch_latency_on_event(&lat, t + 41000);
+    kc_touch_latency_get(&lat, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.to_event.count);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.to_photon.count);
+}
+
+/*
+ * Whole-pipeline budget: scans every FRAME_MS land in the ring 2 ms later (I2C), the GUI
+ * ticks every 16 ms, renders for 4 ms and the flush takes 8 ms. A regression in how the
+ * tracker charges waiting samples shows up as a blown budget.
+ */
+TEST_CASE("simulated drag stays inside the touch-to-photon budget", "[touch]")
+{
+    kc_touch_latency_t lat;
+    kc_touch_latency_reset(&lat);
+    int64_t next_scan = 1000000;
+    int64_t oldest_unread = 0;
+    for (int64_t tick = 1000000; tick < 3000000; tick += 16000) {
+        while (next_scan + 2000 <= tick) {
+            if (oldest_unread == 0) {
+                oldest_unread = next_scan;
+            }
+            next_scan += FRAME_MS * 1000;
+        }
+        if (oldest_unread == 0) {
+            continue;
+        }
+        kc_touch_latency_on_read(&lat, oldest_unread, tick);
+        oldest_unread = 0;
+        kc_touch_latency_on_event(&lat, tick + 100);
+        (void)kc_touch_latency_on_frame_shown(&lat, tick + 200, tick + 200 + 4000 + 8000, NULL);
+    }
+    kc_touch_latency_stats_t stats;
+    kc_touch_latency_get(&lat, &stats);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(100, stats.to_photon.count);
+    TEST_ASSERT_EQUAL_UINT32(stats.to_read.count, stats.to_photon.count);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(16000, stats.to_read.max_us);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(30000, stats.to_photon.max_us);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(25000, stats.to_photon.avg_us);
+}
+
+void app_main(void)
+{
+    UNITY_BEGIN();
+    unity_run_menu();
+    UNITY_END();
+}
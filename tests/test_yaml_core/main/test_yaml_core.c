@@ -0,0 +1,450 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_timer.h"
+#include "unity.h"
+
+#include "yaml_core.h"
+
+#define YAML_BENCH_SMALL_BYTES (16U * 1024U)
+#define YAML_BENCH_LARGE_BYTES (64U * 1024U)
+#define YAML_BENCH_ROUNDS 20U
+#define YAML_WIDE_KEYS 200U
+#define YAML_LOOKUP_ROUNDS 200U
+
+extern const char home_yml_start[] asm("_binary_home_yml_start");
+extern const char home_yml_end[] asm("_binary_home_yml_end");
+extern const char bundle_yml_start[] asm("_binary_bundle_yml_start");
+extern const char bundle_yml_end[] asm("_binary_bundle_yml_end");
+extern const uint8_t bundle_blob_start[] asm("_binary_bundle_ymlb_start");
+extern const uint8_t bundle_blob_end[] asm("_binary_bundle_ymlb_end");
+
+static size_t yaml_test_count_nodes(const yml_node_t *node)
+{
+    size_t total = 1U;
+    for (size_t i = 0; i < yml_node_child_count(node); ++i) {
+        total += yaml_test_count_nodes(yml_node_child_at(node, i));
+    }
+    return total;
+}
+
+/* Builds a schema-shaped document of roughly @p target bytes with unique screen keys. */
+static char *yaml_test_make_bundle(size_t target, size_t *out_len)
+{
+    char *buffer = malloc(target + 512U);
+    TEST_ASSERT_NOT_NULL(buffer);
+    size_t len = (size_t)snprintf(buffer, 512U, "screens:\n");
+    for (uint32_t i = 0; len < target; ++i) {
+        len += (size_t)snprintf(buffer + len, 512U,
+                                "  screen_%" PRIu32 ":\n"
+                                "    widgets:\n"
+                                "      - type: label\n"
+                                "        text: \"Reading {{sensor.value_%" PRIu32 "}}\" # live\n"
+                                "        style: body\n"
+                                "      - type: button\n"
+                                "        text: 'Open'\n"
+                                "        events:\n"
+                                "          on_click: goto(screen_%" PRIu32 ")\n",
+                                i, i, i + 1U);
+    }
+    *out_len = len;
+    return buffer;
+}
+
+static int64_t yaml_test_time_parse(const char *data, size_t len)
+{
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < YAML_BENCH_ROUNDS; ++i) {
+        yml_node_t *root = NULL;
+        TEST_ASSERT_EQUAL(ESP_OK, yaml_core_parse_buffer(data, len, &root));
+        yml_node_free(root);
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+    return elapsed > 0 ? elapsed : 1;
+}
+
+static void yaml_test_parse_stats(const char *data, size_t len, yml_document_stats_t *out_stats)
+{
+    yml_document_t *doc = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_document_parse(data, len, &doc, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, yml_document_get_stats(doc, out_stats));
+    yml_document_free(doc);
+}
+
+static size_t yaml_test_home_len(void)
+{
+    size_t len = (size_t)(home_yml_end - home_yml_start);
+    /* EMBED_TXTFILES appends a terminator */
+    if (len > 0U && home_yml_start[len - 1U] == '\0') {
+        len--;
+    }
+    return len;
+}
+
+TEST_CASE("yaml_core parses home schema", "[yaml_core]")
+{
+    size_t len = yaml_test_home_len();
+    yml_node_t *root = NULL;
+    int64_t start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_parse_buffer(home_yml_start, len, &root));
+    int64_t elapsed = esp_timer_get_time() - start;
+    TEST_ASSERT_NOT_NULL(yml_node_get_child(root, "screens"));
+    size_t nodes = yaml_test_count_nodes(root);
+    start = esp_timer_get_time();
+    yml_node_free(root);
+    int64_t free_us = esp_timer_get_time() - start;
+    printf("yaml bench: home.yml %u bytes, %u nodes, parse %" PRId64 " us, free %" PRId64 " us\n",
+           (unsigned)len, (unsigned)nodes, elapsed, free_us);
+}
+
+TEST_CASE("yaml_core scalars, comments and line endings", "[yaml_core]")
+{
+    const char *doc = "title: \"Home: main\" # trailing\r\n"
+                      "list:\r\n"
+                      "  - 'one'\r\n"
+                      "  - key: value\r\n"
+                      "    other: 2\r\n"
+                      "\r\n"
+                      "# comment only\n"
+                      "empty:\n";
+    yml_node_t *root = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_parse_string(doc, &root));
+    TEST_ASSERT_EQUAL_STRING("Home: main", yml_node_get_scalar(yml_node_get_child(root, "title")));
+    const yml_node_t *list = yml_node_get_child(root, "list");
+    TEST_ASSERT_EQUAL(YML_NODE_SEQUENCE, yml_node_get_type(list));
+    TEST_ASSERT_EQUAL(2, yml_node_child_count(list));
+    TEST_ASSERT_EQUAL_STRING("one", yml_node_get_scalar(yml_node_child_at(list, 0)));
+    const yml_node_t *entry = yml_node_child_at(list, 1);
+    TEST_ASSERT_EQUAL_STRING("value", yml_node_get_scalar(yml_node_get_child(entry, "key")));
+    TEST_ASSERT_EQUAL_STRING("2", yml_node_get_scalar(yml_node_get_child(entry, "other")));
+    TEST_ASSERT_NOT_NULL(yml_node_get_child(root, "empty"));
+    yml_node_free(root);
+}
+
+TEST_CASE("yaml_core reports error line and offset", "[yaml_core]")
+{
+    const char *doc = "screens:\n"
+                      "  home:\n"
+                      "    title: Home\n"
+                      "    - stray\n";
+    yml_node_t *root = NULL;
+    yml_parse_error_t error;
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, yaml_core_parse_buffer_ex(doc, strlen(doc), &root, &error));
+    TEST_ASSERT_NULL(root);
+    TEST_ASSERT_EQUAL(4, error.line);
+    TEST_ASSERT_EQUAL((int)(strstr(doc, "    - stray") - doc), (int)error.offset);
+    TEST_ASSERT_NOT_NULL(error.message);
+
+    const char *crlf = "a: 1\r\nb:\r\n\r\n  - x\r\n  y: 2\r\n";
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, yaml_core_parse_buffer_ex(crlf, strlen(crlf), &root, &error));
+    TEST_ASSERT_EQUAL(5, error.line);
+    TEST_ASSERT_EQUAL((int)(strstr(crlf, "  y: 2") - crlf), (int)error.offset);
+}
+
+TEST_CASE("yaml_core document arena interns strings", "[yaml_core]")
+{
+    const char *doc_text = "widgets:\n"
+                           "  - type: label\n"
+                           "    style: body\n"
+                           "  - type: label\n"
+                           "    style: body\n"
+                           "    text: \"A longer scalar that is copied rather than interned\"\n";
+    yml_document_t *doc = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_document_parse(doc_text, strlen(doc_text), &doc, NULL));
+    yml_node_t *root = yml_document_root(doc);
+    TEST_ASSERT_EQUAL_PTR(doc, yml_node_get_document(root));
+
+    const yml_node_t *widgets = yml_node_get_child(root, "widgets");
+    const yml_node_t *first = yml_node_child_at(widgets, 0);
+    const yml_node_t *second = yml_node_child_at(widgets, 1);
+    TEST_ASSERT_EQUAL_PTR(doc, yml_node_get_document(second));
+    TEST_ASSERT_EQUAL_PTR(yml_node_get_key(yml_node_get_child(first, "type")),
+                          yml_node_get_key(yml_node_get_child(second, "type")));
+    TEST_ASSERT_EQUAL_PTR(yml_node_get_scalar(yml_node_get_child(first, "style")),
+                          yml_node_get_scalar(yml_node_get_child(second, "style")));
+
+    yml_document_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, yml_document_get_stats(doc, &stats));
+    TEST_ASSERT_EQUAL(9, stats.nodes);
+    TEST_ASSERT_EQUAL(1, stats.blocks);
+    TEST_ASSERT_EQUAL(6, stats.strings_interned);
+    TEST_ASSERT_EQUAL(4, stats.intern_hits);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.bytes_reserved, stats.bytes_used);
+    yml_document_free(doc);
+
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_document_parse(home_yml_start, yaml_test_home_len(), &doc, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, yml_document_get_stats(doc, &stats));
+    printf("yaml arena: home.yml %u nodes in %u blocks, %u/%u bytes, %u strings, %u dedup hits\n",
+           (unsigned)stats.nodes, (unsigned)stats.blocks, (unsigned)stats.bytes_used,
+           (unsigned)stats.bytes_reserved, (unsigned)stats.strings_interned, (unsigned)stats.intern_hits);
+    TEST_ASSERT_LESS_THAN(16, stats.blocks);
+    TEST_ASSERT_GREATER_THAN(stats.strings_interned, stats.intern_hits);
+    yml_document_free(doc);
+}
+
+/* One mapping with YAML_WIDE_KEYS entries plus a widget-sized mapping. */
+static char *yaml_test_make_wide(size_t *out_len)
+{
+    size_t cap = YAML_WIDE_KEYS * 32U + 256U;
+    char *buffer = malloc(cap);
+    TEST_ASSERT_NOT_NULL(buffer);
+    size_t len = (size_t)snprintf(buffer, cap, "wide:\n");
+    for (uint32_t i = 0; i < YAML_WIDE_KEYS; ++i) {
+        len += (size_t)snprintf(buffer + len, cap - len, "  key_%" PRIu32 ": %" PRIu32 "\n", i, i);
+    }
+    len += (size_t)snprintf(buffer + len, cap - len, "  key_7: duplicate\n"
+                                                     "widget:\n  type: label\n  id: status\n  text: Ready\n  style: body\n");
+    *out_len = len;
+    return buffer;
+}
+
+TEST_CASE("yaml_core child lookup and index", "[yaml_core]")
+{
+    size_t len = 0U;
+    char *text = yaml_test_make_wide(&len);
+    yml_document_t *doc = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_document_parse(text, len, &doc, NULL));
+    const yml_node_t *wide = yml_node_get_child(yml_document_root(doc), "wide");
+    TEST_ASSERT_EQUAL(YAML_WIDE_KEYS + 1U, yml_node_child_count(wide));
+
+    char key[16];
+    char value[16];
+    for (uint32_t i = 0; i < YAML_WIDE_KEYS; ++i) {
+        snprintf(key, sizeof(key), "key_%" PRIu32, i);
+        snprintf(value, sizeof(value), "%" PRIu32, i);
+        TEST_ASSERT_EQUAL_STRING(value, yml_node_get_scalar(yml_node_get_child(wide, key)));
+        TEST_ASSERT_EQUAL_STRING(key, yml_node_get_key(yml_node_child_at(wide, i)));
+    }
+    TEST_ASSERT_NULL(yml_node_get_child(wide, "key_200"));
+    TEST_ASSERT_NULL(yml_node_child_at(wide, YAML_WIDE_KEYS + 1U));
+    /* Duplicate keys resolve to the first occurrence, as before */
+    TEST_ASSERT_EQUAL_STRING("7", yml_node_get_scalar(yml_node_get_child(wide, "key_7")));
+    TEST_ASSERT_EQUAL_STRING("duplicate", yml_node_get_scalar(yml_node_child_at(wide, YAML_WIDE_KEYS)));
+
+    const yml_node_t *widget = yml_node_get_child(yml_document_root(doc), "widget");
+    TEST_ASSERT_EQUAL_STRING("Ready", yml_node_get_scalar(yml_node_get_child(widget, "text")));
+    TEST_ASSERT_NULL(yml_node_get_child(widget, "missing"));
+
+    yml_document_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, yml_document_get_stats(doc, &stats));
+    TEST_ASSERT_EQUAL(1, stats.indexed_mappings);
+    yml_document_free(doc);
+    free(text);
+}
+
+TEST_CASE("yaml_core child lookup benchmark", "[yaml_core][perf]")
+{
+    size_t len = 0U;
+    char *text = yaml_test_make_wide(&len);
+    yml_document_t *doc = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_document_parse(text, len, &doc, NULL));
+    const yml_node_t *wide = yml_node_get_child(yml_document_root(doc), "wide");
+    const yml_node_t *widget = yml_node_get_child(yml_document_root(doc), "widget");
+    static const char *const widget_keys[] = {"type", "id", "text", "style", "visible_if", "on_click"};
+    char key[16];
+
+    int64_t start = esp_timer_get_time();
+    size_t found = 0U;
+    for (uint32_t round = 0; round < YAML_LOOKUP_ROUNDS; ++round) {
+        for (uint32_t i = 0; i < YAML_WIDE_KEYS; ++i) {
+            snprintf(key, sizeof(key), "key_%" PRIu32, i);
+            found += yml_node_get_child(wide, key) ? 1U : 0U;
+            found += yml_node_child_at(wide, i) ? 1U : 0U;
+        }
+    }
+    int64_t wide_us = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL(YAML_LOOKUP_ROUNDS * YAML_WIDE_KEYS * 2U, found);
+
+    start = esp_timer_get_time();
+    found = 0U;
+    for (uint32_t round = 0; round < YAML_LOOKUP_ROUNDS * 50U; ++round) {
+        for (size_t i = 0; i < sizeof(widget_keys) / sizeof(widget_keys[0]); ++i) {
+            found += yml_node_get_child(widget, widget_keys[i]) ? 1U : 0U;
+        }
+    }
+    int64_t widget_us = esp_timer_get_time() - start;
+    TEST_ASSERT_EQUAL(YAML_LOOKUP_ROUNDS * 50U * 4U, found);
+
+    printf("yaml lookup: %u-key mapping %" PRId64 " us, widget mapping %" PRId64 " us\n",
+           (unsigned)YAML_WIDE_KEYS, wide_us, widget_us);
+    yml_document_free(doc);
+    free(text);
+}
+
+static void yaml_test_assert_same_tree(const yml_node_t *expected, const yml_node_t *actual)
+{
+    TEST_ASSERT_EQUAL(yml_node_get_type(expected), yml_node_get_type(actual));
+    const char *key = yml_node_get_key(expected);
+    if (key) {
+        TEST_ASSERT_EQUAL_STRING(key, yml_node_get_key(actual));
+    } else {
+        TEST_ASSERT_NULL(yml_node_get_key(actual));
+    }
+    if (yml_node_get_type(expected) == YML_NODE_SCALAR) {
+        TEST_ASSERT_EQUAL_STRING(yml_node_get_scalar(expected), yml_node_get_scalar(actual));
+    }
+    size_t count = yml_node_child_count(expected);
+    TEST_ASSERT_EQUAL(count, yml_node_child_count(actual));
+    const yml_node_t *child = yml_node_child_at(actual, 0);
+    for (size_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL_PTR(yml_node_child_at(actual, i), child);
+        const yml_node_t *expected_child = yml_node_child_at(expected, i);
+        yaml_test_assert_same_tree(expected_child, child);
+        if (yml_node_get_type(expected) == YML_NODE_MAPPING) {
+            /* First-match semantics must agree for keyed lookups too */
+            const char *child_key = yml_node_get_key(expected_child);
+            const yml_node_t *by_key = yml_node_get_child(actual, child_key);
+            TEST_ASSERT_NOT_NULL(by_key);
+            TEST_ASSERT_EQUAL_STRING(child_key, yml_node_get_key(by_key));
+            TEST_ASSERT_EQUAL(yml_node_child_count(yml_node_get_child(expected, child_key)), yml_node_child_count(by_key));
+        }
+        child = yml_node_next(child);
+    }
+    TEST_ASSERT_NULL(child);
+    TEST_ASSERT_NULL(yml_node_get_child(actual, "no_such_key"));
+}
+
+static uint8_t *yaml_test_copy_blob(size_t *out_len)
+{
+    /* Embedded data carries no alignment guarantee; heap copies are 4-byte aligned */
+    size_t len = (size_t)(bundle_blob_end - bundle_blob_start);
+    uint8_t *copy = malloc(len);
+    TEST_ASSERT_NOT_NULL(copy);
+    memcpy(copy, bundle_blob_start, len);
+    *out_len = len;
+    return copy;
+}
+
+TEST_CASE("yaml_core binary bundle matches parsed text", "[yaml_core]")
+{
+    size_t text_len = (size_t)(bundle_yml_end - bundle_yml_start) - 1U;
+    yml_node_t *parsed = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_parse_buffer(bundle_yml_start, text_len, &parsed));
+
+    size_t blob_len = 0U;
+    uint8_t *blob = yaml_test_copy_blob(&blob_len);
+    TEST_ASSERT_TRUE(yaml_core_is_blob(blob, blob_len));
+    TEST_ASSERT_FALSE(yaml_core_is_blob(bundle_yml_start, text_len));
+    yml_node_t *mapped = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_blob_view(blob, blob_len, &mapped));
+    TEST_ASSERT_NULL(yml_node_get_document(mapped));
+    yaml_test_assert_same_tree(parsed, mapped);
+
+    /* Roots of views own nothing */
+    yml_node_free(mapped);
+    yml_node_free(parsed);
+    free(blob);
+}
+
+TEST_CASE("yaml_core rejects corrupt binary bundles", "[yaml_core]")
+{
+    size_t blob_len = 0U;
+    uint8_t *blob = yaml_test_copy_blob(&blob_len);
+    yml_node_t *root = NULL;
+
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, yaml_core_blob_view(blob, blob_len / 2U, &root));
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, yaml_core_blob_view(blob + 4, blob_len - 4U, &root));
+
+    blob[4] ^= 0x7FU; /* version */
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, yaml_core_blob_view(blob, blob_len, &root));
+    blob[4] ^= 0x7FU;
+
+    uint32_t node_offset;
+    memcpy(&node_offset, blob + 12, sizeof(node_offset));
+    blob[node_offset + 8U] ^= 0x40U; /* root's first-child offset */
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, yaml_core_blob_view(blob, blob_len, &root));
+    blob[node_offset + 8U] ^= 0x40U;
+
+    blob[blob_len - 1U] = 'x'; /* unterminated string table */
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, yaml_core_blob_view(blob, blob_len, &root));
+    blob[blob_len - 1U] = '\0';
+
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_blob_view(blob, blob_len, &root));
+    free(blob);
+}
+
+/* A view must not copy: every key and scalar it hands out lives inside the blob. */
+static size_t yaml_test_assert_view_in_blob(const yml_node_t *node, const uint8_t *blob, size_t blob_len)
+{
+    const char *strings[] = {yml_node_get_key(node), yml_node_get_scalar(node)};
+    for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); ++i) {
+        if (strings[i]) {
+            TEST_ASSERT_TRUE((const uint8_t *)strings[i] >= blob && (const uint8_t *)strings[i] < blob + blob_len);
+        }
+    }
+    size_t total = 1U;
+    for (const yml_node_t *child = yml_node_child_at(node, 0); child; child = yml_node_next(child)) {
+        total += yaml_test_assert_view_in_blob(child, blob, blob_len);
+    }
+    return total;
+}
+
+TEST_CASE("yaml_core binary bundle load benchmark", "[yaml_core][perf]")
+{
+    size_t text_len = (size_t)(bundle_yml_end - bundle_yml_start) - 1U;
+    size_t blob_len = 0U;
+    uint8_t *blob = yaml_test_copy_blob(&blob_len);
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < YAML_BENCH_ROUNDS; ++i) {
+        yml_node_t *root = NULL;
+        TEST_ASSERT_EQUAL(ESP_OK, yaml_core_parse_buffer(bundle_yml_start, text_len, &root));
+        yml_node_free(root);
+    }
+    int64_t parse_us = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    yml_node_t *view = NULL;
+    for (uint32_t i = 0; i < YAML_BENCH_ROUNDS; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, yaml_core_blob_view(blob, blob_len, &view));
+    }
+    int64_t view_us = esp_timer_get_time() - start;
+
+    printf("yaml bundle: text %u bytes parse %" PRId64 " us, blob %u bytes view %" PRId64 " us (per load)\n",
+           (unsigned)text_len, parse_us / YAML_BENCH_ROUNDS, (unsigned)blob_len, view_us / YAML_BENCH_ROUNDS);
+    /* Timings are informational only; what makes the view cheap is that it builds no tree
+     * and copies no strings, which is checked instead. */
+    TEST_ASSERT_NULL(yml_node_get_document(view));
+    yml_node_t *parsed = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_parse_buffer(bundle_yml_start, text_len, &parsed));
+    TEST_ASSERT_EQUAL(yaml_test_count_nodes(parsed), yaml_test_assert_view_in_blob(view, blob, blob_len));
+    yml_node_free(parsed);
+    free(blob);
+}
+
+TEST_CASE("yaml_core parse time scales linearly", "[yaml_core][perf]")
+{
+    size_t small_len = 0U;
+    size_t large_len = 0U;
+    char *small = yaml_test_make_bundle(YAML_BENCH_SMALL_BYTES, &small_len);
+    char *large = yaml_test_make_bundle(YAML_BENCH_LARGE_BYTES, &large_len);
+
+    /* Warm caches and the allocator before timing */
+    (void)yaml_test_time_parse(small, small_len);
+    int64_t small_us = yaml_test_time_parse(small, small_len);
+    int64_t large_us = yaml_test_time_parse(large, large_len);
+
+    printf("yaml bench: %u bytes %" PRId64 " us, %u bytes %" PRId64 " us (per parse)\n",
+           (unsigned)small_len, small_us / YAML_BENCH_ROUNDS,
+           (unsigned)large_len, large_us / YAML_BENCH_ROUNDS);
+    /* Timings are informational only. The parser copies each key and scalar once, so its
+     * node count and arena use per input byte must not grow with the document. */
+    yml_document_stats_t small_stats;
+    yml_document_stats_t large_stats;
+    yaml_test_parse_stats(small, small_len, &small_stats);
+    yaml_test_parse_stats(large, large_len, &large_stats);
+    TEST_ASSERT_LESS_OR_EQUAL(small_stats.nodes * large_len / small_len + 16U, large_stats.nodes);
+    TEST_ASSERT_LESS_OR_EQUAL(small_stats.bytes_used * large_len / small_len + 512U, large_stats.bytes_used);
+
+    free(small);
+    free(large);
+}
+
+void app_main(void)
+{
+    UNITY_BEGIN();
+    unity_run_menu();
+    UNITY_END();
+}
@@ -0,0 +1,188 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_timer.h"
+#include "unity.h"
+
+#include "yamui_expr.h"
+
+#define EXPR_BENCH_ITERATIONS 20000U
+
+typedef struct {
+    const char *key;
+    const char *value;
+} expr_test_symbol_t;
+
+static const expr_test_symbol_t s_symbols[] = {
+    {"wifi.status", "connected"},
+    {"wifi.enabled", "true"},
+    {"sensor.ph", "7.25"},
+    {"sensor.ec", "1.4"},
+    {"ui.theme", "dark"},
+};
+
+static size_t s_resolve_count;
+
+static bool expr_test_resolver(const char *identifier, void *ctx, yui_expr_value_t *out)
+{
+    (void)ctx;
+    s_resolve_count++;
+    for (size_t i = 0; i < sizeof(s_symbols) / sizeof(s_symbols[0]); ++i) {
+        if (strcmp(s_symbols[i].key, identifier) != 0) {
+            continue;
+        }
+        if (strcmp(s_symbols[i].value, "true") == 0) {
+            yui_expr_value_set_bool(out, true);
+        } else if (strcmp(identifier, "sensor.ph") == 0 || strcmp(identifier, "sensor.ec") == 0) {
+            yui_expr_value_set_number(out, strtod(s_symbols[i].value, NULL));
+        } else {
+            yui_expr_value_set_string_ref(out, s_symbols[i].value);
+        }
+        return true;
+    }
+    return false;
+}
+
+static void expect_same_result(const char *expression)
+{
+    char interpreted[64];
+    char compiled[64];
+    esp_err_t eval_err = yui_expr_eval_to_string(expression, expr_test_resolver, NULL, interpreted, sizeof(interpreted));
+
+    yui_expr_program_t *program = NULL;
+    esp_err_t compile_err = yui_expr_compile(expression, &program);
+    TEST_ASSERT_EQUAL(ESP_OK, compile_err);
+    esp_err_t run_err = yui_expr_run_to_string(program, expr_test_resolver, NULL, compiled, sizeof(compiled));
+    TEST_ASSERT_EQUAL(eval_err, run_err);
+    TEST_ASSERT_EQUAL_STRING(interpreted, compiled);
+    yui_expr_program_free(program);
+}
+
+TEST_CASE("compiled expressions evaluate operators", "[yamui][expr]")
+{
+    char out[64];
+    yui_expr_program_t *program = NULL;
+
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_compile("(sensor.ph - 7) * 10 > 2 ? 'high' : 'ok'", &program));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_run_to_string(program, expr_test_resolver, NULL, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("high", out);
+    yui_expr_program_free(program);
+
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_compile("wifi.ssid ?? 'Unknown'", &program));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_run_to_string(program, expr_test_resolver, NULL, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("Unknown", out);
+    yui_expr_program_free(program);
+
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_compile("'pH ' + sensor.ph", &program));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_run_to_string(program, expr_test_resolver, NULL, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("pH 7.25", out);
+    yui_expr_program_free(program);
+
+    expect_same_result("wifi.enabled && wifi.status != 'error'");
+    expect_same_result("!(ui.theme == 'dark') || sensor.ec >= 1.4");
+    expect_same_result("-sensor.ph + 1");
+    expect_same_result("sensor.ec / 0");
+}
+
+TEST_CASE("one-shot eval returns string results it owns", "[yamui][expr]")
+{
+    yui_expr_value_t value = {0};
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_eval("1 > 0 ? 'yes' : 'no'", expr_test_resolver, NULL, &value));
+    TEST_ASSERT_EQUAL(YUI_EXPR_VALUE_STRING, value.type);
+    TEST_ASSERT_EQUAL_STRING("yes", value.string);
+    yui_expr_value_reset(&value);
+
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_eval("wifi.ssid ?? 'Unknown'", expr_test_resolver, NULL, &value));
+    TEST_ASSERT_EQUAL(YUI_EXPR_VALUE_STRING, value.type);
+    TEST_ASSERT_EQUAL_STRING("Unknown", value.string);
+    yui_expr_value_reset(&value);
+
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_eval("wifi.status", expr_test_resolver, NULL, &value));
+    TEST_ASSERT_EQUAL_STRING("connected", value.string);
+    yui_expr_value_reset(&value);
+}
+
+TEST_CASE("compiled expressions reject malformed input", "[yamui][expr]")
+{
+    yui_expr_program_t *program = NULL;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, yui_expr_compile("1 +", &program));
+    TEST_ASSERT_NULL(program);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, yui_expr_compile("((wifi.status)", &program));
+    TEST_ASSERT_NULL(program);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, yui_expr_compile("a & b", &program));
+    TEST_ASSERT_NULL(program);
+}
+
+static void count_identifier_cb(const char *identifier, void *ctx)
+{
+    (void)identifier;
+    (*(size_t *)ctx)++;
+}
+
+TEST_CASE("compiled expressions dedupe identifiers", "[yamui][expr]")
+{
+    yui_expr_program_t *program = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_compile("sensor.ph > 7 && sensor.ph < 8 || wifi.enabled", &program));
+    size_t count = 0U;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_program_collect_identifiers(program, count_identifier_cb, &count));
+    TEST_ASSERT_EQUAL_UINT32(2, count);
+    TEST_ASSERT_EQUAL_STRING("sensor.ph > 7 && sensor.ph < 8 || wifi.enabled", yui_expr_program_source(program));
+    yui_expr_program_free(program);
+}
+
+TEST_CASE("compiled expressions benchmark", "[yamui][expr][perf]")
+{
+    static const char *expression = "wifi.enabled && wifi.status == 'connected' && (sensor.ph - 7) * 10 > 1 ? 'online' : 'offline'";
+    yui_expr_value_t value = {0};
+
+    s_resolve_count = 0U;
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < EXPR_BENCH_ITERATIONS; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, yui_expr_eval(expression, expr_test_resolver, NULL, &value));
+        yui_expr_value_reset(&value);
+    }
+    int64_t interpreted_us = esp_timer_get_time() - start;
+    size_t interpreted_resolves = s_resolve_count;
+
+    yui_expr_program_t *program = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_compile(expression, &program));
+    s_resolve_count = 0U;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < EXPR_BENCH_ITERATIONS; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, yui_expr_run(program, expr_test_resolver, NULL, &value));
+        yui_expr_value_reset(&value);
+    }
+    int64_t compiled_us = esp_timer_get_time() - start;
+    size_t compiled_resolves = s_resolve_count;
+
+    if (interpreted_us <= 0) {
+        interpreted_us = 1;
+    }
+    if (compiled_us <= 0) {
+        compiled_us = 1;
+    }
+    printf("expr bench: eval %" PRId64 " evals/s, compiled run %" PRId64 " evals/s (%u iterations)\n",
+           (int64_t)EXPR_BENCH_ITERATIONS * 1000000LL / interpreted_us,
+           (int64_t)EXPR_BENCH_ITERATIONS * 1000000LL / compiled_us,
+           (unsigned)EXPR_BENCH_ITERATIONS);
+
+    /* Timings are informational only. A run must reach the same answer without looking up
+     * more symbols than the interpreter does. */
+    TEST_ASSERT_LESS_OR_EQUAL(interpreted_resolves, compiled_resolves);
+    char interpreted[16];
+    char compiled[16];
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_eval_to_string(expression, expr_test_resolver, NULL, interpreted, sizeof(interpreted)));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_expr_run_to_string(program, expr_test_resolver, NULL, compiled, sizeof(compiled)));
+    TEST_ASSERT_EQUAL_STRING("online", interpreted);
+    TEST_ASSERT_EQUAL_STRING(interpreted, compiled);
+    yui_expr_program_free(program);
+}
+
+void app_main(void)
+{
+    UNITY_BEGIN();
+    unity_run_menu();
+    UNITY_END();
+}
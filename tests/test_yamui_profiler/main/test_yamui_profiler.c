@@ -0,0 +1,50 @@
+#include <stdint.h>
+
+#include "unity.h"
+
+#include "yamui_profiler.h"
+#include "yamui_state.h"
+
+TEST_CASE("profiler histogram percentiles", "[yamui][perf]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+    yamui_prof_reset();
+
+    yamui_prof_set_enabled(false);
+    yamui_prof_record(YAMUI_PROF_FRAME, 100U);
+    yamui_prof_summary_t summary;
+    yamui_prof_snapshot(YAMUI_PROF_FRAME, &summary);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.count);
+
+    yamui_prof_set_enabled(true);
+    for (uint32_t i = 1; i <= 100U; ++i) {
+        yamui_prof_record(YAMUI_PROF_FRAME, i * 100U);
+    }
+    yamui_prof_snapshot(YAMUI_PROF_FRAME, &summary);
+    TEST_ASSERT_EQUAL_UINT32(100, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(505000, summary.total_us);
+    TEST_ASSERT_EQUAL_UINT32(10000, summary.max_us);
+    /* 5000 us falls in the (4096, 8192] bucket; p90 and above are clamped to the max. */
+    TEST_ASSERT_EQUAL_UINT32(8192, summary.p50_us);
+    TEST_ASSERT_EQUAL_UINT32(10000, summary.p90_us);
+    TEST_ASSERT_EQUAL_UINT32(10000, summary.p99_us);
+
+    yamui_prof_publish();
+    TEST_ASSERT_EQUAL_INT32(100, yui_state_get_int("perf.frame.count", -1));
+    TEST_ASSERT_EQUAL_INT32(10000, yui_state_get_int("perf.frame.max", -1));
+    TEST_ASSERT_EQUAL_INT32(-1, yui_state_get_int("perf.flush.count", -1));
+
+    yamui_prof_reset();
+    yamui_prof_snapshot(YAMUI_PROF_FRAME, &summary);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.count);
+    yamui_prof_set_enabled(false);
+    yui_state_clear();
+}
+
+void app_main(void)
+{
+    UNITY_BEGIN();
+    unity_run_menu();
+    UNITY_END();
+}
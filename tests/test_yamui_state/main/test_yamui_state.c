@@ -0,0 +1,451 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_timer.h"
+#include "unity.h"
+
+#include "yaml_core.h"
+#include "yaml_ui.h"
+#include "yamui_collection.h"
+#include "yamui_state.h"
+
+#define STATE_BENCH_KEYS 400U
+#define STATE_BENCH_ITERATIONS 50000U
+#define STATE_BATCH_KEYS 5U
+#define STATE_BATCH_ROUNDS 1000U
+
+static size_t s_notify_count;
+
+static void state_test_watch_cb(const char *key, const char *value, void *user_ctx)
+{
+    (void)key;
+    (void)value;
+    (void)user_ctx;
+    s_notify_count++;
+}
+
+TEST_CASE("state store set/get round trip", "[yamui][state]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+
+    TEST_ASSERT_EQUAL_STRING("fallback", yui_state_get("wifi.ssid", "fallback"));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("wifi.ssid", "greenhouse"));
+    TEST_ASSERT_EQUAL_STRING("greenhouse", yui_state_get("wifi.ssid", NULL));
+    TEST_ASSERT_EQUAL_STRING("greenhouse", yui_state_get("state.wifi.ssid", NULL));
+
+    char long_value[YUI_STATE_VALUE_MAX * 2];
+    memset(long_value, 'x', sizeof(long_value) - 1U);
+    long_value[sizeof(long_value) - 1U] = '\0';
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("wifi.ssid", long_value));
+    TEST_ASSERT_EQUAL_STRING(long_value, yui_state_get("wifi.ssid", NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("wifi.ssid", "short"));
+    TEST_ASSERT_EQUAL_STRING("short", yui_state_get("wifi.ssid", NULL));
+
+    yui_state_clear();
+    TEST_ASSERT_NULL(yui_state_get("wifi.ssid", NULL));
+}
+
+TEST_CASE("state store key handles", "[yamui][state]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+
+    yui_state_key_t key = YUI_STATE_KEY_INVALID;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_key_resolve("state.sensor.ph", &key));
+    TEST_ASSERT_NOT_EQUAL(YUI_STATE_KEY_INVALID, key);
+    TEST_ASSERT_EQUAL_STRING("sensor.ph", yui_state_key_name(key));
+    TEST_ASSERT_NULL(yui_state_get("sensor.ph", NULL));
+
+    yui_state_key_t again = YUI_STATE_KEY_INVALID;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_key_resolve("sensor.ph", &again));
+    TEST_ASSERT_EQUAL_UINT32(key, again);
+
+    yui_state_watch_handle_t watch = 0U;
+    s_notify_count = 0U;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch("sensor.ph", state_test_watch_cb, NULL, &watch));
+    yui_state_reset_stats();
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set_by_key(key, "7.10"));
+    yui_state_stats_t stats;
+    yui_state_get_stats(&stats);
+    /* Handing the notify arena back must not take the lock a second time. */
+    TEST_ASSERT_EQUAL_UINT32(1, stats.lock_acquisitions);
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set_by_key(key, "7.10"));
+    TEST_ASSERT_EQUAL_UINT32(1, s_notify_count);
+    TEST_ASSERT_EQUAL_STRING("7.10", yui_state_get("sensor.ph", NULL));
+    TEST_ASSERT_EQUAL_STRING("7.10", yui_state_get_by_key(key, NULL));
+    yui_state_unwatch(watch);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, yui_state_set_by_key(YUI_STATE_KEY_INVALID, "1"));
+    TEST_ASSERT_EQUAL_STRING("none", yui_state_get_by_key(YUI_STATE_KEY_INVALID, "none"));
+}
+
+TEST_CASE("state store keeps typed values", "[yamui][state]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+
+    yui_state_value_t value;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set_int("sensor.level", 42));
+    TEST_ASSERT_TRUE(yui_state_get_value("sensor.level", &value));
+    TEST_ASSERT_EQUAL(YUI_STATE_VALUE_INT, value.type);
+    TEST_ASSERT_EQUAL_INT32(42, value.int_value);
+    TEST_ASSERT_EQUAL_STRING("42", yui_state_get("sensor.level", NULL));
+    TEST_ASSERT_EQUAL_INT32(42, yui_state_get_int("sensor.level", 0));
+
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set_float("sensor.ph", 7.25));
+    TEST_ASSERT_TRUE(yui_state_get_value("sensor.ph", &value));
+    TEST_ASSERT_EQUAL(YUI_STATE_VALUE_FLOAT, value.type);
+    TEST_ASSERT_EQUAL_STRING("7.25", yui_state_get("sensor.ph", NULL));
+    TEST_ASSERT_EQUAL_INT32(7, yui_state_get_int("sensor.ph", 0));
+    TEST_ASSERT_TRUE(yui_state_get_float("sensor.ph", 0.0) == 7.25);
+
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set_bool("wifi.enabled", true));
+    TEST_ASSERT_EQUAL_STRING("true", yui_state_get("wifi.enabled", NULL));
+    TEST_ASSERT_TRUE(yui_state_get_bool("wifi.enabled", false));
+
+    /* Text state still parses on read, and matching text/typed values are not changes. */
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.count", "5"));
+    TEST_ASSERT_TRUE(yui_state_get_value("sensor.count", &value));
+    TEST_ASSERT_EQUAL(YUI_STATE_VALUE_STRING, value.type);
+    TEST_ASSERT_TRUE(yui_state_get_float("sensor.count", 0.0) == 5.0);
+    yui_state_watch_handle_t watch = 0U;
+    s_notify_count = 0U;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch("sensor.count", state_test_watch_cb, NULL, &watch));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set_int("sensor.count", 5));
+    TEST_ASSERT_EQUAL_UINT32(0, s_notify_count);
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set_int("sensor.count", 6));
+    TEST_ASSERT_EQUAL_UINT32(1, s_notify_count);
+    TEST_ASSERT_EQUAL_STRING("6", yui_state_get("sensor.count", NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.count", "six"));
+    TEST_ASSERT_EQUAL_STRING("six", yui_state_get("sensor.count", NULL));
+    TEST_ASSERT_EQUAL_INT32(-1, yui_state_get_int("sensor.missing", -1));
+    yui_state_unwatch(watch);
+}
+
+static size_t s_wildcard_count;
+
+static void state_test_wildcard_cb(const char *key, const char *value, void *user_ctx)
+{
+    (void)key;
+    (void)value;
+    (void)user_ctx;
+    s_wildcard_count++;
+}
+
+static void state_test_chain_cb(const char *key, const char *value, void *user_ctx)
+{
+    (void)key;
+    (void)user_ctx;
+    s_notify_count++;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.ph_label", value));
+}
+
+TEST_CASE("state watchers only fire for their key", "[yamui][state]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+
+    yui_state_watch_handle_t ph_watch = 0U;
+    yui_state_watch_handle_t all_watch = 0U;
+    s_notify_count = 0U;
+    s_wildcard_count = 0U;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch("state.sensor.ph", state_test_watch_cb, NULL, &ph_watch));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch(NULL, state_test_wildcard_cb, NULL, &all_watch));
+
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.ec", "1.2"));
+    TEST_ASSERT_EQUAL_UINT32(0, s_notify_count);
+    TEST_ASSERT_EQUAL_UINT32(1, s_wildcard_count);
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.ph", "6.9"));
+    TEST_ASSERT_EQUAL_UINT32(1, s_notify_count);
+    TEST_ASSERT_EQUAL_UINT32(2, s_wildcard_count);
+
+    yui_state_unwatch(ph_watch);
+    yui_state_unwatch(ph_watch);
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.ph", "7.0"));
+    TEST_ASSERT_EQUAL_UINT32(1, s_notify_count);
+    TEST_ASSERT_EQUAL_UINT32(3, s_wildcard_count);
+
+    /* The freed slot is reused; the stale handle must not remove the new watcher. */
+    yui_state_watch_handle_t reused = 0U;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch("sensor.ph", state_test_watch_cb, NULL, &reused));
+    TEST_ASSERT_NOT_EQUAL(ph_watch, reused);
+    yui_state_unwatch(ph_watch);
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.ph", "7.1"));
+    TEST_ASSERT_EQUAL_UINT32(2, s_notify_count);
+
+    yui_state_unwatch(reused);
+    yui_state_unwatch(all_watch);
+}
+
+TEST_CASE("state watchers may set state from callbacks", "[yamui][state]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+
+    yui_state_watch_handle_t chain = 0U;
+    yui_state_watch_handle_t label = 0U;
+    s_notify_count = 0U;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch("sensor.ph", state_test_chain_cb, NULL, &chain));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch("sensor.ph_label", state_test_watch_cb, NULL, &label));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.ph", "6.5"));
+    TEST_ASSERT_EQUAL_UINT32(2, s_notify_count);
+    TEST_ASSERT_EQUAL_STRING("6.5", yui_state_get("sensor.ph_label", NULL));
+    yui_state_unwatch(chain);
+    yui_state_unwatch(label);
+}
+
+TEST_CASE("state store lookup benchmark", "[yamui][state][perf]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+
+    char key[32];
+    for (uint32_t i = 0; i < STATE_BENCH_KEYS; ++i) {
+        snprintf(key, sizeof(key), "sensor.channel_%" PRIu32, i);
+        TEST_ASSERT_EQUAL(ESP_OK, yui_state_set_int(key, (int32_t)i));
+    }
+    snprintf(key, sizeof(key), "sensor.channel_%u", (unsigned)(STATE_BENCH_KEYS - 1U));
+    yui_state_key_t handle = YUI_STATE_KEY_INVALID;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_key_resolve(key, &handle));
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < STATE_BENCH_ITERATIONS; ++i) {
+        TEST_ASSERT_NOT_NULL(yui_state_get(key, NULL));
+    }
+    int64_t by_name_us = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < STATE_BENCH_ITERATIONS; ++i) {
+        TEST_ASSERT_NOT_NULL(yui_state_get_by_key(handle, NULL));
+    }
+    int64_t by_handle_us = esp_timer_get_time() - start;
+
+    if (by_name_us <= 0) {
+        by_name_us = 1;
+    }
+    if (by_handle_us <= 0) {
+        by_handle_us = 1;
+    }
+    printf("state bench: %u keys, get %" PRId64 " lookups/s, get_by_key %" PRId64 " lookups/s\n",
+           (unsigned)STATE_BENCH_KEYS,
+           (int64_t)STATE_BENCH_ITERATIONS * 1000000LL / by_name_us,
+           (int64_t)STATE_BENCH_ITERATIONS * 1000000LL / by_handle_us);
+    TEST_ASSERT_EQUAL_STRING("399", yui_state_get_by_key(handle, NULL));
+    yui_state_clear();
+}
+
+static const char *const s_batch_keys[STATE_BATCH_KEYS] = {
+    "sensor.ph", "sensor.ec", "sensor.temp", "sensor.level", "sensor.flow",
+};
+
+static void state_batch_fill(yui_state_seed_t *updates, char values[][16], uint32_t round)
+{
+    for (uint32_t i = 0; i < STATE_BATCH_KEYS; ++i) {
+        snprintf(values[i], 16, "%" PRIu32, round * 10U + i);
+        updates[i].key = s_batch_keys[i];
+        updates[i].value = values[i];
+    }
+}
+
+TEST_CASE("state batches coalesce notifications", "[yamui][state]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+
+    /* One "widget" bound to every key: five watches sharing a callback and context. */
+    int widget = 0;
+    yui_state_watch_handle_t watches[STATE_BATCH_KEYS];
+    for (uint32_t i = 0; i < STATE_BATCH_KEYS; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch(s_batch_keys[i], state_test_watch_cb, &widget, &watches[i]));
+    }
+    yui_state_watch_handle_t all_watch = 0U;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch(NULL, state_test_wildcard_cb, NULL, &all_watch));
+
+    s_notify_count = 0U;
+    s_wildcard_count = 0U;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_begin_batch());
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.ph", "6.8"));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_begin_batch());
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.ec", "1.1"));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_commit_batch());
+    TEST_ASSERT_EQUAL_UINT32(0, s_notify_count);
+    TEST_ASSERT_EQUAL_STRING("1.1", yui_state_get("sensor.ec", NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_commit_batch());
+    TEST_ASSERT_EQUAL_UINT32(1, s_notify_count);
+    TEST_ASSERT_EQUAL_UINT32(1, s_wildcard_count);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, yui_state_commit_batch());
+
+    /* Unchanged values inside a batch do not notify. */
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_begin_batch());
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_set("sensor.ph", "6.8"));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_commit_batch());
+    TEST_ASSERT_EQUAL_UINT32(1, s_notify_count);
+
+    for (uint32_t i = 0; i < STATE_BATCH_KEYS; ++i) {
+        yui_state_unwatch(watches[i]);
+    }
+    yui_state_unwatch(all_watch);
+}
+
+TEST_CASE("state batch benchmark", "[yamui][state][perf]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+
+    int widget = 0;
+    yui_state_watch_handle_t watches[STATE_BATCH_KEYS];
+    for (uint32_t i = 0; i < STATE_BATCH_KEYS; ++i) {
+        TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch(s_batch_keys[i], state_test_watch_cb, &widget, &watches[i]));
+    }
+
+    yui_state_seed_t updates[STATE_BATCH_KEYS];
+    char values[STATE_BATCH_KEYS][16];
+    yui_state_stats_t single_stats;
+    yui_state_stats_t batch_stats;
+
+    s_notify_count = 0U;
+    yui_state_reset_stats();
+    int64_t start = esp_timer_get_time();
+    for (uint32_t round = 0; round < STATE_BATCH_ROUNDS; ++round) {
+        state_batch_fill(updates, values, round);
+        for (uint32_t i = 0; i < STATE_BATCH_KEYS; ++i) {
+            TEST_ASSERT_EQUAL(ESP_OK, yui_state_set(updates[i].key, updates[i].value));
+        }
+    }
+    int64_t single_us = esp_timer_get_time() - start;
+    yui_state_get_stats(&single_stats);
+    size_t single_refreshes = s_notify_count;
+
+    s_notify_count = 0U;
+    yui_state_reset_stats();
+    start = esp_timer_get_time();
+    for (uint32_t round = 0; round < STATE_BATCH_ROUNDS; ++round) {
+        state_batch_fill(updates, values, round + STATE_BATCH_ROUNDS);
+        TEST_ASSERT_EQUAL(ESP_OK, yui_state_set_many(updates, STATE_BATCH_KEYS));
+    }
+    int64_t batch_us = esp_timer_get_time() - start;
+    yui_state_get_stats(&batch_stats);
+    size_t batch_refreshes = s_notify_count;
+
+    printf("state batch bench: per round of %u keys: set -> %.2f locks, %.2f refreshes, %" PRId64 " us total; "
+           "set_many -> %.2f locks, %.2f refreshes, %" PRId64 " us total\n",
+           (unsigned)STATE_BATCH_KEYS,
+           (double)single_stats.lock_acquisitions / STATE_BATCH_ROUNDS, (double)single_refreshes / STATE_BATCH_ROUNDS, single_us,
+           (double)batch_stats.lock_acquisitions / STATE_BATCH_ROUNDS, (double)batch_refreshes / STATE_BATCH_ROUNDS, batch_us);
+
+    TEST_ASSERT_EQUAL_UINT32(STATE_BATCH_ROUNDS * STATE_BATCH_KEYS, single_refreshes);
+    TEST_ASSERT_EQUAL_UINT32(STATE_BATCH_ROUNDS, batch_refreshes);
+    TEST_ASSERT_EQUAL_UINT32(STATE_BATCH_ROUNDS, batch_stats.lock_acquisitions);
+    TEST_ASSERT_EQUAL_UINT32(STATE_BATCH_ROUNDS, batch_stats.batches);
+    TEST_ASSERT_TRUE(single_stats.lock_acquisitions >= STATE_BATCH_ROUNDS * STATE_BATCH_KEYS);
+
+    for (uint32_t i = 0; i < STATE_BATCH_KEYS; ++i) {
+        yui_state_unwatch(watches[i]);
+    }
+    yui_state_clear();
+}
+
+TEST_CASE("collections keep a bounded ring and publish revisions", "[yamui][state][collection]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_init());
+    yui_state_clear();
+
+    int widget = 0;
+    yui_state_watch_handle_t watch = 0U;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_collection_create("log", 2, 3));
+    TEST_ASSERT_EQUAL(ESP_OK, yui_state_watch("log.revision", state_test_watch_cb, &widget, &watch));
+
+    s_notify_count = 0U;
+    const char *rows[] = {"r0", "v0", "r1", "v1", "r2", "v2", "r3", "v3", "r4", "v4"};
+    TEST_ASSERT_EQUAL(ESP_OK, yui_collection_append_rows("log", rows, 2, 5));
+    TEST_ASSERT_EQUAL_UINT32(1, s_notify_count);
+    TEST_ASSERT_EQUAL_UINT32(3, yui_collection_count("log"));
+    TEST_ASSERT_EQUAL_INT32(3, yui_state_get_int("log.count", -1));
+
+    char cell[8];
+    TEST_ASSERT_TRUE(yui_collection_copy_cell("log", 0, 1, cell, sizeof(cell)));
+    TEST_ASSERT_EQUAL_STRING("v2", cell);
+    TEST_ASSERT_TRUE(yui_collection_copy_cell("log", 2, 0, cell, sizeof(cell)));
+    TEST_ASSERT_EQUAL_STRING("r4", cell);
+    TEST_ASSERT_FALSE(yui_collection_copy_cell("log", 3, 0, cell, sizeof(cell)));
+    TEST_ASSERT_EQUAL_STRING("", cell);
+
+    const char *replacement[] = {"x"};
+    TEST_ASSERT_EQUAL(ESP_OK, yui_collection_set_row("log", 1, replacement, 1));
+    TEST_ASSERT_TRUE(yui_collection_copy_cell("log", 1, 1, cell, sizeof(cell)));
+    TEST_ASSERT_EQUAL_STRING("", cell);
+    TEST_ASSERT_EQUAL_UINT32(2, s_notify_count);
+
+    yui_state_unwatch(watch);
+    TEST_ASSERT_EQUAL(ESP_OK, yui_collection_destroy("log"));
+    TEST_ASSERT_EQUAL_UINT32(0, yui_collection_count("log"));
+    yui_state_clear();
+}
+
+TEST_CASE("translation handles are shared across locales", "[yamui][state][i18n]")
+{
+    static const char schema_text[] =
+        "app:\n"
+        "  locale: en\n"
+        "translations:\n"
+        "  en:\n"
+        "    entries:\n"
+        "      greet: \"Hello\"\n"
+        "      greet: \"Hello again\"\n"
+        "      only_en: \"English only\"\n"
+        "  de:\n"
+        "    entries:\n"
+        "      only_de: \"Nur Deutsch\"\n"
+        "      greet: \"Hallo\"\n"
+        "screens:\n"
+        "  main:\n"
+        "    widgets: []\n";
+    yml_node_t *root = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, yaml_core_parse_buffer_ex(schema_text, sizeof(schema_text) - 1U, &root, NULL));
+    yui_schema_t schema;
+    TEST_ASSERT_EQUAL(ESP_OK, yui_schema_from_tree(root, &schema));
+
+    /* Duplicate keys share one handle; every key of every locale gets one. */
+    TEST_ASSERT_EQUAL_UINT32(3, schema.translation_index.key_count);
+    yui_translation_handle_t greet = yui_schema_translation_handle(&schema, "greet");
+    yui_translation_handle_t only_en = yui_schema_translation_handle(&schema, "only_en");
+    yui_translation_handle_t only_de = yui_schema_translation_handle(&schema, "only_de");
+    TEST_ASSERT_NOT_EQUAL(YUI_TRANSLATION_HANDLE_INVALID, greet);
+    TEST_ASSERT_NOT_EQUAL(YUI_TRANSLATION_HANDLE_INVALID, only_en);
+    TEST_ASSERT_NOT_EQUAL(YUI_TRANSLATION_HANDLE_INVALID, only_de);
+    TEST_ASSERT_NOT_EQUAL(greet, only_en);
+    TEST_ASSERT_NOT_EQUAL(greet, only_de);
+    TEST_ASSERT_NOT_EQUAL(only_en, only_de);
+    TEST_ASSERT_EQUAL(YUI_TRANSLATION_HANDLE_INVALID, yui_schema_translation_handle(&schema, "missing"));
+    TEST_ASSERT_EQUAL(greet, yui_schema_translation_handle(&schema, "greet"));
+
+    const yui_translation_locale_t *en = yui_schema_find_locale(&schema, NULL);
+    const yui_translation_locale_t *de = yui_schema_find_locale(&schema, "de");
+    TEST_ASSERT_NOT_NULL(en);
+    TEST_ASSERT_NOT_NULL(de);
+    TEST_ASSERT_EQUAL_STRING("en", en->locale);
+    TEST_ASSERT_NULL(yui_schema_find_locale(&schema, "fr"));
+
+    /* The first duplicate wins, and the same handle switches locales by indexing. */
+    TEST_ASSERT_EQUAL_STRING("Hello", yui_translation_lookup(en, greet));
+    TEST_ASSERT_EQUAL_STRING("Hallo", yui_translation_lookup(de, greet));
+    TEST_ASSERT_EQUAL_STRING("English only", yui_translation_lookup(en, only_en));
+    TEST_ASSERT_NULL(yui_translation_lookup(de, only_en));
+    TEST_ASSERT_NULL(yui_translation_lookup(en, only_de));
+    TEST_ASSERT_EQUAL_STRING("Nur Deutsch", yui_translation_lookup(de, only_de));
+    TEST_ASSERT_NULL(yui_translation_lookup(de, YUI_TRANSLATION_HANDLE_INVALID));
+    TEST_ASSERT_EQUAL_STRING("Hallo", yui_schema_translate(&schema, "de", "greet"));
+
+    yui_schema_free(&schema);
+    yml_node_free(root);
+    yui_state_clear();
+}
+
+void app_main(void)
+{
+    UNITY_BEGIN();
+    unity_run_menu();
+    UNITY_END();
+}
@@ -11,10 +11,11 @@ import argparse
 import datetime as _dt
 import hashlib
 import json
+import struct
 import sys
 from copy import deepcopy
 from pathlib import Path
-from typing import Any, Dict, List
+from typing import Any, Dict, List, Optional, Tuple
 
 try:
     import yaml  # type: ignore
@@ -50,6 +51,12 @@ def _parse_args() -> argparse.Namespace:
         type=Path,
         help="Path to write the bundle manifest JSON.",
     )
+    parser.add_argument(
+        "--output-blob",
+        type=Path,
+        help="Optional path to write the bundle as a precompiled binary document "
+        "that yaml_core maps in place (see yaml_core_blob_view).",
+    )
     parser.add_argument(
         "--root",
         type=Path,
@@ -126,6 +133,203 @@ def _write_yaml_bundle(destination: Path, payload: Dict[str, Any]) -> str:
     return yaml_text
 
 
+# --- Binary document -------------------------------------------------------------
+# The blob must describe exactly the tree yaml_core would build from the YAML bundle, so
+# the line tokenizer below mirrors components/yaml_core/src/yaml_core.c rather than
+# reusing PyYAML (which unescapes and retypes scalars differently).
+
+_BLOB_MAGIC = b"YMLB"
+_BLOB_VERSION = 1
+_BLOB_NODE_FLAG = 0x100
+_BLOB_HEADER = struct.Struct("<4s8I")
+_BLOB_NODE = struct.Struct("<IiiIii")
+_BLOB_SLOT = struct.Struct("<II")
+_NODE_UNSET, _NODE_SCALAR, _NODE_MAPPING, _NODE_SEQUENCE = range(4)
+_MAX_STACK_DEPTH = 32
+_KEY_INDEX_MIN_CHILDREN = 8
+_SPACE = b" \t\n\v\f\r"
+
+
+class _TreeNode:
+    __slots__ = ("type", "key", "scalar", "children")
+
+    def __init__(self, node_type: int = _NODE_UNSET, key: Optional[bytes] = None) -> None:
+        self.type = node_type
+        self.key = key
+        self.scalar: Optional[bytes] = None
+        self.children: List["_TreeNode"] = []
+
+
+def _scan_unquoted(text: bytes, stop: int) -> int:
+    quote = 0
+    for i, c in enumerate(text):
+        if c in (0x22, 0x27) and (i == 0 or text[i - 1] != 0x5C):
+            if quote == c:
+                quote = 0
+            elif not quote:
+                quote = c
+        elif c == stop and not quote:
+            return i
+    return len(text)
+
+
+def _trim(text: bytes) -> bytes:
+    text = text.strip(_SPACE)
+    if len(text) >= 2 and text[0] == text[-1] and text[0] in (0x22, 0x27):
+        text = text[1:-1]
+    return text
+
+
+def _parse_tree(data: bytes) -> _TreeNode:
+    root = _TreeNode(_NODE_MAPPING)
+    stack: List[Tuple[_TreeNode, int]] = [(root, -1)]
+    for line_number, raw in enumerate(data.replace(b"\r\n", b"\n").replace(b"\r", b"\n").split(b"\n"), 1):
+        stripped = raw.lstrip(b" ")
+        indent = len(raw) - len(stripped)
+        if stripped.startswith(b"\t"):
+            raise SystemExit(f"Bundle line {line_number}: tabs are not supported")
+        payload = _trim(stripped[:_scan_unquoted(stripped, 0x23)])
+        if not payload:
+            continue
+        is_sequence = payload[:1] == b"-" and (len(payload) == 1 or payload[1] in _SPACE)
+        if is_sequence:
+            payload = payload[1:].lstrip(_SPACE)
+        colon = _scan_unquoted(payload, 0x3A)
+        key: Optional[bytes] = None
+        if colon < len(payload):
+            key = _trim(payload[:colon])
+            value = _trim(payload[colon + 1:])
+        elif not is_sequence:
+            raise SystemExit(f"Bundle line {line_number}: missing ':' separator")
+        else:
+            value = _trim(payload)
+
+        while stack and indent <= stack[-1][1]:
+            stack.pop()
+        if not stack:
+            raise SystemExit(f"Bundle line {line_number}: invalid indentation")
+        parent = stack[-1][0]
+        expected = _NODE_SEQUENCE if is_sequence else _NODE_MAPPING
+        if parent.type == _NODE_UNSET:
+            parent.type = expected
+        if parent.type != expected:
+            raise SystemExit(f"Bundle line {line_number}: mixed mapping and sequence entries")
+
+        node = _TreeNode(key=None if is_sequence else key)
+        parent.children.append(node)
+        if is_sequence and key is not None:
+            node.type = _NODE_MAPPING
+            child = _TreeNode(key=key)
+            if value:
+                child.type = _NODE_SCALAR
+                child.scalar = value
+            node.children.append(child)
+            push = True
+        elif value:
+            node.type = _NODE_SCALAR
+            node.scalar = value
+            push = False
+        else:
+            push = True
+        if push:
+            if len(stack) >= _MAX_STACK_DEPTH:
+                raise SystemExit(f"Bundle line {line_number}: nesting too deep")
+            stack.append((node, indent))
+    return root
+
+
+def _fnv1a(data: bytes) -> int:
+    value = 2166136261
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def _key_index_capacity(count: int) -> int:
+    capacity = _KEY_INDEX_MIN_CHILDREN * 2
+    while capacity < count * 2:
+        capacity *= 2
+    return capacity
+
+
+def _encode_blob(root: _TreeNode) -> bytes:
+    # Breadth-first order keeps every node's children contiguous and after the parent.
+    order = [root]
+    first_child: Dict[int, int] = {}
+    parent_of: Dict[int, int] = {}
+    for index, node in enumerate(order):
+        if node.children:
+            first_child[index] = len(order)
+            for child in node.children:
+                parent_of[len(order)] = index
+                order.append(child)
+
+    strings: Dict[bytes, int] = {}
+    string_table = bytearray()
+
+    def intern(text: bytes) -> int:
+        if text not in strings:
+            strings[text] = len(string_table)
+            string_table.extend(text + b"\0")
+        return strings[text]
+
+    index_table = bytearray()
+    index_offsets: Dict[int, int] = {}
+    for index, node in enumerate(order):
+        if node.type != _NODE_MAPPING or len(node.children) < _KEY_INDEX_MIN_CHILDREN:
+            continue
+        capacity = _key_index_capacity(len(node.children))
+        slots = [(0, 0)] * capacity
+        for position, child in enumerate(node.children, 1):
+            digest = _fnv1a(child.key or b"")
+            slot = digest & (capacity - 1)
+            while slots[slot][1]:
+                slot = (slot + 1) & (capacity - 1)
+            slots[slot] = (digest, position)
+        index_offsets[index] = len(index_table)
+        for digest, position in slots:
+            index_table.extend(_BLOB_SLOT.pack(digest, position))
+
+    node_offset = _BLOB_HEADER.size
+    index_offset = node_offset + len(order) * _BLOB_NODE.size
+    string_offset = index_offset + len(index_table)
+    for node in order:
+        if node.key is not None:
+            intern(node.key)
+        if node.scalar is not None:
+            intern(node.scalar)
+
+    def rel(index: int, target: int) -> int:
+        return target - (node_offset + index * _BLOB_NODE.size)
+
+    node_table = bytearray()
+    for index, node in enumerate(order):
+        key = rel(index, string_offset + strings[node.key]) if node.key is not None else 0
+        if node.type == _NODE_SCALAR:
+            value = rel(index, string_offset + strings[node.scalar or b""])
+        elif node.children:
+            value = rel(index, node_offset + first_child[index] * _BLOB_NODE.size)
+        else:
+            value = 0
+        parent = rel(index, node_offset + parent_of[index] * _BLOB_NODE.size) if index else 0
+        key_index = rel(index, index_offset + index_offsets[index]) if index in index_offsets else 0
+        node_table.extend(_BLOB_NODE.pack(node.type | _BLOB_NODE_FLAG, key, value, len(node.children), parent, key_index))
+
+    total = string_offset + len(string_table)
+    header = _BLOB_HEADER.pack(
+        _BLOB_MAGIC, _BLOB_VERSION, total, node_offset, len(order), index_offset, len(index_table),
+        string_offset, len(string_table),
+    )
+    return header + bytes(node_table) + bytes(index_table) + bytes(string_table)
+
+
+def _write_blob(destination: Path, yaml_text: str) -> bytes:
+    destination.parent.mkdir(parents=True, exist_ok=True)
+    blob = _encode_blob(_parse_tree(yaml_text.encode("utf-8")))
+    destination.write_bytes(blob)
+    return blob
+
+
 def _write_manifest(destination: Path, payload: Dict[str, Any]) -> None:
     destination.parent.mkdir(parents=True, exist_ok=True)
     destination.write_text(json.dumps(payload, indent=2, sort_keys=True), encoding="utf-8")
@@ -155,6 +359,8 @@ def main() -> None:
     yaml_text = _write_yaml_bundle(args.output_yaml, bundle)
     checksum = hashlib.sha256(yaml_text.encode("utf-8")).hexdigest()
 
+    blob = _write_blob(args.output_blob, yaml_text) if args.output_blob else None
+
     generated_at = _dt.datetime.now(_dt.UTC).isoformat(timespec="seconds").replace("+00:00", "Z")
 
     manifest = {
@@ -169,6 +375,11 @@ def main() -> None:
         },
         "checksum": checksum,
     }
+    if blob is not None:
+        manifest["blob"] = {
+            "size": len(blob),
+            "checksum": hashlib.sha256(blob).hexdigest(),
+        }
     _write_manifest(args.output_manifest, manifest)
 
 